@@ -0,0 +1,110 @@
+#! /usr/bin/env python3
+
+# Boolector: Satisfiablity Modulo Theories (SMT) solver.
+#
+# Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+#
+# This file is part of Boolector.
+# See COPYING for more information on using this software.
+#
+
+# Micro-benchmark for the SMT-LIB2 parser. Generates a large file with
+# nested let-chains (as produced by typical front-ends) and reports the
+# token and symbol lookup throughput of the parser.
+
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from argparse import ArgumentParser
+
+
+def gen_let_chains(f, nvars, nasserts, depth, width, seed):
+    rng = random.Random(seed)
+    ops = ["bvadd", "bvmul", "bvand", "bvor", "bvxor", "bvsub"]
+    f.write("(set-logic QF_BV)\n")
+    for i in range(nvars):
+        f.write("(declare-fun v{} () (_ BitVec 32))\n".format(i))
+    for a in range(nasserts):
+        bound = ["v{}".format(rng.randrange(nvars)) for _ in range(4)]
+        f.write("(assert ")
+        for d in range(depth):
+            f.write("(let (")
+            names = []
+            for w in range(width):
+                name = "a!{}".format(d * width + w)
+                f.write("({} ({} {} {})) ".format(
+                    name, rng.choice(ops),
+                    rng.choice(bound), rng.choice(bound)))
+                names.append(name)
+            f.write(")\n")
+            bound = names + ["v{}".format(rng.randrange(nvars))]
+        f.write("(bvult {} {})".format(bound[0], bound[-1]))
+        f.write(")" * (depth + 1))
+        f.write("\n")
+    f.write("(exit)\n")
+
+
+def main():
+    ap = ArgumentParser(description="SMT-LIB2 parser micro-benchmark")
+    ap.add_argument("boolector", help="path to boolector binary")
+    ap.add_argument("--vars", type=int, default=1000)
+    ap.add_argument("--asserts", type=int, default=2000)
+    ap.add_argument("--depth", type=int, default=50,
+                    help="number of nested lets per assertion")
+    ap.add_argument("--width", type=int, default=4,
+                    help="number of bindings per let")
+    ap.add_argument("--seed", type=int, default=0)
+    ap.add_argument("--keep", metavar="FILE",
+                    help="write benchmark to FILE and keep it")
+    args = ap.parse_args()
+
+    if args.keep:
+        path = args.keep
+    else:
+        fd, path = tempfile.mkstemp(suffix=".smt2")
+        os.close(fd)
+    try:
+        with open(path, "w") as f:
+            gen_let_chains(f, args.vars, args.asserts, args.depth, args.width,
+                           args.seed)
+        size = os.path.getsize(path)
+
+        start = time.time()
+        out = subprocess.run([args.boolector, "-v", path],
+                             stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT,
+                             universal_newlines=True).stdout
+        wall = time.time() - start
+
+        m = re.search(r"parsed (\d+) commands in ([\d.]+) seconds", out)
+        s = re.search(r"read (\d+) tokens.* looked up (\d+) symbols", out)
+        if not m or not s:
+            print(out, file=sys.stderr)
+            sys.exit("error: could not find parser statistics")
+        secs = float(m.group(2))
+        if secs > 0:
+            timing = "parse time"
+        else:
+            # boolector compiled without time statistics
+            secs = wall
+            timing = "wall clock time"
+        tokens = int(s.group(1))
+        lookups = int(s.group(2))
+        print("input:          {:.1f} MB".format(size / 1e6))
+        print("commands:       {}".format(m.group(1)))
+        print("time:           {:.2f} seconds ({})".format(secs, timing))
+        print("tokens:         {} ({:.0f} per second)".format(
+            tokens, tokens / secs))
+        print("symbol lookups: {} ({:.0f} per second)".format(
+            lookups, lookups / secs))
+    finally:
+        if not args.keep:
+            os.remove(path)
+
+
+if __name__ == "__main__":
+    main()
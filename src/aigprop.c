@@ -821,8 +821,8 @@ select_move (BtorAIGProp *aprop,
       real_cur = BTOR_REAL_ADDR_AIG (cur);
       assert (btor_aig_is_and (real_cur));
       asscur = BTOR_IS_INVERTED_AIG (cur) ? -asscur : asscur;
-      c[0]   = btor_aig_get_by_id (aprop->amgr, real_cur->children[0]);
-      c[1]   = btor_aig_get_by_id (aprop->amgr, real_cur->children[1]);
+      c[0]   = btor_aig_get_left_child (aprop->amgr, real_cur);
+      c[1]   = btor_aig_get_right_child (aprop->amgr, real_cur);
 
       /* conflict */
       if (btor_aig_is_and (real_cur) && btor_aig_is_const (c[0])
@@ -969,7 +969,8 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
       {
         for (i = 0; i < 2; i++)
         {
-          child = btor_aig_get_by_id (aprop->amgr, cur->children[i]);
+          child = i == 0 ? btor_aig_get_left_child (aprop->amgr, cur)
+                         : btor_aig_get_right_child (aprop->amgr, cur);
           if (!btor_aig_is_const (child)) BTOR_PUSH_STACK (stack, child);
         }
       }
@@ -981,10 +982,11 @@ btor_aigprop_sat (BtorAIGProp *aprop, BtorIntHashTable *roots)
       if (btor_aig_is_var (cur)) continue;
       for (i = 0; i < 2; i++)
       {
-        if (btor_aig_is_const (
-                btor_aig_get_by_id (aprop->amgr, cur->children[i])))
+        childid = i == 0 ? btor_aig_get_left_child_id (aprop->amgr, cur)
+                         : btor_aig_get_right_child_id (aprop->amgr, cur);
+        if (btor_aig_is_const (btor_aig_get_by_id (aprop->amgr, childid)))
           continue;
-        childid = cur->children[i] < 0 ? -cur->children[i] : cur->children[i];
+        childid = childid < 0 ? -childid : childid;
         assert (btor_hashint_map_contains (aprop->parents, childid));
         childparents = btor_hashint_map_get (aprop->parents, childid)->as_ptr;
         assert (childparents);
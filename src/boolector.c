@@ -23,6 +23,7 @@
 #include "btorsort.h"
 #include "btortrapi.h"
 #include "dumper/btordumpaig.h"
+#include "dumper/btordumpbin.h"
 #include "dumper/btordumpbtor.h"
 #include "dumper/btordumpsmt.h"
 #include "preprocess/btorpreprocess.h"
@@ -37,9 +38,85 @@
 
 /*------------------------------------------------------------------------*/
 
+/* With option BTOR_OPT_THREAD_SAFE enabled, every API function that accesses
+ * an instance holds the lock of the instance while doing so, including API
+ * tracing.  Getters take the lock, too, since they may trace, allocate memory
+ * or check the shadow clone.  The lock is recursive since the parsers and the
+ * termination callback may issue API calls while it is held.
+ *
+ * Not locked are boolector_new (the instance is not shared yet),
+ * boolector_delete (must not be called concurrently with any other call on
+ * the instance), boolector_terminate (called from the termination callback,
+ * which may run while another thread holds the lock) and the functions that
+ * return constants (boolector_copyright, boolector_version,
+ * boolector_git_id).
+ *
+ * The instances locked by the current thread are linked via 'api_lock_outer'
+ * such that the locks can be released before the abort callback is called,
+ * which may return to the user (e.g., via an exception). */
+
+#ifdef BTOR_HAVE_PTHREADS
+static __thread Btor *api_locked;
+
+static void
+lock_api (Btor *btor)
+{
+  if (!btor_opt_get (btor, BTOR_OPT_THREAD_SAFE)) return;
+  pthread_mutex_lock (&btor->api_mutex);
+  if (btor->api_lock_depth++ == 0)
+  {
+    btor->api_lock_outer = api_locked;
+    api_locked           = btor;
+  }
+}
+
+static void
+unlock_api (Btor *btor)
+{
+  /* locks are released in reverse order, 'btor' is held by this thread iff it
+   * is the last instance it locked (the option may have been changed while
+   * the lock was held or not held) */
+  if (api_locked != btor) return;
+  assert (btor->api_lock_depth > 0);
+  if (--btor->api_lock_depth == 0) api_locked = btor->api_lock_outer;
+  pthread_mutex_unlock (&btor->api_mutex);
+}
+
+static void
+unlock_api_all (void)
+{
+  Btor *btor;
+
+  while ((btor = api_locked))
+  {
+    api_locked = btor->api_lock_outer;
+    for (; btor->api_lock_depth; btor->api_lock_depth--)
+      pthread_mutex_unlock (&btor->api_mutex);
+  }
+}
+
+#define BTOR_LOCK_API(btor) lock_api (btor)
+#define BTOR_UNLOCK_API(btor) unlock_api (btor)
+#else
+#define BTOR_LOCK_API(btor) \
+  do                        \
+  {                         \
+  } while (0)
+
+#define BTOR_UNLOCK_API(btor) \
+  do                          \
+  {                           \
+  } while (0)
+#endif
+
+/*------------------------------------------------------------------------*/
+
 static void
 abort_aux (const char* msg)
 {
+#ifdef BTOR_HAVE_PTHREADS
+  unlock_api_all ();
+#endif
   if (btor_abort_callback.cb_fun)
     ((void (*) (const char*)) btor_abort_callback.cb_fun) (msg);
 }
@@ -82,6 +159,7 @@ void
 boolector_chkclone (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
 
 #ifndef NDEBUG
@@ -102,7 +180,11 @@ boolector_chkclone (Btor *btor)
   /* do not generate shadow clone if sat solver does not support cloning
    * (else only expression layer will be cloned and shadowed API function
    *  calls may fail) */
-  if (!btor_sat_mgr_has_clone_support (btor_get_sat_mgr (btor))) return;
+  if (!btor_sat_mgr_has_clone_support (btor_get_sat_mgr (btor)))
+  {
+    BTOR_UNLOCK_API (btor);
+    return;
+  }
   btor->clone           = btor_clone_btor (btor);
   btor->clone->apitrace = 0; /* disable tracing of shadow clone */
   assert (btor->clone->mm);
@@ -139,6 +221,7 @@ boolector_chkclone (Btor *btor)
   }
   btor_chkclone (btor, btor->clone);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 #ifndef NDEBUG
@@ -167,6 +250,7 @@ boolector_set_btor_id (Btor *btor, BoolectorNode *node, int32_t id)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN_EXT (exp, "%d", id);
   BTOR_ABORT (!btor_node_is_bv_var (exp) && !btor_node_is_uf_array (exp),
               "'exp' is neither BV/array variable nor UF");
@@ -175,17 +259,20 @@ boolector_set_btor_id (Btor *btor, BoolectorNode *node, int32_t id)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_btor_id, BTOR_CLONED_EXP (exp), id);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 BtorMsg *
 boolector_get_btor_msg (Btor *btor)
 {
   BtorMsg *res;
+  BTOR_LOCK_API (btor);
   /* do not trace, clutters the trace unnecessarily */
   res = btor->msg;
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (get_btor_msg);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -199,6 +286,7 @@ boolector_print_value_smt2 (Btor *btor,
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN_EXT (exp, "%s", symbol_str);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_SAT
@@ -214,6 +302,7 @@ boolector_print_value_smt2 (Btor *btor,
   BTOR_CHKCLONE_NORES (
       print_value_smt2, BTOR_CLONED_EXP (exp), symbol_str, file);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -223,6 +312,7 @@ boolector_var_mark_bool (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (node);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
@@ -233,6 +323,7 @@ boolector_var_mark_bool (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (var_mark_bool, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -242,6 +333,7 @@ boolector_add_output (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (node);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
@@ -249,6 +341,7 @@ boolector_add_output (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (add_output, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -256,13 +349,19 @@ boolector_add_output (Btor *btor, BoolectorNode *node)
 Btor *
 boolector_new (void)
 {
-  char *trname;
+  char *trname, *cachename, *cnfname, *satcmd;
   Btor *btor;
 
   btor = btor_new ();
   if ((trname = getenv ("BTORAPITRACE"))) btor_trapi_open_trace (btor, trname);
   BTOR_TRAPI ("");
   BTOR_TRAPI_RETURN_PTR (btor);
+  if ((cachename = getenv ("BTORRESULTCACHE")))
+    btor->result_cache = btor_result_cache_new (btor->mm, cachename);
+  if ((cnfname = getenv ("BTORCNFSTREAM")))
+    btor->cnf_stream = btor_mem_strdup (btor->mm, cnfname);
+  if ((satcmd = getenv ("BTORSATCMD")))
+    btor->ext_sat_cmd = btor_mem_strdup (btor->mm, satcmd);
   return btor;
 }
 
@@ -272,6 +371,7 @@ boolector_clone (Btor *btor)
   Btor *clone;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   clone = btor_clone_btor (btor);
   BTOR_TRAPI_RETURN_PTR (clone);
@@ -283,6 +383,7 @@ boolector_clone (Btor *btor)
     btor_delete (cshadow);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
   return clone;
 }
 
@@ -335,11 +436,13 @@ void
 boolector_set_msg_prefix (Btor *btor, const char *prefix)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%s", prefix);
   btor_set_msg_prefix (btor, prefix);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_msg_prefix, prefix);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 uint32_t
@@ -348,12 +451,14 @@ boolector_get_refs (Btor *btor)
   uint32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   res = btor->external_refs;
   BTOR_TRAPI_RETURN_INT (res);
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_refs);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -361,49 +466,108 @@ void
 boolector_reset_time (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   btor_reset_time (btor);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (reset_time);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_reset_stats (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   btor_reset_stats (btor);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (reset_stats);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_print_stats (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   btor_sat_print_stats (btor_get_sat_mgr (btor));
   btor_print_stats (btor);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (print_stats);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_set_trapi (Btor *btor, FILE *apitrace)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->apitrace, "API trace already set");
   btor->apitrace = apitrace;
+  BTOR_UNLOCK_API (btor);
 }
 
 FILE *
 boolector_get_trapi (Btor *btor)
+{
+  FILE *res;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
+  res = btor->apitrace;
+  BTOR_UNLOCK_API (btor);
+  return res;
+}
+
+void
+boolector_set_result_cache (Btor *btor, const char *path)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
+  BTOR_TRAPI ("%s", path);
+  BTOR_ABORT_ARG_NULL (path);
+  if (btor->result_cache) btor_result_cache_delete (btor->result_cache);
+  btor->result_cache = btor_result_cache_new (btor->mm, path);
+  BTOR_UNLOCK_API (btor);
+}
+
+void
+boolector_set_cnf_stream (Btor *btor, const char *path)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
+  BTOR_TRAPI ("%s", path);
+  BTOR_ABORT_ARG_NULL (path);
+  BTOR_ABORT (btor_sat_is_initialized (btor_get_sat_mgr (btor)),
+              "setting the CNF stream must be done before calling "
+              "'boolector_sat'");
+  if (btor->cnf_stream) btor_mem_freestr (btor->mm, btor->cnf_stream);
+  btor->cnf_stream = btor_mem_strdup (btor->mm, path);
+  BTOR_UNLOCK_API (btor);
+}
+
+void
+boolector_set_external_sat_solver (Btor *btor, const char *cmd)
 {
   BTOR_ABORT_ARG_NULL (btor);
-  return btor->apitrace;
+  BTOR_LOCK_API (btor);
+  BTOR_TRAPI ("%s", cmd);
+  BTOR_ABORT_ARG_NULL (cmd);
+  BTOR_ABORT (
+      btor->btor_sat_btor_called > 0,
+      "setting the SAT solver must be done before calling 'boolector_sat'");
+  if (btor->ext_sat_cmd) btor_mem_freestr (btor->mm, btor->ext_sat_cmd);
+  btor->ext_sat_cmd = btor_mem_strdup (btor->mm, cmd);
+  btor_opt_set (btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_EXTERNAL);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (set_external_sat_solver, cmd);
+#endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -412,11 +576,16 @@ void
 boolector_push (Btor *btor, uint32_t level)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u", level);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
               "incremental usage has not been enabled");
 
-  if (level == 0) return;
+  if (level == 0)
+  {
+    BTOR_UNLOCK_API (btor);
+    return;
+  }
 
   uint32_t i;
   for (i = 0; i < level; i++)
@@ -425,12 +594,14 @@ boolector_push (Btor *btor, uint32_t level)
                      BTOR_COUNT_STACK (btor->assertions));
   }
   btor->num_push_pop++;
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_pop (Btor *btor, uint32_t level)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u", level);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
               "incremental usage has not been enabled");
@@ -439,7 +610,11 @@ boolector_pop (Btor *btor, uint32_t level)
               level,
               BTOR_COUNT_STACK (btor->assertions_trail));
 
-  if (level == 0) return;
+  if (level == 0)
+  {
+    BTOR_UNLOCK_API (btor);
+    return;
+  }
 
   uint32_t i, pos;
   BtorNode *cur;
@@ -454,6 +629,7 @@ boolector_pop (Btor *btor, uint32_t level)
     btor_node_release (btor, cur);
   }
   btor->num_push_pop++;
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -465,6 +641,7 @@ boolector_assert (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -493,6 +670,7 @@ boolector_assert (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (assert, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -502,6 +680,7 @@ boolector_assume (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
@@ -519,6 +698,7 @@ boolector_assume (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (assume, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 bool
@@ -529,6 +709,7 @@ boolector_failed (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_UNSAT,
               "cannot check failed assumptions if input formula is not UNSAT");
   BTOR_ABORT_ARG_NULL (exp);
@@ -547,6 +728,7 @@ boolector_failed (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, failed, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -559,6 +741,7 @@ boolector_get_failed_assumptions (Btor *btor)
   uint32_t i;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_UNSAT,
               "cannot check failed assumptions if input formula is not UNSAT");
 
@@ -590,6 +773,7 @@ boolector_get_failed_assumptions (Btor *btor)
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -597,6 +781,7 @@ void
 boolector_fixate_assumptions (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   BTOR_ABORT (
       !btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
@@ -605,12 +790,14 @@ boolector_fixate_assumptions (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (fixate_assumptions);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_reset_assumptions (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   BTOR_ABORT (
       !btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
@@ -619,6 +806,7 @@ boolector_reset_assumptions (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (reset_assumptions);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -629,6 +817,7 @@ boolector_sat (Btor *btor)
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
                   && btor->btor_sat_btor_called > 0,
@@ -639,6 +828,7 @@ boolector_sat (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_INT (res, sat);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -647,6 +837,7 @@ boolector_limited_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 {
   int32_t res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%d %d", lod_limit, sat_limit);
   BTOR_ABORT (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
                   && btor->btor_sat_btor_called > 0,
@@ -657,6 +848,7 @@ boolector_limited_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_INT (res, limited_sat, lod_limit, sat_limit);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -668,6 +860,7 @@ boolector_simplify (Btor *btor)
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
 
   res = btor_simplify (btor);
@@ -675,6 +868,7 @@ boolector_simplify (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_INT (res, simplify);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -687,6 +881,7 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
   uint32_t sat_engine, oldval;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%s", solver);
   BTOR_ABORT_ARG_NULL (solver);
   BTOR_ABORT (
@@ -733,6 +928,7 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_sat_solver, solver);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -741,6 +937,7 @@ void
 boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s %u", opt, btor_opt_get_lng (btor, opt), val);
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   BTOR_ABORT (
@@ -836,11 +1033,34 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
         BTOR_COUNT_STACK (btor->nodes_id_table) > 2,
         "setting rewrite level must be done before creating expressions");
   }
+  else if (opt == BTOR_OPT_SAT_ENGINE_PORTFOLIO
+           || opt == BTOR_OPT_SAT_ENGINE_CUBES
+           || opt == BTOR_OPT_SAT_ENGINE_SHARE_LBD)
+  {
+    BTOR_ABORT (btor->btor_sat_btor_called > 0,
+                "setting the SAT solver portfolio, cube-and-conquer or clause "
+                "sharing must be done before calling 'boolector_sat'");
+#ifndef BTOR_HAVE_PTHREADS
+    BTOR_WARN (val > 1, "compiled without thread support, ignoring option");
+    val = 0;
+#endif
+  }
+  else if (opt == BTOR_OPT_THREAD_SAFE)
+  {
+    BTOR_ABORT (BTOR_COUNT_STACK (btor->nodes_id_table) > 2,
+                "enabling/disabling thread-safe term construction must be "
+                "done before creating expressions");
+#ifndef BTOR_HAVE_PTHREADS
+    BTOR_WARN (val, "compiled without thread support, ignoring option");
+    val = 0;
+#endif
+  }
 
   btor_opt_set (btor, opt, val);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_opt, opt, val);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 uint32_t
@@ -848,6 +1068,7 @@ boolector_get_opt (Btor *btor, BtorOption opt)
 {
   uint32_t res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get (btor, opt);
@@ -855,6 +1076,7 @@ boolector_get_opt (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_opt, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -863,6 +1085,7 @@ boolector_get_opt_min (Btor *btor, BtorOption opt)
 {
   uint32_t res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_min (btor, opt);
@@ -870,6 +1093,7 @@ boolector_get_opt_min (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_opt_min, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -878,6 +1102,7 @@ boolector_get_opt_max (Btor *btor, BtorOption opt)
 {
   uint32_t res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_max (btor, opt);
@@ -885,6 +1110,7 @@ boolector_get_opt_max (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_opt_max, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -893,6 +1119,7 @@ boolector_get_opt_dflt (Btor *btor, BtorOption opt)
 {
   uint32_t res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_dflt (btor, opt);
@@ -900,6 +1127,7 @@ boolector_get_opt_dflt (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_opt_dflt, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -908,6 +1136,7 @@ boolector_get_opt_lng (Btor *btor, BtorOption opt)
 {
   const char *res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_lng (btor, opt);
@@ -915,6 +1144,7 @@ boolector_get_opt_lng (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_STR (res, get_opt_lng, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -923,6 +1153,7 @@ boolector_get_opt_shrt (Btor *btor, BtorOption opt)
 {
   const char *res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_shrt (btor, opt);
@@ -930,6 +1161,7 @@ boolector_get_opt_shrt (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_STR (res, get_opt_shrt, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -938,6 +1170,7 @@ boolector_get_opt_desc (Btor *btor, BtorOption opt)
 {
   const char *res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_get_desc (btor, opt);
@@ -945,6 +1178,7 @@ boolector_get_opt_desc (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_STR (res, get_opt_desc, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -953,12 +1187,14 @@ boolector_has_opt (Btor *btor, BtorOption opt)
 {
   bool res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   res = btor_opt_is_valid (btor, opt);
   BTOR_TRAPI_RETURN_BOOL (res);
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, next_opt, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -967,12 +1203,14 @@ boolector_first_opt (Btor *btor)
 {
   BtorOption res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   res = btor_opt_first (btor);
   BTOR_TRAPI_RETURN_INT (res);
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, first_opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -981,6 +1219,7 @@ boolector_next_opt (Btor *btor, BtorOption opt)
 {
   BtorOption res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u %s", opt, btor_opt_get_lng (btor, opt));
   BTOR_ABORT (!btor_opt_is_valid (btor, opt), "invalid option");
   res = btor_opt_next (btor, opt);
@@ -988,6 +1227,7 @@ boolector_next_opt (Btor *btor, BtorOption opt)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, next_opt, opt);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1000,6 +1240,7 @@ boolector_copy (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1010,6 +1251,7 @@ boolector_copy (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, copy, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1020,6 +1262,7 @@ boolector_release (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1033,17 +1276,20 @@ boolector_release (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (release, cexp);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_release_all (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   btor_release_all_ext_refs (btor);
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (release_all);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -1054,6 +1300,7 @@ boolector_true (Btor *btor)
   BtorNode *res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   res = btor_exp_true (btor);
   btor_node_inc_ext_ref_counter (btor, res);
@@ -1061,6 +1308,7 @@ boolector_true (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, true);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1070,6 +1318,7 @@ boolector_false (Btor *btor)
   BtorNode *res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
   res = btor_exp_false (btor);
   btor_node_inc_ext_ref_counter (btor, res);
@@ -1077,6 +1326,7 @@ boolector_false (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, false);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1088,6 +1338,7 @@ boolector_implies (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1107,6 +1358,7 @@ boolector_implies (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, implies, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1118,6 +1370,7 @@ boolector_iff (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1136,6 +1389,7 @@ boolector_iff (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, iff, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1149,6 +1403,7 @@ boolector_eq (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1170,6 +1425,7 @@ boolector_eq (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, eq, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1181,6 +1437,7 @@ boolector_ne (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1200,6 +1457,7 @@ boolector_ne (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ne, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1212,6 +1470,7 @@ boolector_const (Btor *btor, const char *bits)
   BtorBitVector *bv;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%s", bits);
   BTOR_ABORT_ARG_NULL (bits);
   BTOR_ABORT (*bits == '\0', "'bits' must not be empty");
@@ -1223,6 +1482,7 @@ boolector_const (Btor *btor, const char *bits)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, const, bits);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1235,6 +1495,7 @@ boolector_constd (Btor *btor, BoolectorSort sort, const char *str)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT " %s", sort, str);
   BTOR_ABORT_ARG_NULL (str);
   BTOR_ABORT (*str == '\0', "'str' must not be empty");
@@ -1257,6 +1518,7 @@ boolector_constd (Btor *btor, BoolectorSort sort, const char *str)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, constd, sort, str);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1269,6 +1531,7 @@ boolector_consth (Btor *btor, BoolectorSort sort, const char *str)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%s", str);
   BTOR_ABORT_ARG_NULL (str);
   BTOR_ABORT (*str == '\0', "'str' must not be empty");
@@ -1291,6 +1554,7 @@ boolector_consth (Btor *btor, BoolectorSort sort, const char *str)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, consth, sort, str);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1303,6 +1567,7 @@ boolector_is_bv_const_zero (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -1312,6 +1577,7 @@ boolector_is_bv_const_zero (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bv_const_zero, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1322,6 +1588,7 @@ boolector_is_bv_const_one (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -1331,6 +1598,7 @@ boolector_is_bv_const_one (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bv_const_one, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1341,6 +1609,7 @@ boolector_is_bv_const_ones (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -1350,6 +1619,7 @@ boolector_is_bv_const_ones (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bv_const_ones, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1360,6 +1630,7 @@ boolector_is_bv_const_max_signed (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -1369,6 +1640,7 @@ boolector_is_bv_const_max_signed (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bv_const_max_signed, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1379,6 +1651,7 @@ boolector_is_bv_const_min_signed (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -1388,6 +1661,7 @@ boolector_is_bv_const_min_signed (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bv_const_min_signed, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -1400,6 +1674,7 @@ boolector_zero (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1411,6 +1686,7 @@ boolector_zero (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, zero, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1421,6 +1697,7 @@ boolector_ones (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1432,6 +1709,7 @@ boolector_ones (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ones, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1442,6 +1720,7 @@ boolector_one (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1453,6 +1732,7 @@ boolector_one (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, one, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1463,6 +1743,7 @@ boolector_min_signed (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1473,6 +1754,7 @@ boolector_min_signed (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, min_signed, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1483,6 +1765,7 @@ boolector_max_signed (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1493,6 +1776,7 @@ boolector_max_signed (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, max_signed, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1503,6 +1787,7 @@ boolector_unsigned_int (Btor *btor, uint32_t u, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u " BTOR_TRAPI_SORT_FMT, u, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1514,6 +1799,7 @@ boolector_unsigned_int (Btor *btor, uint32_t u, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, unsigned_int, u, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1524,6 +1810,7 @@ boolector_int (Btor *btor, int32_t i, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%d " BTOR_TRAPI_SORT_FMT, i, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
   BTOR_ABORT (!btor_sort_is_valid (btor, s), "'sort' is not a valid sort");
@@ -1535,6 +1822,7 @@ boolector_int (Btor *btor, int32_t i, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, int, i, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1592,6 +1880,7 @@ BoolectorNode *
 boolector_var (Btor *btor, BoolectorSort sort, const char *symbol)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
 
   BtorNode *res;
   char *symb;
@@ -1614,6 +1903,7 @@ boolector_var (Btor *btor, BoolectorSort sort, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, var, sort, symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1621,6 +1911,7 @@ BoolectorNode *
 boolector_array (Btor *btor, BoolectorSort sort, const char *symbol)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
 
   BtorNode *res;
   char *symb;
@@ -1646,6 +1937,7 @@ boolector_array (Btor *btor, BoolectorSort sort, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, array, sort, symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1653,6 +1945,7 @@ BoolectorNode *
 boolector_const_array (Btor *btor, BoolectorSort sort, BoolectorNode *value)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
 
   BtorNode *res, *val;
   BtorSortId s;
@@ -1686,6 +1979,7 @@ boolector_const_array (Btor *btor, BoolectorSort sort, BoolectorNode *value)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, const_array, sort, value);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1693,6 +1987,7 @@ BoolectorNode *
 boolector_uf (Btor *btor, BoolectorSort sort, const char *symbol)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
 
   BtorNode *res;
   BtorSortId s;
@@ -1722,6 +2017,7 @@ boolector_uf (Btor *btor, BoolectorSort sort, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, uf, sort, symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1734,6 +2030,7 @@ boolector_not (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1745,6 +2042,7 @@ boolector_not (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, not, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1755,6 +2053,7 @@ boolector_neg (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1766,6 +2065,7 @@ boolector_neg (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, neg, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1776,6 +2076,7 @@ boolector_redor (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1787,6 +2088,7 @@ boolector_redor (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, redor, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1797,6 +2099,7 @@ boolector_redxor (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1808,6 +2111,7 @@ boolector_redxor (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, redxor, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1818,6 +2122,7 @@ boolector_redand (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1829,6 +2134,7 @@ boolector_redand (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, redand, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1842,6 +2148,7 @@ boolector_slice (Btor *btor,
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u %u", upper, lower);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1856,6 +2163,7 @@ boolector_slice (Btor *btor,
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, slice, BTOR_CLONED_EXP (exp), upper, lower);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1866,6 +2174,7 @@ boolector_uext (Btor *btor, BoolectorNode *node, uint32_t width)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u", width);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1883,6 +2192,7 @@ boolector_uext (Btor *btor, BoolectorNode *node, uint32_t width)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, uext, BTOR_CLONED_EXP (exp), width);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1893,6 +2203,7 @@ boolector_sext (Btor *btor, BoolectorNode *node, uint32_t width)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u", width);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -1910,6 +2221,7 @@ boolector_sext (Btor *btor, BoolectorNode *node, uint32_t width)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sext, BTOR_CLONED_EXP (exp), width);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1921,6 +2233,7 @@ boolector_xor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1937,6 +2250,7 @@ boolector_xor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, xor, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1948,6 +2262,7 @@ boolector_xnor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1964,6 +2279,7 @@ boolector_xnor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, xnor, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -1975,6 +2291,7 @@ boolector_and (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -1991,6 +2308,7 @@ boolector_and (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, and, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2002,6 +2320,7 @@ boolector_nand (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2018,6 +2337,7 @@ boolector_nand (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, nand, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2029,6 +2349,7 @@ boolector_or (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2045,6 +2366,7 @@ boolector_or (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, or, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2056,6 +2378,7 @@ boolector_nor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2072,6 +2395,7 @@ boolector_nor (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, nor, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2083,6 +2407,7 @@ boolector_add (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2099,6 +2424,7 @@ boolector_add (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, add, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2110,6 +2436,7 @@ boolector_uaddo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2127,6 +2454,7 @@ boolector_uaddo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, uaddo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2138,6 +2466,7 @@ boolector_saddo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2155,6 +2484,7 @@ boolector_saddo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, saddo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2166,6 +2496,7 @@ boolector_mul (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2182,6 +2513,7 @@ boolector_mul (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, mul, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2193,6 +2525,7 @@ boolector_umulo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2210,6 +2543,7 @@ boolector_umulo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, umulo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2221,6 +2555,7 @@ boolector_smulo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2239,6 +2574,7 @@ boolector_smulo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, smulo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2250,6 +2586,7 @@ boolector_ult (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2266,6 +2603,7 @@ boolector_ult (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ult, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2277,6 +2615,7 @@ boolector_slt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2293,6 +2632,7 @@ boolector_slt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, slt, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2304,6 +2644,7 @@ boolector_ulte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2320,6 +2661,7 @@ boolector_ulte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ulte, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2331,6 +2673,7 @@ boolector_slte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2347,6 +2690,7 @@ boolector_slte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, slte, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2358,6 +2702,7 @@ boolector_ugt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2374,6 +2719,7 @@ boolector_ugt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ugt, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2385,6 +2731,7 @@ boolector_sgt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2401,6 +2748,7 @@ boolector_sgt (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sgt, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2412,6 +2760,7 @@ boolector_ugte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2428,6 +2777,7 @@ boolector_ugte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ugte, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2439,6 +2789,7 @@ boolector_sgte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2455,6 +2806,7 @@ boolector_sgte (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sgte, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2467,6 +2819,7 @@ boolector_sll (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2498,6 +2851,7 @@ boolector_sll (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sll, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2510,6 +2864,7 @@ boolector_srl (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2540,6 +2895,7 @@ boolector_srl (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, srl, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2552,6 +2908,7 @@ boolector_sra (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2582,6 +2939,7 @@ boolector_sra (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sra, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2592,6 +2950,7 @@ boolector_rol (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BtorNode *e0, *e1, *res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (e0);
@@ -2624,6 +2983,7 @@ boolector_rol (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, rol, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2636,6 +2996,7 @@ boolector_ror (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2666,6 +3027,7 @@ boolector_ror (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, ror, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2676,6 +3038,7 @@ boolector_roli (Btor *btor, BoolectorNode *n, uint32_t nbits)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (n);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u", nbits);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -2687,6 +3050,7 @@ boolector_roli (Btor *btor, BoolectorNode *n, uint32_t nbits)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, roli, BTOR_CLONED_EXP (exp), nbits);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2697,6 +3061,7 @@ boolector_rori (Btor *btor, BoolectorNode *n, uint32_t nbits)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (n);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u", nbits);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -2708,6 +3073,7 @@ boolector_rori (Btor *btor, BoolectorNode *n, uint32_t nbits)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, rori, BTOR_CLONED_EXP (exp), nbits);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2719,6 +3085,7 @@ boolector_sub (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2735,6 +3102,7 @@ boolector_sub (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sub, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2746,6 +3114,7 @@ boolector_usubo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2761,6 +3130,7 @@ boolector_usubo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, usubo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2772,6 +3142,7 @@ boolector_ssubo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2789,6 +3160,7 @@ boolector_ssubo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, ssubo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2800,6 +3172,7 @@ boolector_udiv (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2814,6 +3187,7 @@ boolector_udiv (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, udiv, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2825,6 +3199,7 @@ boolector_sdiv (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2841,6 +3216,7 @@ boolector_sdiv (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, sdiv, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2852,6 +3228,7 @@ boolector_sdivo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2869,6 +3246,7 @@ boolector_sdivo (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, sdivo, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2880,6 +3258,7 @@ boolector_urem (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2896,6 +3275,7 @@ boolector_urem (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, urem, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2907,6 +3287,7 @@ boolector_srem (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2923,6 +3304,7 @@ boolector_srem (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, srem, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2934,6 +3316,7 @@ boolector_smod (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2950,6 +3333,7 @@ boolector_smod (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, smod, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2961,6 +3345,7 @@ boolector_concat (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -2980,6 +3365,7 @@ boolector_concat (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_PTR (
       res, concat, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -2990,6 +3376,7 @@ boolector_repeat (Btor *btor, BoolectorNode *node, uint32_t n)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN_EXT (exp, "%u", n);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3004,6 +3391,7 @@ boolector_repeat (Btor *btor, BoolectorNode *node, uint32_t n)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, repeat, BTOR_CLONED_EXP (exp), n);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3017,6 +3405,7 @@ boolector_read (Btor *btor, BoolectorNode *n_array, BoolectorNode *n_index)
   e_array = BTOR_IMPORT_BOOLECTOR_NODE (n_array);
   e_index = BTOR_IMPORT_BOOLECTOR_NODE (n_index);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_array);
   BTOR_ABORT_ARG_NULL (e_index);
   BTOR_TRAPI_BINFUN (e_array, e_index);
@@ -3037,6 +3426,7 @@ boolector_read (Btor *btor, BoolectorNode *n_array, BoolectorNode *n_index)
   BTOR_CHKCLONE_RES_PTR (
       res, read, BTOR_CLONED_EXP (e_array), BTOR_CLONED_EXP (e_index));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3053,6 +3443,7 @@ boolector_write (Btor *btor,
   e_index = BTOR_IMPORT_BOOLECTOR_NODE (n_index);
   e_value = BTOR_IMPORT_BOOLECTOR_NODE (n_value);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_array);
   BTOR_ABORT_ARG_NULL (e_index);
   BTOR_ABORT_ARG_NULL (e_value);
@@ -3085,6 +3476,7 @@ boolector_write (Btor *btor,
                          BTOR_CLONED_EXP (e_index),
                          BTOR_CLONED_EXP (e_value));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3103,6 +3495,7 @@ boolector_cond (Btor *btor,
   e_if   = BTOR_IMPORT_BOOLECTOR_NODE (n_then);
   e_else = BTOR_IMPORT_BOOLECTOR_NODE (n_else);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_cond);
   BTOR_ABORT_ARG_NULL (e_if);
   BTOR_ABORT_ARG_NULL (e_else);
@@ -3128,6 +3521,7 @@ boolector_cond (Btor *btor,
                          BTOR_CLONED_EXP (e_if),
                          BTOR_CLONED_EXP (e_else));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3137,6 +3531,7 @@ BoolectorNode *
 boolector_param (Btor *btor, BoolectorSort sort, const char *symbol)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
 
   BtorNode *res;
   char *symb;
@@ -3159,6 +3554,7 @@ boolector_param (Btor *btor, BoolectorSort sort, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, param, sort, symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3175,6 +3571,7 @@ boolector_fun (Btor *btor,
   exp    = BTOR_IMPORT_BOOLECTOR_NODE (node);
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (params);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3206,6 +3603,7 @@ boolector_fun (Btor *btor,
     cparam_nodes[i] = BTOR_CLONED_EXP (params[i]);
   BTOR_CHKCLONE_RES_PTR (res, fun, cparam_nodes, paramc, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3223,6 +3621,7 @@ boolector_apply (Btor *btor,
   e_fun = BTOR_IMPORT_BOOLECTOR_NODE (n_fun);
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_fun);
 
   BTOR_ABORT_REFS_NOT_POS (e_fun);
@@ -3253,6 +3652,7 @@ boolector_apply (Btor *btor,
     carg_nodes[i] = BTOR_CLONED_EXP (args[i]);
   BTOR_CHKCLONE_RES_PTR (res, apply, carg_nodes, argc, BTOR_CLONED_EXP (e_fun));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3265,6 +3665,7 @@ boolector_inc (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3277,6 +3678,7 @@ boolector_inc (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, inc, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3287,6 +3689,7 @@ boolector_dec (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3299,6 +3702,7 @@ boolector_dec (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, dec, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3334,6 +3738,7 @@ boolector_forall (Btor *btor,
   params = BTOR_IMPORT_BOOLECTOR_NODE_ARRAY (param_nodes);
   body   = BTOR_IMPORT_BOOLECTOR_NODE (body_node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (params);
   BTOR_ABORT_ARG_NULL (body);
 
@@ -3371,6 +3776,7 @@ boolector_forall (Btor *btor,
   BTOR_CHKCLONE_RES_PTR (
       res, forall, cparam_nodes, paramc, BTOR_CLONED_EXP (body));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3386,6 +3792,7 @@ boolector_exists (Btor *btor,
   params = BTOR_IMPORT_BOOLECTOR_NODE_ARRAY (param_nodes);
   body   = BTOR_IMPORT_BOOLECTOR_NODE (body_node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (params);
   BTOR_ABORT_ARG_NULL (body);
 
@@ -3423,6 +3830,7 @@ boolector_exists (Btor *btor,
   BTOR_CHKCLONE_RES_PTR (
       res, exists, cparam_nodes, paramc, BTOR_CLONED_EXP (body));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3438,6 +3846,7 @@ boolector_get_btor (BoolectorNode *node)
   BTOR_ABORT_REFS_NOT_POS (exp);
   real_exp = btor_node_real_addr (exp);
   btor     = real_exp->btor;
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_TRAPI_RETURN_PTR (btor);
 #ifndef NDEBUG
@@ -3448,6 +3857,7 @@ boolector_get_btor (BoolectorNode *node)
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
   return btor;
 }
 
@@ -3459,6 +3869,7 @@ boolector_get_node_id (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (node);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3468,6 +3879,7 @@ boolector_get_node_id (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_INT (res, get_node_id, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3478,6 +3890,7 @@ boolector_get_sort (Btor *btor, const BoolectorNode *node)
   BtorSortId res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (node);
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_TRAPI_UNFUN (exp);
@@ -3486,6 +3899,7 @@ boolector_get_sort (Btor *btor, const BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, get_sort, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -3496,6 +3910,7 @@ boolector_fun_get_domain_sort (Btor *btor, const BoolectorNode *node)
   BtorSortId res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (node);
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT (!btor_node_is_fun (btor_simplify_exp (btor, exp)),
@@ -3508,6 +3923,7 @@ boolector_fun_get_domain_sort (Btor *btor, const BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, fun_get_domain_sort, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -3518,6 +3934,7 @@ boolector_fun_get_codomain_sort (Btor *btor, const BoolectorNode *node)
   BtorSortId res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (node);
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT (!btor_node_is_fun (btor_simplify_exp (btor, exp)),
@@ -3530,6 +3947,7 @@ boolector_fun_get_codomain_sort (Btor *btor, const BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, fun_get_codomain_sort, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -3540,6 +3958,7 @@ boolector_match_node_by_id (Btor *btor, int32_t id)
 {
   BtorNode *res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (id <= 0, "node id must be > 0");
   BTOR_TRAPI ("%d", id);
   res = btor_node_match_by_id (btor, id);
@@ -3552,6 +3971,7 @@ boolector_match_node_by_id (Btor *btor, int32_t id)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, match_node_by_id, id);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3562,6 +3982,7 @@ boolector_match_node_by_symbol (Btor *btor, const char *symbol)
   uint32_t i;
   BtorNode *res;
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (symbol);
   BTOR_TRAPI ("%s", symbol);
   for (i = 0, res = 0; !res && i <= btor->num_push_pop; i++)
@@ -3579,6 +4000,7 @@ boolector_match_node_by_symbol (Btor *btor, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, match_node_by_symbol, symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3589,6 +4011,7 @@ boolector_match_node (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
   res = btor_node_match (btor, exp);
@@ -3599,6 +4022,7 @@ boolector_match_node (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, match_node, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -3612,6 +4036,7 @@ boolector_get_symbol (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3621,6 +4046,7 @@ boolector_get_symbol (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_STR (res, get_symbol, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3632,6 +4058,7 @@ boolector_set_symbol (Btor *btor, BoolectorNode *node, const char *symbol)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_ARG_NULL (symbol);
   BTOR_TRAPI_UNFUN_EXT (exp, "%s", symbol);
@@ -3652,6 +4079,7 @@ boolector_set_symbol (Btor *btor, BoolectorNode *node, const char *symbol)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (set_symbol, BTOR_CLONED_EXP (exp), symbol);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 uint32_t
@@ -3662,6 +4090,7 @@ boolector_get_width (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3674,6 +4103,7 @@ boolector_get_width (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_width, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3685,6 +4115,7 @@ boolector_get_index_width (Btor *btor, BoolectorNode *n_array)
 
   e_array = BTOR_IMPORT_BOOLECTOR_NODE (n_array);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_array);
   BTOR_TRAPI_UNFUN (e_array);
   BTOR_ABORT_REFS_NOT_POS (e_array);
@@ -3697,6 +4128,7 @@ boolector_get_index_width (Btor *btor, BoolectorNode *n_array)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_index_width, BTOR_CLONED_EXP (e_array));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3710,6 +4142,7 @@ boolector_get_bits (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (node);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3736,6 +4169,7 @@ boolector_get_bits (Btor *btor, BoolectorNode *node)
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3743,6 +4177,7 @@ void
 boolector_free_bits (Btor *btor, const char *bits)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%p", bits);
   BTOR_ABORT_ARG_NULL (bits);
 #ifndef NDEBUG
@@ -3753,6 +4188,7 @@ boolector_free_bits (Btor *btor, const char *bits)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (free_bits, cass);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 uint32_t
@@ -3763,6 +4199,7 @@ boolector_get_fun_arity (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3774,6 +4211,7 @@ boolector_get_fun_arity (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, get_fun_arity, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3786,6 +4224,7 @@ boolector_is_const (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_BTOR_MISMATCH (btor, exp);
   BTOR_TRAPI_UNFUN (exp);
@@ -3795,6 +4234,7 @@ boolector_is_const (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_const, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3805,6 +4245,7 @@ boolector_is_var (Btor *btor, BoolectorNode *node)
   bool res;
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3814,6 +4255,7 @@ boolector_is_var (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_var, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3825,6 +4267,7 @@ boolector_is_array (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3834,6 +4277,7 @@ boolector_is_array (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_array, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3845,6 +4289,7 @@ boolector_is_array_var (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3854,6 +4299,7 @@ boolector_is_array_var (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_array_var, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3865,6 +4311,7 @@ boolector_is_param (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3874,6 +4321,7 @@ boolector_is_param (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_param, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3885,6 +4333,7 @@ boolector_is_bound_param (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3896,6 +4345,7 @@ boolector_is_bound_param (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bound_param, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3907,6 +4357,7 @@ boolector_is_uf (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3916,6 +4367,7 @@ boolector_is_uf (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_uf, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3927,6 +4379,7 @@ boolector_is_fun (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -3936,6 +4389,7 @@ boolector_is_fun (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_fun, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3954,6 +4408,7 @@ boolector_fun_sort_check (Btor *btor,
   args  = BTOR_IMPORT_BOOLECTOR_NODE_ARRAY (arg_nodes);
   e_fun = BTOR_IMPORT_BOOLECTOR_NODE (n_fun);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e_fun);
   BTOR_ABORT (argc < 1, "'argc' must not be < 1");
   BTOR_ABORT (argc >= 1 && !args, "no arguments given but argc defined > 0");
@@ -3978,6 +4433,7 @@ boolector_fun_sort_check (Btor *btor,
   BTOR_CHKCLONE_RES_INT (
       res, fun_sort_check, carg_nodes, argc, BTOR_CLONED_EXP (e_fun));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -3991,6 +4447,7 @@ boolector_get_value (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (
       btor->last_sat_result != BTOR_RESULT_SAT || !btor->valid_assignments,
       "cannot retrieve model if input formula is not SAT");
@@ -4008,6 +4465,7 @@ boolector_get_value (Btor *btor, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_PTR (res, get_value, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_NODE (res);
 }
 
@@ -4022,6 +4480,7 @@ boolector_bv_assignment (Btor *btor, BoolectorNode *node)
 
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_SAT
               || !btor->valid_assignments,
               "cannot retrieve model if input formula is not SAT");
@@ -4061,6 +4520,7 @@ boolector_bv_assignment (Btor *btor, BoolectorNode *node)
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4068,6 +4528,7 @@ void
 boolector_free_bv_assignment (Btor *btor, const char *assignment)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%p", assignment);
   BTOR_ABORT_ARG_NULL (assignment);
 #ifndef NDEBUG
@@ -4079,6 +4540,7 @@ boolector_free_bv_assignment (Btor *btor, const char *assignment)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (free_bv_assignment, cass);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 static void
@@ -4237,6 +4699,7 @@ boolector_array_assignment (Btor *btor,
 
   e_array = BTOR_IMPORT_BOOLECTOR_NODE (n_array);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_SAT
               || !btor->valid_assignments,
               "cannot retrieve model if input formula is not SAT");
@@ -4278,6 +4741,7 @@ boolector_array_assignment (Btor *btor,
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4289,12 +4753,17 @@ boolector_free_array_assignment (Btor *btor,
   BtorFunAss *funass;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%p %p %u", indices, values, size);
   BTOR_ABORT (size && !indices, "size > 0 but 'indices' are zero");
   BTOR_ABORT (size && !values, "size > 0 but 'values' are zero");
   BTOR_ABORT (!size && indices, "non zero 'indices' but 'size == 0'");
   BTOR_ABORT (!size && values, "non zero 'values' but 'size == 0'");
-  if (!size) { return; }
+  if (!size)
+  {
+    BTOR_UNLOCK_API (btor);
+    return;
+  }
 
   funass =
       btor_ass_get_fun ((const char **) indices, (const char **) values, size);
@@ -4309,6 +4778,7 @@ boolector_free_array_assignment (Btor *btor,
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (free_array_assignment, cindices, cvalues, size);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4323,6 +4793,7 @@ boolector_uf_assignment (Btor *btor,
 
   e_uf = BTOR_IMPORT_BOOLECTOR_NODE (n_uf);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT (btor->last_sat_result != BTOR_RESULT_SAT
               || !btor->valid_assignments,
               "cannot retrieve model if input formula is not SAT");
@@ -4364,6 +4835,7 @@ boolector_uf_assignment (Btor *btor,
     btor_chkclone (btor, btor->clone);
   }
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4375,6 +4847,7 @@ boolector_free_uf_assignment (Btor *btor,
   BtorFunAss *funass;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%p %p %u", args, values, size);
   BTOR_ABORT (size && !args, "size > 0 but 'args' are zero");
   BTOR_ABORT (size && !values, "size > 0 but 'values' are zero");
@@ -4393,12 +4866,14 @@ boolector_free_uf_assignment (Btor *btor,
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (free_array_assignment, cargs, cvalues, size);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
 boolector_print_model (Btor *btor, char *format, FILE *file)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (format);
   BTOR_TRAPI ("%s", format);
   BTOR_ABORT_ARG_NULL (file);
@@ -4414,6 +4889,7 @@ boolector_print_model (Btor *btor, char *format, FILE *file)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (print_model, format, file);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
@@ -4422,6 +4898,7 @@ BoolectorSort
 boolector_bool_sort (Btor *btor)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("");
 
   BtorSortId res;
@@ -4431,6 +4908,7 @@ boolector_bool_sort (Btor *btor)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, bool_sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -4438,6 +4916,7 @@ BoolectorSort
 boolector_bitvec_sort (Btor *btor, uint32_t width)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI ("%u", width);
   BTOR_ABORT (width == 0, "'width' must be > 0");
 
@@ -4448,6 +4927,7 @@ boolector_bitvec_sort (Btor *btor, uint32_t width)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, bitvec_sort, width);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -4468,6 +4948,7 @@ boolector_fun_sort (Btor *btor,
                     BoolectorSort codomain)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (domain);
   BTOR_ABORT (arity <= 0, "'arity' must be > 0");
 
@@ -4511,6 +4992,7 @@ boolector_fun_sort (Btor *btor,
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, fun_sort, domain, arity, codomain);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -4518,6 +5000,7 @@ BoolectorSort
 boolector_array_sort (Btor *btor, BoolectorSort index, BoolectorSort element)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (
       BTOR_TRAPI_SORT_FMT " " BTOR_TRAPI_SORT_FMT, index, btor, element, btor);
 
@@ -4541,6 +5024,7 @@ boolector_array_sort (Btor *btor, BoolectorSort index, BoolectorSort element)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, array_sort, index, element);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -4548,6 +5032,7 @@ BoolectorSort
 boolector_copy_sort (Btor *btor, BoolectorSort sort)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, BTOR_IMPORT_BOOLECTOR_SORT (sort), btor);
 
   BtorSortId s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
@@ -4558,6 +5043,7 @@ boolector_copy_sort (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_SORT (res, copy_sort, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return BTOR_EXPORT_BOOLECTOR_SORT (res);
 }
 
@@ -4565,6 +5051,7 @@ void
 boolector_release_sort (Btor *btor, BoolectorSort sort)
 {
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, BTOR_IMPORT_BOOLECTOR_SORT (sort), btor);
 
   BtorSortId s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
@@ -4574,6 +5061,7 @@ boolector_release_sort (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (release_sort, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 bool
@@ -4585,6 +5073,7 @@ boolector_is_equal_sort (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   e0 = BTOR_IMPORT_BOOLECTOR_NODE (n0);
   e1 = BTOR_IMPORT_BOOLECTOR_NODE (n1);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (e0);
   BTOR_ABORT_ARG_NULL (e1);
   BTOR_TRAPI_BINFUN (e0, e1);
@@ -4598,6 +5087,7 @@ boolector_is_equal_sort (Btor *btor, BoolectorNode *n0, BoolectorNode *n1)
   BTOR_CHKCLONE_RES_BOOL (
       res, is_equal_sort, BTOR_CLONED_EXP (e0), BTOR_CLONED_EXP (e1));
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4608,6 +5098,7 @@ boolector_is_array_sort (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
 
@@ -4618,6 +5109,7 @@ boolector_is_array_sort (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_array_sort, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4628,6 +5120,7 @@ boolector_is_bitvec_sort (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
 
@@ -4638,6 +5131,7 @@ boolector_is_bitvec_sort (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_bitvec_sort, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4648,6 +5142,7 @@ boolector_is_fun_sort (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
 
@@ -4658,6 +5153,7 @@ boolector_is_fun_sort (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_BOOL (res, is_fun_sort, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4668,6 +5164,7 @@ boolector_bitvec_sort_get_width (Btor *btor, BoolectorSort sort)
   BtorSortId s;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_TRAPI (BTOR_TRAPI_SORT_FMT, sort, btor);
   s = BTOR_IMPORT_BOOLECTOR_SORT (sort);
 
@@ -4678,6 +5175,7 @@ boolector_bitvec_sort_get_width (Btor *btor, BoolectorSort sort)
 #ifndef NDEBUG
   BTOR_CHKCLONE_RES_UINT (res, bitvec_sort_get_width, sort);
 #endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4697,6 +5195,7 @@ boolector_parse (Btor *btor,
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (infile);
   BTOR_ABORT_ARG_NULL (infile_name);
   BTOR_ABORT_ARG_NULL (outfile);
@@ -4709,6 +5208,7 @@ boolector_parse (Btor *btor,
   /* shadow clone can not shadow boolector_parse* (parser uses API calls only,
    * hence all API calls issued while parsing are already shadowed and the
    * shadow clone already maintains the parsed formula) */
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4723,6 +5223,7 @@ boolector_parse_btor (Btor *btor,
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (infile);
   BTOR_ABORT_ARG_NULL (infile_name);
   BTOR_ABORT_ARG_NULL (outfile);
@@ -4734,6 +5235,7 @@ boolector_parse_btor (Btor *btor,
   /* shadow clone can not shadow boolector_parse* (parser uses API calls only,
    * hence all API calls issued while parsing are already shadowed and the
    * shadow clone already maintains the parsed formula) */
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4748,6 +5250,7 @@ boolector_parse_btor2 (Btor *btor,
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (infile);
   BTOR_ABORT_ARG_NULL (infile_name);
   BTOR_ABORT_ARG_NULL (outfile);
@@ -4759,6 +5262,36 @@ boolector_parse_btor2 (Btor *btor,
   /* shadow clone can not shadow boolector_parse* (parser uses API calls only,
    * hence all API calls issued while parsing are already shadowed and the
    * shadow clone already maintains the parsed formula) */
+  BTOR_UNLOCK_API (btor);
+  return res;
+}
+
+int32_t
+boolector_parse_btor_binary (Btor *btor,
+                             FILE *infile,
+                             const char *infile_name,
+                             FILE *outfile,
+                             char **error_msg,
+                             int32_t *status)
+{
+  int32_t res;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
+  BTOR_ABORT_ARG_NULL (infile);
+  BTOR_ABORT_ARG_NULL (infile_name);
+  BTOR_ABORT_ARG_NULL (outfile);
+  BTOR_ABORT_ARG_NULL (error_msg);
+  BTOR_ABORT_ARG_NULL (status);
+  BTOR_ABORT (BTOR_COUNT_STACK (btor->nodes_id_table) > 2,
+              "file parsing must be done before creating expressions");
+  res = btor_parse_btor_binary (
+      btor, infile, infile_name, outfile, error_msg, status);
+#ifndef NDEBUG
+  /* the binary parser does not use API calls, re-create shadow clone */
+  if (btor->clone) boolector_chkclone (btor);
+#endif
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4773,6 +5306,7 @@ boolector_parse_smt1 (Btor *btor,
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (infile);
   BTOR_ABORT_ARG_NULL (infile_name);
   BTOR_ABORT_ARG_NULL (outfile);
@@ -4784,6 +5318,7 @@ boolector_parse_smt1 (Btor *btor,
   /* shadow clone can not shadow boolector_parse* (parser uses API calls only,
    * hence all API calls issued while parsing are already shadowed and the
    * shadow clone already maintains the parsed formula) */
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4798,6 +5333,7 @@ boolector_parse_smt2 (Btor *btor,
   int32_t res;
 
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (infile);
   BTOR_ABORT_ARG_NULL (infile_name);
   BTOR_ABORT_ARG_NULL (outfile);
@@ -4809,6 +5345,7 @@ boolector_parse_smt2 (Btor *btor,
   /* shadow clone can not shadow boolector_parse* (parser uses API calls only,
    * hence all API calls issued while parsing are already shadowed and the
    * shadow clone already maintains the parsed formula) */
+  BTOR_UNLOCK_API (btor);
   return res;
 }
 
@@ -4822,6 +5359,7 @@ boolector_dump_btor_node (Btor *btor, FILE *file, BoolectorNode *node)
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -4830,6 +5368,7 @@ boolector_dump_btor_node (Btor *btor, FILE *file, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_btor_node, stdout, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4837,6 +5376,7 @@ boolector_dump_btor (Btor *btor, FILE *file)
 {
   BTOR_TRAPI ("");
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT (!btor_dumpbtor_can_be_dumped (btor),
               "formula cannot be dumped in BTOR format as it does "
@@ -4848,6 +5388,24 @@ boolector_dump_btor (Btor *btor, FILE *file)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_btor, stdout);
 #endif
+  BTOR_UNLOCK_API (btor);
+}
+
+void
+boolector_dump_btor_binary (Btor *btor, FILE *file)
+{
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
+  BTOR_ABORT_ARG_NULL (file);
+  BTOR_WARN (btor->assumptions->count > 0,
+             "dumping in incremental mode only captures the current state "
+             "of the input formula without assumptions");
+  btor_dumpbin_dump (btor, file);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (dump_btor_binary, stdout);
+#endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4858,6 +5416,7 @@ boolector_dump_smt2_node (Btor *btor, FILE *file, BoolectorNode *node)
   exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
   BTOR_TRAPI_UNFUN (exp);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT_ARG_NULL (exp);
   BTOR_ABORT_REFS_NOT_POS (exp);
@@ -4866,6 +5425,7 @@ boolector_dump_smt2_node (Btor *btor, FILE *file, BoolectorNode *node)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_smt2_node, stdout, BTOR_CLONED_EXP (exp));
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4873,6 +5433,7 @@ boolector_dump_smt2 (Btor *btor, FILE *file)
 {
   BTOR_TRAPI ("");
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_WARN (btor->assumptions->count > 0,
              "dumping in incremental mode only captures the current state "
@@ -4881,6 +5442,7 @@ boolector_dump_smt2 (Btor *btor, FILE *file)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_smt2, stdout);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4888,6 +5450,7 @@ boolector_dump_aiger_ascii (Btor *btor, FILE *file, bool merge_roots)
 {
   BTOR_TRAPI ("%d", merge_roots);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT (btor->lambdas->count > 0 || btor->ufs->count > 0,
               "dumping to ASCII AIGER is supported for QF_BV only");
@@ -4898,6 +5461,7 @@ boolector_dump_aiger_ascii (Btor *btor, FILE *file, bool merge_roots)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_aiger_ascii, stdout, merge_roots);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 void
@@ -4905,6 +5469,7 @@ boolector_dump_aiger_binary (Btor *btor, FILE *file, bool merge_roots)
 {
   BTOR_TRAPI ("%d", merge_roots);
   BTOR_ABORT_ARG_NULL (btor);
+  BTOR_LOCK_API (btor);
   BTOR_ABORT_ARG_NULL (file);
   BTOR_ABORT (btor->lambdas->count > 0 || btor->ufs->count > 0,
               "dumping to binary AIGER is supported for QF_BV only");
@@ -4915,6 +5480,7 @@ boolector_dump_aiger_binary (Btor *btor, FILE *file, bool merge_roots)
 #ifndef NDEBUG
   BTOR_CHKCLONE_NORES (dump_aiger_binary, stdout, merge_roots);
 #endif
+  BTOR_UNLOCK_API (btor);
 }
 
 /*------------------------------------------------------------------------*/
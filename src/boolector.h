@@ -198,6 +198,65 @@ void boolector_set_trapi (Btor *btor, FILE *apitrace);
 */
 FILE *boolector_get_trapi (Btor *btor);
 
+/*!
+  Set the file of the persistent result cache and enable it.
+
+  If model generation is disabled, boolector_sat looks up the result of the
+  current query (the simplified formula and assumptions) in this file and
+  skips solving if the query was already decided, possibly by another
+  process. New SAT and UNSAT results are added to the file, which is created
+  if it does not exist.
+
+  :param btor: Boolector instance.
+  :param path: Name of the cache file.
+
+  .. note::
+    The result cache file can also be set via the environment variable
+    BTORRESULTCACHE=<filename>.
+*/
+void boolector_set_result_cache (Btor *btor, const char *path);
+
+/*!
+  Stream the CNF sent to the SAT solver to file ``path`` as it is
+  generated ("-" denotes stdout).
+
+  Clauses are written while they are added instead of being recorded in
+  memory. The format is selected via BTOR_OPT_CNF_STREAM_FORMAT and
+  BTOR_OPT_CNF_STREAM_BINARY. Solving is not affected, i.e., the CNF is
+  still solved by the configured SAT solver.
+
+  :param btor: Boolector instance.
+  :param path: Name of the output file or (named) pipe.
+
+  .. note::
+    Must be called before the first call to :c:func:`boolector_sat`.
+    The CNF stream can also be set via the environment variable
+    BTORCNFSTREAM=<filename>.
+*/
+void boolector_set_cnf_stream (Btor *btor, const char *path);
+
+/*!
+  Use an external SAT solver process as SAT engine.
+
+  The solver is started via ``/bin/sh -c cmd`` on the first call to
+  :c:func:`boolector_sat` and receives the CNF in incremental iCNF format on
+  its stdin, where every SAT call is sent as ``a <assumptions> 0`` line. It
+  has to answer each of them on its stdout with ``s SATISFIABLE`` followed by
+  ``v`` lines, ``s UNSATISFIABLE`` followed by ``f`` lines with the failed
+  assumptions, or ``s UNKNOWN``, where ``v`` and ``f`` lines are terminated by
+  0. Standard SAT solvers thus require a small wrapper script.
+
+  :param btor: Boolector instance.
+  :param cmd: Shell command that starts the solver.
+
+  .. note::
+    Must be called before the first call to :c:func:`boolector_sat`.
+    Not supported on Windows. The command can also be set via the
+    environment variable BTORSATCMD=<command> together with option
+    BTOR_OPT_SAT_ENGINE set to BTOR_SAT_ENGINE_EXTERNAL.
+*/
+void boolector_set_external_sat_solver (Btor *btor, const char *cmd);
+
 /*------------------------------------------------------------------------*/
 
 /*!
@@ -2400,6 +2459,28 @@ int32_t boolector_parse_btor2 (Btor *btor,
                                char **error_msg,
                                int32_t *status);
 
+/*!
+  Parse input file in binary BTOR format (as written by
+  boolector_dump_btor_binary).
+
+  See boolector_parse.
+
+  :param btor: Boolector instance.
+  :param infile: Input file.
+  :param infile_name: Input file name.
+  :param outfile: Output file.
+  :param error_msg: Error message.
+  :param status: Status of the input formula.
+  :return: BOOLECTOR_UNKNOWN or BOOLECTOR_PARSE_ERROR if a parse error
+           occurred.
+*/
+int32_t boolector_parse_btor_binary (Btor *btor,
+                                     FILE *infile,
+                                     const char *infile_name,
+                                     FILE *outfile,
+                                     char **error_msg,
+                                     int32_t *status);
+
 /*!
   Parse input file in `SMT-LIB v1`_ format.
 
@@ -2464,6 +2545,19 @@ void boolector_dump_btor_node (Btor *btor, FILE *file, BoolectorNode *node);
 */
 void boolector_dump_btor (Btor *btor, FILE *file);
 
+/*!
+  Dump formula to file in binary BTOR format.
+
+  The binary format stores the expression DAG of the current (simplified)
+  formula and is intended for saving a formula after boolector_simplify and
+  reloading it with boolector_parse_btor_binary without parsing text.
+
+  :param btor: Boolector instance.
+  :param file: File to which the formula should be dumped. The file must be
+               have been opened by the user before.
+*/
+void boolector_dump_btor_binary (Btor *btor, FILE *file);
+
 /*!
   Recursively dump ``node`` to file in `SMT-LIB v2`_ format.
 
@@ -9,9 +9,11 @@
 #include "btoraig.h"
 
 #include "btorabort.h"
+#include "btoraigrw.h"
 #include "btorcore.h"
 #include "btorsat.h"
 #include "utils/btoraigmap.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
 
@@ -71,8 +73,13 @@ setup_aig_and_add_to_id_table (BtorAIGMgr *amgr, BtorAIG *aig)
   aig->refs = 1;
   aig->id   = id;
   BTOR_PUSH_STACK (amgr->id2aig, aig);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2next, 0);
   assert (aig->id >= 0);
   assert (BTOR_COUNT_STACK (amgr->id2aig) == (size_t) aig->id + 1);
+  assert (BTOR_COUNT_STACK (amgr->id2children) == 2 * ((size_t) aig->id + 1));
+  assert (BTOR_COUNT_STACK (amgr->id2next) == (size_t) aig->id + 1);
   assert (BTOR_PEEK_STACK (amgr->id2aig, aig->id) == aig);
 }
 
@@ -84,14 +91,11 @@ new_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   assert (!btor_aig_is_const (right));
 
   BtorAIG *aig;
-  size_t size;
 
-  size = sizeof (BtorAIG) + 2 * sizeof (int32_t);
-  aig  = btor_mem_malloc (amgr->btor->mm, size);
-  memset (aig, 0, size);
+  aig = btor_mem_slab_alloc (amgr->slab);
   setup_aig_and_add_to_id_table (amgr, aig);
-  aig->children[0] = btor_aig_get_id (left);
-  aig->children[1] = btor_aig_get_id (right);
+  amgr->id2children.start[2 * aig->id]     = btor_aig_get_id (left);
+  amgr->id2children.start[2 * aig->id + 1] = btor_aig_get_id (right);
   amgr->cur_num_aigs++;
   if (amgr->max_num_aigs < amgr->cur_num_aigs)
     amgr->max_num_aigs = amgr->cur_num_aigs;
@@ -108,7 +112,8 @@ release_cnf_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *aig)
   if (amgr->smgr->have_restore) return;
   amgr->cnfid2aig.start[aig->cnf_id] = 0;
   btor_sat_mgr_release_cnf_id (amgr->smgr, aig->cnf_id);
-  aig->cnf_id = 0;
+  aig->cnf_id  = 0;
+  aig->encoded = 0;
 }
 
 static void
@@ -122,14 +127,14 @@ delete_aig_node (BtorAIGMgr *amgr, BtorAIG *aig)
   if (aig->is_var)
   {
     amgr->cur_num_aig_vars--;
-    BTOR_DELETE (amgr->btor->mm, aig);
   }
   else
   {
     amgr->cur_num_aigs--;
-    btor_mem_free (
-        amgr->btor->mm, aig, sizeof (BtorAIG) + 2 * sizeof (int32_t));
+    amgr->id2children.start[2 * aig->id]     = 0;
+    amgr->id2children.start[2 * aig->id + 1] = 0;
   }
+  btor_mem_slab_free (amgr->slab, aig);
 }
 
 static uint32_t
@@ -146,12 +151,14 @@ hash_aig (int32_t id0, int32_t id1, uint32_t table_size)
 }
 
 static uint32_t
-compute_aig_hash (BtorAIG *aig, uint32_t table_size)
+compute_aig_hash (BtorAIGMgr *amgr, int32_t id, uint32_t table_size)
 {
   uint32_t hash;
-  assert (!BTOR_IS_INVERTED_AIG (aig));
-  assert (btor_aig_is_and (aig));
-  hash = hash_aig (aig->children[0], aig->children[1], table_size);
+  assert (id > 0);
+  assert (btor_aig_is_and (BTOR_PEEK_STACK (amgr->id2aig, id)));
+  hash = hash_aig (amgr->id2children.start[2 * id],
+                   amgr->id2children.start[2 * id + 1],
+                   table_size);
   return hash;
 }
 
@@ -159,24 +166,19 @@ static void
 delete_aig_nodes_unique_table_entry (BtorAIGMgr *amgr, BtorAIG *aig)
 {
   uint32_t hash;
-  BtorAIG *cur, *prev;
+  int32_t *cur;
   assert (amgr);
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (btor_aig_is_and (aig));
-  prev = 0;
-  hash = compute_aig_hash (aig, amgr->table.size);
-  cur  = btor_aig_get_by_id (amgr, amgr->table.chains[hash]);
-  while (cur != aig)
+  hash = compute_aig_hash (amgr, aig->id, amgr->table.size);
+  cur  = amgr->table.chains + hash;
+  while (*cur != aig->id)
   {
-    assert (!BTOR_IS_INVERTED_AIG (cur));
-    prev = cur;
-    cur  = btor_aig_get_by_id (amgr, cur->next);
+    assert (*cur);
+    cur = amgr->id2next.start + *cur;
   }
-  assert (cur);
-  if (!prev)
-    amgr->table.chains[hash] = cur->next;
-  else
-    prev->next = cur->next;
+  *cur                         = amgr->id2next.start[aig->id];
+  amgr->id2next.start[aig->id] = 0;
   amgr->table.num_elements--;
 }
 
@@ -205,9 +207,8 @@ find_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   assert (!btor_aig_is_const (left));
   assert (!btor_aig_is_const (right));
 
-  BtorAIG *cur;
+  int32_t *result, *children, *next, cur, left_id, right_id;
   uint32_t hash;
-  int32_t *result;
 
   if (btor_opt_get (amgr->btor, BTOR_OPT_SORT_AIG) > 0
       && BTOR_REAL_ADDR_AIG (right)->id < BTOR_REAL_ADDR_AIG (left)->id)
@@ -215,25 +216,24 @@ find_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
     BTOR_SWAP (BtorAIG *, left, right);
   }
 
-  hash   = hash_aig (BTOR_REAL_ADDR_AIG (left)->id,
-                   BTOR_REAL_ADDR_AIG (right)->id,
-                   amgr->table.size);
-  result = amgr->table.chains + hash;
-  cur    = btor_aig_get_by_id (amgr, *result);
-  while (cur)
+  left_id  = btor_aig_get_id (left);
+  right_id = btor_aig_get_id (right);
+  children = amgr->id2children.start;
+  next     = amgr->id2next.start;
+  hash     = hash_aig (left_id, right_id, amgr->table.size);
+  result   = amgr->table.chains + hash;
+  while ((cur = *result))
   {
-    assert (!BTOR_IS_INVERTED_AIG (cur));
-    assert (btor_aig_is_and (cur));
-    if (btor_aig_get_left_child (amgr, cur) == left
-        && btor_aig_get_right_child (amgr, cur) == right)
+    assert (cur > 0);
+    assert (btor_aig_is_and (btor_aig_get_by_id (amgr, cur)));
+    if (children[2 * cur] == left_id && children[2 * cur + 1] == right_id)
       break;
 #ifndef NDEBUG
     if (btor_opt_get (amgr->btor, BTOR_OPT_SORT_AIG) > 0)
-      assert (btor_aig_get_left_child (amgr, cur) != right
-              || btor_aig_get_right_child (amgr, cur) != left);
+      assert (children[2 * cur] != right_id
+              || children[2 * cur + 1] != left_id);
 #endif
-    result = &cur->next;
-    cur    = cur->next == 0 ? 0 : btor_aig_get_by_id (amgr, cur->next);
+    result = next + cur;
   }
   return result;
 }
@@ -253,28 +253,27 @@ static void
 enlarge_aig_nodes_unique_table (BtorAIGMgr *amgr)
 {
   BtorMemMgr *mm;
-  int32_t *new_chains;
+  int32_t *new_chains, *next;
   uint32_t i, size, new_size;
   uint32_t hash;
-  BtorAIG *temp = 0;
-  BtorAIG *cur  = 0;
+  int32_t cur, temp;
   assert (amgr);
   size     = amgr->table.size;
   new_size = size << 1;
   assert (new_size / size == 2);
   mm = amgr->btor->mm;
   BTOR_CNEWN (mm, new_chains, new_size);
+  next = amgr->id2next.start;
   for (i = 0; i < size; i++)
   {
-    cur = btor_aig_get_by_id (amgr, amgr->table.chains[i]);
+    cur = amgr->table.chains[i];
     while (cur)
     {
-      assert (!BTOR_IS_INVERTED_AIG (cur));
-      assert (btor_aig_is_and (cur));
-      temp             = btor_aig_get_by_id (amgr, cur->next);
-      hash             = compute_aig_hash (cur, new_size);
-      cur->next        = new_chains[hash];
-      new_chains[hash] = cur->id;
+      assert (btor_aig_is_and (btor_aig_get_by_id (amgr, cur)));
+      temp             = next[cur];
+      hash             = compute_aig_hash (amgr, cur, new_size);
+      next[cur]        = new_chains[hash];
+      new_chains[hash] = cur;
       cur              = temp;
     }
   }
@@ -352,7 +351,7 @@ btor_aig_var (BtorAIGMgr *amgr)
 {
   BtorAIG *aig;
   assert (amgr);
-  BTOR_CNEW (amgr->btor->mm, aig);
+  aig = btor_mem_slab_alloc (amgr->slab);
   setup_aig_and_add_to_id_table (amgr, aig);
   aig->is_var = 1;
   amgr->cur_num_aig_vars++;
@@ -720,6 +719,13 @@ BTOR_AIG_TWO_LEVEL_OPT_TRY_AGAIN:
       enlarge_aig_nodes_unique_table (amgr);
       lookup = find_and_aig (amgr, left, right);
     }
+    /* 'lookup' may point into 'id2next', which must not be moved when the
+     * new AIG is added to the id tables */
+    if (BTOR_FULL_STACK (amgr->id2next))
+    {
+      BTOR_ENLARGE_STACK (amgr->id2next);
+      lookup = find_and_aig (amgr, left, right);
+    }
     if (btor_opt_get (amgr->btor, BTOR_OPT_SORT_AIG) > 0
         && real_right->id < real_left->id)
     {
@@ -790,9 +796,18 @@ btor_aig_mgr_new (Btor *btor)
   amgr->btor = btor;
   BTOR_INIT_AIG_UNIQUE_TABLE (btor->mm, amgr->table);
   amgr->smgr = btor_sat_mgr_new (btor);
+  amgr->slab = btor_mem_slab_new (btor->mm, sizeof (BtorAIG));
   BTOR_INIT_STACK (btor->mm, amgr->id2aig);
+  BTOR_INIT_STACK (btor->mm, amgr->id2children);
+  BTOR_INIT_STACK (btor->mm, amgr->id2next);
   BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_FALSE);
   BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_TRUE);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2children, 0);
+  BTOR_PUSH_STACK (amgr->id2next, 0);
+  BTOR_PUSH_STACK (amgr->id2next, 0);
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
@@ -800,20 +815,17 @@ btor_aig_mgr_new (Btor *btor)
 }
 
 static BtorAIG *
-clone_aig (BtorMemMgr *mm, BtorAIG *aig)
+clone_aig (BtorAIGMgr *clone, BtorAIG *aig)
 {
-  assert (mm);
+  assert (clone);
 
-  size_t size;
   BtorAIG *res, *real_aig;
 
   if (btor_aig_is_const (aig)) return aig;
 
   real_aig = BTOR_REAL_ADDR_AIG (aig);
-  size     = sizeof (BtorAIG);
-  if (!real_aig->is_var) size += 2 * sizeof (int32_t);
-  res = btor_mem_malloc (mm, size);
-  memcpy (res, real_aig, size);
+  res      = btor_mem_slab_alloc (clone->slab);
+  memcpy (res, real_aig, sizeof (BtorAIG));
 
   res = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
   return res;
@@ -843,10 +855,36 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
   }
   for (i = 0; i < BTOR_COUNT_STACK (amgr->id2aig); i++)
   {
-    aig = clone_aig (mm, BTOR_PEEK_STACK (amgr->id2aig, i));
+    aig = clone_aig (clone, BTOR_PEEK_STACK (amgr->id2aig, i));
     BTOR_POKE_STACK (clone->id2aig, i, aig);
   }
 
+  /* clone children and unique table chain tables */
+  BTOR_INIT_STACK (mm, clone->id2children);
+  size = BTOR_SIZE_STACK (amgr->id2children);
+  if (size)
+  {
+    BTOR_NEWN (mm, clone->id2children.start, size);
+    clone->id2children.end = clone->id2children.start + size;
+    clone->id2children.top =
+        clone->id2children.start + BTOR_COUNT_STACK (amgr->id2children);
+    memcpy (clone->id2children.start,
+            amgr->id2children.start,
+            BTOR_COUNT_STACK (amgr->id2children) * sizeof (int32_t));
+  }
+  BTOR_INIT_STACK (mm, clone->id2next);
+  size = BTOR_SIZE_STACK (amgr->id2next);
+  if (size)
+  {
+    BTOR_NEWN (mm, clone->id2next.start, size);
+    clone->id2next.end = clone->id2next.start + size;
+    clone->id2next.top =
+        clone->id2next.start + BTOR_COUNT_STACK (amgr->id2next);
+    memcpy (clone->id2next.start,
+            amgr->id2next.start,
+            BTOR_COUNT_STACK (amgr->id2next) * sizeof (int32_t));
+  }
+
   /* clone unique table */
   BTOR_CNEWN (mm, clone->table.chains, amgr->table.size);
   clone->table.size         = amgr->table.size;
@@ -884,15 +922,20 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->btor = btor;
 
   res->smgr = btor_sat_mgr_clone (btor, amgr->smgr);
+  res->slab = btor_mem_slab_new (btor->mm, sizeof (BtorAIG));
   /* Note: we do not yet clone aigs here (we need the clone of the aig
    *       manager for that). */
-  res->max_num_aigs     = amgr->max_num_aigs;
-  res->max_num_aig_vars = amgr->max_num_aig_vars;
-  res->cur_num_aigs     = amgr->cur_num_aigs;
-  res->cur_num_aig_vars = amgr->cur_num_aig_vars;
-  res->num_cnf_vars     = amgr->num_cnf_vars;
-  res->num_cnf_clauses  = amgr->num_cnf_clauses;
-  res->num_cnf_literals = amgr->num_cnf_literals;
+  res->max_num_aigs      = amgr->max_num_aigs;
+  res->max_num_aig_vars  = amgr->max_num_aig_vars;
+  res->cur_num_aigs      = amgr->cur_num_aigs;
+  res->cur_num_aig_vars  = amgr->cur_num_aig_vars;
+  res->num_cnf_vars      = amgr->num_cnf_vars;
+  res->num_cnf_clauses   = amgr->num_cnf_clauses;
+  res->num_cnf_literals  = amgr->num_cnf_literals;
+  res->num_rw_saved_ands = amgr->num_rw_saved_ands;
+  res->num_fraig_merged  = amgr->num_fraig_merged;
+  res->num_sim_patterns  = amgr->num_sim_patterns;
+  res->time_sim          = amgr->time_sim;
   clone_aigs (amgr, res);
   return res;
 }
@@ -907,7 +950,12 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   mm = amgr->btor->mm;
   BTOR_RELEASE_AIG_UNIQUE_TABLE (mm, amgr->table);
   btor_sat_mgr_delete (amgr->smgr);
+  btor_mem_slab_delete (amgr->slab);
+  btor_aigrw_delete_lib (amgr);
+  if (amgr->assignments) btor_hashint_map_delete (amgr->assignments);
   BTOR_RELEASE_STACK (amgr->id2aig);
+  BTOR_RELEASE_STACK (amgr->id2children);
+  BTOR_RELEASE_STACK (amgr->id2next);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
   BTOR_DELETE (mm, amgr);
 }
@@ -1038,7 +1086,8 @@ set_next_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *root)
 {
   assert (!BTOR_IS_INVERTED_AIG (root));
   assert (!root->cnf_id);
-  root->cnf_id = btor_sat_mgr_next_cnf_id (amgr->smgr);
+  root->cnf_id  = btor_sat_mgr_next_cnf_id (amgr->smgr);
+  root->encoded = BTOR_AIG_ENC_FULL;
   assert (root->cnf_id > 0);
   BTOR_FIT_STACK (amgr->cnfid2aig, (size_t) root->cnf_id);
   amgr->cnfid2aig.start[root->cnf_id] = root->id;
@@ -1107,6 +1156,158 @@ is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
 }
 #endif
 
+/*------------------------------------------------------------------------*/
+
+/* Returns the polarities required for the real AIG of 'edge' if 'edge' is
+ * required in polarities 'pol'. */
+static uint32_t
+get_edge_polarity (BtorAIG *edge, uint32_t pol)
+{
+  if (!BTOR_IS_INVERTED_AIG (edge)) return pol;
+  return ((pol & BTOR_AIG_ENC_POS) ? BTOR_AIG_ENC_NEG : 0)
+         | ((pol & BTOR_AIG_ENC_NEG) ? BTOR_AIG_ENC_POS : 0);
+}
+
+static void
+add_clause (BtorAIGMgr *amgr, int32_t a, int32_t b, int32_t c)
+{
+  assert (a);
+  assert (b);
+  btor_sat_add (amgr->smgr, a);
+  btor_sat_add (amgr->smgr, b);
+  amgr->num_cnf_literals += 2;
+  if (c)
+  {
+    btor_sat_add (amgr->smgr, c);
+    amgr->num_cnf_literals++;
+  }
+  btor_sat_add (amgr->smgr, 0);
+  amgr->num_cnf_clauses++;
+}
+
+/* Polarity-aware (Plaisted-Greenbaum) Tseitin transformation of 'start'
+ * in polarities 'pol'. AIGs that are already encoded in some polarity are
+ * upgraded with the clauses of the missing polarity (if required). */
+static void
+aig_to_sat_tseitin_pol (BtorAIGMgr *amgr, BtorAIG *start, uint32_t pol)
+{
+  BtorAIGPtrStack stack, leafs;
+  BtorIntStack pols;
+  BtorAIG *root, **p;
+  BtorMemMgr *mm;
+  int32_t x, a, b, c;
+  uint32_t need;
+  bool isxor, isite, expanded;
+
+  mm = amgr->btor->mm;
+  BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, pols);
+  BTOR_INIT_STACK (mm, leafs);
+
+  BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (start));
+  BTOR_PUSH_STACK (pols, get_edge_polarity (start, pol));
+
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    root     = BTOR_POP_STACK (stack);
+    need     = BTOR_POP_STACK (pols);
+    expanded = need > BTOR_AIG_ENC_FULL;
+    need &= BTOR_AIG_ENC_FULL & ~root->encoded;
+    if (!need) continue;
+
+    if (btor_aig_is_var (root))
+    {
+      assert (!root->cnf_id);
+      set_next_id_aig_mgr (amgr, root);
+      continue;
+    }
+
+    assert (BTOR_EMPTY_STACK (leafs));
+    if ((isxor = is_xor_aig (amgr, root, &leafs)))
+      isite = false;
+    else
+      isite = is_ite_aig (amgr, root, &leafs);
+    if (!isxor && !isite)
+    {
+      BTOR_PUSH_STACK (leafs, btor_aig_get_left_child (amgr, root));
+      BTOR_PUSH_STACK (leafs, btor_aig_get_right_child (amgr, root));
+    }
+
+    if (!expanded)
+    {
+      /* encode children first */
+      BTOR_PUSH_STACK (stack, root);
+      BTOR_PUSH_STACK (pols, need | (BTOR_AIG_ENC_FULL + 1));
+      for (p = leafs.start; p < leafs.top; p++)
+      {
+        BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (*p));
+        /* xor inputs and ite conditions occur in both polarities */
+        if (isxor || (isite && p == leafs.start + 2))
+          BTOR_PUSH_STACK (pols, BTOR_AIG_ENC_FULL);
+        else
+          BTOR_PUSH_STACK (pols, get_edge_polarity (*p, need));
+      }
+      BTOR_RESET_STACK (leafs);
+      continue;
+    }
+
+    if (!root->cnf_id)
+    {
+      set_next_id_aig_mgr (amgr, root);
+      root->encoded = 0;
+    }
+    x = root->cnf_id;
+
+    if (isxor)
+    {
+      a = btor_aig_get_cnf_id (leafs.start[0]);
+      b = btor_aig_get_cnf_id (leafs.start[1]);
+      if (need & BTOR_AIG_ENC_POS)
+      {
+        add_clause (amgr, -x, a, -b);
+        add_clause (amgr, -x, -a, b);
+      }
+      if (need & BTOR_AIG_ENC_NEG)
+      {
+        add_clause (amgr, x, -a, -b);
+        add_clause (amgr, x, a, b);
+      }
+    }
+    else if (isite)
+    {
+      a = btor_aig_get_cnf_id (leafs.start[0]); /* else */
+      b = btor_aig_get_cnf_id (leafs.start[1]); /* then */
+      c = btor_aig_get_cnf_id (leafs.start[2]); /* cond */
+      if (need & BTOR_AIG_ENC_POS)
+      {
+        add_clause (amgr, -x, -c, b);
+        add_clause (amgr, -x, c, a);
+      }
+      if (need & BTOR_AIG_ENC_NEG)
+      {
+        add_clause (amgr, x, -c, -b);
+        add_clause (amgr, x, c, -a);
+      }
+    }
+    else
+    {
+      a = btor_aig_get_cnf_id (leafs.start[0]);
+      b = btor_aig_get_cnf_id (leafs.start[1]);
+      if (need & BTOR_AIG_ENC_NEG) add_clause (amgr, x, -a, -b);
+      if (need & BTOR_AIG_ENC_POS)
+      {
+        add_clause (amgr, -x, a, 0);
+        add_clause (amgr, -x, b, 0);
+      }
+    }
+    root->encoded |= need;
+    BTOR_RESET_STACK (leafs);
+  }
+  BTOR_RELEASE_STACK (leafs);
+  BTOR_RELEASE_STACK (pols);
+  BTOR_RELEASE_STACK (stack);
+}
+
 void
 btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 {
@@ -1123,6 +1324,12 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
 
   assert (amgr);
 
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_POLARITY))
+  {
+    aig_to_sat_tseitin_pol (amgr, start, BTOR_AIG_ENC_FULL);
+    return;
+  }
+
   smgr = amgr->smgr;
   mm   = amgr->btor->mm;
 
@@ -1335,7 +1542,11 @@ btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig)
 {
   assert (amgr);
   if (!btor_sat_is_initialized (amgr->smgr)) return;
-  if (!btor_aig_is_const (aig)) aig_to_sat_tseitin (amgr, aig);
+  if (btor_aig_is_const (aig)) return;
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_POLARITY))
+    aig_to_sat_tseitin_pol (amgr, aig, BTOR_AIG_ENC_POS);
+  else
+    aig_to_sat_tseitin (amgr, aig);
 }
 
 void
@@ -1464,6 +1675,78 @@ btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
   return amgr ? amgr->smgr : 0;
 }
 
+static int32_t
+get_sat_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  int32_t val;
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  if (!aig->cnf_id) return -1;
+  val = btor_sat_deref (amgr->smgr, aig->cnf_id);
+  return val ? val : -1;
+}
+
+/* The value of an AIG that is not fully encoded is not determined by the
+ * SAT solver and has to be computed from the values of its children. */
+static int32_t
+compute_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  BtorAIGPtrStack visit;
+  BtorHashTableData *d;
+  BtorAIG *cur, *child;
+  int32_t val, cval;
+  uint32_t i;
+
+  assert (BTOR_IS_REGULAR_AIG (aig));
+
+  if (!amgr->assignments
+      || amgr->assignments_satcalls != amgr->smgr->satcalls)
+  {
+    if (amgr->assignments) btor_hashint_map_delete (amgr->assignments);
+    amgr->assignments          = btor_hashint_map_new (amgr->btor->mm);
+    amgr->assignments_satcalls = amgr->smgr->satcalls;
+  }
+
+  BTOR_INIT_STACK (amgr->btor->mm, visit);
+  BTOR_PUSH_STACK (visit, aig);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_TOP_STACK (visit);
+    if (btor_hashint_map_contains (amgr->assignments, cur->id))
+    {
+      (void) BTOR_POP_STACK (visit);
+      continue;
+    }
+    if (!btor_aig_is_and (cur) || cur->encoded == BTOR_AIG_ENC_FULL)
+    {
+      (void) BTOR_POP_STACK (visit);
+      btor_hashint_map_add (amgr->assignments, cur->id)->as_int =
+          get_sat_assignment (amgr, cur);
+      continue;
+    }
+    val = 1;
+    for (i = 0; i < 2 && val; i++)
+    {
+      child = i ? btor_aig_get_right_child (amgr, cur)
+                : btor_aig_get_left_child (amgr, cur);
+      d = btor_hashint_map_get (amgr->assignments,
+                                BTOR_REAL_ADDR_AIG (child)->id);
+      if (!d)
+      {
+        BTOR_PUSH_STACK (visit, BTOR_REAL_ADDR_AIG (child));
+        val = 0;
+        break;
+      }
+      cval = BTOR_IS_INVERTED_AIG (child) ? -d->as_int : d->as_int;
+      if (cval < 0) val = -1;
+    }
+    if (!val) continue;
+    (void) BTOR_POP_STACK (visit);
+    btor_hashint_map_add (amgr->assignments, cur->id)->as_int = val;
+  }
+  BTOR_RELEASE_STACK (visit);
+  return btor_hashint_map_get (amgr->assignments, aig->id)->as_int;
+}
+
 int32_t
 btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
 {
@@ -1471,6 +1754,14 @@ btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
   if (aig == BTOR_AIG_TRUE) return 1;
   if (aig == BTOR_AIG_FALSE) return -1;
 
+  BtorAIG *real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_aig_is_and (real_aig) && real_aig->encoded != BTOR_AIG_ENC_FULL
+      && btor_opt_get (amgr->btor, BTOR_OPT_AIG_POLARITY))
+  {
+    int32_t res = compute_assignment (amgr, real_aig);
+    return BTOR_IS_INVERTED_AIG (aig) ? -res : res;
+  }
+
   /* Note: If an AIG is not yet encoded to SAT or if the SAT solver returns
    * undefined for a variable, we implicitly initialize it with false (-1). */
   int32_t val = -1;
@@ -1500,6 +1791,38 @@ btor_aig_compare (const BtorAIG *aig0, const BtorAIG *aig1)
   return aig0->id - aig1->id;
 }
 
+uint32_t
+btor_aig_count_unencoded_cone (BtorAIGMgr *amgr, BtorAIGPtrStack *roots)
+{
+  assert (amgr);
+  assert (roots);
+
+  BtorAIGPtrStack visit;
+  BtorIntHashTable *cache;
+  BtorAIG *cur;
+  uint32_t i, res;
+
+  res   = 0;
+  cache = btor_hashint_table_new (amgr->btor->mm);
+  BTOR_INIT_STACK (amgr->btor->mm, visit);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (visit));
+    if (!btor_aig_is_unencoded_and (cur)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+    res++;
+    BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, cur));
+    BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, cur));
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
 /* hash AIG by id */
 uint32_t
 btor_aig_hash_by_id (const BtorAIG *aig)
@@ -12,6 +12,7 @@
 #include "btoropt.h"
 #include "btorsat.h"
 #include "btortypes.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
@@ -20,21 +21,34 @@
 #include <stdio.h>
 
 struct BtorAIGMap;
+struct BtorAIGRWLib;
 
 /*------------------------------------------------------------------------*/
 
+/* Note: The structure of the AIG graph, i.e., the children of AND nodes and
+ * the links of the unique table chains, is not stored in the nodes but in
+ * packed arrays indexed by AIG id (see 'id2children' and 'id2next' in
+ * BtorAIGMgr). Hash consing and structural traversals therefore only work
+ * on 32-bit ids and do not have to touch the nodes themselves.
+ */
 struct BtorAIG
 {
   int32_t id;
   int32_t cnf_id;
   uint32_t refs;
-  int32_t next; /* next AIG id for unique table */
   uint8_t mark : 2;
-  uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t is_var : 1;  /* is it an AIG variable or an AND? */
+  uint8_t encoded : 2; /* polarities encoded to CNF (BTOR_AIG_ENC_*) */
   uint32_t local;
-  int32_t children[]; /* only allocated for AIG AND */
 };
 
+/* With polarity-aware encoding, the CNF of an AND 'x' with function 'f' may
+ * only contain the clauses for 'x -> f' (positive polarity) or 'f -> x'
+ * (negative polarity). */
+#define BTOR_AIG_ENC_POS 1
+#define BTOR_AIG_ENC_NEG 2
+#define BTOR_AIG_ENC_FULL (BTOR_AIG_ENC_POS | BTOR_AIG_ENC_NEG)
+
 typedef struct BtorAIG BtorAIG;
 
 BTOR_DECLARE_STACK (BtorAIGPtr, BtorAIG *);
@@ -53,8 +67,14 @@ struct BtorAIGMgr
   Btor *btor;
   BtorAIGUniqueTable table;
   BtorSATMgr *smgr;
-  BtorAIGPtrStack id2aig; /* id to AIG node */
-  BtorIntStack cnfid2aig; /* cnf id to AIG id */
+  BtorMemSlab *slab;             /* node memory */
+  BtorAIGPtrStack id2aig;        /* id to AIG node */
+  BtorIntStack id2children;      /* id to children ids (2 per id, 0 for vars) */
+  BtorIntStack id2next;          /* id to next AIG id in unique table chain */
+  BtorIntStack cnfid2aig;        /* cnf id to AIG id */
+  struct BtorAIGRWLib *rwlib;    /* structures for AIG rewriting (lazy) */
+  BtorIntHashTable *assignments; /* assignments of partially encoded AIGs */
+  int32_t assignments_satcalls;  /* SAT call of 'assignments' */
 
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
@@ -65,6 +85,10 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_rw_saved_ands; /* ANDs removed by AIG rewriting */
+  uint_least64_t num_fraig_merged;  /* ANDs merged by SAT sweeping */
+  uint_least64_t num_sim_patterns;  /* input patterns simulated */
+  double time_sim;                  /* time spent in simulation */
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -118,6 +142,14 @@ btor_aig_is_and (const BtorAIG *aig)
   return !aig->is_var;
 }
 
+/* AND node that has not been encoded to CNF yet. */
+static inline bool
+btor_aig_is_unencoded_and (const BtorAIG *aig)
+{
+  aig = BTOR_REAL_ADDR_AIG (aig);
+  return btor_aig_is_and (aig) && !aig->cnf_id;
+}
+
 static inline int32_t
 btor_aig_get_id (const BtorAIG *aig)
 {
@@ -144,13 +176,32 @@ btor_aig_get_cnf_id (const BtorAIG *aig)
                                     : aig->cnf_id;
 }
 
+static inline int32_t
+btor_aig_get_left_child_id (BtorAIGMgr *amgr, const BtorAIG *aig)
+{
+  assert (amgr);
+  assert (aig);
+  assert (!btor_aig_is_const (aig));
+  return BTOR_PEEK_STACK (amgr->id2children, 2 * BTOR_REAL_ADDR_AIG (aig)->id);
+}
+
+static inline int32_t
+btor_aig_get_right_child_id (BtorAIGMgr *amgr, const BtorAIG *aig)
+{
+  assert (amgr);
+  assert (aig);
+  assert (!btor_aig_is_const (aig));
+  return BTOR_PEEK_STACK (amgr->id2children,
+                          2 * BTOR_REAL_ADDR_AIG (aig)->id + 1);
+}
+
 static inline BtorAIG *
 btor_aig_get_left_child (BtorAIGMgr *amgr, const BtorAIG *aig)
 {
   assert (amgr);
   assert (aig);
   assert (!btor_aig_is_const (aig));
-  return btor_aig_get_by_id (amgr, BTOR_REAL_ADDR_AIG (aig)->children[0]);
+  return btor_aig_get_by_id (amgr, btor_aig_get_left_child_id (amgr, aig));
 }
 
 static inline BtorAIG *
@@ -159,7 +210,7 @@ btor_aig_get_right_child (BtorAIGMgr *amgr, const BtorAIG *aig)
   assert (amgr);
   assert (aig);
   assert (!btor_aig_is_const (aig));
-  return btor_aig_get_by_id (amgr, BTOR_REAL_ADDR_AIG (aig)->children[1]);
+  return btor_aig_get_by_id (amgr, btor_aig_get_right_child_id (amgr, aig));
 }
 
 /*------------------------------------------------------------------------*/
@@ -200,7 +251,10 @@ BtorAIG *btor_aig_copy (BtorAIGMgr *amgr, BtorAIG *aig);
  */
 void btor_aig_release (BtorAIGMgr *amgr, BtorAIG *aig);
 
-/* Translates AIG into SAT instance. */
+/* Translates AIG into SAT instance.
+ * With polarity-aware encoding (BTOR_OPT_AIG_POLARITY) only the clauses
+ * required for asserting or assuming 'aig' are added.
+ */
 void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
 
 /* As 'btor_aig_to_sat' but also add the argument as new SAT constraint.
@@ -210,10 +264,16 @@ void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
 /* Translates AIG into SAT instance in both phases.
  * The function guarantees that after finishing every reachable AIG
- * has a CNF id.
+ * has a CNF id. AIGs that are encoded in one polarity only are upgraded.
  */
 void btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig);
 
+/* Returns the number of AND nodes without CNF id reachable from 'roots'
+ * (through AND nodes without CNF id only).
+ */
+uint32_t btor_aig_count_unencoded_cone (BtorAIGMgr *amgr,
+                                        BtorAIGPtrStack *roots);
+
 /* Gets current assignment of AIG aig (in the SAT case).
  */
 int32_t btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig);
@@ -0,0 +1,464 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigfraig.h"
+
+#include "btoraigsim.h"
+#include "btorcore.h"
+#include "btorsat.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+#include "utils/btorrng.h"
+#include "utils/btorstack.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+/* number of random 64-bit simulation words per node */
+#define BTOR_AIGFRAIG_INIT_WORDS 4
+
+/* maximum number of simulation words (counterexample words included) */
+#define BTOR_AIGFRAIG_MAX_WORDS 8
+
+/* conflict limit of a single equivalence check */
+#define BTOR_AIGFRAIG_SAT_LIMIT 1000
+
+/*------------------------------------------------------------------------*/
+
+/* Per node data, indexed by the position of the node in the simulator. */
+struct BtorAIGFraigNode
+{
+  BtorAIG *res; /* merged result (referenced) */
+  int32_t satvar;
+  int32_t next; /* next node in candidate class chain */
+  bool is_repr; /* can serve as candidate representative */
+};
+
+typedef struct BtorAIGFraigNode BtorAIGFraigNode;
+
+struct BtorAIGFraig
+{
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mm;
+  BtorAIGSim *sim;           /* BTOR_AIGFRAIG_MAX_WORDS words per node */
+  uint32_t num_words;        /* number of simulation words in use */
+  BtorAIGFraigNode *nodes;
+  BtorIntHashTable *classes; /* signature hash -> first node in chain */
+  uint64_t *cex;             /* pending counterexample word per node */
+  uint32_t num_cex;
+  BtorSATMgr *smgr;
+  uint32_t num_merged;
+};
+
+typedef struct BtorAIGFraig BtorAIGFraig;
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t *
+get_sim (BtorAIGFraig *fr, uint32_t p)
+{
+  return btor_aigsim_get_words (fr->sim, p);
+}
+
+static int32_t
+get_child (BtorAIGFraig *fr, uint32_t p, uint32_t j)
+{
+  return BTOR_PEEK_STACK (fr->sim->children, 2 * p + j);
+}
+
+static void
+init_simulation (BtorAIGFraig *fr)
+{
+  BtorRNG rng;
+  uint32_t w;
+
+  memset (&rng, 0, sizeof (rng));
+  btor_rng_init (&rng, btor_opt_get (fr->amgr->btor, BTOR_OPT_SEED));
+  for (w = 0; w < BTOR_AIGFRAIG_INIT_WORDS; w++)
+    btor_aigsim_randomize (fr->sim, &rng, w);
+  btor_rng_delete (&rng);
+
+  fr->num_words = BTOR_AIGFRAIG_INIT_WORDS;
+  btor_aigsim_simulate (fr->sim, 0, fr->num_words);
+}
+
+/* Signatures are normalized such that the first simulated bit is 0, i.e.,
+ * complementary nodes end up in the same candidate class. */
+static bool
+get_phase (BtorAIGFraig *fr, uint32_t p)
+{
+  return get_sim (fr, p)[0] & 1;
+}
+
+static int32_t
+hash_sim (BtorAIGFraig *fr, uint32_t p)
+{
+  uint64_t *sim, mask, h;
+  uint32_t w;
+
+  sim  = get_sim (fr, p);
+  mask = get_phase (fr, p) ? ~(uint64_t) 0 : 0;
+  h    = 0;
+  for (w = 0; w < fr->num_words; w++)
+    h = (h + (sim[w] ^ mask)) * 0x9e3779b97f4a7c15ull;
+  return (int32_t) ((h >> 32) | 1);
+}
+
+static bool
+is_const_sim (BtorAIGFraig *fr, uint32_t p)
+{
+  uint64_t *sim, mask;
+  uint32_t w;
+
+  sim  = get_sim (fr, p);
+  mask = get_phase (fr, p) ? ~(uint64_t) 0 : 0;
+  for (w = 0; w < fr->num_words; w++)
+    if ((sim[w] ^ mask) != 0) return false;
+  return true;
+}
+
+static bool
+is_equal_sim (BtorAIGFraig *fr, uint32_t p, uint32_t q)
+{
+  uint64_t *sp, *sq, mask;
+  uint32_t w;
+
+  sp   = get_sim (fr, p);
+  sq   = get_sim (fr, q);
+  mask = get_phase (fr, p) != get_phase (fr, q) ? ~(uint64_t) 0 : 0;
+  for (w = 0; w < fr->num_words; w++)
+    if (sp[w] != (sq[w] ^ mask)) return false;
+  return true;
+}
+
+static void
+insert_class (BtorAIGFraig *fr, uint32_t p)
+{
+  BtorHashTableData *d;
+  int32_t h;
+
+  h = hash_sim (fr, p);
+  d = btor_hashint_map_get (fr->classes, h);
+  if (d)
+  {
+    fr->nodes[p].next = d->as_int;
+    d->as_int               = p;
+  }
+  else
+  {
+    fr->nodes[p].next = -1;
+    d                       = btor_hashint_map_add (fr->classes, h);
+    d->as_int               = p;
+  }
+}
+
+static int32_t
+find_class (BtorAIGFraig *fr, uint32_t p)
+{
+  BtorHashTableData *d;
+  int32_t q;
+
+  d = btor_hashint_map_get (fr->classes, hash_sim (fr, p));
+  for (q = d ? d->as_int : -1; q >= 0; q = fr->nodes[q].next)
+    if (is_equal_sim (fr, p, q)) return q;
+  return -1;
+}
+
+/* Rebuild the candidate classes of the representatives before node 'p'. */
+static void
+rebuild_classes (BtorAIGFraig *fr, uint32_t p)
+{
+  uint32_t i;
+
+  btor_hashint_map_delete (fr->classes);
+  fr->classes = btor_hashint_map_new (fr->mm);
+  for (i = 0; i < p; i++)
+    if (fr->nodes[i].is_repr) insert_class (fr, i);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Encode the cone of node 'p' on the side SAT manager. */
+static int32_t
+encode (BtorAIGFraig *fr, uint32_t p)
+{
+  BtorIntStack visit;
+  BtorAIGFraigNode *node;
+  int32_t q, x, a, b, c0, c1;
+
+  if (fr->nodes[p].satvar) return fr->nodes[p].satvar;
+
+  BTOR_INIT_STACK (fr->mm, visit);
+  BTOR_PUSH_STACK (visit, p);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    q    = BTOR_TOP_STACK (visit);
+    node = &fr->nodes[q];
+    if (node->satvar)
+    {
+      (void) BTOR_POP_STACK (visit);
+      continue;
+    }
+    c0 = get_child (fr, q, 0);
+    c1 = get_child (fr, q, 1);
+    if (c0 >= 0)
+    {
+      a = fr->nodes[c0 >> 1].satvar;
+      b = fr->nodes[c1 >> 1].satvar;
+      if (!a || !b)
+      {
+        if (!a) BTOR_PUSH_STACK (visit, c0 >> 1);
+        if (!b) BTOR_PUSH_STACK (visit, c1 >> 1);
+        continue;
+      }
+      if (c0 & 1) a = -a;
+      if (c1 & 1) b = -b;
+    }
+    x            = btor_sat_mgr_next_cnf_id (fr->smgr);
+    node->satvar = x;
+    if (c0 >= 0)
+    {
+      btor_sat_add (fr->smgr, -x);
+      btor_sat_add (fr->smgr, a);
+      btor_sat_add (fr->smgr, 0);
+      btor_sat_add (fr->smgr, -x);
+      btor_sat_add (fr->smgr, b);
+      btor_sat_add (fr->smgr, 0);
+      btor_sat_add (fr->smgr, x);
+      btor_sat_add (fr->smgr, -a);
+      btor_sat_add (fr->smgr, -b);
+      btor_sat_add (fr->smgr, 0);
+    }
+    (void) BTOR_POP_STACK (visit);
+  }
+  BTOR_RELEASE_STACK (visit);
+  return fr->nodes[p].satvar;
+}
+
+/* Returns true if 'lit' is unsatisfiable under 'other' (if non-zero).
+ * A model is recorded as counterexample for refining the simulation. */
+static bool
+refute (BtorAIGFraig *fr, int32_t lit, int32_t other)
+{
+  BtorSolverResult res;
+  uint32_t i, n, w;
+
+  btor_sat_assume (fr->smgr, lit);
+  if (other) btor_sat_assume (fr->smgr, other);
+  res = btor_sat_check_sat (fr->smgr, BTOR_AIGFRAIG_SAT_LIMIT);
+  if (res == BTOR_RESULT_UNSAT) return true;
+  if (res != BTOR_RESULT_SAT || fr->num_words == BTOR_AIGFRAIG_MAX_WORDS)
+    return false;
+
+  n = btor_aigsim_num_nodes (fr->sim);
+  for (i = 0; i < n; i++)
+  {
+    if (btor_aigsim_is_input (fr->sim, i) && fr->nodes[i].satvar
+        && btor_sat_deref (fr->smgr, fr->nodes[i].satvar) > 0)
+      fr->cex[i] |= (uint64_t) 1 << fr->num_cex;
+  }
+  if (++fr->num_cex == 64)
+  {
+    w = fr->num_words++;
+    for (i = 0; i < n; i++)
+    {
+      if (btor_aigsim_is_input (fr->sim, i)) get_sim (fr, i)[w] = fr->cex[i];
+      fr->cex[i] = 0;
+    }
+    fr->num_cex = 0;
+    btor_aigsim_simulate (fr->sim, w, w + 1);
+  }
+  return false;
+}
+
+/* Try to prove that node 'p' is equivalent to 'q' (or its complement if
+ * 'inv' is true). If 'q' is negative, 'p' is checked for being constant
+ * false (true if 'inv' is true). */
+static bool
+prove (BtorAIGFraig *fr, uint32_t p, int32_t q, bool inv)
+{
+  int32_t x, y;
+
+  if (!fr->smgr)
+  {
+    fr->smgr = btor_sat_mgr_new (fr->amgr->btor);
+    btor_sat_enable_side_solver (fr->smgr);
+    btor_sat_init (fr->smgr);
+  }
+  if (!btor_sat_mgr_has_incremental_support (fr->smgr)) return false;
+
+  x = encode (fr, p);
+  if (q < 0) return refute (fr, inv ? -x : x, 0);
+
+  y = encode (fr, q);
+  if (inv) y = -y;
+  if (!refute (fr, x, -y) || !refute (fr, -x, y)) return false;
+
+  /* equivalence is permanent, keep it for later checks */
+  btor_sat_add (fr->smgr, -x);
+  btor_sat_add (fr->smgr, y);
+  btor_sat_add (fr->smgr, 0);
+  btor_sat_add (fr->smgr, x);
+  btor_sat_add (fr->smgr, -y);
+  btor_sat_add (fr->smgr, 0);
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorAIG *
+get_child_result (BtorAIGFraig *fr, uint32_t p, uint32_t j)
+{
+  BtorAIG *res;
+  int32_t c;
+
+  c   = get_child (fr, p, j);
+  res = fr->nodes[c >> 1].res;
+  return (c & 1) ? BTOR_INVERT_AIG (res) : res;
+}
+
+static void
+sweep_node (BtorAIGFraig *fr, uint32_t p)
+{
+  BtorAIGFraigNode *node;
+  BtorAIG *res;
+  uint32_t num_words;
+  int32_t q;
+  bool inv;
+
+  node = &fr->nodes[p];
+  if (btor_aigsim_is_input (fr->sim, p))
+  {
+    node->res = btor_aig_copy (fr->amgr, BTOR_PEEK_STACK (fr->sim->aigs, p));
+    insert_class (fr, p);
+    return;
+  }
+
+  res = 0;
+  inv = get_phase (fr, p);
+  if (is_const_sim (fr, p))
+  {
+    num_words = fr->num_words;
+    if (prove (fr, p, -1, inv))
+      res = inv ? BTOR_AIG_TRUE : BTOR_AIG_FALSE;
+    else if (num_words != fr->num_words)
+      rebuild_classes (fr, p);
+  }
+  else
+  {
+    while ((q = find_class (fr, p)) >= 0)
+    {
+      num_words = fr->num_words;
+      inv       = get_phase (fr, p) != get_phase (fr, q);
+      if (prove (fr, p, q, inv))
+      {
+        res = btor_aig_copy (fr->amgr, fr->nodes[q].res);
+        if (inv) res = BTOR_INVERT_AIG (res);
+        break;
+      }
+      /* retry with the refined simulation, otherwise give up */
+      if (num_words == fr->num_words) break;
+      rebuild_classes (fr, p);
+    }
+  }
+
+  if (res)
+  {
+    node->is_repr = false;
+    fr->num_merged++;
+  }
+  else
+  {
+    res = btor_aig_and (
+        fr->amgr, get_child_result (fr, p, 0), get_child_result (fr, p, 1));
+    insert_class (fr, p);
+  }
+  node->res = res;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_aigfraig_sweep (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n)
+{
+  assert (amgr);
+  assert (aigs);
+
+  BtorAIGFraig fr;
+  BtorMemMgr *mm;
+  BtorAIGPtrStack roots;
+  BtorAIG *aig, *res;
+  uint32_t i, num_nodes, num_old, num_new;
+  int32_t p;
+
+  mm = amgr->btor->mm;
+
+  memset (&fr, 0, sizeof (fr));
+  fr.amgr = amgr;
+  fr.mm   = mm;
+  fr.sim  = btor_aigsim_new (amgr, aigs, n, BTOR_AIGFRAIG_MAX_WORDS, true);
+  BTOR_INIT_STACK (mm, roots);
+
+  num_nodes = btor_aigsim_num_nodes (fr.sim);
+  num_old   = 0;
+  for (i = 0; i < num_nodes; i++)
+    if (!btor_aigsim_is_input (fr.sim, i)) num_old++;
+
+  /* nothing to merge with less than two ANDs */
+  if (num_old > 1)
+  {
+    BTOR_CNEWN (mm, fr.nodes, num_nodes);
+    BTOR_CNEWN (mm, fr.cex, num_nodes);
+    for (i = 0; i < num_nodes; i++)
+    {
+      fr.nodes[i].next    = -1;
+      fr.nodes[i].is_repr = true;
+    }
+    fr.classes = btor_hashint_map_new (mm);
+
+    init_simulation (&fr);
+    for (i = 0; i < num_nodes; i++) sweep_node (&fr, i);
+
+    for (i = 0; i < n; i++)
+    {
+      aig = aigs[i];
+      if (btor_aig_is_unencoded_and (aig))
+      {
+        p   = btor_aigsim_get_pos (fr.sim, BTOR_REAL_ADDR_AIG (aig)->id);
+        res = fr.nodes[p].res;
+        aig = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
+      }
+      BTOR_PUSH_STACK (roots, aig);
+    }
+
+    num_new = btor_aig_count_unencoded_cone (amgr, &roots);
+    if (fr.num_merged > 0 && num_new < num_old)
+    {
+      for (i = 0; i < n; i++)
+      {
+        aig = btor_aig_copy (amgr, BTOR_PEEK_STACK (roots, i));
+        btor_aig_release (amgr, aigs[i]);
+        aigs[i] = aig;
+      }
+      amgr->num_fraig_merged += fr.num_merged;
+    }
+
+    for (i = 0; i < num_nodes; i++) btor_aig_release (amgr, fr.nodes[i].res);
+
+    if (fr.smgr) btor_sat_mgr_delete (fr.smgr);
+    btor_hashint_map_delete (fr.classes);
+    BTOR_DELETEN (mm, fr.cex, num_nodes);
+    BTOR_DELETEN (mm, fr.nodes, num_nodes);
+  }
+
+  BTOR_RELEASE_STACK (roots);
+  btor_aigsim_delete (fr.sim);
+}
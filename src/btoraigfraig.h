@@ -0,0 +1,29 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGFRAIG_H_INCLUDED
+#define BTORAIGFRAIG_H_INCLUDED
+
+#include "btoraig.h"
+
+#include <stdint.h>
+
+/*------------------------------------------------------------------------*/
+
+/* SAT sweeping (fraiging) of the AND nodes in the cone of the given AIGs.
+ * Candidate pairs of equivalent (or complementary) nodes are determined by
+ * random simulation and then proved equivalent by incremental SAT calls on
+ * a separate SAT manager. Proven equivalent nodes are merged.
+ * AIG variables and AIGs that already have a CNF id are treated as inputs.
+ *
+ * The AIGs 'aigs[0], ..., aigs[n - 1]' are replaced in place by the merged
+ * AIGs (their old references are released).
+ */
+void btor_aigfraig_sweep (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n);
+
+#endif
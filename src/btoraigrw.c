@@ -0,0 +1,919 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigrw.h"
+
+#include "btorcore.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_AIGRW_CUT_SIZE 4
+
+/* maximum number of non-trivial cuts stored per AND node */
+#define BTOR_AIGRW_MAX_CUTS 8
+
+#define BTOR_AIGRW_NUM_TTS (1u << 16)
+
+#define BTOR_AIGRW_NUM_PERMS 24
+
+#define BTOR_AIGRW_UNKNOWN_COST 0xff
+
+#define BTOR_AIGRW_MAX_COST 0xfe
+
+#define BTOR_AIGRW_NPN_VALID (1u << 31)
+
+/* Structures are stored as small programs of AND gates over literals
+ * '2 * index + sign', where index 0 is constant false, indices 1 - 4 are the
+ * inputs of the structure and indices starting from 5 are gates. */
+#define BTOR_AIGRW_FIRST_GATE (BTOR_AIGRW_CUT_SIZE + 1)
+
+static const uint32_t btor_aigrw_var_tt[BTOR_AIGRW_CUT_SIZE] = {
+    0xaaaa, 0xcccc, 0xf0f0, 0xff00};
+
+/*------------------------------------------------------------------------*/
+
+/* Library of AIG structures for the NPN classes of 4-input functions.
+ * NPN classes and structures are computed lazily on first use. */
+struct BtorAIGRWLib
+{
+  BtorMemMgr *mm;
+  uint8_t perms[BTOR_AIGRW_NUM_PERMS][BTOR_AIGRW_CUT_SIZE];
+  uint8_t perm_minterms[BTOR_AIGRW_NUM_PERMS][1u << BTOR_AIGRW_CUT_SIZE];
+  /* truth table -> canonical truth table | perm << 16 | phase << 21
+   *                | output phase << 25 | BTOR_AIGRW_NPN_VALID */
+  uint32_t *npn;
+  /* truth table -> number of ANDs of its structure */
+  uint8_t *cost;
+  /* canonical truth table + 1 -> position of its program in 'programs' */
+  BtorIntHashTable *classes;
+  /* [num gates, output literal, gate literals ...] per class */
+  BtorIntStack programs;
+};
+
+typedef struct BtorAIGRWLib BtorAIGRWLib;
+
+enum BtorAIGRWDecKind
+{
+  BTOR_AIGRW_DEC_AND,
+  BTOR_AIGRW_DEC_XOR,
+  BTOR_AIGRW_DEC_MUX,
+};
+
+typedef enum BtorAIGRWDecKind BtorAIGRWDecKind;
+
+/* f = neg ^ (g & h), f = neg ^ g ^ h or f = var ? g : h */
+struct BtorAIGRWDec
+{
+  BtorAIGRWDecKind kind;
+  uint32_t g, h;
+  uint32_t var;
+  uint32_t neg;
+};
+
+typedef struct BtorAIGRWDec BtorAIGRWDec;
+
+/*------------------------------------------------------------------------*/
+
+struct BtorAIGRWCut
+{
+  int32_t leaves[BTOR_AIGRW_CUT_SIZE]; /* leaf AIG ids in ascending order */
+  uint32_t size;
+  uint32_t tt; /* function of the cut root over its leaves */
+};
+
+typedef struct BtorAIGRWCut BtorAIGRWCut;
+
+struct BtorAIGRWNode
+{
+  BtorAIG *aig;     /* AND node of the original cone */
+  BtorAIG *res;     /* rewritten AIG */
+  int32_t child[2]; /* cone positions of the children, -1 if not in cone */
+  uint32_t refs;    /* number of references from within the cone */
+  uint32_t first_cut;
+  uint32_t num_cuts;
+  uint32_t mark;
+  bool owned; /* all references to 'aig' are from within the cone */
+};
+
+typedef struct BtorAIGRWNode BtorAIGRWNode;
+
+BTOR_DECLARE_STACK (BtorAIGRWCut, BtorAIGRWCut);
+BTOR_DECLARE_STACK (BtorAIGRWNode, BtorAIGRWNode);
+
+struct BtorAIGRW
+{
+  BtorAIGMgr *amgr;
+  BtorAIGRWLib *lib;
+  BtorIntHashTable *pos; /* AIG id -> cone position */
+  BtorAIGRWNodeStack nodes;
+  BtorAIGRWCutStack cuts;
+  BtorUIntStack mffc;
+  BtorAIGPtrStack gates;
+  uint32_t mark;
+};
+
+typedef struct BtorAIGRW BtorAIGRW;
+
+/*------------------------------------------------------------------------*/
+
+static uint32_t
+tt_cofactor0 (uint32_t f, uint32_t var)
+{
+  f &= ~btor_aigrw_var_tt[var] & 0xffff;
+  return f | (f << (1u << var));
+}
+
+static uint32_t
+tt_cofactor1 (uint32_t f, uint32_t var)
+{
+  f &= btor_aigrw_var_tt[var];
+  return f | (f >> (1u << var));
+}
+
+static uint32_t
+tt_support (uint32_t f)
+{
+  uint32_t i, res;
+  for (i = 0, res = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+    if (tt_cofactor0 (f, i) != tt_cofactor1 (f, i)) res |= 1u << i;
+  return res;
+}
+
+static uint32_t
+tt_exists (uint32_t f, uint32_t vars)
+{
+  uint32_t i;
+  for (i = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+    if (vars & (1u << i)) f = tt_cofactor0 (f, i) | tt_cofactor1 (f, i);
+  return f;
+}
+
+static uint32_t
+tt_fix0 (uint32_t f, uint32_t vars)
+{
+  uint32_t i;
+  for (i = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+    if (vars & (1u << i)) f = tt_cofactor0 (f, i);
+  return f;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorAIGRWLib *
+new_lib (BtorMemMgr *mm)
+{
+  BtorAIGRWLib *lib;
+  uint32_t a, b, c, d, p, i, m, y;
+
+  BTOR_CNEW (mm, lib);
+  lib->mm = mm;
+  BTOR_CNEWN (mm, lib->npn, BTOR_AIGRW_NUM_TTS);
+  BTOR_NEWN (mm, lib->cost, BTOR_AIGRW_NUM_TTS);
+  memset (lib->cost, BTOR_AIGRW_UNKNOWN_COST, BTOR_AIGRW_NUM_TTS);
+  lib->classes = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, lib->programs);
+
+  p = 0;
+  for (a = 0; a < 4; a++)
+    for (b = 0; b < 4; b++)
+      for (c = 0; c < 4; c++)
+      {
+        if (a == b || a == c || b == c) continue;
+        d               = 6 - a - b - c;
+        lib->perms[p][0] = a;
+        lib->perms[p][1] = b;
+        lib->perms[p][2] = c;
+        lib->perms[p][3] = d;
+        p++;
+      }
+  assert (p == BTOR_AIGRW_NUM_PERMS);
+
+  /* minterm 'm' of the inputs is mapped to minterm 'y' of the original
+   * function with bit 'perms[p][i]' of 'y' set to bit 'i' of 'm' */
+  for (p = 0; p < BTOR_AIGRW_NUM_PERMS; p++)
+    for (m = 0; m < (1u << BTOR_AIGRW_CUT_SIZE); m++)
+    {
+      for (i = 0, y = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+        if (m & (1u << i)) y |= 1u << lib->perms[p][i];
+      lib->perm_minterms[p][m] = y;
+    }
+  return lib;
+}
+
+void
+btor_aigrw_delete_lib (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+
+  BtorAIGRWLib *lib;
+
+  if (!(lib = amgr->rwlib)) return;
+  BTOR_DELETEN (lib->mm, lib->npn, BTOR_AIGRW_NUM_TTS);
+  BTOR_DELETEN (lib->mm, lib->cost, BTOR_AIGRW_NUM_TTS);
+  btor_hashint_map_delete (lib->classes);
+  BTOR_RELEASE_STACK (lib->programs);
+  BTOR_DELETE (lib->mm, lib);
+  amgr->rwlib = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Get the NPN class of 'f', i.e., the smallest truth table 'c' with
+ * c(x) = out ^ f(y), where y[perms[perm][i]] = x[i] ^ phase[i]. */
+static uint32_t
+get_npn (BtorAIGRWLib *lib, uint32_t f)
+{
+  uint32_t p, phase, x, g, t, best, res;
+
+  if (!(lib->npn[f] & BTOR_AIGRW_NPN_VALID))
+  {
+    best = UINT32_MAX;
+    res  = 0;
+    for (p = 0; p < BTOR_AIGRW_NUM_PERMS; p++)
+      for (phase = 0; phase < (1u << BTOR_AIGRW_CUT_SIZE); phase++)
+      {
+        for (x = 0, g = 0; x < (1u << BTOR_AIGRW_CUT_SIZE); x++)
+          if ((f >> lib->perm_minterms[p][x ^ phase]) & 1) g |= 1u << x;
+        if (g < best)
+        {
+          best = g;
+          res  = g | (p << 16) | (phase << 21);
+        }
+        t = ~g & 0xffff;
+        if (t < best)
+        {
+          best = t;
+          res  = t | (p << 16) | (phase << 21) | (1u << 25);
+        }
+      }
+    lib->npn[f] = res | BTOR_AIGRW_NPN_VALID;
+  }
+  return lib->npn[f];
+}
+
+static uint32_t get_cost (BtorAIGRWLib *lib, uint32_t f);
+
+static void
+update_dec (BtorAIGRWDec *dec,
+            uint32_t *best,
+            uint32_t cost,
+            BtorAIGRWDecKind kind,
+            uint32_t g,
+            uint32_t h,
+            uint32_t var,
+            uint32_t neg)
+{
+  if (cost >= *best) return;
+  *best     = cost;
+  dec->kind = kind;
+  dec->g    = g;
+  dec->h    = h;
+  dec->var  = var;
+  dec->neg  = neg;
+}
+
+/* Determine the cheapest decomposition of a function 'f' with at least two
+ * variables in its support. Besides Shannon decomposition, we try to split
+ * the support into two disjoint sets of variables such that 'f' is an AND,
+ * OR or XOR of two functions over these sets. */
+static uint32_t
+decompose (BtorAIGRWLib *lib, uint32_t f, BtorAIGRWDec *dec)
+{
+  uint32_t supp, low, s1, s2, nf, g, h, c, i, best;
+
+  supp = tt_support (f);
+  assert (supp & (supp - 1));
+  low  = supp & (~supp + 1);
+  nf   = ~f & 0xffff;
+  best = UINT32_MAX;
+
+  for (s1 = (supp - 1) & supp; s1; s1 = (s1 - 1) & supp)
+  {
+    if (!(s1 & low)) continue;
+    s2 = supp & ~s1;
+
+    g = tt_exists (f, s2);
+    h = tt_exists (f, s1);
+    if ((g & h) == f)
+      update_dec (dec,
+                  &best,
+                  get_cost (lib, g) + get_cost (lib, h) + 1,
+                  BTOR_AIGRW_DEC_AND,
+                  g,
+                  h,
+                  0,
+                  0);
+
+    g = tt_exists (nf, s2);
+    h = tt_exists (nf, s1);
+    if ((g & h) == nf)
+      update_dec (dec,
+                  &best,
+                  get_cost (lib, g) + get_cost (lib, h) + 1,
+                  BTOR_AIGRW_DEC_AND,
+                  g,
+                  h,
+                  0,
+                  1);
+
+    g = tt_fix0 (f, s2);
+    h = tt_fix0 (f, s1);
+    c = (f & 1) ? 0xffff : 0;
+    if ((g ^ h ^ c) == f)
+      update_dec (dec,
+                  &best,
+                  get_cost (lib, g) + get_cost (lib, h) + 3,
+                  BTOR_AIGRW_DEC_XOR,
+                  g,
+                  h ^ c,
+                  0,
+                  0);
+  }
+
+  for (i = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+  {
+    if (!(supp & (1u << i))) continue;
+    g = tt_cofactor1 (f, i);
+    h = tt_cofactor0 (f, i);
+    update_dec (dec,
+                &best,
+                get_cost (lib, g) + get_cost (lib, h) + 3,
+                BTOR_AIGRW_DEC_MUX,
+                g,
+                h,
+                i,
+                0);
+  }
+
+  return best > BTOR_AIGRW_MAX_COST ? BTOR_AIGRW_MAX_COST : best;
+}
+
+static uint32_t
+get_cost (BtorAIGRWLib *lib, uint32_t f)
+{
+  BtorAIGRWDec dec;
+  uint32_t supp;
+
+  if (lib->cost[f] == BTOR_AIGRW_UNKNOWN_COST)
+  {
+    supp = tt_support (f);
+    /* constants and literals do not need any gates */
+    lib->cost[f] = (supp & (supp - 1)) ? decompose (lib, f, &dec) : 0;
+  }
+  return lib->cost[f];
+}
+
+static int32_t
+synth_gate (BtorIntStack *gates, int32_t a, int32_t b)
+{
+  int32_t tmp;
+  size_t i;
+
+  if (a > b)
+  {
+    tmp = a;
+    a   = b;
+    b   = tmp;
+  }
+  if (a == 0) return 0;
+  if (a == 1 || a == b) return b;
+  if ((a ^ 1) == b) return 0;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*gates); i += 2)
+    if (BTOR_PEEK_STACK (*gates, i) == a
+        && BTOR_PEEK_STACK (*gates, i + 1) == b)
+      return 2 * (BTOR_AIGRW_FIRST_GATE + i / 2);
+
+  BTOR_PUSH_STACK (*gates, a);
+  BTOR_PUSH_STACK (*gates, b);
+  return 2 * (BTOR_AIGRW_FIRST_GATE + BTOR_COUNT_STACK (*gates) / 2 - 1);
+}
+
+static int32_t
+synth (BtorAIGRWLib *lib, uint32_t f, BtorIntStack *gates)
+{
+  BtorAIGRWDec dec;
+  uint32_t supp, i;
+  int32_t a, b, s, t0, t1, res;
+
+  supp = tt_support (f);
+  if (!supp) return f ? 1 : 0;
+  if (!(supp & (supp - 1)))
+  {
+    for (i = 0; !(supp & (1u << i)); i++)
+      ;
+    res = 2 * (i + 1);
+    return f == btor_aigrw_var_tt[i] ? res : res ^ 1;
+  }
+
+  (void) decompose (lib, f, &dec);
+  a = synth (lib, dec.g, gates);
+  b = synth (lib, dec.h, gates);
+  switch (dec.kind)
+  {
+    case BTOR_AIGRW_DEC_AND: res = synth_gate (gates, a, b); break;
+    case BTOR_AIGRW_DEC_XOR:
+      t0  = synth_gate (gates, a, b ^ 1);
+      t1  = synth_gate (gates, a ^ 1, b);
+      res = synth_gate (gates, t0 ^ 1, t1 ^ 1) ^ 1;
+      break;
+    default:
+      assert (dec.kind == BTOR_AIGRW_DEC_MUX);
+      s   = 2 * (dec.var + 1);
+      t0  = synth_gate (gates, s, a);
+      t1  = synth_gate (gates, s ^ 1, b);
+      res = synth_gate (gates, t0 ^ 1, t1 ^ 1) ^ 1;
+  }
+  return res ^ dec.neg;
+}
+
+static uint32_t
+get_program (BtorAIGRWLib *lib, uint32_t tt)
+{
+  BtorHashTableData *d;
+  BtorIntStack gates;
+  int32_t out;
+  uint32_t res;
+  size_t i;
+
+  if ((d = btor_hashint_map_get (lib->classes, tt + 1))) return d->as_int;
+
+  BTOR_INIT_STACK (lib->mm, gates);
+  out = synth (lib, tt, &gates);
+  res = BTOR_COUNT_STACK (lib->programs);
+  BTOR_PUSH_STACK (lib->programs, BTOR_COUNT_STACK (gates) / 2);
+  BTOR_PUSH_STACK (lib->programs, out);
+  for (i = 0; i < BTOR_COUNT_STACK (gates); i++)
+    BTOR_PUSH_STACK (lib->programs, BTOR_PEEK_STACK (gates, i));
+  BTOR_RELEASE_STACK (gates);
+
+  btor_hashint_map_add (lib->classes, tt + 1)->as_int = res;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+get_pos (BtorAIGRW *rw, int32_t id)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (rw->pos, id);
+  return d ? d->as_int : -1;
+}
+
+/* Collect all AND nodes without CNF id reachable from 'aigs' in topological
+ * order (children first). */
+static void
+collect_cone (BtorAIGRW *rw, BtorAIG **aigs, uint32_t n)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack visit;
+  BtorAIGRWNode node;
+  BtorHashTableData *d;
+  BtorAIG *cur;
+  uint32_t i, j;
+  int32_t p;
+
+  amgr = rw->amgr;
+  BTOR_INIT_STACK (amgr->btor->mm, visit);
+  for (i = 0; i < n; i++) BTOR_PUSH_STACK (visit, aigs[i]);
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (visit));
+    if (!btor_aig_is_unencoded_and (cur)) continue;
+
+    d = btor_hashint_map_get (rw->pos, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (rw->pos, cur->id)->as_int = -1;
+      BTOR_PUSH_STACK (visit, cur);
+      BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, cur));
+    }
+    else if (d->as_int == -1)
+    {
+      d->as_int = BTOR_COUNT_STACK (rw->nodes);
+      memset (&node, 0, sizeof (node));
+      node.aig      = cur;
+      node.child[0] =
+          get_pos (rw, abs (btor_aig_get_left_child_id (amgr, cur)));
+      node.child[1] =
+          get_pos (rw, abs (btor_aig_get_right_child_id (amgr, cur)));
+      for (j = 0; j < 2; j++)
+        if (node.child[j] >= 0) rw->nodes.start[node.child[j]].refs++;
+      BTOR_PUSH_STACK (rw->nodes, node);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  for (i = 0; i < n; i++)
+  {
+    if (!btor_aig_is_unencoded_and (aigs[i])) continue;
+    p = get_pos (rw, BTOR_REAL_ADDR_AIG (aigs[i])->id);
+    assert (p >= 0);
+    rw->nodes.start[p].refs++;
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (rw->nodes); i++)
+    rw->nodes.start[i].owned =
+        rw->nodes.start[i].aig->refs == rw->nodes.start[i].refs;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+merge_cuts (BtorAIGRWCut *c0, BtorAIGRWCut *c1, BtorAIGRWCut *res)
+{
+  uint32_t i, j, k;
+
+  i = j = k = 0;
+  while (i < c0->size || j < c1->size)
+  {
+    if (k == BTOR_AIGRW_CUT_SIZE) return false;
+    if (j == c1->size || (i < c0->size && c0->leaves[i] < c1->leaves[j]))
+      res->leaves[k++] = c0->leaves[i++];
+    else if (i == c0->size || c1->leaves[j] < c0->leaves[i])
+      res->leaves[k++] = c1->leaves[j++];
+    else
+    {
+      res->leaves[k++] = c0->leaves[i++];
+      j++;
+    }
+  }
+  res->size = k;
+  return true;
+}
+
+static bool
+is_subset_cut (BtorAIGRWCut *c0, BtorAIGRWCut *c1)
+{
+  uint32_t i, j;
+
+  for (i = 0, j = 0; i < c0->size; i++, j++)
+  {
+    while (j < c1->size && c1->leaves[j] < c0->leaves[i]) j++;
+    if (j == c1->size || c1->leaves[j] != c0->leaves[i]) return false;
+  }
+  return true;
+}
+
+static bool
+is_leaf_cut (BtorAIGRWCut *cut, int32_t id)
+{
+  uint32_t i;
+  for (i = 0; i < cut->size; i++)
+    if (cut->leaves[i] == id) return true;
+  return false;
+}
+
+/* Expand truth table of 'cut' to the leaves of 'merged'. */
+static uint32_t
+expand_tt (BtorAIGRWCut *cut, BtorAIGRWCut *merged)
+{
+  uint32_t i, j, x, y, res, map[BTOR_AIGRW_CUT_SIZE];
+
+  for (i = 0, j = 0; i < cut->size; i++, j++)
+  {
+    while (merged->leaves[j] != cut->leaves[i]) j++;
+    map[i] = j;
+  }
+  for (x = 0, res = 0; x < (1u << BTOR_AIGRW_CUT_SIZE); x++)
+  {
+    for (i = 0, y = 0; i < cut->size; i++) y |= ((x >> map[i]) & 1) << i;
+    if ((cut->tt >> y) & 1) res |= 1u << x;
+  }
+  return res;
+}
+
+static void
+compute_cuts (BtorAIGRW *rw, uint32_t p)
+{
+  BtorAIGRWNode *node;
+  BtorAIGRWCut cut, c0, c1, tmp[2];
+  BtorAIG *child[2];
+  uint32_t j, first[2], num[2], i0, i1, k, first_cut;
+
+  node     = &rw->nodes.start[p];
+  child[0] = btor_aig_get_left_child (rw->amgr, node->aig);
+  child[1] = btor_aig_get_right_child (rw->amgr, node->aig);
+
+  for (j = 0; j < 2; j++)
+  {
+    if (node->child[j] >= 0)
+    {
+      first[j] = rw->nodes.start[node->child[j]].first_cut;
+      num[j]   = rw->nodes.start[node->child[j]].num_cuts;
+    }
+    else
+    {
+      /* leaves of the cone only have the trivial cut */
+      tmp[j].leaves[0] = BTOR_REAL_ADDR_AIG (child[j])->id;
+      tmp[j].size      = 1;
+      tmp[j].tt        = btor_aigrw_var_tt[0];
+      num[j]           = 1;
+    }
+  }
+
+  BTOR_CLR (&cut);
+  first_cut     = BTOR_COUNT_STACK (rw->cuts);
+  cut.leaves[0] = node->aig->id;
+  cut.size      = 1;
+  cut.tt        = btor_aigrw_var_tt[0];
+  BTOR_PUSH_STACK (rw->cuts, cut);
+
+  for (i0 = 0; i0 < num[0]; i0++)
+  {
+    c0 = node->child[0] >= 0 ? BTOR_PEEK_STACK (rw->cuts, first[0] + i0)
+                             : tmp[0];
+    for (i1 = 0; i1 < num[1]; i1++)
+    {
+      if (BTOR_COUNT_STACK (rw->cuts) - first_cut > BTOR_AIGRW_MAX_CUTS)
+        goto DONE;
+      c1 = node->child[1] >= 0 ? BTOR_PEEK_STACK (rw->cuts, first[1] + i1)
+                               : tmp[1];
+      if (!merge_cuts (&c0, &c1, &cut)) continue;
+      for (k = first_cut + 1; k < BTOR_COUNT_STACK (rw->cuts); k++)
+        if (is_subset_cut (&rw->cuts.start[k], &cut)) break;
+      if (k < BTOR_COUNT_STACK (rw->cuts)) continue;
+      cut.tt = expand_tt (&c0, &cut);
+      if (BTOR_IS_INVERTED_AIG (child[0])) cut.tt ^= 0xffff;
+      if (BTOR_IS_INVERTED_AIG (child[1]))
+        cut.tt &= expand_tt (&c1, &cut) ^ 0xffff;
+      else
+        cut.tt &= expand_tt (&c1, &cut);
+      BTOR_PUSH_STACK (rw->cuts, cut);
+    }
+  }
+DONE:
+  node->first_cut = first_cut;
+  node->num_cuts  = BTOR_COUNT_STACK (rw->cuts) - first_cut;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Mark the maximum fanout free cone of node 'p' bounded by the leaves of
+ * 'cut' and return its size. */
+static uint32_t
+mark_mffc (BtorAIGRW *rw, uint32_t p, BtorAIGRWCut *cut)
+{
+  BtorAIGRWNode *nodes;
+  uint32_t i, j, q, res;
+  int32_t c;
+
+  nodes = rw->nodes.start;
+  rw->mark++;
+  BTOR_RESET_STACK (rw->mffc);
+  BTOR_PUSH_STACK (rw->mffc, p);
+  nodes[p].mark = rw->mark;
+
+  for (i = 0; i < BTOR_COUNT_STACK (rw->mffc); i++)
+  {
+    q = BTOR_PEEK_STACK (rw->mffc, i);
+    for (j = 0; j < 2; j++)
+    {
+      c = nodes[q].child[j];
+      if (c < 0 || is_leaf_cut (cut, nodes[c].aig->id)) continue;
+      assert (nodes[c].refs > 0);
+      nodes[c].refs--;
+      if (!nodes[c].refs && nodes[c].owned)
+      {
+        nodes[c].mark = rw->mark;
+        BTOR_PUSH_STACK (rw->mffc, c);
+      }
+    }
+  }
+  res = BTOR_COUNT_STACK (rw->mffc);
+
+  for (i = 0; i < BTOR_COUNT_STACK (rw->mffc); i++)
+  {
+    q = BTOR_PEEK_STACK (rw->mffc, i);
+    for (j = 0; j < 2; j++)
+    {
+      c = nodes[q].child[j];
+      if (c < 0 || is_leaf_cut (cut, nodes[c].aig->id)) continue;
+      nodes[c].refs++;
+    }
+  }
+  return res;
+}
+
+static BtorAIG *
+get_leaf_result (BtorAIGRW *rw, int32_t id)
+{
+  int32_t p;
+  p = get_pos (rw, id);
+  return p >= 0 ? rw->nodes.start[p].res : btor_aig_get_by_id (rw->amgr, id);
+}
+
+static BtorAIG *
+get_child_result (BtorAIGRW *rw, uint32_t p, uint32_t j)
+{
+  BtorAIGRWNode *node;
+  BtorAIG *child, *res;
+
+  node  = &rw->nodes.start[p];
+  child = j ? btor_aig_get_right_child (rw->amgr, node->aig)
+            : btor_aig_get_left_child (rw->amgr, node->aig);
+  if (node->child[j] < 0) return child;
+  res = rw->nodes.start[node->child[j]].res;
+  return BTOR_IS_INVERTED_AIG (child) ? BTOR_INVERT_AIG (res) : res;
+}
+
+static BtorAIG *
+lit2aig (BtorAIGRW *rw, int32_t lit)
+{
+  BtorAIG *res;
+  res = BTOR_PEEK_STACK (rw->gates, lit >> 1);
+  return (lit & 1) ? BTOR_INVERT_AIG (res) : res;
+}
+
+/* Instantiate the structure of the NPN class of 'cut' and determine the
+ * number of ANDs that would have to be added if node 'p' was replaced by it,
+ * i.e., ANDs that are new or in the (marked) MFFC of 'p'. */
+static BtorAIG *
+build_structure (BtorAIGRW *rw,
+                 BtorAIGRWCut *cut,
+                 int32_t watermark,
+                 uint32_t *cost)
+{
+  BtorAIGRWLib *lib;
+  BtorAIGMgr *amgr;
+  BtorAIG *aig, *real_aig, *res;
+  uint32_t npn, perm, phase, i, leaf, prog, num_gates;
+  int32_t p;
+
+  amgr      = rw->amgr;
+  lib       = rw->lib;
+  npn       = get_npn (lib, cut->tt);
+  perm      = (npn >> 16) & 0x1f;
+  phase     = (npn >> 21) & 0xf;
+  prog      = get_program (lib, npn & 0xffff);
+  num_gates = BTOR_PEEK_STACK (lib->programs, prog);
+
+  BTOR_RESET_STACK (rw->gates);
+  BTOR_PUSH_STACK (rw->gates, BTOR_AIG_FALSE);
+  for (i = 0; i < BTOR_AIGRW_CUT_SIZE; i++)
+  {
+    leaf = lib->perms[perm][i];
+    /* the class does not depend on inputs mapped to unused positions */
+    aig = leaf < cut->size ? get_leaf_result (rw, cut->leaves[leaf])
+                           : BTOR_AIG_FALSE;
+    if ((phase >> i) & 1) aig = BTOR_INVERT_AIG (aig);
+    BTOR_PUSH_STACK (rw->gates, aig);
+  }
+
+  *cost = 0;
+  for (i = 0; i < num_gates; i++)
+  {
+    aig = btor_aig_and (
+        amgr,
+        lit2aig (rw, BTOR_PEEK_STACK (lib->programs, prog + 2 + 2 * i)),
+        lit2aig (rw, BTOR_PEEK_STACK (lib->programs, prog + 3 + 2 * i)));
+    BTOR_PUSH_STACK (rw->gates, aig);
+    real_aig = BTOR_REAL_ADDR_AIG (aig);
+    if (!btor_aig_is_unencoded_and (real_aig)) continue;
+    if (real_aig->id >= watermark) *cost += 1;
+    else if ((p = get_pos (rw, real_aig->id)) >= 0
+             && rw->nodes.start[p].mark == rw->mark)
+      *cost += 1;
+  }
+
+  res = btor_aig_copy (
+      amgr, lit2aig (rw, BTOR_PEEK_STACK (lib->programs, prog + 1)));
+  if (npn & (1u << 25)) res = BTOR_INVERT_AIG (res);
+
+  for (i = 0; i < num_gates; i++)
+    btor_aig_release (
+        amgr, BTOR_PEEK_STACK (rw->gates, BTOR_AIGRW_FIRST_GATE + i));
+  return res;
+}
+
+static void
+rewrite_node (BtorAIGRW *rw, uint32_t p)
+{
+  BtorAIGRWCut cut;
+  BtorAIG *res, *cand;
+  uint32_t i, first_cut, num_cuts, mffc, cost;
+  int32_t watermark, gain, best_gain;
+  bool found;
+
+  res       = 0;
+  found     = false;
+  best_gain = 0;
+  watermark = BTOR_COUNT_STACK (rw->amgr->id2aig);
+  first_cut = rw->nodes.start[p].first_cut;
+  num_cuts  = rw->nodes.start[p].num_cuts;
+
+  /* replacing a node that is referenced from outside the cone does not
+   * remove it */
+  if (rw->nodes.start[p].owned)
+  {
+    /* skip the trivial cut */
+    for (i = 1; i < num_cuts; i++)
+    {
+      cut  = BTOR_PEEK_STACK (rw->cuts, first_cut + i);
+      mffc = mark_mffc (rw, p, &cut);
+      cand = build_structure (rw, &cut, watermark, &cost);
+      gain = (int32_t) mffc - (int32_t) cost;
+      if (gain > best_gain)
+      {
+        if (found) btor_aig_release (rw->amgr, res);
+        res       = cand;
+        best_gain = gain;
+        found     = true;
+      }
+      else
+        btor_aig_release (rw->amgr, cand);
+    }
+  }
+
+  if (!found)
+    res = btor_aig_and (
+        rw->amgr, get_child_result (rw, p, 0), get_child_result (rw, p, 1));
+  rw->nodes.start[p].res = res;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_aigrw_rewrite (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n)
+{
+  assert (amgr);
+  assert (aigs);
+
+  BtorAIGRW rw;
+  BtorMemMgr *mm;
+  BtorAIGPtrStack roots;
+  BtorAIG *aig, *res;
+  uint32_t i, num_old, num_new;
+  int32_t p;
+
+  mm = amgr->btor->mm;
+  if (!amgr->rwlib) amgr->rwlib = new_lib (mm);
+
+  memset (&rw, 0, sizeof (rw));
+  rw.amgr = amgr;
+  rw.lib  = amgr->rwlib;
+  rw.pos  = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, rw.nodes);
+  BTOR_INIT_STACK (mm, rw.cuts);
+  BTOR_INIT_STACK (mm, rw.mffc);
+  BTOR_INIT_STACK (mm, rw.gates);
+  BTOR_INIT_STACK (mm, roots);
+
+  collect_cone (&rw, aigs, n);
+  num_old = BTOR_COUNT_STACK (rw.nodes);
+
+  if (num_old > 0)
+  {
+    for (i = 0; i < num_old; i++) compute_cuts (&rw, i);
+    for (i = 0; i < num_old; i++) rewrite_node (&rw, i);
+
+    for (i = 0; i < n; i++)
+    {
+      aig = aigs[i];
+      if (btor_aig_is_unencoded_and (aig))
+      {
+        p   = get_pos (&rw, BTOR_REAL_ADDR_AIG (aig)->id);
+        res = rw.nodes.start[p].res;
+        aig = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
+      }
+      BTOR_PUSH_STACK (roots, aig);
+    }
+
+    /* only keep the result if it is actually smaller */
+    num_new = btor_aig_count_unencoded_cone (amgr, &roots);
+    if (num_new < num_old)
+    {
+      for (i = 0; i < n; i++)
+      {
+        aig = btor_aig_copy (amgr, BTOR_PEEK_STACK (roots, i));
+        btor_aig_release (amgr, aigs[i]);
+        aigs[i] = aig;
+      }
+      amgr->num_rw_saved_ands += num_old - num_new;
+    }
+
+    for (i = 0; i < num_old; i++)
+      btor_aig_release (amgr, rw.nodes.start[i].res);
+  }
+
+  BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (rw.gates);
+  BTOR_RELEASE_STACK (rw.mffc);
+  BTOR_RELEASE_STACK (rw.cuts);
+  BTOR_RELEASE_STACK (rw.nodes);
+  btor_hashint_map_delete (rw.pos);
+}
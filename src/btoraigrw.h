@@ -0,0 +1,32 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGRW_H_INCLUDED
+#define BTORAIGRW_H_INCLUDED
+
+#include "btoraig.h"
+
+#include <stdint.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Cut based AIG rewriting: every AND node in the cone of the given AIGs is
+ * resynthesized from its 4-input cuts, using the structure computed for the
+ * NPN class of the cut function, if this reduces the number of ANDs.
+ * AIG variables and AIGs that already have a CNF id are not rewritten.
+ *
+ * The AIGs 'aigs[0], ..., aigs[n - 1]' are replaced in place by equivalent
+ * AIGs (their old references are released) if the rewritten cone contains
+ * fewer ANDs than the original one.
+ */
+void btor_aigrw_rewrite (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t n);
+
+/* Deletes the NPN structure library of 'amgr' (if it was created). */
+void btor_aigrw_delete_lib (BtorAIGMgr *amgr);
+
+#endif
@@ -0,0 +1,187 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigsim.h"
+
+#include "btorcore.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_input (BtorAIG *aig, bool encoded_inputs)
+{
+  return btor_aig_is_var (aig) || (encoded_inputs && aig->cnf_id);
+}
+
+static void
+push_node (BtorAIGSim *sim, BtorAIG *aig, bool encoded_inputs)
+{
+  int32_t id, p;
+  uint32_t j;
+
+  if (is_input (aig, encoded_inputs))
+  {
+    BTOR_PUSH_STACK (sim->children, -1);
+    BTOR_PUSH_STACK (sim->children, -1);
+  }
+  else
+  {
+    for (j = 0; j < 2; j++)
+    {
+      id = j ? btor_aig_get_right_child_id (sim->amgr, aig)
+             : btor_aig_get_left_child_id (sim->amgr, aig);
+      p  = btor_aigsim_get_pos (sim, abs (id));
+      assert (p >= 0);
+      BTOR_PUSH_STACK (sim->children, 2 * p + (id < 0));
+    }
+  }
+  btor_hashint_map_get (sim->pos, aig->id)->as_int =
+      BTOR_COUNT_STACK (sim->aigs);
+  BTOR_PUSH_STACK (sim->aigs, aig);
+}
+
+BtorAIGSim *
+btor_aigsim_new (BtorAIGMgr *amgr,
+                 BtorAIG **aigs,
+                 uint32_t n,
+                 uint32_t num_words,
+                 bool encoded_inputs)
+{
+  assert (amgr);
+  assert (aigs || n == 0);
+  assert (num_words > 0);
+
+  BtorAIGSim *sim;
+  BtorMemMgr *mm;
+  BtorAIGPtrStack visit;
+  BtorHashTableData *d;
+  BtorAIG *cur;
+  uint32_t i;
+
+  mm = amgr->btor->mm;
+  BTOR_CNEW (mm, sim);
+  sim->amgr      = amgr;
+  sim->num_words = num_words;
+  sim->pos       = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, sim->aigs);
+  BTOR_INIT_STACK (mm, sim->children);
+
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < n; i++)
+    if (!btor_aig_is_const (aigs[i])) BTOR_PUSH_STACK (visit, aigs[i]);
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (visit));
+    d   = btor_hashint_map_get (sim->pos, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (sim->pos, cur->id)->as_int = -1;
+      if (is_input (cur, encoded_inputs))
+      {
+        push_node (sim, cur, encoded_inputs);
+        continue;
+      }
+      BTOR_PUSH_STACK (visit, cur);
+      BTOR_PUSH_STACK (visit, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (visit, btor_aig_get_left_child (amgr, cur));
+    }
+    else if (d->as_int == -1)
+      push_node (sim, cur, encoded_inputs);
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  if (btor_aigsim_num_nodes (sim) > 0)
+    BTOR_CNEWN (
+        mm, sim->words, (size_t) btor_aigsim_num_nodes (sim) * num_words);
+  return sim;
+}
+
+void
+btor_aigsim_delete (BtorAIGSim *sim)
+{
+  assert (sim);
+
+  BtorMemMgr *mm;
+
+  mm = sim->amgr->btor->mm;
+  BTOR_DELETEN (
+      mm, sim->words, (size_t) btor_aigsim_num_nodes (sim) * sim->num_words);
+  BTOR_RELEASE_STACK (sim->children);
+  BTOR_RELEASE_STACK (sim->aigs);
+  btor_hashint_map_delete (sim->pos);
+  BTOR_DELETE (mm, sim);
+}
+
+int32_t
+btor_aigsim_get_pos (BtorAIGSim *sim, int32_t id)
+{
+  assert (sim);
+  assert (id > 0);
+
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (sim->pos, id);
+  return d ? d->as_int : -1;
+}
+
+void
+btor_aigsim_randomize (BtorAIGSim *sim, BtorRNG *rng, uint32_t w)
+{
+  assert (sim);
+  assert (rng);
+  assert (w < sim->num_words);
+
+  uint32_t i, n;
+
+  n = btor_aigsim_num_nodes (sim);
+  for (i = 0; i < n; i++)
+  {
+    if (!btor_aigsim_is_input (sim, i)) continue;
+    btor_aigsim_get_words (sim, i)[w] =
+        ((uint64_t) btor_rng_rand (rng) << 32) | btor_rng_rand (rng);
+  }
+}
+
+void
+btor_aigsim_simulate (BtorAIGSim *sim, uint32_t from, uint32_t to)
+{
+  assert (sim);
+  assert (from <= to);
+  assert (to <= sim->num_words);
+
+  const uint64_t *a, *b;
+  uint64_t *res, ma, mb;
+  int32_t *children;
+  uint32_t i, n, w;
+  double start;
+
+  start    = btor_util_time_stamp ();
+  n        = btor_aigsim_num_nodes (sim);
+  children = sim->children.start;
+  for (i = 0; i < n; i++)
+  {
+    if (children[2 * i] < 0) continue;
+    /* children precede their parents, no aliasing with 'res' */
+    assert ((uint32_t) children[2 * i] / 2 < i);
+    assert ((uint32_t) children[2 * i + 1] / 2 < i);
+    a   = btor_aigsim_get_words (sim, children[2 * i] / 2);
+    b   = btor_aigsim_get_words (sim, children[2 * i + 1] / 2);
+    ma  = children[2 * i] & 1 ? ~(uint64_t) 0 : 0;
+    mb  = children[2 * i + 1] & 1 ? ~(uint64_t) 0 : 0;
+    res = btor_aigsim_get_words (sim, i);
+    for (w = from; w < to; w++) res[w] = (a[w] ^ ma) & (b[w] ^ mb);
+  }
+  sim->amgr->num_sim_patterns += 64 * (uint_least64_t) (to - from);
+  sim->amgr->time_sim += btor_util_time_stamp () - start;
+}
@@ -0,0 +1,82 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGSIM_H_INCLUDED
+#define BTORAIGSIM_H_INCLUDED
+
+#include "btoraig.h"
+#include "utils/btorhashint.h"
+#include "utils/btorrng.h"
+
+#include <stdint.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Bit-parallel simulation of the cone of a set of AIGs.
+ *
+ * The nodes of the cone are stored in topological order (children first)
+ * and are addressed by their position. Each node holds 'num_words' 64-bit
+ * simulation words, i.e., 64 * 'num_words' input patterns are evaluated at
+ * once. Input nodes are AIG variables and, if requested, ANDs with a CNF
+ * id (their cones are not simulated).
+ */
+struct BtorAIGSim
+{
+  BtorAIGMgr *amgr;
+  BtorIntHashTable *pos;  /* AIG id -> position */
+  BtorAIGPtrStack aigs;   /* regular AIG per position */
+  BtorIntStack children;  /* 2 per position: 2 * position + inverted,
+                             -1 for input nodes */
+  uint32_t num_words;     /* simulation words per node */
+  uint64_t *words;
+};
+
+typedef struct BtorAIGSim BtorAIGSim;
+
+/* Create simulator for the cone of 'aigs[0], ..., aigs[n - 1]' with
+ * 'num_words' simulation words per node (initialized to 0).
+ * If 'encoded_inputs' is true, ANDs with a CNF id are input nodes. */
+BtorAIGSim *btor_aigsim_new (BtorAIGMgr *amgr,
+                             BtorAIG **aigs,
+                             uint32_t n,
+                             uint32_t num_words,
+                             bool encoded_inputs);
+
+void btor_aigsim_delete (BtorAIGSim *sim);
+
+/* Assign random values to word 'w' of all input nodes. */
+void btor_aigsim_randomize (BtorAIGSim *sim, BtorRNG *rng, uint32_t w);
+
+/* Evaluate words 'from, ..., to - 1' of all AND nodes from the values of
+ * the input nodes. */
+void btor_aigsim_simulate (BtorAIGSim *sim, uint32_t from, uint32_t to);
+
+/* Returns the position of the AIG with given (positive) id, or -1 if it is
+ * not in the cone. */
+int32_t btor_aigsim_get_pos (BtorAIGSim *sim, int32_t id);
+
+static inline uint32_t
+btor_aigsim_num_nodes (const BtorAIGSim *sim)
+{
+  return BTOR_COUNT_STACK (sim->aigs);
+}
+
+static inline bool
+btor_aigsim_is_input (const BtorAIGSim *sim, uint32_t p)
+{
+  return BTOR_PEEK_STACK (sim->children, 2 * p) < 0;
+}
+
+/* Returns the simulation words of the node at position 'p'. */
+static inline uint64_t *
+btor_aigsim_get_words (const BtorAIGSim *sim, uint32_t p)
+{
+  return sim->words + (size_t) p * sim->num_words;
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "btoraig.h"
 #include "btoraigvec.h"
 #include "btorcore.h"
+#include "utils/btorhashint.h"
 #include "utils/btorutil.h"
 
 #include <limits.h>
@@ -28,14 +29,18 @@ struct BtorBitVector
 #else
   uint32_t len;   /* length of 'bits' array */
 
-  /* 'bits' represents the bit vector in 32-bit chunks, first bit of 32-bit bv
+  /* 'bits' represents the bit vector in 64-bit limbs, first bit of 64-bit bv
    * in bits[0] is MSB, bit vector is 'filled' from LSB, hence spare bits (if
    * any) come in front of the MSB and are zeroed out.
-   * E.g., for a bit vector of width 31, representing value 1:
+   * E.g., for a bit vector of width 63, representing value 1:
    *
    *    bits[0] = 0 0000....1
    *              ^ ^--- MSB
    *              |--- spare bit
+   *
+   * The limbs are allocated together with the header, bit vectors of
+   * bit-width <= 64 thus consist of a single limb and are handled by
+   * the 'uint64_t' fast paths of the arithmetic operations.
    * */
   BTOR_BV_TYPE bits[];
 #endif
@@ -65,6 +70,524 @@ set_rem_bits_to_zero (BtorBitVector *bv)
   if (bv->width != BTOR_BV_TYPE_BW * bv->len)
     bv->bits[0] &= BTOR_MASK_REM_BITS (bv);
 }
+
+/* Random values and hash values are computed on 32-bit words (word 0 is the
+ * least significant word) in order to not depend on the limb size. */
+
+static uint32_t
+get_num_words (const BtorBitVector *bv)
+{
+  return (bv->width + 31) / 32;
+}
+
+static uint32_t
+get_word (const BtorBitVector *bv, uint32_t pos)
+{
+  assert (pos < get_num_words (bv));
+  return (uint32_t) (bv->bits[bv->len - 1 - pos / 2] >> (32 * (pos % 2)));
+}
+
+static void
+set_word (BtorBitVector *bv, uint32_t pos, uint32_t word)
+{
+  assert (pos < get_num_words (bv));
+
+  BTOR_BV_TYPE *limb = &bv->bits[bv->len - 1 - pos / 2];
+  uint32_t shift     = 32 * (pos % 2);
+
+  *limb &= ~((BTOR_BV_TYPE) UINT32_MAX << shift);
+  *limb |= (BTOR_BV_TYPE) word << shift;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Bulk operations on the limbs of bit-vectors wider than
+ * BTOR_BV_SIMD_MIN_LEN limbs.  On x86, AVX2 and SSE4.2 implementations are
+ * selected at runtime (via CPUID) with a portable scalar fallback. */
+
+#define BTOR_BV_SIMD_MIN_LEN 4
+
+struct BtorBvLimbOps
+{
+  void (*and_limbs) (BTOR_BV_TYPE *r,
+                     const BTOR_BV_TYPE *a,
+                     const BTOR_BV_TYPE *b,
+                     uint32_t n);
+  void (*or_limbs) (BTOR_BV_TYPE *r,
+                    const BTOR_BV_TYPE *a,
+                    const BTOR_BV_TYPE *b,
+                    uint32_t n);
+  void (*xor_limbs) (BTOR_BV_TYPE *r,
+                     const BTOR_BV_TYPE *a,
+                     const BTOR_BV_TYPE *b,
+                     uint32_t n);
+  void (*not_limbs) (BTOR_BV_TYPE *r, const BTOR_BV_TYPE *a, uint32_t n);
+  /* true if all limbs are zero (resp. ones) */
+  bool (*is_zero_limbs) (const BTOR_BV_TYPE *a, uint32_t n);
+  bool (*is_ones_limbs) (const BTOR_BV_TYPE *a, uint32_t n);
+  /* index of the first limb in which 'a' and 'b' differ, 'n' if none */
+  uint32_t (*find_diff_limb) (const BTOR_BV_TYPE *a,
+                              const BTOR_BV_TYPE *b,
+                              uint32_t n);
+  /* index of the first (resp. last) non-zero limb, 'n' if none */
+  uint32_t (*find_nonzero_limb) (const BTOR_BV_TYPE *a, uint32_t n);
+  uint32_t (*rfind_nonzero_limb) (const BTOR_BV_TYPE *a, uint32_t n);
+  /* number of bits in which 'a' and 'b' differ */
+  uint32_t (*hamming_limbs) (const BTOR_BV_TYPE *a,
+                             const BTOR_BV_TYPE *b,
+                             uint32_t n);
+};
+
+typedef struct BtorBvLimbOps BtorBvLimbOps;
+
+static uint32_t
+popcount_limb (BTOR_BV_TYPE limb)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll (limb);
+#else
+  uint32_t res;
+  for (res = 0; limb; limb &= limb - 1) res++;
+  return res;
+#endif
+}
+
+static void
+and_limbs_scalar (BTOR_BV_TYPE *r,
+                  const BTOR_BV_TYPE *a,
+                  const BTOR_BV_TYPE *b,
+                  uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) r[i] = a[i] & b[i];
+}
+
+static void
+or_limbs_scalar (BTOR_BV_TYPE *r,
+                 const BTOR_BV_TYPE *a,
+                 const BTOR_BV_TYPE *b,
+                 uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) r[i] = a[i] | b[i];
+}
+
+static void
+xor_limbs_scalar (BTOR_BV_TYPE *r,
+                  const BTOR_BV_TYPE *a,
+                  const BTOR_BV_TYPE *b,
+                  uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) r[i] = a[i] ^ b[i];
+}
+
+static void
+not_limbs_scalar (BTOR_BV_TYPE *r, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++) r[i] = ~a[i];
+}
+
+static bool
+is_zero_limbs_scalar (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++)
+    if (a[i] != 0) return false;
+  return true;
+}
+
+static bool
+is_ones_limbs_scalar (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n; i++)
+    if (a[i] != ~(BTOR_BV_TYPE) 0) return false;
+  return true;
+}
+
+static uint32_t
+find_diff_limb_scalar (const BTOR_BV_TYPE *a,
+                       const BTOR_BV_TYPE *b,
+                       uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n && a[i] == b[i]; i++)
+    ;
+  return i;
+}
+
+static uint32_t
+find_nonzero_limb_scalar (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i < n && a[i] == 0; i++)
+    ;
+  return i;
+}
+
+static uint32_t
+rfind_nonzero_limb_scalar (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  for (i = n; i > 0; i--)
+    if (a[i - 1] != 0) return i - 1;
+  return n;
+}
+
+static uint32_t
+hamming_limbs_scalar (const BTOR_BV_TYPE *a,
+                      const BTOR_BV_TYPE *b,
+                      uint32_t n)
+{
+  uint32_t i, res;
+  for (i = 0, res = 0; i < n; i++) res += popcount_limb (a[i] ^ b[i]);
+  return res;
+}
+
+static const BtorBvLimbOps limb_ops_scalar = {
+    and_limbs_scalar,
+    or_limbs_scalar,
+    xor_limbs_scalar,
+    not_limbs_scalar,
+    is_zero_limbs_scalar,
+    is_ones_limbs_scalar,
+    find_diff_limb_scalar,
+    find_nonzero_limb_scalar,
+    rfind_nonzero_limb_scalar,
+    hamming_limbs_scalar,
+};
+
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define BTOR_BV_USE_SIMD
+
+#include <immintrin.h>
+
+/* AVX2 and SSE4.2 process 4 (resp. 2) limbs per step, the remaining limbs
+ * are handled by the scalar implementations.  Neither provides a vector
+ * population count, the Hamming distance is computed with the scalar
+ * 'popcnt' instruction instead. */
+
+#define BTOR_BV_AVX2 __attribute__ ((target ("avx2")))
+#define BTOR_BV_SSE42 __attribute__ ((target ("sse4.2")))
+
+#define BTOR_BV_LOAD256(p) _mm256_loadu_si256 ((const __m256i *) (p))
+#define BTOR_BV_STORE256(p, v) _mm256_storeu_si256 ((__m256i *) (p), (v))
+#define BTOR_BV_LOAD128(p) _mm_loadu_si128 ((const __m128i *) (p))
+#define BTOR_BV_STORE128(p, v) _mm_storeu_si128 ((__m128i *) (p), (v))
+
+/* Bit mask with one bit per 64-bit lane, set if the lane of 'v' is ~0. */
+#define BTOR_BV_MASK256(v) \
+  ((uint32_t) _mm256_movemask_pd (_mm256_castsi256_pd (v)))
+#define BTOR_BV_MASK128(v) ((uint32_t) _mm_movemask_pd (_mm_castsi128_pd (v)))
+
+__attribute__ ((target ("popcnt"))) static uint32_t
+hamming_limbs_popcnt (const BTOR_BV_TYPE *a,
+                      const BTOR_BV_TYPE *b,
+                      uint32_t n)
+{
+  uint32_t i, res;
+  for (i = 0, res = 0; i < n; i++) res += __builtin_popcountll (a[i] ^ b[i]);
+  return res;
+}
+
+BTOR_BV_AVX2 static void
+and_limbs_avx2 (BTOR_BV_TYPE *r,
+                const BTOR_BV_TYPE *a,
+                const BTOR_BV_TYPE *b,
+                uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 4 <= n; i += 4)
+    BTOR_BV_STORE256 (r + i,
+                      _mm256_and_si256 (BTOR_BV_LOAD256 (a + i),
+                                        BTOR_BV_LOAD256 (b + i)));
+  and_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_AVX2 static void
+or_limbs_avx2 (BTOR_BV_TYPE *r,
+               const BTOR_BV_TYPE *a,
+               const BTOR_BV_TYPE *b,
+               uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 4 <= n; i += 4)
+    BTOR_BV_STORE256 (r + i,
+                      _mm256_or_si256 (BTOR_BV_LOAD256 (a + i),
+                                       BTOR_BV_LOAD256 (b + i)));
+  or_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_AVX2 static void
+xor_limbs_avx2 (BTOR_BV_TYPE *r,
+                const BTOR_BV_TYPE *a,
+                const BTOR_BV_TYPE *b,
+                uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 4 <= n; i += 4)
+    BTOR_BV_STORE256 (r + i,
+                      _mm256_xor_si256 (BTOR_BV_LOAD256 (a + i),
+                                        BTOR_BV_LOAD256 (b + i)));
+  xor_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_AVX2 static void
+not_limbs_avx2 (BTOR_BV_TYPE *r, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m256i ones = _mm256_set1_epi64x (-1);
+  for (i = 0; i + 4 <= n; i += 4)
+    BTOR_BV_STORE256 (r + i, _mm256_xor_si256 (BTOR_BV_LOAD256 (a + i), ones));
+  not_limbs_scalar (r + i, a + i, n - i);
+}
+
+BTOR_BV_AVX2 static bool
+is_zero_limbs_avx2 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m256i acc = _mm256_setzero_si256 ();
+  for (i = 0; i + 4 <= n; i += 4)
+    acc = _mm256_or_si256 (acc, BTOR_BV_LOAD256 (a + i));
+  return _mm256_testz_si256 (acc, acc) && is_zero_limbs_scalar (a + i, n - i);
+}
+
+BTOR_BV_AVX2 static bool
+is_ones_limbs_avx2 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m256i ones = _mm256_set1_epi64x (-1), acc = ones;
+  for (i = 0; i + 4 <= n; i += 4)
+    acc = _mm256_and_si256 (acc, BTOR_BV_LOAD256 (a + i));
+  return _mm256_testc_si256 (acc, ones) && is_ones_limbs_scalar (a + i, n - i);
+}
+
+BTOR_BV_AVX2 static uint32_t
+find_diff_limb_avx2 (const BTOR_BV_TYPE *a, const BTOR_BV_TYPE *b, uint32_t n)
+{
+  uint32_t i, m;
+  for (i = 0; i + 4 <= n; i += 4)
+  {
+    m = BTOR_BV_MASK256 (
+        _mm256_cmpeq_epi64 (BTOR_BV_LOAD256 (a + i), BTOR_BV_LOAD256 (b + i)));
+    if (m != 0xf) return i + __builtin_ctz (~m);
+  }
+  return i + find_diff_limb_scalar (a + i, b + i, n - i);
+}
+
+BTOR_BV_AVX2 static uint32_t
+find_nonzero_limb_avx2 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i, m;
+  __m256i zero = _mm256_setzero_si256 ();
+  for (i = 0; i + 4 <= n; i += 4)
+  {
+    m = BTOR_BV_MASK256 (_mm256_cmpeq_epi64 (BTOR_BV_LOAD256 (a + i), zero));
+    if (m != 0xf) return i + __builtin_ctz (~m);
+  }
+  return i + find_nonzero_limb_scalar (a + i, n - i);
+}
+
+BTOR_BV_AVX2 static uint32_t
+rfind_nonzero_limb_avx2 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i, m;
+  __m256i zero = _mm256_setzero_si256 ();
+  for (i = n; i >= 4; i -= 4)
+  {
+    m = BTOR_BV_MASK256 (
+        _mm256_cmpeq_epi64 (BTOR_BV_LOAD256 (a + i - 4), zero));
+    if (m != 0xf) return i - 4 + 31 - __builtin_clz (~m & 0xf);
+  }
+  m = rfind_nonzero_limb_scalar (a, i);
+  return m < i ? m : n;
+}
+
+static const BtorBvLimbOps limb_ops_avx2 = {
+    and_limbs_avx2,
+    or_limbs_avx2,
+    xor_limbs_avx2,
+    not_limbs_avx2,
+    is_zero_limbs_avx2,
+    is_ones_limbs_avx2,
+    find_diff_limb_avx2,
+    find_nonzero_limb_avx2,
+    rfind_nonzero_limb_avx2,
+    hamming_limbs_popcnt,
+};
+
+BTOR_BV_SSE42 static void
+and_limbs_sse42 (BTOR_BV_TYPE *r,
+                 const BTOR_BV_TYPE *a,
+                 const BTOR_BV_TYPE *b,
+                 uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 2 <= n; i += 2)
+    BTOR_BV_STORE128 (r + i,
+                      _mm_and_si128 (BTOR_BV_LOAD128 (a + i),
+                                     BTOR_BV_LOAD128 (b + i)));
+  and_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_SSE42 static void
+or_limbs_sse42 (BTOR_BV_TYPE *r,
+                const BTOR_BV_TYPE *a,
+                const BTOR_BV_TYPE *b,
+                uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 2 <= n; i += 2)
+    BTOR_BV_STORE128 (r + i,
+                      _mm_or_si128 (BTOR_BV_LOAD128 (a + i),
+                                    BTOR_BV_LOAD128 (b + i)));
+  or_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_SSE42 static void
+xor_limbs_sse42 (BTOR_BV_TYPE *r,
+                 const BTOR_BV_TYPE *a,
+                 const BTOR_BV_TYPE *b,
+                 uint32_t n)
+{
+  uint32_t i;
+  for (i = 0; i + 2 <= n; i += 2)
+    BTOR_BV_STORE128 (r + i,
+                      _mm_xor_si128 (BTOR_BV_LOAD128 (a + i),
+                                     BTOR_BV_LOAD128 (b + i)));
+  xor_limbs_scalar (r + i, a + i, b + i, n - i);
+}
+
+BTOR_BV_SSE42 static void
+not_limbs_sse42 (BTOR_BV_TYPE *r, const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m128i ones = _mm_set1_epi64x (-1);
+  for (i = 0; i + 2 <= n; i += 2)
+    BTOR_BV_STORE128 (r + i, _mm_xor_si128 (BTOR_BV_LOAD128 (a + i), ones));
+  not_limbs_scalar (r + i, a + i, n - i);
+}
+
+BTOR_BV_SSE42 static bool
+is_zero_limbs_sse42 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m128i acc = _mm_setzero_si128 ();
+  for (i = 0; i + 2 <= n; i += 2)
+    acc = _mm_or_si128 (acc, BTOR_BV_LOAD128 (a + i));
+  return _mm_testz_si128 (acc, acc) && is_zero_limbs_scalar (a + i, n - i);
+}
+
+BTOR_BV_SSE42 static bool
+is_ones_limbs_sse42 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i;
+  __m128i ones = _mm_set1_epi64x (-1), acc = ones;
+  for (i = 0; i + 2 <= n; i += 2)
+    acc = _mm_and_si128 (acc, BTOR_BV_LOAD128 (a + i));
+  return _mm_testc_si128 (acc, ones) && is_ones_limbs_scalar (a + i, n - i);
+}
+
+BTOR_BV_SSE42 static uint32_t
+find_diff_limb_sse42 (const BTOR_BV_TYPE *a,
+                      const BTOR_BV_TYPE *b,
+                      uint32_t n)
+{
+  uint32_t i, m;
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    m = BTOR_BV_MASK128 (
+        _mm_cmpeq_epi64 (BTOR_BV_LOAD128 (a + i), BTOR_BV_LOAD128 (b + i)));
+    if (m != 0x3) return i + __builtin_ctz (~m);
+  }
+  return i + find_diff_limb_scalar (a + i, b + i, n - i);
+}
+
+BTOR_BV_SSE42 static uint32_t
+find_nonzero_limb_sse42 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i, m;
+  __m128i zero = _mm_setzero_si128 ();
+  for (i = 0; i + 2 <= n; i += 2)
+  {
+    m = BTOR_BV_MASK128 (_mm_cmpeq_epi64 (BTOR_BV_LOAD128 (a + i), zero));
+    if (m != 0x3) return i + __builtin_ctz (~m);
+  }
+  return i + find_nonzero_limb_scalar (a + i, n - i);
+}
+
+BTOR_BV_SSE42 static uint32_t
+rfind_nonzero_limb_sse42 (const BTOR_BV_TYPE *a, uint32_t n)
+{
+  uint32_t i, m;
+  __m128i zero = _mm_setzero_si128 ();
+  for (i = n; i >= 2; i -= 2)
+  {
+    m = BTOR_BV_MASK128 (_mm_cmpeq_epi64 (BTOR_BV_LOAD128 (a + i - 2), zero));
+    if (m != 0x3) return i - 2 + 31 - __builtin_clz (~m & 0x3);
+  }
+  m = rfind_nonzero_limb_scalar (a, i);
+  return m < i ? m : n;
+}
+
+static const BtorBvLimbOps limb_ops_sse42 = {
+    and_limbs_sse42,
+    or_limbs_sse42,
+    xor_limbs_sse42,
+    not_limbs_sse42,
+    is_zero_limbs_sse42,
+    is_ones_limbs_sse42,
+    find_diff_limb_sse42,
+    find_nonzero_limb_sse42,
+    rfind_nonzero_limb_sse42,
+    hamming_limbs_popcnt,
+};
+#endif
+
+#ifdef BTOR_BV_USE_SIMD
+/* Limb operations for wide bit-vectors, 0 if not selected yet.
+ *
+ * Bit vectors are shared by the threads of the portfolio and cube modes.
+ * Every thread selects the same operations, hence concurrent
+ * initialization is harmless as long as 'limb_ops' is accessed atomically. */
+static const BtorBvLimbOps *limb_ops;
+
+/* Select the limb operations supported by the CPU.  Both SIMD tiers use the
+ * 'popcnt' instruction, which has its own CPUID bit and is not implied by
+ * SSE4.2, and are only used if it is available. */
+static const BtorBvLimbOps *
+select_limb_ops (void)
+{
+  __builtin_cpu_init ();
+  if (!__builtin_cpu_supports ("popcnt")) return &limb_ops_scalar;
+  if (__builtin_cpu_supports ("avx2")) return &limb_ops_avx2;
+  if (__builtin_cpu_supports ("sse4.2")) return &limb_ops_sse42;
+  return &limb_ops_scalar;
+}
+#endif
+
+/* Get limb operations for limb arrays of length 'len'. */
+static const BtorBvLimbOps *
+get_limb_ops (uint32_t len)
+{
+  if (len <= BTOR_BV_SIMD_MIN_LEN) return &limb_ops_scalar;
+
+#ifdef BTOR_BV_USE_SIMD
+  const BtorBvLimbOps *res = __atomic_load_n (&limb_ops, __ATOMIC_ACQUIRE);
+
+  if (!res)
+  {
+    res = select_limb_ops ();
+    __atomic_store_n (&limb_ops, res, __ATOMIC_RELEASE);
+  }
+  return res;
+#else
+  return &limb_ops_scalar;
+#endif
+}
 #endif
 
 #ifndef NDEBUG
@@ -81,7 +604,7 @@ check_bits_sll_dbg (const BtorBitVector *bv,
 
   if (shift >= bv->width)
   {
-    for (i = 0; i < bv->width; i++) assert (btor_bv_get_bit (bv, i) == 0);
+    for (i = 0; i < bv->width; i++) assert (btor_bv_get_bit (res, i) == 0);
   }
   else
   {
@@ -214,11 +737,12 @@ btor_bv_new_random_bit_range (
 #ifdef BTOR_USE_GMP
   res = btor_bv_new_random (mm, rng, bw);
 #else
+  uint32_t n;
+
   res = btor_bv_new (mm, bw);
-  for (i = 1; i < res->len; i++)
-    res->bits[i] = (BTOR_BV_TYPE) btor_rng_rand (rng);
-  res->bits[0] = (BTOR_BV_TYPE) btor_rng_pick_rand (
-      rng, 0, ((~0) >> (BTOR_BV_TYPE_BW - bw % BTOR_BV_TYPE_BW)) - 1);
+  n   = get_num_words (res);
+  for (i = n - 1; i > 0; i--) set_word (res, i - 1, btor_rng_rand (rng));
+  set_word (res, n - 1, btor_rng_pick_rand (rng, 0, UINT32_MAX - 1));
   set_rem_bits_to_zero (res);
 #endif
   for (i = 0; i < lo; i++) btor_bv_set_bit (res, i, 0);
@@ -264,8 +788,6 @@ btor_bv_uint64_to_bv (BtorMemMgr *mm, uint64_t value, uint32_t bw)
   res = btor_bv_new (mm, bw);
   assert (res->len > 0);
   res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -300,8 +822,6 @@ btor_bv_int64_to_bv (BtorMemMgr *mm, int64_t value, uint32_t bw)
   }
 
   res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -468,15 +988,25 @@ btor_bv_copy (BtorMemMgr *mm, const BtorBitVector *bv)
   BtorBitVector *res;
 
   res = btor_bv_new (mm, bv->width);
-  assert (res->width == bv->width);
+  btor_bv_copy_into (res, bv);
+  assert (btor_bv_compare (res, (BtorBitVector *) bv) == 0);
+  return res;
+}
+
+void
+btor_bv_copy_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+  if (dst == bv) return;
 #ifdef BTOR_USE_GMP
-  mpz_set (res->val, bv->val);
+  mpz_set (dst->val, bv->val);
 #else
-  assert (res->len == bv->len);
-  memcpy (res->bits, bv->bits, sizeof (*(bv->bits)) * bv->len);
+  assert (dst->len == bv->len);
+  memcpy (dst->bits, bv->bits, sizeof (*(bv->bits)) * bv->len);
 #endif
-  assert (btor_bv_compare (res, (BtorBitVector *) bv) == 0);
-  return res;
 }
 
 /*------------------------------------------------------------------------*/
@@ -521,8 +1051,7 @@ btor_bv_compare (const BtorBitVector *a, const BtorBitVector *b)
 #else
   uint32_t i;
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
   if (i == a->len) return 0;
   if (a->bits[i] > b->bits[i]) return 1;
   assert (a->bits[i] < b->bits[i]);
@@ -578,13 +1107,13 @@ btor_bv_hash (const BtorBitVector *bv)
     res = ((x >> 16) ^ x);
   }
 #else
-  for (i = 0, j = 0, n = bv->len; i < n; i++)
+  for (i = 0, j = 0, n = get_num_words (bv); i < n; i++)
   {
     p0 = hash_primes[j++];
     if (j == NPRIMES) j = 0;
     p1 = hash_primes[j++];
     if (j == NPRIMES) j = 0;
-    x   = bv->bits[i] ^ res;
+    x   = get_word (bv, n - 1 - i) ^ res;
     x   = ((x >> 16) ^ x) * p0;
     x   = ((x >> 16) ^ x) * p1;
     res = ((x >> 16) ^ x);
@@ -711,13 +1240,8 @@ get_first_one_bit_idx (const BtorBitVector *bv)
 #ifdef BTOR_USE_GMP
   return mpz_scan1 (bv->val, 0);
 #else
-  uint32_t i;
-  for (i = bv->width - 1; i < UINT32_MAX; i--)
-  {
-    if (btor_bv_get_bit (bv, i)) break;
-    if (i == 0) return UINT32_MAX;
-  }
-  return i;
+  /* UINT32_MAX if zero */
+  return bv->width - 1 - btor_bv_get_num_leading_zeros (bv);
 #endif
 }
 
@@ -823,11 +1347,8 @@ btor_bv_to_uint64 (const BtorBitVector *bv)
 #ifdef BTOR_USE_GMP
   res = mpz_get_ui (bv->val);
 #else
-  assert (bv->len <= 2);
-  uint32_t i;
-  res = 0;
-  for (i = 0; i < bv->len; i++)
-    res |= ((uint64_t) bv->bits[i]) << (BTOR_BV_TYPE_BW * (bv->len - 1 - i));
+  assert (bv->len == 1);
+  res = bv->bits[0];
 #endif
 
   return res;
@@ -898,11 +1419,11 @@ btor_bv_set_bit (BtorBitVector *bv, uint32_t pos, uint32_t bit)
 
   if (bit)
   {
-    bv->bits[bv->len - 1 - i] |= (1u << j);
+    bv->bits[bv->len - 1 - i] |= ((BTOR_BV_TYPE) 1 << j);
   }
   else
   {
-    bv->bits[bv->len - 1 - i] &= ~(1u << j);
+    bv->bits[bv->len - 1 - i] &= ~((BTOR_BV_TYPE) 1 << j);
   }
 #endif
 }
@@ -949,10 +1470,7 @@ btor_bv_is_zero (const BtorBitVector *bv)
 #ifdef BTOR_USE_GMP
   return mpz_cmp_ui (bv->val, 0) == 0;
 #else
-  uint32_t i;
-  for (i = 0; i < bv->len; i++)
-    if (bv->bits[i] != 0) return false;
-  return true;
+  return get_limb_ops (bv->len)->is_zero_limbs (bv->bits, bv->len);
 #endif
 }
 
@@ -961,8 +1479,9 @@ btor_bv_is_ones (const BtorBitVector *bv)
 {
   assert (bv);
 
-  uint32_t i, n;
+  uint32_t n;
 #ifdef BTOR_USE_GMP
+  uint32_t i;
   uint64_t m, max;
   mp_limb_t limb;
   if ((n = mpz_size (bv->val)) == 0) return false;  // zero
@@ -981,14 +1500,12 @@ btor_bv_is_ones (const BtorBitVector *bv)
   m = mp_bits_per_limb - bv->width % mp_bits_per_limb;
   return ((uint64_t) limb) == (max >> m);
 #else
-  for (i = bv->len - 1; i >= 1; i--)
-  {
-    if (bv->bits[i] != UINT32_MAX) return false;
-  }
+  if (!get_limb_ops (bv->len)->is_ones_limbs (bv->bits + 1, bv->len - 1))
+    return false;
   n = BTOR_BV_TYPE_BW - bv->width % BTOR_BV_TYPE_BW;
   assert (n > 0);
-  if (n == BTOR_BV_TYPE_BW) return bv->bits[0] == UINT32_MAX;
-  return bv->bits[0] == (UINT32_MAX >> n);
+  if (n == BTOR_BV_TYPE_BW) return bv->bits[0] == ~(BTOR_BV_TYPE) 0;
+  return bv->bits[0] == (~(BTOR_BV_TYPE) 0 >> n);
 #endif
 }
 
@@ -1017,7 +1534,8 @@ btor_bv_is_min_signed (const BtorBitVector *bv)
   if (get_first_one_bit_idx (bv) != bv->width - 1) return false;
 #else
   uint32_t i;
-  if (bv->bits[0] != (1u << ((bv->width % BTOR_BV_TYPE_BW) - 1))) return false;
+  if (bv->bits[0] != ((BTOR_BV_TYPE) 1 << ((bv->width - 1) % BTOR_BV_TYPE_BW)))
+    return false;
   for (i = 1; i < bv->len; i++)
     if (bv->bits[i] != 0) return false;
 #endif
@@ -1039,12 +1557,12 @@ btor_bv_is_max_signed (const BtorBitVector *bv)
   {
     if (bv->bits[0] != 0) return false;
   }
-  else if (bv->bits[0] != (~0u >> msc))
+  else if (bv->bits[0] != (~(BTOR_BV_TYPE) 0 >> msc))
   {
     return false;
   }
   for (i = 1; i < bv->len; i++)
-    if (bv->bits[i] != ~0u) return false;
+    if (bv->bits[i] != ~(BTOR_BV_TYPE) 0) return false;
 #endif
   return true;
 }
@@ -1106,7 +1624,7 @@ btor_bv_small_positive_int (const BtorBitVector *bv)
 #else
   for (i = 0, n = bv->len - 1; i < n; i++)
     if (bv->bits[i] != 0) return -1;
-  if (((int32_t) bv->bits[bv->len - 1]) < 0) return -1;
+  if (bv->bits[bv->len - 1] > INT32_MAX) return -1;
   res = bv->bits[bv->len - 1];
 #endif
   return res;
@@ -1124,11 +1642,15 @@ btor_bv_get_num_trailing_zeros (const BtorBitVector *bv)
 #else
   uint32_t i;
 
-  for (i = 0, res = 0; i < bv->width; i++)
-  {
-    if (btor_bv_get_bit (bv, i)) break;
-    res += 1;
-  }
+  i = get_limb_ops (bv->len)->rfind_nonzero_limb (bv->bits, bv->len);
+  if (i == bv->len) return bv->width;
+#if defined(__GNUC__) || defined(__clang__)
+  res = __builtin_ctzll (bv->bits[i]);
+#else
+  for (res = 0; !((bv->bits[i] >> res) & 1); res++)
+    ;
+#endif
+  res += (bv->len - 1 - i) * BTOR_BV_TYPE_BW;
 #endif
   return res;
 }
@@ -1192,11 +1714,8 @@ get_limb (const BtorBitVector *bv,
   /* for leading zeros */
   if (zeros)
   {
-    for (i = 0; i < bv->len; i++)
-    {
-      res = bv->bits[i];
-      if (res > 0) break;
-    }
+    i = get_limb_ops (bv->len)->find_nonzero_limb (bv->bits, bv->len);
+    if (i < bv->len) res = bv->bits[i];
   }
   /* for leading ones */
   else
@@ -1313,6 +1832,21 @@ btor_bv_get_num_leading_ones (const BtorBitVector *bv)
 #endif
 }
 
+uint32_t
+btor_bv_hamming_distance (const BtorBitVector *a, const BtorBitVector *b)
+{
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+
+#ifdef BTOR_USE_GMP
+  return mpz_hamdist (a->val, b->val);
+#else
+  assert (a->len == b->len);
+  return get_limb_ops (a->len)->hamming_limbs (a->bits, b->bits, a->len);
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 BtorBitVector *
@@ -1411,19 +1945,27 @@ btor_bv_not (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (bv);
 
   BtorBitVector *res;
-  uint32_t bw = bv->width;
-#ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_com (res->val, bv->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_not_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_not_into (BtorBitVector *dst, const BtorBitVector *bv)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst->width == bv->width);
+
+#ifdef BTOR_USE_GMP
+  mpz_com (dst->val, bv->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, bv->width);
 #else
-  uint32_t i;
-  res = btor_bv_new (mm, bw);
-  for (i = 0; i < bv->len; i++) res->bits[i] = ~bv->bits[i];
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
+  get_limb_ops (bv->len)->not_limbs (dst->bits, bv->bits, bv->len);
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1482,7 +2024,7 @@ btor_bv_redand (BtorMemMgr *mm, const BtorBitVector *bv)
 #else
   uint32_t i;
   uint32_t bit;
-  uint32_t mask0;
+  BTOR_BV_TYPE mask0;
 
   res = btor_bv_new (mm, 1);
   assert (rem_bits_zero_dbg (res));
@@ -1548,39 +2090,43 @@ btor_bv_add (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_add_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_add_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_add (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_add (dst->val, a->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, a->width);
 #else
   assert (a->len == b->len);
   int64_t i;
-  uint64_t x, y, sum;
-  BTOR_BV_TYPE carry;
+  BTOR_BV_TYPE x, sum, carry;
 
-  if (bw <= 64)
-  {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x + y, bw);
-  }
-  else
+  /* 'dst' may alias 'a' or 'b' */
+  for (i = a->len - 1, carry = 0; i >= 0; i--)
   {
-    res   = btor_bv_new (mm, bw);
-    carry = 0;
-    for (i = a->len - 1; i >= 0; i--)
-    {
-      sum          = (uint64_t) a->bits[i] + b->bits[i] + carry;
-      res->bits[i] = (BTOR_BV_TYPE) sum;
-      carry        = (BTOR_BV_TYPE) (sum >> 32);
-    }
+    x            = a->bits[i];
+    sum          = x + b->bits[i];
+    dst->bits[i] = sum + carry;
+    carry        = (sum < x) | (dst->bits[i] < sum);
   }
 
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1617,21 +2163,32 @@ btor_bv_and (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_and_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_and_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_and (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_and (dst->val, a->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, a->width);
 #else
   assert (a->len == b->len);
-  uint32_t i;
-
-  res = btor_bv_new (mm, bw);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] & b->bits[i];
+  get_limb_ops (a->len)->and_limbs (dst->bits, a->bits, b->bits, a->len);
 
-  assert (rem_bits_zero_dbg (res));
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1676,10 +2233,8 @@ btor_bv_or (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   assert (a->len == b->len);
-  uint32_t i;
-
   res = btor_bv_new (mm, bw);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] | b->bits[i];
+  get_limb_ops (a->len)->or_limbs (res->bits, a->bits, b->bits, a->len);
 
   assert (rem_bits_zero_dbg (res));
 #endif
@@ -1786,10 +2341,8 @@ btor_bv_xor (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   assert (a->len == b->len);
-  uint32_t i;
-
   res = btor_bv_new (mm, bw);
-  for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] ^ b->bits[i];
+  get_limb_ops (a->len)->xor_limbs (res->bits, a->bits, b->bits, a->len);
 
   assert (rem_bits_zero_dbg (res));
 #endif
@@ -1805,28 +2358,35 @@ btor_bv_eq (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, 1);
+  btor_bv_eq_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_eq_into (BtorBitVector *dst,
+                 const BtorBitVector *a,
+                 const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == 1);
+
 #ifdef BTOR_USE_GMP
-  res = mpz_cmp (a->val, b->val) == 0 ? btor_bv_one (mm, 1)
-                                      : btor_bv_zero (mm, 1);
+  mpz_set_ui (dst->val, mpz_cmp (a->val, b->val) == 0);
 #else
   assert (a->len == b->len);
-  uint32_t i, bit;
+  uint32_t i;
 
-  res = btor_bv_new (mm, 1);
-  bit = 1;
-  for (i = 0; i < a->len; i++)
-  {
-    if (a->bits[i] != b->bits[i])
-    {
-      bit = 0;
-      break;
-    }
-  }
-  btor_bv_set_bit (res, 0, bit);
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
 
-  assert (rem_bits_zero_dbg (res));
+  dst->bits[0] = i == a->len;
+
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1843,19 +2403,11 @@ btor_bv_ne (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
                                       : btor_bv_zero (mm, 1);
 #else
   assert (a->len == b->len);
-  uint32_t i, bit;
+  uint32_t i;
 
   res = btor_bv_new (mm, 1);
-  bit = 1;
-  for (i = 0; i < a->len; i++)
-  {
-    if (a->bits[i] != b->bits[i])
-    {
-      bit = 0;
-      break;
-    }
-  }
-  btor_bv_set_bit (res, 0, !bit);
+  i   = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
+  btor_bv_set_bit (res, 0, i != a->len);
 
   assert (rem_bits_zero_dbg (res));
 #endif
@@ -1871,28 +2423,41 @@ btor_bv_ult (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, 1);
+  btor_bv_ult_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_ult_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == 1);
+
 #ifdef BTOR_USE_GMP
-  res =
-      mpz_cmp (a->val, b->val) < 0 ? btor_bv_one (mm, 1) : btor_bv_zero (mm, 1);
+  mpz_set_ui (dst->val, mpz_cmp (a->val, b->val) < 0);
 #else
   assert (a->len == b->len);
   uint32_t i, bit;
 
-  res = btor_bv_new (mm, 1);
   bit = 1;
 
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
 
   /* a >= b */
   if (i == a->len || a->bits[i] >= b->bits[i]) bit = 0;
 
-  btor_bv_set_bit (res, 0, bit);
+  dst->bits[0] = bit;
 
-  assert (rem_bits_zero_dbg (res));
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1915,8 +2480,7 @@ btor_bv_ulte (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   bit = 1;
 
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
 
   /* a > b */
   if (i < a->len && a->bits[i] > b->bits[i]) bit = 0;
@@ -1948,8 +2512,7 @@ btor_bv_ugt (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   bit = 1;
 
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
 
   /* a <= b */
   if (i == a->len || a->bits[i] <= b->bits[i]) bit = 0;
@@ -1981,8 +2544,7 @@ btor_bv_ugte (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   bit = 1;
 
   /* find index on which a and b differ */
-  for (i = 0; i < a->len && a->bits[i] == b->bits[i]; i++)
-    ;
+  i = get_limb_ops (a->len)->find_diff_limb (a->bits, b->bits, a->len);
 
   /* a < b */
   if (i < a->len && a->bits[i] < b->bits[i]) bit = 0;
@@ -2110,54 +2672,91 @@ btor_bv_sgte (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   return res;
 }
 
-BtorBitVector *
-btor_bv_sll_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
+static void
+set_zero (BtorBitVector *bv)
 {
-  assert (mm);
+#ifdef BTOR_USE_GMP
+  mpz_set_ui (bv->val, 0);
+#else
+  BTOR_CLRN (bv->bits, bv->len);
+#endif
+}
+
+static void
+set_ones (BtorBitVector *bv)
+{
+#ifdef BTOR_USE_GMP
+  mpz_set_ui (bv->val, 1);
+  mpz_mul_2exp (bv->val, bv->val, bv->width);
+  mpz_sub_ui (bv->val, bv->val, 1);
+#else
+  uint32_t i;
+  for (i = 0; i < bv->len; i++) bv->bits[i] = ~(BTOR_BV_TYPE) 0;
+  set_rem_bits_to_zero (bv);
+#endif
+}
+
+/* 'dst' may alias 'a'. */
+static void
+sll_uint64_into (BtorBitVector *dst, const BtorBitVector *a, uint64_t shift)
+{
+  assert (dst);
   assert (a);
+  assert (dst->width == a->width);
 
-  BtorBitVector *res;
   uint32_t bw = a->width;
 
-  res = btor_bv_new (mm, bw);
-  if (shift >= bw) return res;
+  if (shift >= bw)
+  {
+    set_zero (dst);
+    return;
+  }
 
 #ifdef BTOR_USE_GMP
-  mpz_mul_2exp (res->val, a->val, shift);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_mul_2exp (dst->val, a->val, shift);
+  mpz_fdiv_r_2exp (dst->val, dst->val, bw);
 #else
-  uint32_t skip, i, j, k;
+  uint32_t skip, i, k;
   BTOR_BV_TYPE v;
 
   k    = shift % BTOR_BV_TYPE_BW;
   skip = shift / BTOR_BV_TYPE_BW;
 
-  v = 0;
-  for (i = a->len - 1, j = res->len - 1 - skip;; i--, j--)
+  /* limbs are stored MSB first, bits move towards lower indices */
+  for (i = 0; i + skip < a->len; i++)
   {
-    v            = (k == 0) ? a->bits[i] : v | (a->bits[i] << k);
-    res->bits[j] = v;
-    v            = (k == 0) ? a->bits[i] : a->bits[i] >> (BTOR_BV_TYPE_BW - k);
-    if (i == 0 || j == 0) break;
+    v = a->bits[i + skip] << k;
+    if (k && i + skip + 1 < a->len)
+      v |= a->bits[i + skip + 1] >> (BTOR_BV_TYPE_BW - k);
+    dst->bits[i] = v;
   }
-  set_rem_bits_to_zero (res);
-  assert (rem_bits_zero_dbg (res));
+  for (; i < a->len; i++) dst->bits[i] = 0;
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
 #endif
+}
+
+BtorBitVector *
+btor_bv_sll_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
+{
+  assert (mm);
+  assert (a);
+
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  sll_uint64_into (res, a, shift);
   assert (check_bits_sll_dbg (a, res, shift));
   return res;
 }
 
 static bool
-shift_is_uint64 (BtorMemMgr *mm,
-                 const BtorBitVector *b,
-                 uint64_t *res)
+shift_is_uint64 (const BtorBitVector *b, uint64_t *res)
 {
-  assert (mm);
   assert (b);
   assert (res);
 
   uint64_t zeroes;
-  BtorBitVector *shift;
 
   if (b->width <= 64)
   {
@@ -2168,11 +2767,11 @@ shift_is_uint64 (BtorMemMgr *mm,
   zeroes = btor_bv_get_num_leading_zeros (b);
   if (zeroes < b->width - 64) return false;
 
-  shift =
-      btor_bv_slice (mm, b, zeroes < b->width ? b->width - 1 - zeroes : 0, 0);
-  assert (shift->width <= 64);
-  *res = btor_bv_to_uint64 (shift);
-  btor_bv_free (mm, shift);
+#ifdef BTOR_USE_GMP
+  *res = mpz_get_ui (b->val);
+#else
+  *res = b->bits[b->len - 1];
+#endif
   return true;
 }
 
@@ -2184,13 +2783,29 @@ btor_bv_sll (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (b);
   assert (a->width == b->width);
 
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_sll_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_sll_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+
   uint64_t ushift;
 
-  if (shift_is_uint64 (mm, b, &ushift))
-  {
-    return btor_bv_sll_uint64 (mm, a, ushift);
-  }
-  return btor_bv_new (mm, a->width);
+  if (shift_is_uint64 (b, &ushift))
+    sll_uint64_into (dst, a, ushift);
+  else
+    set_zero (dst);
 }
 
 BtorBitVector *
@@ -2220,32 +2835,52 @@ btor_bv_sra (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   return res;
 }
 
-BtorBitVector *
-btor_bv_srl_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
+/* 'dst' may alias 'a'. */
+static void
+srl_uint64_into (BtorBitVector *dst, const BtorBitVector *a, uint64_t shift)
 {
-  assert (mm);
+  assert (dst);
   assert (a);
+  assert (dst->width == a->width);
 
-  BtorBitVector *res;
+  if (shift >= a->width)
+  {
+    set_zero (dst);
+    return;
+  }
 
-  res = btor_bv_new (mm, a->width);
-  if (shift >= a->width) return res;
 #ifdef BTOR_USE_GMP
-  mpz_fdiv_q_2exp (res->val, a->val, shift);
+  mpz_fdiv_q_2exp (dst->val, a->val, shift);
 #else
   uint32_t skip, i, j, k;
   BTOR_BV_TYPE v;
-  k = shift % BTOR_BV_TYPE_BW;
+
+  k    = shift % BTOR_BV_TYPE_BW;
   skip = shift / BTOR_BV_TYPE_BW;
-  v = 0;
-  for (i = 0, j = skip; i < a->len && j < a->len; i++, j++)
+
+  /* limbs are stored MSB first, bits move towards higher indices */
+  for (i = a->len; i > skip; i--)
   {
-    v = (k == 0) ? a->bits[i] : v | (a->bits[i] >> k);
-    res->bits[j] = v;
-    v = (k == 0) ? a->bits[i] : a->bits[i] << (BTOR_BV_TYPE_BW - k);
+    j = i - 1;
+    v = a->bits[j - skip] >> k;
+    if (k && j > skip) v |= a->bits[j - skip - 1] << (BTOR_BV_TYPE_BW - k);
+    dst->bits[j] = v;
   }
-  assert (rem_bits_zero_dbg (res));
+  for (i = 0; i < skip; i++) dst->bits[i] = 0;
+  assert (rem_bits_zero_dbg (dst));
 #endif
+}
+
+BtorBitVector *
+btor_bv_srl_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
+{
+  assert (mm);
+  assert (a);
+
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  srl_uint64_into (res, a, shift);
   return res;
 }
 
@@ -2257,14 +2892,296 @@ btor_bv_srl (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (b);
   assert (a->width == b->width);
 
+  BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_srl_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_srl_into (BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+
   uint64_t ushift;
 
-  if (shift_is_uint64 (mm, b, &ushift))
+  if (shift_is_uint64 (b, &ushift))
+    srl_uint64_into (dst, a, ushift);
+  else
+    set_zero (dst);
+}
+
+#ifndef BTOR_USE_GMP
+/* Word-level kernels for multiplication and division of bit-vectors wider
+ * than 64 bits.  They operate on little-endian arrays of 32-bit words (see
+ * get_word) with 64-bit intermediate results.  Karatsuba multiplication is
+ * used for operands with at least BTOR_BV_KARATSUBA_THRESHOLD words. */
+
+#define BTOR_BV_KARATSUBA_THRESHOLD 32
+
+static void
+bv_to_words (const BtorBitVector *bv, uint32_t *words)
+{
+  uint32_t i, n;
+  for (i = 0, n = get_num_words (bv); i < n; i++) words[i] = get_word (bv, i);
+}
+
+static void
+words_to_bv (BtorBitVector *bv, const uint32_t *words)
+{
+  uint32_t i, n;
+  for (i = 0, n = get_num_words (bv); i < n; i++) set_word (bv, i, words[i]);
+  set_rem_bits_to_zero (bv);
+}
+
+/* r[0..n) += a[0..m) with m <= n, returns the carry. */
+static uint32_t
+add_words (uint32_t *r, const uint32_t *a, uint32_t n, uint32_t m)
+{
+  assert (m <= n);
+
+  uint32_t i;
+  uint64_t t, carry = 0;
+
+  for (i = 0; i < m; i++)
+  {
+    t     = (uint64_t) r[i] + a[i] + carry;
+    r[i]  = (uint32_t) t;
+    carry = t >> 32;
+  }
+  for (; carry && i < n; i++)
+  {
+    t     = (uint64_t) r[i] + carry;
+    r[i]  = (uint32_t) t;
+    carry = t >> 32;
+  }
+  return (uint32_t) carry;
+}
+
+/* r[0..n) -= a[0..m) with m <= n, returns the borrow. */
+static uint32_t
+sub_words (uint32_t *r, const uint32_t *a, uint32_t n, uint32_t m)
+{
+  assert (m <= n);
+
+  uint32_t i;
+  uint64_t t, borrow = 0;
+
+  for (i = 0; i < m; i++)
+  {
+    t      = (uint64_t) r[i] - a[i] - borrow;
+    r[i]   = (uint32_t) t;
+    borrow = (t >> 32) & 1;
+  }
+  for (; borrow && i < n; i++)
+  {
+    t      = (uint64_t) r[i] - borrow;
+    r[i]   = (uint32_t) t;
+    borrow = (t >> 32) & 1;
+  }
+  return (uint32_t) borrow;
+}
+
+/* r[0..2n) = a[0..n) * b[0..n) (schoolbook). */
+static void
+mul_words (uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+  uint32_t i, j;
+  uint64_t t, carry;
+
+  memset (r, 0, sizeof (*r) * 2 * n);
+  for (i = 0; i < n; i++)
+  {
+    if (!a[i]) continue;
+    for (j = 0, carry = 0; j < n; j++)
+    {
+      t        = (uint64_t) a[i] * b[j] + r[i + j] + carry;
+      r[i + j] = (uint32_t) t;
+      carry    = t >> 32;
+    }
+    r[i + n] = (uint32_t) carry;
+  }
+}
+
+/* r[0..n) = (a[0..n) * b[0..n)) mod 2^(32n) (schoolbook). */
+static void
+mul_words_low (uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t n)
+{
+  uint32_t i, j;
+  uint64_t t, carry;
+
+  memset (r, 0, sizeof (*r) * n);
+  for (i = 0; i < n; i++)
+  {
+    if (!a[i]) continue;
+    for (j = 0, carry = 0; i + j < n; j++)
+    {
+      t        = (uint64_t) a[i] * b[j] + r[i + j] + carry;
+      r[i + j] = (uint32_t) t;
+      carry    = t >> 32;
+    }
+  }
+}
+
+/* Number of scratch words required by karatsuba_words for n-word operands. */
+static uint32_t
+karatsuba_scratch_size (uint32_t n)
+{
+  uint32_t k;
+  if (n < BTOR_BV_KARATSUBA_THRESHOLD) return 0;
+  k = n - n / 2 + 1;
+  return 4 * k + karatsuba_scratch_size (k);
+}
+
+/* r[0..2n) = a[0..n) * b[0..n). */
+static void
+karatsuba_words (
+    uint32_t *r, const uint32_t *a, const uint32_t *b, uint32_t n, uint32_t *s)
+{
+  uint32_t h, k, *sa, *sb, *z1;
+
+  if (n < BTOR_BV_KARATSUBA_THRESHOLD)
+  {
+    mul_words (r, a, b, n);
+    return;
+  }
+
+  /* a = a1 * B^h + a0, b = b1 * B^h + b0 with B = 2^32 */
+  h  = n / 2;
+  k  = n - h + 1;
+  sa = s;
+  sb = sa + k;
+  z1 = sb + k;
+  s += 4 * k;
+
+  /* sa = a0 + a1, sb = b0 + b1 */
+  memcpy (sa, a + h, sizeof (*sa) * (k - 1));
+  sa[k - 1] = add_words (sa, a, k - 1, h);
+  memcpy (sb, b + h, sizeof (*sb) * (k - 1));
+  sb[k - 1] = add_words (sb, b, k - 1, h);
+
+  /* z0 = a0 * b0, z2 = a1 * b1, z1 = sa * sb - z0 - z2 */
+  karatsuba_words (z1, sa, sb, k, s);
+  karatsuba_words (r, a, b, h, s);
+  karatsuba_words (r + 2 * h, a + h, b + h, n - h, s);
+  sub_words (z1, r, 2 * k, 2 * h);
+  sub_words (z1, r + 2 * h, 2 * k, 2 * (n - h));
+
+  /* r = z2 * B^2h + z1 * B^h + z0, z1 < B^(n+1) */
+  assert (!z1[2 * k - 1]);
+  add_words (r + h, z1, 2 * n - h, n + 1);
+}
+
+static uint32_t
+clz_word (uint32_t word)
+{
+  assert (word);
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clz (word);
+#else
+  uint32_t res;
+  for (res = 0; !(word & 0x80000000u); word <<= 1, res++)
+    ;
+  return res;
+#endif
+}
+
+/* q[0..m) = u[0..m) / v[0..n) and r[0..n) = u[0..m) % v[0..n) with
+ * v[n-1] != 0 and m >= n (Knuth, TAOCP Vol. 2, 4.3.1, Algorithm D).
+ * Scratch arrays 'un' and 'vn' hold m + 1 and n words, respectively. */
+static void
+udiv_urem_words (uint32_t *q,
+                 uint32_t *r,
+                 const uint32_t *u,
+                 uint32_t m,
+                 const uint32_t *v,
+                 uint32_t n,
+                 uint32_t *un,
+                 uint32_t *vn)
+{
+  assert (n > 0);
+  assert (m >= n);
+  assert (v[n - 1]);
+
+  const uint64_t b = (uint64_t) 1 << 32;
+  uint32_t s;
+  int64_t i, j;
+  uint64_t qhat, rhat, p, k;
+  int64_t t, c;
+
+  memset (q, 0, sizeof (*q) * m);
+
+  if (n == 1)
+  {
+    for (j = m - 1, k = 0; j >= 0; j--)
+    {
+      q[j] = (uint32_t) ((k * b + u[j]) / v[0]);
+      k    = (k * b + u[j]) - (uint64_t) q[j] * v[0];
+    }
+    r[0] = (uint32_t) k;
+    return;
+  }
+
+  /* D1: normalize such that the most significant bit of vn is set */
+  s = clz_word (v[n - 1]);
+  for (i = n - 1; i > 0; i--)
+    vn[i] = (v[i] << s) | (uint32_t) ((uint64_t) v[i - 1] >> (32 - s));
+  vn[0] = v[0] << s;
+  un[m] = (uint32_t) ((uint64_t) u[m - 1] >> (32 - s));
+  for (i = m - 1; i > 0; i--)
+    un[i] = (u[i] << s) | (uint32_t) ((uint64_t) u[i - 1] >> (32 - s));
+  un[0] = u[0] << s;
+
+  for (j = m - n; j >= 0; j--)
   {
-    return btor_bv_srl_uint64 (mm, a, ushift);
+    /* D3: estimate qhat of q[j] */
+    qhat = ((uint64_t) un[j + n] * b + un[j + n - 1]) / vn[n - 1];
+    rhat = ((uint64_t) un[j + n] * b + un[j + n - 1]) - qhat * vn[n - 1];
+    while (qhat >= b || qhat * vn[n - 2] > b * rhat + un[j + n - 2])
+    {
+      qhat -= 1;
+      rhat += vn[n - 1];
+      if (rhat >= b) break;
+    }
+
+    /* D4: multiply and subtract */
+    for (i = 0, c = 0; i < n; i++)
+    {
+      p         = qhat * vn[i];
+      t         = (int64_t) un[i + j] - c - (int64_t) (p & UINT32_MAX);
+      un[i + j] = (uint32_t) t;
+      c         = (int64_t) (p >> 32) - (t >> 32);
+    }
+    t         = (int64_t) un[j + n] - c;
+    un[j + n] = (uint32_t) t;
+    q[j]      = (uint32_t) qhat;
+
+    /* D6: add back if we subtracted too much */
+    if (t < 0)
+    {
+      q[j] -= 1;
+      for (i = 0, k = 0; i < n; i++)
+      {
+        k         = (uint64_t) un[i + j] + vn[i] + k;
+        un[i + j] = (uint32_t) k;
+        k >>= 32;
+      }
+      un[j + n] += (uint32_t) k;
+    }
   }
-  return btor_bv_new (mm, a->width);
+
+  /* D8: unnormalize remainder */
+  for (i = 0; i < n - 1; i++)
+    r[i] = (un[i] >> s) | (uint32_t) ((uint64_t) un[i + 1] << (32 - s));
+  r[n - 1] = un[n - 1] >> s;
 }
+#endif
 
 BtorBitVector *
 btor_bv_mul (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
@@ -2275,64 +3192,84 @@ btor_bv_mul (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_mul_into (mm, res, a, b);
+  return res;
+}
+
+void
+btor_bv_mul_into (BtorMemMgr *mm,
+                  BtorBitVector *dst,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_mul (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  (void) mm;
+  mpz_mul (dst->val, a->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, a->width);
 #else
   assert (a->len == b->len);
-  uint32_t i;
-  uint64_t x, y;
-  BtorBitVector *and, *shift, *add;
+  uint32_t n, size;
+  uint32_t *words, *wa, *wb, *wr;
 
-  if (bw <= 64)
+  if (a->width <= 64)
   {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x * y, bw);
+    dst->bits[0] = a->bits[0] * b->bits[0];
+    set_rem_bits_to_zero (dst);
   }
   else
   {
-    res = btor_bv_new (mm, bw);
-    for (i = 0; i < bw; i++)
-    {
-      if (btor_bv_get_bit (b, i))
-        and = btor_bv_copy (mm, a);
-      else
-        and = btor_bv_new (mm, bw);
-      shift = btor_bv_sll_uint64 (mm, and, i);
-      add   = btor_bv_add (mm, res, shift);
-      btor_bv_free (mm, and);
-      btor_bv_free (mm, shift);
-      btor_bv_free (mm, res);
-      res = add;
-    }
+    n = get_num_words (a);
+    if (n < BTOR_BV_KARATSUBA_THRESHOLD)
+      size = 3 * n;
+    else
+      size = 4 * n + karatsuba_scratch_size (n);
+    BTOR_NEWN (mm, words, size);
+    wa = words;
+    wb = wa + n;
+    wr = wb + n;
+    bv_to_words (a, wa);
+    bv_to_words (b, wb);
+    if (n < BTOR_BV_KARATSUBA_THRESHOLD)
+      mul_words_low (wr, wa, wb, n);
+    else
+      karatsuba_words (wr, wa, wb, n, wr + 2 * n);
+    words_to_bv (dst, wr);
+    BTOR_DELETEN (mm, words, size);
   }
 #endif
-  return res;
 }
 
 #ifndef BTOR_USE_GMP
+/* Compute quotient and/or remainder of 'a' and 'b' into 'q' and 'r', both of
+ * which may be 0 and may alias 'a' or 'b'. */
 static void
 udiv_urem_bv (BtorMemMgr *mm,
               const BtorBitVector *a,
               const BtorBitVector *b,
-              BtorBitVector **q,
-              BtorBitVector **r)
+              BtorBitVector *q,
+              BtorBitVector *r)
 {
   assert (mm);
   assert (a);
   assert (b);
   assert (a->width == b->width);
+  assert (!q || q->width == a->width);
+  assert (!r || r->width == a->width);
 
   assert (a->len == b->len);
-  int64_t i;
-  bool is_true;
+  uint32_t m, n, size;
   uint64_t x, y, z;
   uint32_t bw = a->width;
-
-  BtorBitVector *neg_b, *quot, *rem, *ult, *eq, *tmp;
+  uint32_t *words, *wu, *wv, *wq, *wr;
 
   if (bw <= 64)
   {
@@ -2349,53 +3286,36 @@ udiv_urem_bv (BtorMemMgr *mm,
       y = x % y;
       x = z;
     }
-    quot = btor_bv_uint64_to_bv (mm, x, bw);
-    rem  = btor_bv_uint64_to_bv (mm, y, bw);
-  }
-  else
-  {
-    neg_b = btor_bv_neg (mm, b);
-    quot  = btor_bv_new (mm, bw);
-    rem   = btor_bv_new (mm, bw);
-
-    for (i = bw - 1; i >= 0; i--)
+    if (q)
     {
-      tmp = btor_bv_sll_uint64 (mm, rem, 1);
-      btor_bv_free (mm, rem);
-      rem = tmp;
-      btor_bv_set_bit (rem, 0, btor_bv_get_bit (a, i));
-
-      ult     = btor_bv_ult (mm, b, rem);
-      is_true = btor_bv_is_true (ult);
-      btor_bv_free (mm, ult);
-
-      if (is_true) goto UDIV_UREM_SUBTRACT;
-
-      eq      = btor_bv_eq (mm, b, rem);
-      is_true = btor_bv_is_true (eq);
-      btor_bv_free (mm, eq);
-
-      if (is_true)
-      {
-      UDIV_UREM_SUBTRACT:
-        tmp = btor_bv_add (mm, rem, neg_b);
-        btor_bv_free (mm, rem);
-        rem = tmp;
-        btor_bv_set_bit (quot, i, 1);
-      }
+      q->bits[0] = x;
+      set_rem_bits_to_zero (q);
     }
-    btor_bv_free (mm, neg_b);
+    if (r) r->bits[0] = y;
+  }
+  else if (btor_bv_is_zero (b))
+  {
+    if (r) btor_bv_copy_into (r, a);
+    if (q) set_ones (q);
   }
-
-  if (q)
-    *q = quot;
-  else
-    btor_bv_free (mm, quot);
-
-  if (r)
-    *r = rem;
   else
-    btor_bv_free (mm, rem);
+  {
+    m    = get_num_words (a);
+    size = 6 * m + 1;
+    BTOR_CNEWN (mm, words, size);
+    wu = words;
+    wv = wu + m;
+    wq = wv + m;
+    wr = wq + m;
+    bv_to_words (a, wu);
+    bv_to_words (b, wv);
+    for (n = m; !wv[n - 1]; n--)
+      ;
+    udiv_urem_words (wq, wr, wu, m, wv, n, wr + m, wr + 2 * m + 1);
+    if (q) words_to_bv (q, wq);
+    if (r) words_to_bv (r, wr);
+    BTOR_DELETEN (mm, words, size);
+  }
 }
 #endif
 
@@ -2408,18 +3328,38 @@ btor_bv_udiv (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_udiv_into (mm, res, a, b);
+  return res;
+}
+
+void
+btor_bv_udiv_into (BtorMemMgr *mm,
+                   BtorBitVector *dst,
+                   const BtorBitVector *a,
+                   const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  uint32_t bw = a->width;
-  if (btor_bv_is_zero (b)) return btor_bv_ones (mm, bw);
-  res = btor_bv_new (mm, bw);
-  mpz_fdiv_q (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  (void) mm;
+  if (btor_bv_is_zero (b))
+  {
+    set_ones (dst);
+    return;
+  }
+  mpz_fdiv_q (dst->val, a->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, a->width);
 #else
   assert (a->len == b->len);
-  udiv_urem_bv (mm, a, b, &res, 0);
-  assert (res);
+  udiv_urem_bv (mm, a, b, dst, 0);
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2431,18 +3371,38 @@ btor_bv_urem (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_urem_into (mm, res, a, b);
+  return res;
+}
+
+void
+btor_bv_urem_into (BtorMemMgr *mm,
+                   BtorBitVector *dst,
+                   const BtorBitVector *a,
+                   const BtorBitVector *b)
+{
+  assert (mm);
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (dst->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  uint32_t bw = a->width;
-  if (btor_bv_is_zero (b)) return btor_bv_copy (mm, a);
-  res = btor_bv_new (mm, bw);
-  mpz_fdiv_r (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  (void) mm;
+  if (btor_bv_is_zero (b))
+  {
+    btor_bv_copy_into (dst, a);
+    return;
+  }
+  mpz_fdiv_r (dst->val, a->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, a->width);
 #else
   assert (a->len == b->len);
-  udiv_urem_bv (mm, a, b, 0, &res);
-  assert (res);
+  udiv_urem_bv (mm, a, b, 0, dst);
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2547,22 +3507,36 @@ btor_bv_concat (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (b);
 
   BtorBitVector *res;
-  uint32_t bw = a->width + b->width;
+
+  res = btor_bv_new (mm, a->width + b->width);
+  btor_bv_concat_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_concat_into (BtorBitVector *dst,
+                     const BtorBitVector *a,
+                     const BtorBitVector *b)
+{
+  assert (dst);
+  assert (a);
+  assert (b);
+  assert (dst != a);
+  assert (dst != b);
+  assert (dst->width == a->width + b->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_mul_2exp (res->val, a->val, b->width);
-  mpz_add (res->val, res->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_mul_2exp (dst->val, a->val, b->width);
+  mpz_add (dst->val, dst->val, b->val);
+  mpz_fdiv_r_2exp (dst->val, dst->val, dst->width);
 #else
   int64_t i, j, k;
   BTOR_BV_TYPE v;
 
-  res = btor_bv_new (mm, bw);
-
-  j = res->len - 1;
+  j = dst->len - 1;
 
   /* copy bits from bit vector b */
-  for (i = b->len - 1; i >= 0; i--) res->bits[j--] = b->bits[i];
+  for (i = b->len - 1; i >= 0; i--) dst->bits[j--] = b->bits[i];
 
   k = b->width % BTOR_BV_TYPE_BW;
 
@@ -2570,27 +3544,26 @@ btor_bv_concat (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   if (k == 0)
   {
     assert (j >= 0);
-    for (i = a->len - 1; i >= 0; i--) res->bits[j--] = a->bits[i];
+    for (i = a->len - 1; i >= 0; i--) dst->bits[j--] = a->bits[i];
   }
   else
   {
     j += 1;
-    assert (res->bits[j] >> k == 0);
-    v = res->bits[j];
+    assert (dst->bits[j] >> k == 0);
+    v = dst->bits[j];
     for (i = a->len - 1; i >= 0; i--)
     {
       v = v | (a->bits[i] << k);
       assert (j >= 0);
-      res->bits[j--] = v;
+      dst->bits[j--] = v;
       v              = a->bits[i] >> (BTOR_BV_TYPE_BW - k);
     }
     assert (j <= 0);
-    if (j == 0) res->bits[j] = v;
+    if (j == 0) dst->bits[j] = v;
   }
 
-  assert (rem_bits_zero_dbg (res));
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2603,21 +3576,45 @@ btor_bv_slice (BtorMemMgr *mm,
   assert (bv);
 
   BtorBitVector *res;
-  uint32_t bw = upper - lower + 1;
+
+  res = btor_bv_new (mm, upper - lower + 1);
+  btor_bv_slice_into (res, bv, upper, lower);
+  return res;
+}
+
+void
+btor_bv_slice_into (BtorBitVector *dst,
+                    const BtorBitVector *bv,
+                    uint32_t upper,
+                    uint32_t lower)
+{
+  assert (dst);
+  assert (bv);
+  assert (dst != bv);
+  assert (upper >= lower);
+  assert (upper < bv->width);
+  assert (dst->width == upper - lower + 1);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
-  mpz_fdiv_r_2exp (res->val, bv->val, upper + 1);
-  mpz_fdiv_q_2exp (res->val, res->val, lower);
+  mpz_fdiv_r_2exp (dst->val, bv->val, upper + 1);
+  mpz_fdiv_q_2exp (dst->val, dst->val, lower);
 #else
-  uint32_t i, j;
-
-  res = btor_bv_new (mm, bw);
-  for (i = lower, j = 0; i <= upper; i++)
-    btor_bv_set_bit (res, j++, btor_bv_get_bit (bv, i));
+  (void) upper;
+  uint32_t i, j, k;
+  BTOR_BV_TYPE v;
 
-  assert (rem_bits_zero_dbg (res));
+  k = lower % BTOR_BV_TYPE_BW;
+  /* i-th limb of 'dst' and j-th limb of 'bv', counted from the LSB */
+  for (i = 0, j = lower / BTOR_BV_TYPE_BW; i < dst->len; i++, j++)
+  {
+    v = bv->bits[bv->len - 1 - j] >> k;
+    if (k && j + 1 < bv->len)
+      v |= bv->bits[bv->len - 2 - j] << (BTOR_BV_TYPE_BW - k);
+    dst->bits[dst->len - 1 - i] = v;
+  }
+  set_rem_bits_to_zero (dst);
+  assert (rem_bits_zero_dbg (dst));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2985,7 +3982,9 @@ btor_bv_mod_inverse (BtorMemMgr *mm, const BtorBitVector *bv)
 
   while (!btor_bv_is_zero (b))
   {
-    udiv_urem_bv (mm, a, b, &q, &r);
+    q = btor_bv_new (mm, ebw);
+    r = btor_bv_new (mm, ebw);
+    udiv_urem_bv (mm, a, b, q, r);
 
     btor_bv_free (mm, a);
 
@@ -3040,6 +4039,87 @@ btor_bv_is_special_const (const BtorBitVector *bv)
 
 /*------------------------------------------------------------------------*/
 
+struct BtorBitVectorPool
+{
+  BtorMemMgr *mm;
+  BtorIntHashTable *free; /* maps bit-width to BtorBitVectorPtrStack */
+};
+
+BtorBitVectorPool *
+btor_bv_pool_new (BtorMemMgr *mm)
+{
+  assert (mm);
+
+  BtorBitVectorPool *res;
+
+  BTOR_CNEW (mm, res);
+  res->mm   = mm;
+  res->free = btor_hashint_map_new (mm);
+  return res;
+}
+
+void
+btor_bv_pool_delete (BtorBitVectorPool *pool)
+{
+  assert (pool);
+
+  BtorIntHashTableIterator it;
+  BtorBitVectorPtrStack *stack;
+
+  btor_iter_hashint_init (&it, pool->free);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    stack = btor_iter_hashint_next_data (&it)->as_ptr;
+    while (!BTOR_EMPTY_STACK (*stack))
+      btor_bv_free (pool->mm, BTOR_POP_STACK (*stack));
+    BTOR_RELEASE_STACK (*stack);
+    BTOR_DELETE (pool->mm, stack);
+  }
+  btor_hashint_map_delete (pool->free);
+  BTOR_DELETE (pool->mm, pool);
+}
+
+BtorBitVector *
+btor_bv_pool_get (BtorBitVectorPool *pool, uint32_t bw)
+{
+  assert (pool);
+  assert (bw > 0);
+
+  BtorHashTableData *d;
+  BtorBitVectorPtrStack *stack;
+
+  d = btor_hashint_map_get (pool->free, (int32_t) bw);
+  if (d)
+  {
+    stack = d->as_ptr;
+    if (!BTOR_EMPTY_STACK (*stack)) return BTOR_POP_STACK (*stack);
+  }
+  return btor_bv_new (pool->mm, bw);
+}
+
+void
+btor_bv_pool_put (BtorBitVectorPool *pool, BtorBitVector *bv)
+{
+  assert (pool);
+  assert (bv);
+
+  BtorHashTableData *d;
+  BtorBitVectorPtrStack *stack;
+
+  d = btor_hashint_map_get (pool->free, (int32_t) bv->width);
+  if (d)
+    stack = d->as_ptr;
+  else
+  {
+    BTOR_NEW (pool->mm, stack);
+    BTOR_INIT_STACK (pool->mm, *stack);
+    btor_hashint_map_add (pool->free, (int32_t) bv->width)->as_ptr = stack;
+  }
+  BTOR_PUSH_STACK (*stack, bv);
+}
+
+/*------------------------------------------------------------------------*/
+
 BtorBitVectorTuple *
 btor_bv_new_tuple (BtorMemMgr *mm, uint32_t arity)
 {
@@ -3154,3 +4234,35 @@ btor_bv_size_tuple (BtorBitVectorTuple *t)
 }
 
 /*------------------------------------------------------------------------*/
+
+bool
+btor_bv_set_limb_ops (BtorBvLimbOpsKind kind)
+{
+#ifdef BTOR_BV_USE_SIMD
+  const BtorBvLimbOps *ops;
+
+  __builtin_cpu_init ();
+  switch (kind)
+  {
+    case BTOR_BV_LIMB_OPS_AUTO: ops = 0; break;
+    case BTOR_BV_LIMB_OPS_SCALAR: ops = &limb_ops_scalar; break;
+    case BTOR_BV_LIMB_OPS_SSE42:
+      if (!__builtin_cpu_supports ("popcnt")
+          || !__builtin_cpu_supports ("sse4.2"))
+        return false;
+      ops = &limb_ops_sse42;
+      break;
+    default:
+      assert (kind == BTOR_BV_LIMB_OPS_AVX2);
+      if (!__builtin_cpu_supports ("popcnt")
+          || !__builtin_cpu_supports ("avx2"))
+        return false;
+      ops = &limb_ops_avx2;
+  }
+  __atomic_store_n (&limb_ops, ops, __ATOMIC_RELEASE);
+  return true;
+#else
+  /* only the portable implementation is available */
+  return kind == BTOR_BV_LIMB_OPS_AUTO || kind == BTOR_BV_LIMB_OPS_SCALAR;
+#endif
+}
@@ -16,7 +16,7 @@
 #include "utils/btorrng.h"
 #include "utils/btorstack.h"
 
-#define BTOR_BV_TYPE uint32_t
+#define BTOR_BV_TYPE uint64_t
 #define BTOR_BV_TYPE_BW (sizeof (BTOR_BV_TYPE) * 8)
 
 typedef struct BtorBitVector BtorBitVector;
@@ -163,6 +163,10 @@ uint32_t btor_bv_get_num_leading_zeros (const BtorBitVector *bv);
 /* count leading ones (starting from MSB) */
 uint32_t btor_bv_get_num_leading_ones (const BtorBitVector *bv);
 
+/* number of bits in which 'a' and 'b' differ */
+uint32_t btor_bv_hamming_distance (const BtorBitVector *a,
+                                   const BtorBitVector *b);
+
 /*------------------------------------------------------------------------*/
 
 #define btor_bv_zero(MM, BW) btor_bv_new (MM, BW)
@@ -429,6 +433,72 @@ BtorSpecialConstBitVector btor_bv_is_special_const (const BtorBitVector *bv);
 
 /*------------------------------------------------------------------------*/
 
+/**
+ * Destination-passing variants of the operations above.
+ *
+ * The result is written into the caller-owned bit-vector 'dst' instead of a
+ * new bit-vector, which must have the bit-width of the result.  Except for
+ * btor_bv_concat_into and btor_bv_slice_into, 'dst' may alias an operand.
+ */
+void btor_bv_copy_into (BtorBitVector *dst, const BtorBitVector *bv);
+void btor_bv_not_into (BtorBitVector *dst, const BtorBitVector *bv);
+void btor_bv_add_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_and_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_eq_into (BtorBitVector *dst,
+                      const BtorBitVector *a,
+                      const BtorBitVector *b);
+void btor_bv_ult_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_sll_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_srl_into (BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_mul_into (BtorMemMgr *mm,
+                       BtorBitVector *dst,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_udiv_into (BtorMemMgr *mm,
+                        BtorBitVector *dst,
+                        const BtorBitVector *a,
+                        const BtorBitVector *b);
+void btor_bv_urem_into (BtorMemMgr *mm,
+                        BtorBitVector *dst,
+                        const BtorBitVector *a,
+                        const BtorBitVector *b);
+void btor_bv_concat_into (BtorBitVector *dst,
+                          const BtorBitVector *a,
+                          const BtorBitVector *b);
+void btor_bv_slice_into (BtorBitVector *dst,
+                         const BtorBitVector *bv,
+                         uint32_t upper,
+                         uint32_t lower);
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * Pool of unused bit-vectors, indexed by bit-width.
+ *
+ * Bit-vectors taken from the pool are ordinary bit-vectors that may be freed
+ * via btor_bv_free, or returned to the pool for reuse via btor_bv_pool_put.
+ */
+typedef struct BtorBitVectorPool BtorBitVectorPool;
+
+BtorBitVectorPool *btor_bv_pool_new (BtorMemMgr *mm);
+/* Delete given pool and free all bit-vectors in it. */
+void btor_bv_pool_delete (BtorBitVectorPool *pool);
+
+/* Get a bit-vector of given bit-width from the pool (value is undefined). */
+BtorBitVector *btor_bv_pool_get (BtorBitVectorPool *pool, uint32_t bw);
+/* Return given bit-vector to the pool. */
+void btor_bv_pool_put (BtorBitVectorPool *pool, BtorBitVector *bv);
+
 struct BtorBitVectorTuple
 {
   uint32_t arity;
@@ -456,4 +526,22 @@ uint32_t btor_bv_hash_tuple (const BtorBitVectorTuple *t);
 
 /*------------------------------------------------------------------------*/
 
+/* Implementations of the bulk limb operations on wide bit-vectors. */
+enum BtorBvLimbOpsKind
+{
+  BTOR_BV_LIMB_OPS_AUTO, /* selected via CPUID on first use */
+  BTOR_BV_LIMB_OPS_SCALAR,
+  BTOR_BV_LIMB_OPS_SSE42,
+  BTOR_BV_LIMB_OPS_AVX2,
+};
+typedef enum BtorBvLimbOpsKind BtorBvLimbOpsKind;
+
+/* Force the limb operations of given kind for all subsequent operations.
+ * Returns false (and does not change anything) if they are not supported by
+ * the CPU or the build.  Intended for testing only, must not be called while
+ * bit-vectors are used concurrently. */
+bool btor_bv_set_limb_ops (BtorBvLimbOpsKind kind);
+
+/*------------------------------------------------------------------------*/
+
 #endif
@@ -366,7 +366,6 @@ chkclone_opts (Btor *btor, Btor *clone)
 static void
 chkclone_aig (BtorAIG *aig, BtorAIG *clone)
 {
-  int32_t i;
   BtorAIG *real_aig, *real_clone;
 
   real_aig   = BTOR_REAL_ADDR_AIG (aig);
@@ -378,13 +377,11 @@ chkclone_aig (BtorAIG *aig, BtorAIG *clone)
   {
     BTOR_CHKCLONE_AIG (id);
     BTOR_CHKCLONE_AIG (refs);
-    BTOR_CHKCLONE_AIG (next);
     BTOR_CHKCLONE_AIG (cnf_id);
     BTOR_CHKCLONE_AIG (mark);
     BTOR_CHKCLONE_AIG (is_var);
+    BTOR_CHKCLONE_AIG (encoded);
     BTOR_CHKCLONE_AIG (local);
-    if (!real_aig->is_var)
-      for (i = 0; i < 2; i++) BTOR_CHKCLONE_AIG (children[i]);
   }
 }
 
@@ -419,6 +416,27 @@ chkclone_aig_id_table (Btor *btor, Btor *clone)
     chkclone_aig (btable->start[i], ctable->start[i]);
 }
 
+static inline void
+chkclone_aig_structure_tables (Btor *btor, Btor *clone)
+{
+  uint32_t i;
+  BtorAIGMgr *bamgr, *camgr;
+
+  bamgr = btor_get_aig_mgr (btor);
+  camgr = btor_get_aig_mgr (clone);
+  assert (bamgr != camgr);
+
+  assert (BTOR_COUNT_STACK (bamgr->id2children)
+          == BTOR_COUNT_STACK (camgr->id2children));
+  for (i = 0; i < BTOR_COUNT_STACK (bamgr->id2children); i++)
+    assert (bamgr->id2children.start[i] == camgr->id2children.start[i]);
+
+  assert (BTOR_COUNT_STACK (bamgr->id2next)
+          == BTOR_COUNT_STACK (camgr->id2next));
+  for (i = 0; i < BTOR_COUNT_STACK (bamgr->id2next); i++)
+    assert (bamgr->id2next.start[i] == camgr->id2next.start[i]);
+}
+
 static inline void
 chkclone_aig_cnf_id_table (Btor *btor, Btor *clone)
 {
@@ -549,13 +567,8 @@ btor_chkclone_exp (Btor *btor,
   else if (real_exp->rho)
     chkclone_node_ptr_hash_table (real_exp->rho, real_cexp->rho, 0);
 
-  BTOR_CHKCLONE_EXPPTRID (next);
   BTOR_CHKCLONE_EXPPTRID (simplified);
-  BTOR_CHKCLONE_EXPPTRID (first_parent);
-  BTOR_CHKCLONE_EXPPTRID (last_parent);
   BTOR_CHKCLONE_EXPPTRINV (simplified);
-  BTOR_CHKCLONE_EXPPTRTAG (first_parent);
-  BTOR_CHKCLONE_EXPPTRTAG (last_parent);
 
   if (btor_node_is_proxy (real_exp)) return;
 
@@ -577,14 +590,6 @@ btor_chkclone_exp (Btor *btor,
       assert (btor_node_bv_slice_get_lower (real_exp)
               == btor_node_bv_slice_get_lower (real_cexp));
     }
-
-    for (i = 0; i < real_exp->arity; i++)
-    {
-      BTOR_CHKCLONE_EXPPTRID (prev_parent[i]);
-      BTOR_CHKCLONE_EXPPTRID (next_parent[i]);
-      BTOR_CHKCLONE_EXPPTRTAG (prev_parent[i]);
-      BTOR_CHKCLONE_EXPPTRTAG (next_parent[i]);
-    }
   }
 
 #if 0
@@ -715,6 +720,21 @@ chkclone_node_id_table (Btor *btor, Btor *clone)
 
   assert (BTOR_COUNT_STACK (*btable) == BTOR_COUNT_STACK (*ctable));
 
+  /* parent and sibling links refer to nodes by id */
+  assert (BTOR_COUNT_STACK (btor->parent_links)
+          == BTOR_COUNT_STACK (clone->parent_links));
+  assert (!memcmp (btor->parent_links.start,
+                   clone->parent_links.start,
+                   BTOR_COUNT_STACK (btor->parent_links)
+                       * sizeof (BtorNodeParentLinks)));
+  assert (BTOR_COUNT_STACK (btor->sibling_links)
+          == BTOR_COUNT_STACK (clone->sibling_links));
+  assert (!BTOR_COUNT_STACK (btor->sibling_links)
+          || !memcmp (btor->sibling_links.start,
+                      clone->sibling_links.start,
+                      BTOR_COUNT_STACK (btor->sibling_links)
+                          * sizeof (BtorNodeSiblingLinks)));
+
   for (i = 0; i < BTOR_COUNT_STACK (*btable); i++)
   {
     if (!BTOR_PEEK_STACK (*btable, i))
@@ -732,8 +752,6 @@ chkclone_node_id_table (Btor *btor, Btor *clone)
 
 /*------------------------------------------------------------------------*/
 
-/* Note: no need to check next pointers here as we catch all of them when
- *	 traversing through nodes id table. */
 static inline void
 chkclone_node_unique_table (Btor *btor, Btor *clone)
 {
@@ -748,12 +766,13 @@ chkclone_node_unique_table (Btor *btor, Btor *clone)
 
   for (i = 0; i < btable->size; i++)
   {
-    if (!btable->chains[i])
+    assert (btable->hashes[i] == ctable->hashes[i]);
+    if (!btable->slots[i])
     {
-      assert (!ctable->chains[i]);
+      assert (!ctable->slots[i]);
       continue;
     }
-    BTOR_CHKCLONE_EXPID (btable->chains[i], ctable->chains[i]);
+    BTOR_CHKCLONE_EXPID (btable->slots[i], ctable->slots[i]);
   }
 }
 
@@ -816,7 +835,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->symbols->count == clone->symbols->count);
     assert (btor->symbols->hash == clone->symbols->hash);
     assert (btor->symbols->cmp == clone->symbols->cmp);
-    assert (!btor->symbols->first || clone->symbols->first);
+    assert (!btor->symbols->count || clone->symbols->count);
     btor_iter_hashptr_init (&pit, btor->symbols);
     btor_iter_hashptr_init (&cpit, clone->symbols);
     while (btor_iter_hashptr_has_next (&pit))
@@ -837,7 +856,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->node2symbol->count == clone->node2symbol->count);
     assert (btor->node2symbol->hash == clone->node2symbol->hash);
     assert (btor->node2symbol->cmp == clone->node2symbol->cmp);
-    assert (!btor->node2symbol->first || clone->node2symbol->first);
+    assert (!btor->node2symbol->count || clone->node2symbol->count);
     btor_iter_hashptr_init (&pit, btor->node2symbol);
     btor_iter_hashptr_init (&cpit, clone->node2symbol);
     while (btor_iter_hashptr_has_next (&pit))
@@ -878,7 +897,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->parameterized->count == clone->parameterized->count);
     assert (btor->parameterized->hash == clone->parameterized->hash);
     assert (btor->parameterized->cmp == clone->parameterized->cmp);
-    assert (!btor->parameterized->first || clone->parameterized->first);
+    assert (!btor->parameterized->count || clone->parameterized->count);
     btor_iter_hashptr_init (&pit, btor->parameterized);
     btor_iter_hashptr_init (&cpit, clone->parameterized);
     while (btor_iter_hashptr_has_next (&pit))
@@ -1045,7 +1064,7 @@ chkclone_slv (Btor *btor, Btor *clone)
       assert (slv->score->count == cslv->score->count);
       assert (slv->score->hash == cslv->score->hash);
       assert (slv->score->cmp == cslv->score->cmp);
-      assert (!slv->score->first || cslv->score->first);
+      assert (!slv->score->count || cslv->score->count);
       if (h == BTOR_JUST_HEUR_BRANCH_MIN_APP)
       {
         btor_iter_hashptr_init (&it, slv->score);
@@ -1255,6 +1274,7 @@ btor_chkclone (Btor *btor, Btor *clone)
   {
     chkclone_aig_unique_table (btor, clone);
     chkclone_aig_id_table (btor, clone);
+    chkclone_aig_structure_tables (btor, clone);
     chkclone_aig_cnf_id_table (btor, clone);
   }
 
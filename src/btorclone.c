@@ -83,21 +83,6 @@ btor_clone_key_as_bv_tuple (BtorMemMgr *mm, const void *map, const void *t)
   return btor_bv_copy_tuple (mm, (BtorBitVectorTuple *) t);
 }
 
-void *
-btor_clone_key_as_rw_cache_tuple (BtorMemMgr *mm,
-                                  const void *map,
-                                  const void *t)
-{
-  assert (mm);
-  assert (t);
-  (void) map;
-
-  BtorRwCacheTuple *res;
-  BTOR_CNEW (mm, res);
-  memcpy (res, t, sizeof (BtorRwCacheTuple));
-  return res;
-}
-
 void
 btor_clone_data_as_node_ptr (BtorMemMgr *mm,
                              const void *map,
@@ -484,7 +469,6 @@ clone_sorts_unique_table (BtorMemMgr * mm,
 static BtorNode *
 clone_exp (Btor *clone,
            BtorNode *exp,
-           BtorNodePtrPtrStack *parents,
            BtorNodePtrPtrStack *nodes,
            BtorNodePtrStack *rhos,
            BtorNodePtrStack *static_rhos,
@@ -495,7 +479,6 @@ clone_exp (Btor *clone,
   assert (clone);
   assert (exp);
   assert (btor_node_is_regular (exp));
-  assert (parents);
   assert (nodes);
   assert (exp_map);
 
@@ -533,9 +516,6 @@ clone_exp (Btor *clone,
   else if (exp->av)
     res->av = exp_layer_only ? 0 : btor_aigvec_clone (exp->av, clone->avmgr);
 
-  assert (!exp->next || !btor_node_is_invalid (exp->next));
-  BTOR_PUSH_STACK_IF (exp->next, *nodes, &res->next);
-
   assert (!btor_node_is_simplified (exp) || !btor_node_is_invalid (exp->simplified));
   if (clone_simplified || btor_node_is_proxy (exp))
   {
@@ -547,12 +527,6 @@ clone_exp (Btor *clone,
   }
 
   res->btor = clone;
-
-  assert (!exp->first_parent || !btor_node_is_invalid (exp->first_parent));
-  assert (!exp->last_parent || !btor_node_is_invalid (exp->last_parent));
-
-  BTOR_PUSH_STACK_IF (exp->first_parent, *parents, &res->first_parent);
-  BTOR_PUSH_STACK_IF (exp->last_parent, *parents, &res->last_parent);
   /* <---------------------------------------------------------------------- */
 
   /* ------------ BTOR_BV_ADDITIONAL_VAR_NODE_STRUCT (all nodes) ----------> */
@@ -569,19 +543,6 @@ clone_exp (Btor *clone,
           assert (res->e[i]);
         }
       }
-
-      for (i = 0; i < exp->arity; i++)
-      {
-        assert (!exp->prev_parent[i]
-                || !btor_node_is_invalid (exp->prev_parent[i]));
-        assert (!exp->next_parent[i]
-                || !btor_node_is_invalid (exp->next_parent[i]));
-
-        BTOR_PUSH_STACK_IF (
-            exp->prev_parent[i], *parents, &res->prev_parent[i]);
-        BTOR_PUSH_STACK_IF (
-            exp->next_parent[i], *parents, &res->next_parent[i]);
-      }
     }
   }
   /* <---------------------------------------------------------------------- */
@@ -661,6 +622,22 @@ btor_clone_node_ptr_stack (BtorMemMgr *mm,
   assert (BTOR_SIZE_STACK (*stack) == BTOR_SIZE_STACK (*res));
 }
 
+/* Copies a stack of plain data, keeping its size. */
+#define CLONE_DATA_STACK(mm, stack, res)                               \
+  do                                                                   \
+  {                                                                    \
+    BTOR_INIT_STACK ((mm), (res));                                     \
+    if (BTOR_SIZE_STACK (stack))                                       \
+    {                                                                  \
+      BTOR_NEWN ((mm), (res).start, BTOR_SIZE_STACK (stack));          \
+      (res).top = (res).start + BTOR_COUNT_STACK (stack);              \
+      (res).end = (res).start + BTOR_SIZE_STACK (stack);               \
+      memcpy ((res).start,                                             \
+              (stack).start,                                           \
+              BTOR_COUNT_STACK (stack) * sizeof (*(stack).start));     \
+    }                                                                  \
+  } while (0)
+
 static void
 clone_nodes_id_table (Btor *btor,
                       Btor *clone,
@@ -676,18 +653,16 @@ clone_nodes_id_table (Btor *btor,
   assert (exp_map);
 
   size_t i;
-  int32_t tag;
   BtorNode **tmp, *exp, *cloned_exp;
   BtorMemMgr *mm;
   BtorNodePtrStack *id_table;
-  BtorNodePtrPtrStack parents, nodes;
+  BtorNodePtrPtrStack nodes;
   BtorPtrHashTable *t;
   BtorNodePtrStack static_rhos;
 
   mm       = clone->mm;
   id_table = &btor->nodes_id_table;
 
-  BTOR_INIT_STACK (mm, parents);
   BTOR_INIT_STACK (mm, nodes);
   BTOR_INIT_STACK (mm, static_rhos);
 
@@ -707,7 +682,6 @@ clone_nodes_id_table (Btor *btor,
       exp           = id_table->start[i];
       res->start[i] = exp ? clone_exp (clone,
                                        exp,
-                                       &parents,
                                        &nodes,
                                        rhos,
                                        &static_rhos,
@@ -731,15 +705,11 @@ clone_nodes_id_table (Btor *btor,
     assert (*tmp);
   }
 
-  while (!BTOR_EMPTY_STACK (parents))
-  {
-    tmp = BTOR_POP_STACK (parents);
-    assert (*tmp);
-    tag  = btor_node_get_tag (*tmp);
-    *tmp = btor_nodemap_mapped (exp_map, btor_node_real_addr (*tmp));
-    assert (*tmp);
-    *tmp = btor_node_set_tag (*tmp, tag);
-  }
+  /* parent and sibling links refer to nodes by id and can be copied as is */
+  assert (BTOR_COUNT_STACK (btor->parent_links)
+          == BTOR_COUNT_STACK (*id_table));
+  CLONE_DATA_STACK (mm, btor->parent_links, clone->parent_links);
+  CLONE_DATA_STACK (mm, btor->sibling_links, clone->sibling_links);
 
   /* clone static_rho tables */
   while (!BTOR_EMPTY_STACK (static_rhos))
@@ -760,7 +730,6 @@ clone_nodes_id_table (Btor *btor,
                                   exp_map));
   }
 
-  BTOR_RELEASE_STACK (parents);
   BTOR_RELEASE_STACK (nodes);
   BTOR_RELEASE_STACK (static_rhos);
 }
@@ -780,15 +749,18 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
   table = &btor->nodes_unique_table;
   res   = &clone->nodes_unique_table;
 
-  BTOR_CNEWN (mm, res->chains, table->size);
+  BTOR_CNEWN (mm, res->slots, table->size);
+  BTOR_NEWN (mm, res->hashes, table->size);
   res->size         = table->size;
   res->num_elements = table->num_elements;
 
+  /* node ids are preserved, hence the cached hash values remain valid */
+  memcpy (res->hashes, table->hashes, table->size * sizeof (*table->hashes));
   for (i = 0; i < table->size; i++)
   {
-    if (!table->chains[i]) continue;
-    res->chains[i] = btor_nodemap_mapped (exp_map, table->chains[i]);
-    assert (res->chains[i]);
+    if (!table->slots[i]) continue;
+    res->slots[i] = btor_nodemap_mapped (exp_map, table->slots[i]);
+    assert (res->slots[i]);
   }
 }
 
@@ -803,8 +775,8 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
            : 0)
 
 #define MEM_PTR_HASH_TABLE(table)                                             \
-  ((table) ? sizeof (*(table)) + (table)->size * sizeof (BtorPtrHashBucket *) \
-                 + (table)->count * sizeof (BtorPtrHashBucket)                \
+  ((table) ? sizeof (*(table)) + (table)->size * sizeof (BtorPtrHashSlot)     \
+                 + (table)->max_buckets * sizeof (BtorPtrHashBucket)          \
            : 0)
 
 #define CHKCLONE_MEM_INT_HASH_TABLE(table, clone)                      \
@@ -906,6 +878,9 @@ clone_aux_btor (Btor *btor,
 #endif
   memcpy (clone, btor, sizeof (Btor));
   clone->mm = mm;
+#ifdef BTOR_HAVE_PTHREADS
+  btor_init_api_lock (clone);
+#endif
   btor_rng_clone (&btor->rng, &clone->rng);
 
   BTOR_CLR (&clone->cbs);
@@ -1015,8 +990,12 @@ clone_aux_btor (Btor *btor,
       clone->avmgr = btor_aigvec_mgr_new (clone);
       assert ((allocated += sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
                             + sizeof (BtorSATMgr)
+                            /* AIG node slab */
+                            + sizeof (BtorMemSlab)
                             /* true and false AIGs */
                             + 2 * sizeof (BtorAIG *)
+                            /* children and chain links of true and false */
+                            + 4 * sizeof (int32_t) + 2 * sizeof (int32_t)
                             + sizeof (int32_t)) /* unique table chains */
               == clone->mm->allocated);
     }
@@ -1029,13 +1008,13 @@ clone_aux_btor (Btor *btor,
       allocated +=
           sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
           + sizeof (BtorSATMgr)
-          /* memory of AIG nodes */
-          + (amgr->cur_num_aigs + amgr->cur_num_aig_vars) * sizeof (BtorAIG)
-          /* children for AND AIGs */
-          + amgr->cur_num_aigs * sizeof (int32_t) * 2
+          /* memory of AIG nodes (chunks of the cloned node slab) */
+          + sizeof (BtorMemSlab) + clone->avmgr->amgr->slab->allocated
           /* unique table chain */
           + amgr->table.size * sizeof (int32_t)
           + BTOR_SIZE_STACK (amgr->id2aig) * sizeof (BtorAIG *)
+          + BTOR_SIZE_STACK (amgr->id2children) * sizeof (int32_t)
+          + BTOR_SIZE_STACK (amgr->id2next) * sizeof (int32_t)
           + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t);
 #ifdef BTOR_USE_LINGELING
       assert (strcmp (amgr->smgr->name, "Lingeling") == 0
@@ -1111,10 +1090,14 @@ clone_aux_btor (Btor *btor,
     if (btor_node_is_lambda (cur) && btor_node_lambda_get_static_rho (cur))
       allocated += MEM_PTR_HASH_TABLE (btor_node_lambda_get_static_rho (cur));
   }
-  /* Note: hash table is initialized with size 1 */
-  allocated += (emap->table->size - 1) * sizeof (BtorPtrHashBucket *)
-               + emap->table->count * sizeof (BtorPtrHashBucket)
-               + BTOR_SIZE_STACK (btor->nodes_id_table) * sizeof (BtorNode *);
+  /* Note: hash table is initialized with size 4 */
+  allocated += (emap->table->size - 4) * sizeof (BtorPtrHashSlot)
+               + emap->table->max_buckets * sizeof (BtorPtrHashBucket)
+               + BTOR_SIZE_STACK (btor->nodes_id_table) * sizeof (BtorNode *)
+               + BTOR_SIZE_STACK (btor->parent_links)
+                     * sizeof (BtorNodeParentLinks)
+               + BTOR_SIZE_STACK (btor->sibling_links)
+                     * sizeof (BtorNodeSiblingLinks);
   assert (allocated == clone->mm->allocated);
 #endif
 
@@ -1126,7 +1109,8 @@ clone_aux_btor (Btor *btor,
   BTORLOG (2,
            "  clone nodes unique table: %.3f s",
            (btor_util_time_stamp () - delta));
-  assert ((allocated += btor->nodes_unique_table.size * sizeof (BtorNode *))
+  assert ((allocated += btor->nodes_unique_table.size
+                        * (sizeof (BtorNode *) + sizeof (uint32_t)))
           == clone->mm->allocated);
 
   clone->symbols = btor_hashptr_table_clone (mm,
@@ -1365,14 +1349,11 @@ clone_aux_btor (Btor *btor,
   assert (allocated == clone->mm->allocated);
 #endif
   BTOR_NEW (mm, clone->rw_cache);
-  clone->rw_cache->btor  = clone;
-  clone->rw_cache->cache = btor_hashptr_table_clone (
-      mm, btor->rw_cache->cache, btor_clone_key_as_rw_cache_tuple, 0, 0, 0);
+  btor_rw_cache_clone (btor->rw_cache, clone->rw_cache, clone);
 #ifndef NDEBUG
-  CHKCLONE_MEM_PTR_HASH_TABLE (btor->rw_cache->cache, clone->rw_cache->cache);
   allocated += sizeof (*btor->rw_cache);
-  allocated += btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple);
-  allocated += MEM_PTR_HASH_TABLE (btor->rw_cache->cache);
+  allocated += btor_rw_cache_size (btor->rw_cache);
+  assert (allocated == clone->mm->allocated);
 #endif
 
   /* move synthesized constraints to unsynthesized if we only clone the exp
@@ -1482,9 +1463,9 @@ clone_aux_btor (Btor *btor,
       {
         assert (BTOR_PEEK_STACK (cslv->moves, i));
         m = BTOR_PEEK_STACK (cslv->moves, i);
-        assert (MEM_PTR_HASH_TABLE (m->cans)
-                == MEM_PTR_HASH_TABLE (BTOR_PEEK_STACK (cslv->moves, i)->cans));
-        allocated += MEM_PTR_HASH_TABLE (m->cans);
+        assert (MEM_INT_HASH_MAP (m->cans)
+                == MEM_INT_HASH_MAP (BTOR_PEEK_STACK (cslv->moves, i)->cans));
+        allocated += MEM_INT_HASH_MAP (m->cans);
         btor_iter_hashint_init (&iit, m->cans);
         while (btor_iter_hashint_has_next (&iit))
           allocated +=
@@ -1495,7 +1476,7 @@ clone_aux_btor (Btor *btor,
       {
         assert (slv->max_cans);
         assert (slv->max_cans->count == cslv->max_cans->count);
-        allocated += MEM_PTR_HASH_TABLE (cslv->max_cans);
+        allocated += MEM_INT_HASH_MAP (cslv->max_cans);
         btor_iter_hashint_init (&iit, cslv->max_cans);
         while (btor_iter_hashint_has_next (&iit))
           allocated +=
@@ -1510,8 +1491,8 @@ clone_aux_btor (Btor *btor,
       CHKCLONE_MEM_INT_HASH_MAP (slv->roots, cslv->roots);
       CHKCLONE_MEM_INT_HASH_MAP (slv->score, cslv->score);
 
-      allocated += sizeof (BtorPropSolver) + MEM_PTR_HASH_TABLE (cslv->roots)
-                   + MEM_PTR_HASH_TABLE (cslv->score);
+      allocated += sizeof (BtorPropSolver) + MEM_INT_HASH_MAP (cslv->roots)
+                   + MEM_INT_HASH_MAP (cslv->score);
     }
     else if (clone->slv->kind == BTOR_AIGPROP_SOLVER_KIND)
     {
@@ -1521,13 +1502,13 @@ clone_aux_btor (Btor *btor,
       if (slv->aprop)
       {
         assert (cslv->aprop);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->roots, cslv->aprop->roots);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->score, cslv->aprop->score);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->model, cslv->aprop->model);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->roots, cslv->aprop->roots);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->score, cslv->aprop->score);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->model, cslv->aprop->model);
         allocated += sizeof (BtorAIGProp)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->roots)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->score)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->model);
+                     + MEM_INT_HASH_MAP (cslv->aprop->roots)
+                     + MEM_INT_HASH_MAP (cslv->aprop->score)
+                     + MEM_INT_HASH_MAP (cslv->aprop->model);
       }
 
       allocated += sizeof (BtorAIGPropSolver);
@@ -1542,6 +1523,10 @@ clone_aux_btor (Btor *btor,
   clone->clone = NULL;
 #endif
   clone->close_apitrace = 0;
+  clone->result_cache   = 0;
+  clone->cnf_stream     = 0;
+  clone->ext_sat_cmd =
+      btor->ext_sat_cmd ? btor_mem_strdup (mm, btor->ext_sat_cmd) : 0;
 
   if (exp_map)
     *exp_map = emap;
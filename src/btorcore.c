@@ -11,6 +11,8 @@
 #include <limits.h>
 
 #include "btorabort.h"
+#include "btoraigfraig.h"
+#include "btoraigrw.h"
 #ifndef NDEBUG
 #include "btorchkfailed.h"
 #include "btorchkmodel.h"
@@ -53,6 +55,24 @@
     BTOR_DELETEN (mm, (table).chains, (table).size); \
   } while (0)
 
+#define BTOR_INIT_NODE_UNIQUE_TABLE(mm, table) \
+  do                                           \
+  {                                            \
+    assert (mm);                               \
+    (table).size         = 1;                  \
+    (table).num_elements = 0;                  \
+    BTOR_CNEW (mm, (table).slots);             \
+    BTOR_CNEW (mm, (table).hashes);            \
+  } while (0)
+
+#define BTOR_RELEASE_NODE_UNIQUE_TABLE(mm, table)    \
+  do                                                 \
+  {                                                  \
+    assert (mm);                                     \
+    BTOR_DELETEN (mm, (table).slots, (table).size);  \
+    BTOR_DELETEN (mm, (table).hashes, (table).size); \
+  } while (0)
+
 #define BTOR_INIT_SORT_UNIQUE_TABLE(mm, table) \
   do                                           \
   {                                            \
@@ -512,14 +532,20 @@ btor_print_stats (Btor *btor)
   BTOR_MSG (btor->msg, 1, "  %lld cached (add) ", btor->rw_cache->num_add);
   BTOR_MSG (btor->msg, 1, "  %lld cached (get)", btor->rw_cache->num_get);
   BTOR_MSG (btor->msg, 1, "  %lld updated", btor->rw_cache->num_update);
-  BTOR_MSG (btor->msg, 1, "  %lld removed (gc)", btor->rw_cache->num_remove);
+  BTOR_MSG (btor->msg, 1, "  %lld replaced", btor->rw_cache->num_remove);
   BTOR_MSG (btor->msg,
             1,
             "  %.2f MB cache",
-            (btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple)
-             + btor->rw_cache->cache->count * sizeof (BtorPtrHashBucket)
-             + btor->rw_cache->cache->size * sizeof (BtorPtrHashBucket *))
-                / (double) (1 << 20));
+            btor_rw_cache_size (btor->rw_cache) / (double) (1 << 20));
+
+  if (btor->result_cache)
+  {
+    BTOR_MSG (btor->msg, 1, "");
+    BTOR_MSG (btor->msg, 1, "result cache");
+    BTOR_MSG (btor->msg, 1, "  %lld lookups", btor->result_cache->num_get);
+    BTOR_MSG (btor->msg, 1, "  %lld hits", btor->result_cache->num_hit);
+    BTOR_MSG (btor->msg, 1, "  %lld added", btor->result_cache->num_add);
+  }
 
 #ifndef NDEBUG
   BtorPtrHashTableIterator it;
@@ -556,6 +582,23 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld AIG variables",
             btor->avmgr ? btor->avmgr->amgr->max_num_aig_vars : 0);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs saved by rewriting",
+              btor->avmgr ? btor->avmgr->amgr->num_rw_saved_ands : 0);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_FRAIG))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs merged by fraiging",
+              btor->avmgr ? btor->avmgr->amgr->num_fraig_merged : 0);
+  if (btor->avmgr && btor->avmgr->amgr->num_sim_patterns)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG simulation patterns (%.0f patterns per second)",
+              btor->avmgr->amgr->num_sim_patterns,
+              btor->avmgr->amgr->num_sim_patterns
+                  / BTOR_MAX_UTIL (btor->avmgr->amgr->time_sim, 1e-6));
   BTOR_MSG (btor->msg,
             1,
             "  %7lld CNF variables",
@@ -672,6 +715,7 @@ btor_new (void)
 {
   BtorMemMgr *mm;
   Btor *btor;
+  BtorNodeParentLinks no_links;
 
   mm = btor_mem_mgr_new ();
   BTOR_CNEW (mm, btor);
@@ -680,14 +724,21 @@ btor_new (void)
   btor->msg = btor_msg_new (btor);
   btor_set_msg_prefix (btor, "btor");
 
-  BTOR_INIT_UNIQUE_TABLE (mm, btor->nodes_unique_table);
+  BTOR_INIT_NODE_UNIQUE_TABLE (mm, btor->nodes_unique_table);
   BTOR_INIT_SORT_UNIQUE_TABLE (mm, btor->sorts_unique_table);
   BTOR_INIT_STACK (btor->mm, btor->nodes_id_table);
   BTOR_PUSH_STACK (btor->nodes_id_table, 0);
+  BTOR_INIT_STACK (btor->mm, btor->parent_links);
+  BTOR_CLR (&no_links);
+  BTOR_PUSH_STACK (btor->parent_links, no_links);
+  BTOR_INIT_STACK (btor->mm, btor->sibling_links);
   BTOR_INIT_STACK (btor->mm, btor->functions_with_model);
   BTOR_INIT_STACK (btor->mm, btor->outputs);
 
   btor_opt_init_opts (btor);
+#ifdef BTOR_HAVE_PTHREADS
+  btor_init_api_lock (btor);
+#endif
 
   btor->avmgr = btor_aigvec_mgr_new (btor);
 
@@ -886,6 +937,24 @@ btor_delete_varsubst_constraints (Btor *btor)
   btor_hashptr_table_delete (btor->varsubst_constraints);
 }
 
+#ifdef BTOR_HAVE_PTHREADS
+void
+btor_init_api_lock (Btor *btor)
+{
+  assert (btor);
+
+  pthread_mutexattr_t attr;
+
+  /* the parsers and callbacks issue API calls while the lock is held */
+  pthread_mutexattr_init (&attr);
+  pthread_mutexattr_settype (&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init (&btor->api_mutex, &attr);
+  pthread_mutexattr_destroy (&attr);
+  btor->api_lock_depth = 0;
+  btor->api_lock_outer = 0;
+}
+#endif
+
 void
 btor_delete (Btor *btor)
 {
@@ -1020,8 +1089,10 @@ btor_delete (Btor *btor)
   }
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKEXP") || !node_leak);
 #endif
-  BTOR_RELEASE_UNIQUE_TABLE (mm, btor->nodes_unique_table);
+  BTOR_RELEASE_NODE_UNIQUE_TABLE (mm, btor->nodes_unique_table);
   BTOR_RELEASE_STACK (btor->nodes_id_table);
+  BTOR_RELEASE_STACK (btor->parent_links);
+  BTOR_RELEASE_STACK (btor->sibling_links);
 
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKSORT")
           || btor->sorts_unique_table.num_elements == 0);
@@ -1052,9 +1123,15 @@ btor_delete (Btor *btor)
 
   btor_rw_cache_delete (btor->rw_cache);
   BTOR_DELETE (mm, btor->rw_cache);
+  if (btor->result_cache) btor_result_cache_delete (btor->result_cache);
+  if (btor->cnf_stream) btor_mem_freestr (btor->mm, btor->cnf_stream);
+  if (btor->ext_sat_cmd) btor_mem_freestr (btor->mm, btor->ext_sat_cmd);
 
   assert (btor->rec_rw_calls == 0);
   btor_msg_delete (btor->msg);
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_destroy (&btor->api_mutex);
+#endif
   BTOR_DELETE (mm, btor);
   btor_mem_mgr_delete (mm);
 }
@@ -1088,7 +1165,7 @@ btor_process_unsynthesized_constraints (Btor *btor)
 
   while (uc->count > 0)
   {
-    bucket = uc->first;
+    bucket = btor_hashptr_table_first (uc);
     assert (bucket);
     cur = (BtorNode *) bucket->key;
 
@@ -1811,7 +1888,8 @@ exp_to_cnf_lit (Btor *btor, BtorNode *exp)
       sign *= -1;
     }
 
-    if (!aig->cnf_id) btor_aig_to_sat_tseitin (amgr, aig);
+    if (!aig->cnf_id || aig->encoded != BTOR_AIG_ENC_FULL)
+      btor_aig_to_sat_tseitin (amgr, aig);
 
     res = aig->cnf_id;
     btor_aig_release (amgr, aig);
@@ -2466,15 +2544,54 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
+/* optimize the AIGs of the given synthesized nodes as a whole and (if
+ * 'encode' is true) encode them to CNF */
+static void
+optimize_and_encode (Btor *btor,
+                     BtorNodePtrStack *nodes,
+                     bool fraig,
+                     bool encode)
+{
+  BtorAIGVecMgr *avmgr;
+  BtorAIGPtrStack aigs;
+  BtorNode *cur;
+  uint32_t i, j, k;
+
+  avmgr = btor->avmgr;
+  BTOR_INIT_STACK (btor->mm, aigs);
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    for (j = 0; j < cur->av->width; j++)
+      BTOR_PUSH_STACK (aigs, cur->av->aigs[j]);
+  }
+
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE))
+    btor_aigrw_rewrite (avmgr->amgr, aigs.start, BTOR_COUNT_STACK (aigs));
+  if (fraig)
+    btor_aigfraig_sweep (avmgr->amgr, aigs.start, BTOR_COUNT_STACK (aigs));
+
+  for (i = 0, k = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    for (j = 0; j < cur->av->width; j++, k++)
+      cur->av->aigs[j] = BTOR_PEEK_STACK (aigs, k);
+    if (encode) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+  }
+  BTOR_RELEASE_STACK (aigs);
+}
+
 /* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
- * then it is also encoded. with option lazy_synthesize enabled,
- * 'btor_synthesize_exp' stops at feq and apply nodes */
+ * then it is also encoded (with option aig_polarity enabled, only inputs are
+ * encoded, all other AIGs are encoded when asserted or assumed).
+ * with option lazy_synthesize enabled, 'btor_synthesize_exp' stops at feq and
+ * apply nodes */
 void
 btor_synthesize_exp (Btor *btor,
                      BtorNode *exp,
                      BtorPtrHashTable *backannotation)
 {
-  BtorNodePtrStack exp_stack;
+  BtorNodePtrStack exp_stack, unencoded;
   BtorNode *cur, *value, *args;
   BtorAIGVec *av0, *av1, *av2;
   BtorMemMgr *mm;
@@ -2490,20 +2607,35 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av1 = false;
   bool invert_av2 = false;
   double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, opt_aig_rewrite, opt_aig_fraig, opt_aig_pol;
+  bool defer;
   BtorIntHashTable *cache;
 
   assert (btor);
   assert (exp);
 
-  start          = btor_util_time_stamp ();
-  mm             = btor->mm;
-  avmgr          = btor->avmgr;
-  count          = 0;
-  cache          = btor_hashint_table_new (mm);
-  opt_lazy_synth = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  start           = btor_util_time_stamp ();
+  mm              = btor->mm;
+  avmgr           = btor->avmgr;
+  count           = 0;
+  cache           = btor_hashint_table_new (mm);
+  opt_lazy_synth  = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  opt_aig_rewrite = btor_opt_get (btor, BTOR_OPT_AIG_REWRITE) == 1;
+  /* SAT sweeping requires an incremental SAT solver and must not interfere
+   * with printing the CNF */
+  opt_aig_fraig = btor_opt_get (btor, BTOR_OPT_AIG_FRAIG) == 1
+                  && btor_sat_is_initialized (avmgr->amgr->smgr)
+                  && btor_sat_mgr_has_incremental_support (avmgr->amgr->smgr)
+                  && !btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS);
+  opt_aig_pol = btor_opt_get (btor, BTOR_OPT_AIG_POLARITY) == 1;
+  /* optimize all synthesized AIGs at once if they are not encoded per node,
+   * otherwise the same (unencoded) cones are optimized over and over */
+  defer = opt_aig_fraig
+          || (opt_aig_pol && opt_aig_rewrite
+              && btor_sat_is_initialized (avmgr->amgr->smgr));
 
   BTOR_INIT_STACK (mm, exp_stack);
+  BTOR_INIT_STACK (mm, unencoded);
   BTOR_PUSH_STACK (exp_stack, exp);
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
 
@@ -2702,7 +2834,6 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -2751,9 +2882,22 @@ btor_synthesize_exp (Btor *btor,
       }
       assert (cur->av);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+      /* AIGs are optimized (and encoded) at once after all nodes are
+       * synthesized */
+      if (defer)
+      {
+        BTOR_PUSH_STACK (unencoded, cur);
+        continue;
+      }
+      /* optimize AIGs before they are encoded to CNF */
+      if (opt_aig_rewrite && btor_sat_is_initialized (avmgr->amgr->smgr))
+        btor_aigrw_rewrite (avmgr->amgr, cur->av->aigs, cur->av->width);
+      if (!opt_aig_pol) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
+  if (!BTOR_EMPTY_STACK (unencoded))
+    optimize_and_encode (btor, &unencoded, opt_aig_fraig, !opt_aig_pol);
+  BTOR_RELEASE_STACK (unencoded);
   BTOR_RELEASE_STACK (exp_stack);
   btor_hashint_table_delete (cache);
 
@@ -2883,6 +3027,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   double start, delta;
   BtorSolverResult res;
   uint32_t engine;
+  bool use_cache, cached = false;
+  BtorResultCacheKey key;
 
   start = btor_util_time_stamp ();
 
@@ -2971,7 +3117,28 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   res = btor_simplify (btor);
 
-  if (res != BTOR_RESULT_UNSAT)
+  /* Without model generation, SAT and UNSAT results of previous identical
+   * queries can be taken from the persistent result cache. Failed assumptions
+   * can only be determined by solving, hence an UNSAT result is not used if
+   * there are assumptions. */
+  use_cache = btor->result_cache && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+  if (res != BTOR_RESULT_UNSAT && use_cache)
+  {
+    btor_result_cache_key (btor, &key);
+    res = btor_result_cache_get (btor->result_cache, &key);
+    if (res == BTOR_RESULT_UNSAT && btor->assumptions->count > 0)
+      res = BTOR_RESULT_UNKNOWN;
+    if (res != BTOR_RESULT_UNKNOWN)
+    {
+      BTOR_MSG (btor->msg, 1, "found result in result cache");
+      cached = true;
+#ifndef NDEBUG
+      check = false;
+#endif
+    }
+  }
+
+  if (res != BTOR_RESULT_UNSAT && !cached)
   {
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
@@ -3031,6 +3198,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
     assert (btor->slv);
     res = btor->slv->api.sat (btor->slv);
+
+    if (use_cache && (res == BTOR_RESULT_SAT || res == BTOR_RESULT_UNSAT))
+      btor_result_cache_add (btor->result_cache, &key, res);
   }
   btor->last_sat_result = res;
   btor->btor_sat_btor_called++;
@@ -3066,7 +3236,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (chkmodel)
   {
-    if (res == BTOR_RESULT_SAT && !btor_opt_get (btor, BTOR_OPT_UCOPT))
+    if (check && res == BTOR_RESULT_SAT
+        && !btor_opt_get (btor, BTOR_OPT_UCOPT))
     {
       btor_check_model (chkmodel);
     }
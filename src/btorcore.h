@@ -13,6 +13,7 @@
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
+#include "btorrescache.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
 #include "btorslv.h"
@@ -23,6 +24,9 @@
 #include "utils/btorrng.h"
 
 #include <stdbool.h>
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -49,11 +53,15 @@
 
 /*------------------------------------------------------------------------*/
 
+/* Open addressing hash table with robin hood probing. The full hash of each
+ * node is cached in 'hashes', which allows to reject most mismatches without
+ * accessing the node itself. */
 struct BtorNodeUniqueTable
 {
   uint32_t size;
   uint32_t num_elements;
-  BtorNode **chains;
+  BtorNode **slots;
+  uint32_t *hashes;
 };
 
 typedef struct BtorNodeUniqueTable BtorNodeUniqueTable;
@@ -94,6 +102,8 @@ struct Btor
   BtorFunAssList *fun_assignments;
 
   BtorNodePtrStack nodes_id_table;
+  BtorNodeParentLinksStack parent_links;   /* indexed by node id */
+  BtorNodeSiblingLinksStack sibling_links; /* see 'BtorNodeParentLinks' */
   BtorNodeUniqueTable nodes_unique_table;
   BtorSortUniqueTable sorts_unique_table;
 
@@ -124,6 +134,9 @@ struct Btor
   uint32_t rec_rw_calls; /* calls for recursive rewriting */
   uint32_t valid_assignments;
   BtorRwCache *rw_cache;
+  BtorResultCache *result_cache; /* persistent SAT/UNSAT cache, optional */
+  char *cnf_stream; /* file the CNF is streamed to, optional */
+  char *ext_sat_cmd; /* command of the external SAT solver, optional */
 
   int32_t vis_idx; /* file index for visualizing expressions */
 
@@ -166,6 +179,12 @@ struct Btor
   FILE *apitrace;
   int8_t close_apitrace;
 
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_t api_mutex; /* for BTOR_OPT_THREAD_SAFE, recursive */
+  uint32_t api_lock_depth;   /* nesting depth of the holding thread */
+  Btor *api_lock_outer;      /* instance locked by the holder before */
+#endif
+
   BtorOpt *options;
   BtorPtrHashTable *str2opt;
 
@@ -242,6 +261,11 @@ Btor *btor_new (void);
 /* Deletes boolector. */
 void btor_delete (Btor *btor);
 
+#ifdef BTOR_HAVE_PTHREADS
+/* Initializes the (unlocked) API lock of a new or cloned instance. */
+void btor_init_api_lock (Btor *btor);
+#endif
+
 /* Gets version. */
 const char *btor_version (const Btor *btor);
 
@@ -55,16 +55,19 @@ btor_dbg_check_unique_table_children_proxy_free (const Btor *btor)
   BtorNode *cur;
 
   for (i = 0; i < btor->nodes_unique_table.size; i++)
-    for (cur = btor->nodes_unique_table.chains[i]; cur; cur = cur->next)
-      for (j = 0; j < cur->arity; j++)
-        if (btor_node_is_proxy (cur->e[j]))
-        {
-          BTORLOG (1,
-                   "found proxy node in unique table: %s (parent: %s)",
-                   btor_util_node2string (cur->e[j]),
-                   btor_util_node2string (cur));
-          return false;
-        }
+  {
+    cur = btor->nodes_unique_table.slots[i];
+    if (!cur) continue;
+    for (j = 0; j < cur->arity; j++)
+      if (btor_node_is_proxy (cur->e[j]))
+      {
+        BTORLOG (1,
+                 "found proxy node in unique table: %s (parent: %s)",
+                 btor_util_node2string (cur->e[j]),
+                 btor_util_node2string (cur));
+        return false;
+      }
+  }
   return true;
 }
 
@@ -113,16 +116,16 @@ btor_dbg_check_unique_table_rebuild (const Btor *btor)
   BtorNode *cur;
 
   for (i = 0; i < btor->nodes_unique_table.size; i++)
-    for (cur = btor->nodes_unique_table.chains[i]; cur; cur = cur->next)
+  {
+    cur = btor->nodes_unique_table.slots[i];
+    if (cur && cur->rebuild)
     {
-      if (cur->rebuild)
-      {
-        BTORLOG (1,
-                 "found node with rebuild flag enabled: %s",
-                 btor_util_node2string (cur));
-        return false;
-      }
+      BTORLOG (1,
+               "found node with rebuild flag enabled: %s",
+               btor_util_node2string (cur));
+      return false;
     }
+  }
   return true;
 }
 
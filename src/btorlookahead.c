@@ -0,0 +1,308 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorlookahead.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* Maximum number of candidate variables considered for a split. */
+#define BTOR_LOOKAHEAD_CANDIDATES 32
+
+/*------------------------------------------------------------------------*/
+
+struct BtorLookahead
+{
+  BtorMemMgr *mm;
+  int32_t maxvar;
+  int32_t *lits;           /* clauses */
+  int8_t *vals;            /* assignment of variables */
+  BtorUIntStack *watches;  /* offsets of watched clauses indexed by literal */
+  BtorIntStack trail;      /* assigned literals */
+  size_t next;             /* next literal on the trail to propagate */
+  int32_t *candidates;     /* candidate variables for splitting */
+  uint32_t num_candidates;
+};
+
+typedef struct BtorLookahead BtorLookahead;
+
+static uint32_t
+lit2idx (int32_t lit)
+{
+  return 2 * (uint32_t) abs (lit) + (lit < 0);
+}
+
+static int8_t
+val (BtorLookahead *la, int32_t lit)
+{
+  int8_t res = la->vals[abs (lit)];
+  return lit < 0 ? -res : res;
+}
+
+static void
+assign (BtorLookahead *la, int32_t lit)
+{
+  assert (!val (la, lit));
+  la->vals[abs (lit)] = lit < 0 ? -1 : 1;
+  BTOR_PUSH_STACK (la->trail, lit);
+}
+
+static void
+backtrack (BtorLookahead *la, size_t level)
+{
+  while (BTOR_COUNT_STACK (la->trail) > level)
+    la->vals[abs (BTOR_POP_STACK (la->trail))] = 0;
+  la->next = level;
+}
+
+/* Boolean constraint propagation with two watched literals, the watched
+ * literals of a clause are its first two literals. Returns false on
+ * conflict. */
+static bool
+propagate (BtorLookahead *la)
+{
+  BtorUIntStack *ws;
+  int32_t lit, *c, *l, tmp;
+  size_t i, j;
+
+  while (la->next < BTOR_COUNT_STACK (la->trail))
+  {
+    lit = -BTOR_PEEK_STACK (la->trail, la->next);
+    la->next += 1;
+    ws = la->watches + lit2idx (lit);
+    for (i = j = 0; i < BTOR_COUNT_STACK (*ws); i++)
+    {
+      c = la->lits + ws->start[i];
+      if (c[0] == lit)
+      {
+        c[0] = c[1];
+        c[1] = lit;
+      }
+      assert (c[1] == lit);
+      ws->start[j++] = ws->start[i];
+      if (val (la, c[0]) > 0) continue;
+      for (l = c + 2; *l && val (la, *l) < 0; l++)
+        ;
+      if (*l)
+      {
+        tmp  = *l;
+        *l   = lit;
+        c[1] = tmp;
+        BTOR_PUSH_STACK (la->watches[lit2idx (tmp)], ws->start[i]);
+        j -= 1;
+      }
+      else if (val (la, c[0]) < 0)
+      {
+        for (i += 1; i < BTOR_COUNT_STACK (*ws); i++)
+          ws->start[j++] = ws->start[i];
+        ws->top = ws->start + j;
+        return false;
+      }
+      else
+        assign (la, c[0]);
+    }
+    ws->top = ws->start + j;
+  }
+  return true;
+}
+
+/* Assign 'lit' and propagate. Returns false on conflict. */
+static bool
+decide (BtorLookahead *la, int32_t lit)
+{
+  if (val (la, lit) < 0) return false;
+  if (val (la, lit) > 0) return true;
+  assign (la, lit);
+  return propagate (la);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Select the variables that occur most often in both phases as candidates. */
+static void
+select_candidates (BtorLookahead *la, size_t num_lits)
+{
+  BtorMemMgr *mm = la->mm;
+  uint32_t *pos, *neg, i, j;
+  uint64_t occs[BTOR_LOOKAHEAD_CANDIDATES], occ;
+  int32_t v;
+
+  BTOR_CNEWN (mm, pos, la->maxvar + 1);
+  BTOR_CNEWN (mm, neg, la->maxvar + 1);
+  for (size_t k = 0; k < num_lits; k++)
+  {
+    if (la->lits[k] > 0)
+      pos[la->lits[k]] += 1;
+    else if (la->lits[k] < 0)
+      neg[-la->lits[k]] += 1;
+  }
+
+  /* keep candidates sorted by decreasing number of occurrences */
+  for (v = 1; v <= la->maxvar; v++)
+  {
+    if (!pos[v] || !neg[v]) continue;
+    occ = (uint64_t) pos[v] * neg[v] + pos[v] + neg[v];
+    for (i = la->num_candidates; i > 0 && occs[i - 1] < occ; i--)
+      ;
+    if (i == BTOR_LOOKAHEAD_CANDIDATES) continue;
+    if (la->num_candidates < BTOR_LOOKAHEAD_CANDIDATES) la->num_candidates++;
+    for (j = la->num_candidates - 1; j > i; j--)
+    {
+      occs[j]           = occs[j - 1];
+      la->candidates[j] = la->candidates[j - 1];
+    }
+    occs[i]           = occ;
+    la->candidates[i] = v;
+  }
+
+  BTOR_DELETEN (mm, neg, la->maxvar + 1);
+  BTOR_DELETEN (mm, pos, la->maxvar + 1);
+}
+
+/* Number of assignments implied by 'lit', -1 on conflict. */
+static int64_t
+probe (BtorLookahead *la, int32_t lit)
+{
+  size_t level = BTOR_COUNT_STACK (la->trail);
+  int64_t res;
+
+  res = decide (la, lit) ? (int64_t) (BTOR_COUNT_STACK (la->trail) - level)
+                         : -1;
+  backtrack (la, level);
+  return res;
+}
+
+static int32_t
+select_split (BtorLookahead *la)
+{
+  int32_t v, res = 0;
+  int64_t n1, n0, score, best = -1;
+
+  for (uint32_t i = 0; i < la->num_candidates; i++)
+  {
+    v = la->candidates[i];
+    if (la->vals[v]) continue;
+    if ((n1 = probe (la, v)) < 0 || (n0 = probe (la, -v)) < 0) continue;
+    score = (n1 + 1) * (n0 + 1);
+    if (score > best)
+    {
+      best = score;
+      res  = v;
+    }
+  }
+  return res;
+}
+
+static void
+split (BtorLookahead *la,
+       uint32_t depth,
+       BtorIntStack *cube,
+       BtorIntStack *cubes)
+{
+  size_t level, i;
+  int32_t v, lits[2];
+
+  if (depth > 0 && (v = select_split (la)))
+  {
+    level   = BTOR_COUNT_STACK (la->trail);
+    lits[0] = v;
+    lits[1] = -v;
+    for (i = 0; i < 2; i++)
+    {
+      BTOR_PUSH_STACK (*cube, lits[i]);
+      /* inconsistent branches are not split further */
+      split (la, decide (la, lits[i]) ? depth - 1 : 0, cube, cubes);
+      backtrack (la, level);
+      (void) BTOR_POP_STACK (*cube);
+    }
+    return;
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (*cube); i++)
+    BTOR_PUSH_STACK (*cubes, BTOR_PEEK_STACK (*cube, i));
+  BTOR_PUSH_STACK (*cubes, 0);
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_lookahead_cubes (BtorMemMgr *mm,
+                      int32_t maxvar,
+                      BtorIntStack *clauses,
+                      BtorIntStack *assumptions,
+                      uint32_t depth,
+                      BtorIntStack *cubes)
+{
+  assert (mm);
+  assert (maxvar >= 0);
+  assert (clauses);
+  assert (assumptions);
+  assert (cubes);
+
+  BtorLookahead la;
+  BtorIntStack cube;
+  size_t i, num_lits, num_watches, num_cubes;
+  int32_t *c;
+  bool consistent;
+
+  num_lits  = BTOR_COUNT_STACK (*clauses);
+  num_cubes = BTOR_COUNT_STACK (*cubes);
+  BTOR_INIT_STACK (mm, cube);
+
+  /* offsets of watched clauses are 32 bit */
+  if (depth > 0 && maxvar > 0 && num_lits <= UINT32_MAX)
+  {
+    BTOR_CLR (&la);
+    la.mm       = mm;
+    la.maxvar   = maxvar;
+    la.lits     = clauses->start;
+    num_watches = 2 * ((size_t) maxvar + 1);
+    BTOR_CNEWN (mm, la.vals, maxvar + 1);
+    BTOR_NEWN (mm, la.watches, num_watches);
+    for (i = 0; i < num_watches; i++) BTOR_INIT_STACK (mm, la.watches[i]);
+    BTOR_NEWN (mm, la.candidates, BTOR_LOOKAHEAD_CANDIDATES);
+    BTOR_INIT_STACK (mm, la.trail);
+
+    consistent = true;
+    for (i = 0; i < num_lits; i++)
+    {
+      c = la.lits + i;
+      if (!c[0])
+        consistent = false;
+      else if (!c[1])
+        BTOR_PUSH_STACK (cube, c[0]);
+      else
+      {
+        BTOR_PUSH_STACK (la.watches[lit2idx (c[0])], i);
+        BTOR_PUSH_STACK (la.watches[lit2idx (c[1])], i);
+      }
+      while (la.lits[i]) i++;
+    }
+    for (i = 0; i < BTOR_COUNT_STACK (*assumptions); i++)
+      BTOR_PUSH_STACK (cube, BTOR_PEEK_STACK (*assumptions, i));
+    for (i = 0; consistent && i < BTOR_COUNT_STACK (cube); i++)
+      consistent = decide (&la, BTOR_PEEK_STACK (cube, i));
+    BTOR_RESET_STACK (cube);
+
+    if (consistent)
+    {
+      select_candidates (&la, num_lits);
+      split (&la, depth, &cube, cubes);
+    }
+
+    BTOR_RELEASE_STACK (la.trail);
+    BTOR_DELETEN (mm, la.candidates, BTOR_LOOKAHEAD_CANDIDATES);
+    for (i = 0; i < num_watches; i++) BTOR_RELEASE_STACK (la.watches[i]);
+    BTOR_DELETEN (mm, la.watches, num_watches);
+    BTOR_DELETEN (mm, la.vals, maxvar + 1);
+  }
+
+  if (BTOR_COUNT_STACK (*cubes) == num_cubes) BTOR_PUSH_STACK (*cubes, 0);
+  BTOR_RELEASE_STACK (cube);
+}
@@ -0,0 +1,39 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORLOOKAHEAD_H_INCLUDED
+#define BTORLOOKAHEAD_H_INCLUDED
+
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+
+#include <stdint.h>
+
+/* Split the CNF 'clauses' (a sequence of 0-terminated clauses over variables
+ * 1 to 'maxvar') under 'assumptions' into at most 2^'depth' cubes for
+ * cube-and-conquer solving.
+ *
+ * The split variables are selected via lookahead: for each candidate
+ * variable both phases are propagated and the variable that implies the most
+ * assignments in both phases is selected. Branches that become inconsistent
+ * under propagation are not split further.
+ *
+ * The cubes are pushed onto 'cubes' as 0-terminated sequences of literals
+ * (an empty cube if the CNF is not split at all). The cubes cover all
+ * assignments, i.e., the CNF is satisfiable under 'assumptions' iff it is
+ * satisfiable under 'assumptions' and one of the cubes.
+ *
+ * Note: The literals of a clause in 'clauses' may be reordered. */
+void btor_lookahead_cubes (BtorMemMgr *mm,
+                           int32_t maxvar,
+                           BtorIntStack *clauses,
+                           BtorIntStack *assumptions,
+                           uint32_t depth,
+                           BtorIntStack *cubes);
+
+#endif
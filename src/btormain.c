@@ -67,7 +67,9 @@ enum BtorMainOption
   BTORMAIN_OPT_BTOR2,
   BTORMAIN_OPT_SMT2,
   BTORMAIN_OPT_SMT1,
+  BTORMAIN_OPT_BTOR_BINARY,
   BTORMAIN_OPT_DUMP_BTOR,
+  BTORMAIN_OPT_DUMP_BTOR_BINARY,
 #if 0
   BTORMAIN_OPT_DUMP_BTOR2,
 #endif
@@ -314,6 +316,18 @@ btormain_init_opts (BtorMainApp *app)
                      false,
                      BTOR_ARG_EXPECT_NONE,
                      "force SMT-LIB v1 input format");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_BTOR_BINARY,
+                     true,
+                     true,
+                     "btor-binary",
+                     0,
+                     0,
+                     0,
+                     1,
+                     false,
+                     BTOR_ARG_EXPECT_NONE,
+                     "force binary BTOR input format");
   btormain_init_opt (app,
                      BTORMAIN_OPT_DUMP_BTOR,
                      true,
@@ -326,6 +340,18 @@ btormain_init_opts (BtorMainApp *app)
                      false,
                      BTOR_ARG_EXPECT_NONE,
                      "dump formula in BTOR format");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_DUMP_BTOR_BINARY,
+                     true,
+                     true,
+                     "dump-btor-binary",
+                     "dbb",
+                     0,
+                     0,
+                     1,
+                     false,
+                     BTOR_ARG_EXPECT_NONE,
+                     "dump formula in binary BTOR format");
 #if 0
   btormain_init_opt (app, BTORMAIN_OPT_DUMP_BTOR2, true, true,
                      "dump-btor2", "db2", 0, 0, 1,
@@ -1188,6 +1214,10 @@ boolector_main (int32_t argc, char **argv)
           format = BTOR_INPUT_FORMAT_SMT1;
           goto SET_INPUT_FORMAT;
 
+        case BTORMAIN_OPT_BTOR_BINARY:
+          format = BTOR_INPUT_FORMAT_BTOR_BINARY;
+          goto SET_INPUT_FORMAT;
+
         case BTORMAIN_OPT_DUMP_BTOR:
           dump = BTOR_OUTPUT_FORMAT_BTOR;
         SET_OUTPUT_FORMAT:
@@ -1213,6 +1243,10 @@ boolector_main (int32_t argc, char **argv)
 
         case BTORMAIN_OPT_DUMP_AIGER_MERGE: dump_merge = true; break;
 
+        case BTORMAIN_OPT_DUMP_BTOR_BINARY:
+          dump = BTOR_OUTPUT_FORMAT_BTOR_BINARY;
+          goto SET_OUTPUT_FORMAT;
+
         default:
           /* get rid of compiler warnings, should be unreachable */
           assert (bmopt == BTORMAIN_OPT_NUM_OPTS);
@@ -1432,6 +1466,16 @@ boolector_main (int32_t argc, char **argv)
                                         &parse_status);
       parsed_smt2 = true;
       break;
+    case BTOR_INPUT_FORMAT_BTOR_BINARY:
+      if (g_verbosity)
+        btormain_msg ("binary BTOR input forced through cmd line options");
+      parse_res = boolector_parse_btor_binary (btor,
+                                               g_app->infile,
+                                               g_app->infile_name,
+                                               g_app->outfile,
+                                               &parse_err_msg,
+                                               &parse_status);
+      break;
 
     default:
       parse_res = boolector_parse (btor,
@@ -1522,6 +1566,10 @@ boolector_main (int32_t argc, char **argv)
         if (g_verbosity) btormain_msg ("dumping in ascii AIGER format");
         boolector_dump_aiger_ascii (btor, g_app->outfile, dump_merge);
         break;
+      case BTOR_OUTPUT_FORMAT_BTOR_BINARY:
+        if (g_verbosity) btormain_msg ("dumping in binary BTOR format");
+        boolector_dump_btor_binary (btor, g_app->outfile);
+        break;
       default:
         assert (dump == BTOR_OUTPUT_FORMAT_AIGER_BINARY);
         if (g_verbosity) btormain_msg ("dumping in binary AIGER format");
@@ -798,13 +798,18 @@ btor_model_recursively_compute_assignment (Btor *btor,
   BtorNode *cur, *real_cur, *next, *cur_parent;
   BtorHashTableData *d, dd;
   BtorIntHashTable *assigned, *reset_st, *param_model_cache;
-  BtorBitVector *result = 0, *inv_result, **e;
+  BtorBitVector *result = 0, *cached, **e;
   BtorBitVectorTuple *t;
   BtorIntHashTable *mark;
   BtorHashTableData *md;
+  BtorBitVectorPool *pool;
 
   mm = btor->mm;
 
+  /* intermediate results are reused to avoid allocating a bit-vector for
+   * every evaluated node */
+  pool = btor_bv_pool_new (mm);
+
   assigned = btor_hashint_map_new (mm);
 
   /* model cache for parameterized nodes */
@@ -871,7 +876,8 @@ btor_model_recursively_compute_assignment (Btor *btor,
       }
       else if (btor_node_is_bv_const (real_cur))
       {
-        result = btor_bv_copy (mm, btor_node_bv_const_get_bits (real_cur));
+        result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+        btor_bv_copy_into (result, btor_node_bv_const_get_bits (real_cur));
         goto CACHE_AND_PUSH_RESULT;
       }
       /* substitute param with its assignment */
@@ -971,61 +977,72 @@ btor_model_recursively_compute_assignment (Btor *btor,
       switch (real_cur->kind)
       {
         case BTOR_BV_SLICE_NODE:
-          result = btor_bv_slice (mm,
-                                  e[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
-          btor_bv_free (mm, e[0]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_slice_into (result,
+                              e[0],
+                              btor_node_bv_slice_get_upper (real_cur),
+                              btor_node_bv_slice_get_lower (real_cur));
+          btor_bv_pool_put (pool, e[0]);
           break;
         case BTOR_BV_AND_NODE:
-          result = btor_bv_and (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_and_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_EQ_NODE:
-          result = btor_bv_eq (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_eq_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_ADD_NODE:
-          result = btor_bv_add (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_add_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_MUL_NODE:
-          result = btor_bv_mul (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_mul_into (mm, result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_ULT_NODE:
-          result = btor_bv_ult (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_ult_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_SLL_NODE:
-          result = btor_bv_sll (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_sll_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_SRL_NODE:
-          result = btor_bv_srl (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_srl_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_UDIV_NODE:
-          result = btor_bv_udiv (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_udiv_into (mm, result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_UREM_NODE:
-          result = btor_bv_urem (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_urem_into (mm, result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
         case BTOR_BV_CONCAT_NODE:
-          result = btor_bv_concat (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          result = btor_bv_pool_get (pool, btor_node_bv_get_width (btor, cur));
+          btor_bv_concat_into (result, e[1], e[0]);
+          btor_bv_pool_put (pool, e[0]);
+          btor_bv_pool_put (pool, e[1]);
           break;
 
         case BTOR_APPLY_NODE:
@@ -1034,7 +1051,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
           for (i = 0; i < num_args; i++)
           {
             btor_bv_add_to_tuple (mm, t, e[i], num_args - 1 - i);
-            btor_bv_free (mm, e[i]);
+            btor_bv_pool_put (pool, e[i]);
           }
 
           /* check if there is already a value for given arguments */
@@ -1047,14 +1064,14 @@ btor_model_recursively_compute_assignment (Btor *btor,
             add_to_fun_model (btor, fun_model, real_cur->e[0], t, result);
           }
           else
-            btor_bv_free (mm, e[num_args]);
+            btor_bv_pool_put (pool, e[num_args]);
 
           btor_bv_free_tuple (mm, t);
           break;
 
         case BTOR_LAMBDA_NODE:
           result = e[0];
-          btor_bv_free (mm, e[1]);
+          btor_bv_pool_put (pool, e[1]);
           if (btor_node_is_lambda (real_cur) && cur_parent
               && btor_node_is_apply (cur_parent))
           {
@@ -1073,7 +1090,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
               assert (next->parameterized);
               btor_hashint_map_remove (mark, next->id, 0);
               btor_hashint_map_remove (param_model_cache, next->id, &dd);
-              btor_bv_free (mm, dd.as_ptr);
+              btor_bv_pool_put (pool, dd.as_ptr);
             }
           }
           break;
@@ -1094,9 +1111,9 @@ btor_model_recursively_compute_assignment (Btor *btor,
           if (!result)
             result = e[2];
           else
-            btor_bv_free (mm, e[2]);
-          btor_bv_free (mm, e[1]);
-          btor_bv_free (mm, e[0]);
+            btor_bv_pool_put (pool, e[2]);
+          btor_bv_pool_put (pool, e[1]);
+          btor_bv_pool_put (pool, e[0]);
           break;
 
         default:
@@ -1113,7 +1130,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
              * apply */
             BTOR_PUSH_STACK (work_stack, next);
             BTOR_PUSH_STACK (work_stack, cur_parent);
-            btor_bv_free (mm, e[0]);
+            btor_bv_pool_put (pool, e[0]);
             /* no result yet, we need to evaluate the selected function
              */
             md->as_int = 0;
@@ -1154,8 +1171,9 @@ btor_model_recursively_compute_assignment (Btor *btor,
          * valid under current parameter assignment and will be reset
          * when parameters are unassigned */
         assert (!btor_hashint_map_contains (param_model_cache, real_cur->id));
-        btor_hashint_map_add (param_model_cache, real_cur->id)->as_ptr =
-            btor_bv_copy (mm, result);
+        cached = btor_bv_pool_get (pool, btor_bv_get_width (result));
+        btor_bv_copy_into (cached, result);
+        btor_hashint_map_add (param_model_cache, real_cur->id)->as_ptr = cached;
       }
       else
       {
@@ -1164,12 +1182,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
       }
 
     PUSH_RESULT:
-      if (btor_node_is_inverted (cur))
-      {
-        inv_result = btor_bv_not (mm, result);
-        btor_bv_free (mm, result);
-        result = inv_result;
-      }
+      if (btor_node_is_inverted (cur)) btor_bv_not_into (result, result);
       BTOR_PUSH_STACK (arg_stack, result);
     }
     else
@@ -1180,7 +1193,9 @@ btor_model_recursively_compute_assignment (Btor *btor,
         d = btor_hashint_map_get (param_model_cache, real_cur->id);
       else
         d = btor_hashint_map_get (bv_model, real_cur->id);
-      result = btor_bv_copy (mm, (BtorBitVector *) d->as_ptr);
+      cached = d->as_ptr;
+      result = btor_bv_pool_get (pool, btor_bv_get_width (cached));
+      btor_bv_copy_into (result, cached);
       goto PUSH_RESULT;
     }
   }
@@ -1196,6 +1211,7 @@ btor_model_recursively_compute_assignment (Btor *btor,
   btor_hashint_map_delete (reset_st);
   btor_hashint_map_delete (param_model_cache);
   btor_hashint_map_delete (mark);
+  btor_bv_pool_delete (pool);
 
   return result;
 }
@@ -32,9 +32,24 @@
 
 #define BTOR_UNIQUE_TABLE_LIMIT 30
 
-#define BTOR_FULL_UNIQUE_TABLE(table)   \
-  ((table).num_elements >= (table).size \
-   && btor_util_log_2 ((table).size) < BTOR_UNIQUE_TABLE_LIMIT)
+/* Keep the load factor of the open addressing unique table below 7/8. */
+#define BTOR_FULL_UNIQUE_TABLE(table) \
+  ((table).num_elements + 1 >= (table).size - (table).size / 8)
+
+/* Distance of slot 'pos' to the home slot of 'hash'. */
+#define BTOR_UNIQUE_TABLE_DIST(table, hash, pos) \
+  (((pos) - (hash)) & ((table)->size - 1))
+
+/* Iterate over the slots 'pos' that may hold a node with hash value 'hash',
+ * where 'cur' is the node in slot 'pos'. The search stops at an empty slot
+ * or as soon as the probe distance of a slot is smaller than the current
+ * probe distance 'dist' (robin hood invariant). */
+#define BTOR_UNIQUE_TABLE_PROBE(table, hash, pos, dist, cur)                  \
+  for ((pos) = (hash) & ((table)->size - 1), (dist) = 0;                      \
+       ((cur) = (table)->slots[pos])                                          \
+       && BTOR_UNIQUE_TABLE_DIST ((table), (table)->hashes[pos], (pos))       \
+              >= (dist);                                                      \
+       (pos) = ((pos) + 1) & ((table)->size - 1), (dist)++)
 
 /*------------------------------------------------------------------------*/
 
@@ -426,11 +441,9 @@ hash_binder_exp (Btor *btor,
 
 /* Computes hash value of expresssion by children ids */
 static uint32_t
-compute_hash_exp (Btor *btor, BtorNode *exp, uint32_t table_size)
+compute_hash_exp (Btor *btor, BtorNode *exp)
 {
   assert (exp);
-  assert (table_size > 0);
-  assert (btor_util_is_power_of_2 (table_size));
   assert (btor_node_is_regular (exp));
   assert (!btor_node_is_bv_var (exp));
   assert (!btor_node_is_uf (exp));
@@ -454,12 +467,100 @@ compute_hash_exp (Btor *btor, BtorNode *exp, uint32_t table_size)
                            btor_node_bv_slice_get_lower (exp));
   else
     hash = hash_bv_exp (btor, exp->kind, exp->arity, exp->e);
-  hash &= table_size - 1;
   return hash;
 }
 
 /*------------------------------------------------------------------------*/
 
+static BtorNodeParentLinks *
+get_parent_links (Btor *btor, uint32_t id)
+{
+  assert (btor);
+  assert (id < BTOR_COUNT_STACK (btor->parent_links));
+  return btor->parent_links.start + id;
+}
+
+/* Links of node 'id' in the parent list of its child at position 'pos'. */
+static BtorNodeSiblingLinks *
+get_sibling_links (Btor *btor, uint32_t id, uint32_t pos)
+{
+  assert (btor);
+  assert (pos <= 2);
+
+  uint32_t i;
+
+  i = get_parent_links (btor, id)->siblings + pos;
+  assert (i < BTOR_COUNT_STACK (btor->sibling_links));
+  return btor->sibling_links.start + i;
+}
+
+/* Link to 'parent' in the parent list of its child at position 'pos'. */
+static uint32_t
+get_parent_link (BtorNode *parent, uint32_t pos)
+{
+  assert (btor_node_is_regular (parent));
+  assert (pos <= 2);
+  return (uint32_t) parent->id << 2 | pos;
+}
+
+static BtorNode *
+get_parent_from_link (Btor *btor, uint32_t link)
+{
+  if (!link) return 0;
+  return btor_node_set_tag (BTOR_PEEK_STACK (btor->nodes_id_table, link >> 2),
+                            link & 3);
+}
+
+#define BTOR_NEXT_PARENT_LINK(btor, link) \
+  (get_sibling_links ((btor), (link) >> 2, (link) & 3)->next_parent)
+
+#define BTOR_PREV_PARENT_LINK(btor, link) \
+  (get_sibling_links ((btor), (link) >> 2, (link) & 3)->prev_parent)
+
+BtorNode *
+btor_node_get_first_parent (Btor *btor, const BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  BtorNodeParentLinks *links;
+  links = get_parent_links (btor, btor_node_real_addr (exp)->id);
+  return get_parent_from_link (btor, links->first_parent);
+}
+
+BtorNode *
+btor_node_get_last_parent (Btor *btor, const BtorNode *exp)
+{
+  assert (btor);
+  assert (exp);
+  BtorNodeParentLinks *links;
+  links = get_parent_links (btor, btor_node_real_addr (exp)->id);
+  return get_parent_from_link (btor, links->last_parent);
+}
+
+BtorNode *
+btor_node_get_next_parent (Btor *btor, const BtorNode *parent)
+{
+  assert (btor);
+  assert (parent);
+  BtorNodeSiblingLinks *links;
+  links = get_sibling_links (
+      btor, btor_node_real_addr (parent)->id, btor_node_get_tag (parent));
+  return get_parent_from_link (btor, links->next_parent);
+}
+
+BtorNode *
+btor_node_get_prev_parent (Btor *btor, const BtorNode *parent)
+{
+  assert (btor);
+  assert (parent);
+  BtorNodeSiblingLinks *links;
+  links = get_sibling_links (
+      btor, btor_node_real_addr (parent)->id, btor_node_get_tag (parent));
+  return get_parent_from_link (btor, links->prev_parent);
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 setup_node_and_add_to_id_table (Btor *btor, void *ptr)
 {
@@ -467,7 +568,9 @@ setup_node_and_add_to_id_table (Btor *btor, void *ptr)
   assert (ptr);
 
   BtorNode *exp;
-  uint32_t id;
+  uint32_t id, i;
+  BtorNodeParentLinks links;
+  BtorNodeSiblingLinks no_siblings;
 
   exp = (BtorNode *) ptr;
   assert (!btor_node_is_inverted (exp));
@@ -477,49 +580,111 @@ setup_node_and_add_to_id_table (Btor *btor, void *ptr)
   exp->btor = btor;
   btor->stats.expressions++;
   id = BTOR_COUNT_STACK (btor->nodes_id_table);
-  BTOR_ABORT (id == INT32_MAX, "expression id overflow");
+  /* parent links store ids tagged with 2 bits */
+  BTOR_ABORT (id > UINT32_MAX >> 2, "expression id overflow");
   exp->id = id;
   BTOR_PUSH_STACK (btor->nodes_id_table, exp);
   assert (BTOR_COUNT_STACK (btor->nodes_id_table) == (size_t) exp->id + 1);
   assert (BTOR_PEEK_STACK (btor->nodes_id_table, exp->id) == exp);
-  btor->stats.node_bytes_alloc += exp->bytes;
+  /* at most 3 * 2^30 sibling links, which fits into 'siblings' */
+  BTOR_CLR (&links);
+  links.siblings = BTOR_COUNT_STACK (btor->sibling_links);
+  BTOR_PUSH_STACK (btor->parent_links, links);
+  assert (BTOR_COUNT_STACK (btor->parent_links) == (size_t) exp->id + 1);
+  BTOR_CLR (&no_siblings);
+  for (i = 0; i < exp->arity; i++)
+    BTOR_PUSH_STACK (btor->sibling_links, no_siblings);
+  btor->stats.node_bytes_alloc += exp->bytes + sizeof (BtorNodeParentLinks)
+                                  + exp->arity * sizeof (BtorNodeSiblingLinks);
 
   if (btor_node_is_apply (exp)) exp->apply_below = 1;
 }
 
-/* Enlarges unique table and rehashes expressions. */
+/* Inserts 'exp' with hash value 'hash' into 'table', which must have at
+ * least one empty slot. */
+static void
+insert_into_unique_table (BtorNodeUniqueTable *table,
+                          BtorNode *exp,
+                          uint32_t hash)
+{
+  assert (table);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+
+  uint32_t mask, pos, dist, end, prev;
+
+  mask = table->size - 1;
+  pos  = hash & mask;
+  dist = 0;
+  while (table->slots[pos]
+         && BTOR_UNIQUE_TABLE_DIST (table, table->hashes[pos], pos) >= dist)
+  {
+    assert (table->slots[pos] != exp);
+    pos = (pos + 1) & mask;
+    dist++;
+  }
+  /* shift the remaining cluster by one slot to make room for 'exp' */
+  end = pos;
+  while (table->slots[end]) end = (end + 1) & mask;
+  while (end != pos)
+  {
+    prev               = (end - 1) & mask;
+    table->slots[end]  = table->slots[prev];
+    table->hashes[end] = table->hashes[prev];
+    end                = prev;
+  }
+  table->slots[pos]  = exp;
+  table->hashes[pos] = hash;
+}
+
+/* Enlarges unique table and reinserts expressions with their cached hash
+ * values. */
 static void
 enlarge_nodes_unique_table (Btor *btor)
 {
   assert (btor);
 
   BtorMemMgr *mm;
-  uint32_t size, new_size, i;
-  uint32_t hash;
-  BtorNode *cur, *temp, **new_chains;
-
-  mm       = btor->mm;
-  size     = btor->nodes_unique_table.size;
-  new_size = size ? 2 * size : 1;
-  BTOR_CNEWN (mm, new_chains, new_size);
+  uint32_t size, i;
+  BtorNodeUniqueTable *table, new_table;
+
+  mm    = btor->mm;
+  table = &btor->nodes_unique_table;
+  size  = table->size;
+  BTOR_ABORT (btor_util_log_2 (size) >= BTOR_UNIQUE_TABLE_LIMIT,
+              "node unique table size limit exceeded");
+  new_table.size         = 2 * size;
+  new_table.num_elements = table->num_elements;
+  BTOR_CNEWN (mm, new_table.slots, new_table.size);
+  BTOR_CNEWN (mm, new_table.hashes, new_table.size);
   for (i = 0; i < size; i++)
   {
-    cur = btor->nodes_unique_table.chains[i];
-    while (cur)
-    {
-      assert (btor_node_is_regular (cur));
-      assert (!btor_node_is_bv_var (cur));
-      assert (!btor_node_is_uf (cur));
-      temp             = cur->next;
-      hash             = compute_hash_exp (btor, cur, new_size);
-      cur->next        = new_chains[hash];
-      new_chains[hash] = cur;
-      cur              = temp;
-    }
+    if (!table->slots[i]) continue;
+    assert (!btor_node_is_bv_var (table->slots[i]));
+    assert (!btor_node_is_uf (table->slots[i]));
+    insert_into_unique_table (&new_table, table->slots[i], table->hashes[i]);
   }
-  BTOR_DELETEN (mm, btor->nodes_unique_table.chains, size);
-  btor->nodes_unique_table.size   = new_size;
-  btor->nodes_unique_table.chains = new_chains;
+  BTOR_DELETEN (mm, table->slots, size);
+  BTOR_DELETEN (mm, table->hashes, size);
+  *table = new_table;
+}
+
+/* Adds new expression 'exp' with hash value 'hash' (as computed by a failed
+ * lookup) to the unique table. */
+static void
+add_to_nodes_unique_table (Btor *btor, BtorNode *exp, uint32_t hash)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (!exp->unique);
+
+  if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
+    enlarge_nodes_unique_table (btor);
+  insert_into_unique_table (&btor->nodes_unique_table, exp, hash);
+  assert (btor->nodes_unique_table.num_elements < INT32_MAX);
+  btor->nodes_unique_table.num_elements++;
+  exp->unique = 1;
 }
 
 static void
@@ -528,35 +693,36 @@ remove_from_nodes_unique_table_exp (Btor *btor, BtorNode *exp)
   assert (exp);
   assert (btor_node_is_regular (exp));
 
-  uint32_t hash;
-  BtorNode *cur, *prev;
+  uint32_t hash, mask, pos, next;
+  BtorNodeUniqueTable *table;
 
   if (!exp->unique) return;
 
   assert (btor);
   assert (btor->nodes_unique_table.num_elements > 0);
 
-  hash = compute_hash_exp (btor, exp, btor->nodes_unique_table.size);
-  prev = 0;
-  cur  = btor->nodes_unique_table.chains[hash];
-
-  while (cur != exp)
+  table = &btor->nodes_unique_table;
+  mask  = table->size - 1;
+  hash  = compute_hash_exp (btor, exp);
+  for (pos = hash & mask; table->slots[pos] != exp; pos = (pos + 1) & mask)
+    assert (table->slots[pos]);
+  assert (table->hashes[pos] == hash);
+
+  /* backward shift deletion, no tombstones needed */
+  for (next = (pos + 1) & mask;
+       table->slots[next]
+       && BTOR_UNIQUE_TABLE_DIST (table, table->hashes[next], next) > 0;
+       pos = next, next = (next + 1) & mask)
   {
-    assert (cur);
-    assert (btor_node_is_regular (cur));
-    prev = cur;
-    cur  = cur->next;
+    table->slots[pos]  = table->slots[next];
+    table->hashes[pos] = table->hashes[next];
   }
-  assert (cur);
-  if (!prev)
-    btor->nodes_unique_table.chains[hash] = cur->next;
-  else
-    prev->next = cur->next;
+  table->slots[pos]  = 0;
+  table->hashes[pos] = 0;
 
-  btor->nodes_unique_table.num_elements--;
+  table->num_elements--;
 
   exp->unique = 0; /* NOTE: this is not debugging code ! */
-  exp->next   = 0;
 }
 
 static void
@@ -626,9 +792,11 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
           || btor_node_is_apply (parent) || btor_node_is_update (parent));
 
   (void) btor;
-  uint32_t tag;
+  uint32_t link, first_parent, last_parent;
   bool insert_beginning = 1;
-  BtorNode *real_child, *first_parent, *last_parent, *tagged_parent;
+  BtorNode *real_child;
+  BtorNodeParentLinks *child_links;
+  BtorNodeSiblingLinks *parent_links;
 
   /* set specific flags */
 
@@ -660,37 +828,37 @@ connect_child_exp (Btor *btor, BtorNode *parent, BtorNode *child, uint32_t pos)
 
   real_child     = btor_node_real_addr (child);
   parent->e[pos] = child;
-  tagged_parent  = btor_node_set_tag (parent, pos);
+  link           = get_parent_link (parent, pos);
+  child_links    = get_parent_links (btor, real_child->id);
+  parent_links   = get_sibling_links (btor, parent->id, pos);
 
-  assert (!parent->prev_parent[pos]);
-  assert (!parent->next_parent[pos]);
+  assert (!parent_links->prev_parent);
+  assert (!parent_links->next_parent);
 
   /* no parent so far? */
-  if (!real_child->first_parent)
+  if (!child_links->first_parent)
   {
-    assert (!real_child->last_parent);
-    real_child->first_parent = tagged_parent;
-    real_child->last_parent  = tagged_parent;
+    assert (!child_links->last_parent);
+    child_links->first_parent = link;
+    child_links->last_parent  = link;
   }
   /* add parent at the beginning of the list */
   else if (insert_beginning)
   {
-    first_parent = real_child->first_parent;
+    first_parent = child_links->first_parent;
     assert (first_parent);
-    parent->next_parent[pos] = first_parent;
-    tag                      = btor_node_get_tag (first_parent);
-    btor_node_real_addr (first_parent)->prev_parent[tag] = tagged_parent;
-    real_child->first_parent                             = tagged_parent;
+    parent_links->next_parent                  = first_parent;
+    BTOR_PREV_PARENT_LINK (btor, first_parent) = link;
+    child_links->first_parent                  = link;
   }
   /* add parent at the end of the list */
   else
   {
-    last_parent = real_child->last_parent;
+    last_parent = child_links->last_parent;
     assert (last_parent);
-    parent->prev_parent[pos] = last_parent;
-    tag                      = btor_node_get_tag (last_parent);
-    btor_node_real_addr (last_parent)->next_parent[tag] = tagged_parent;
-    real_child->last_parent                             = tagged_parent;
+    parent_links->prev_parent                 = last_parent;
+    BTOR_NEXT_PARENT_LINK (btor, last_parent) = link;
+    child_links->last_parent                  = link;
   }
 }
 
@@ -708,14 +876,20 @@ disconnect_child_exp (Btor *btor, BtorNode *parent, uint32_t pos)
   assert (pos <= 2);
 
   (void) btor;
-  BtorNode *first_parent, *last_parent;
-  BtorNode *real_child, *tagged_parent;
+  uint32_t link, first_parent, last_parent, prev_parent, next_parent;
+  BtorNode *real_child;
+  BtorNodeParentLinks *child_links;
+  BtorNodeSiblingLinks *parent_links;
 
-  tagged_parent = btor_node_set_tag (parent, pos);
-  real_child    = btor_node_real_addr (parent->e[pos]);
+  link       = get_parent_link (parent, pos);
+  real_child = btor_node_real_addr (parent->e[pos]);
   real_child->parents--;
-  first_parent = real_child->first_parent;
-  last_parent  = real_child->last_parent;
+  child_links  = get_parent_links (btor, real_child->id);
+  parent_links = get_sibling_links (btor, parent->id, pos);
+  first_parent = child_links->first_parent;
+  last_parent  = child_links->last_parent;
+  prev_parent  = parent_links->prev_parent;
+  next_parent  = parent_links->next_parent;
   assert (first_parent);
   assert (last_parent);
 
@@ -731,40 +905,40 @@ disconnect_child_exp (Btor *btor, BtorNode *parent, uint32_t pos)
     btor_node_param_set_binder (parent->e[0], 0);
 
   /* only one parent? */
-  if (first_parent == tagged_parent && first_parent == last_parent)
+  if (first_parent == link && first_parent == last_parent)
   {
-    assert (!parent->next_parent[pos]);
-    assert (!parent->prev_parent[pos]);
-    real_child->first_parent = 0;
-    real_child->last_parent  = 0;
+    assert (!next_parent);
+    assert (!prev_parent);
+    child_links->first_parent = 0;
+    child_links->last_parent  = 0;
   }
   /* is parent first parent in the list? */
-  else if (first_parent == tagged_parent)
+  else if (first_parent == link)
   {
-    assert (parent->next_parent[pos]);
-    assert (!parent->prev_parent[pos]);
-    real_child->first_parent                    = parent->next_parent[pos];
-    BTOR_PREV_PARENT (real_child->first_parent) = 0;
+    assert (next_parent);
+    assert (!prev_parent);
+    child_links->first_parent                 = next_parent;
+    BTOR_PREV_PARENT_LINK (btor, next_parent) = 0;
   }
   /* is parent last parent in the list? */
-  else if (last_parent == tagged_parent)
+  else if (last_parent == link)
   {
-    assert (!parent->next_parent[pos]);
-    assert (parent->prev_parent[pos]);
-    real_child->last_parent                    = parent->prev_parent[pos];
-    BTOR_NEXT_PARENT (real_child->last_parent) = 0;
+    assert (!next_parent);
+    assert (prev_parent);
+    child_links->last_parent                  = prev_parent;
+    BTOR_NEXT_PARENT_LINK (btor, prev_parent) = 0;
   }
   /* detach parent from list */
   else
   {
-    assert (parent->next_parent[pos]);
-    assert (parent->prev_parent[pos]);
-    BTOR_PREV_PARENT (parent->next_parent[pos]) = parent->prev_parent[pos];
-    BTOR_NEXT_PARENT (parent->prev_parent[pos]) = parent->next_parent[pos];
+    assert (next_parent);
+    assert (prev_parent);
+    BTOR_PREV_PARENT_LINK (btor, next_parent) = prev_parent;
+    BTOR_NEXT_PARENT_LINK (btor, prev_parent) = next_parent;
   }
-  parent->next_parent[pos] = 0;
-  parent->prev_parent[pos] = 0;
-  parent->e[pos]           = 0;
+  parent_links->next_parent = 0;
+  parent_links->prev_parent = 0;
+  parent->e[pos]            = 0;
 }
 
 /* Disconnect children of expression in parent list and if applicable from
@@ -889,6 +1063,8 @@ really_deallocate_exp (Btor *btor, BtorNode *exp)
   assert (exp->id);
   assert (BTOR_PEEK_STACK (btor->nodes_id_table, exp->id) == exp);
   BTOR_POKE_STACK (btor->nodes_id_table, exp->id, 0);
+  assert (!get_parent_links (btor, exp->id)->first_parent);
+  assert (!get_parent_links (btor, exp->id)->last_parent);
 
   BtorMemMgr *mm;
 
@@ -1488,97 +1664,97 @@ sort_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[])
 
 /*------------------------------------------------------------------------*/
 
-/* Search for constant expression in hash table. Returns 0 if not found. */
-static BtorNode **
-find_const_exp (Btor *btor, BtorBitVector *bits)
+/* Search for constant expression in hash table. Returns 0 if not found.
+ * The hash value of the expression is stored in 'hash' (if given). */
+static BtorNode *
+find_const_exp (Btor *btor, BtorBitVector *bits, uint32_t *hash)
 {
   assert (btor);
   assert (bits);
 
-  BtorNode *cur, **result;
-  uint32_t hash;
+  BtorNodeUniqueTable *table;
+  BtorNode *cur;
+  uint32_t h, pos, dist;
 
-  hash = btor_bv_hash (bits);
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
-  while (cur)
+  table = &btor->nodes_unique_table;
+  h     = btor_bv_hash (bits);
+  if (hash) *hash = h;
+  BTOR_UNIQUE_TABLE_PROBE (table, h, pos, dist, cur)
   {
     assert (btor_node_is_regular (cur));
-    if (btor_node_is_bv_const (cur)
+    if (table->hashes[pos] == h && btor_node_is_bv_const (cur)
         && btor_node_bv_get_width (btor, cur) == btor_bv_get_width (bits)
         && !btor_bv_compare (btor_node_bv_const_get_bits (cur), bits))
-      break;
-    else
-    {
-      result = &cur->next;
-      cur    = *result;
-    }
+      return cur;
   }
-  return result;
+  return 0;
 }
 
-/* Search for slice expression in hash table. Returns 0 if not found. */
-static BtorNode **
-find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
+/* Search for slice expression in hash table. Returns 0 if not found.
+ * The hash value of the expression is stored in 'hash' (if given). */
+static BtorNode *
+find_slice_exp (Btor *btor,
+                BtorNode *e0,
+                uint32_t upper,
+                uint32_t lower,
+                uint32_t *hash)
 {
   assert (btor);
   assert (e0);
   assert (upper >= lower);
 
-  BtorNode *cur, **result;
-  uint32_t hash;
+  BtorNodeUniqueTable *table;
+  BtorNode *cur;
+  uint32_t h, pos, dist;
 
-  hash = hash_slice_exp (e0, upper, lower);
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
-  while (cur)
+  table = &btor->nodes_unique_table;
+  h     = hash_slice_exp (e0, upper, lower);
+  if (hash) *hash = h;
+  BTOR_UNIQUE_TABLE_PROBE (table, h, pos, dist, cur)
   {
     assert (btor_node_is_regular (cur));
-    if (cur->kind == BTOR_BV_SLICE_NODE && cur->e[0] == e0
-        && btor_node_bv_slice_get_upper (cur) == upper
+    if (table->hashes[pos] == h && cur->kind == BTOR_BV_SLICE_NODE
+        && cur->e[0] == e0 && btor_node_bv_slice_get_upper (cur) == upper
         && btor_node_bv_slice_get_lower (cur) == lower)
-      break;
-    else
-    {
-      result = &cur->next;
-      cur    = *result;
-    }
+      return cur;
   }
-  return result;
+  return 0;
 }
 
-static BtorNode **
-find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
+static BtorNode *
+find_bv_exp (Btor *btor,
+             BtorNodeKind kind,
+             BtorNode *e[],
+             uint32_t arity,
+             uint32_t *hash)
 {
   bool equal;
   uint32_t i;
-  uint32_t hash;
-  BtorNode *cur, **result;
+  uint32_t h, pos, dist;
+  BtorNodeUniqueTable *table;
+  BtorNode *cur;
 
   assert (kind != BTOR_BV_SLICE_NODE);
   assert (kind != BTOR_BV_CONST_NODE);
 
   sort_bv_exp (btor, kind, e);
-  hash = hash_bv_exp (btor, kind, arity, e);
-  hash &= btor->nodes_unique_table.size - 1;
+  table = &btor->nodes_unique_table;
+  h     = hash_bv_exp (btor, kind, arity, e);
+  if (hash) *hash = h;
 
-  result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
-  while (cur)
+  BTOR_UNIQUE_TABLE_PROBE (table, h, pos, dist, cur)
   {
     assert (btor_node_is_regular (cur));
-    if (cur->kind == kind && cur->arity == arity)
+    if (table->hashes[pos] == h && cur->kind == kind && cur->arity == arity)
     {
       equal = true;
       /* special case for bv eq; (= (bvnot a) b) == (= a (bvnot b)) */
       if (kind == BTOR_BV_EQ_NODE && cur->e[0] == btor_node_invert (e[0])
           && cur->e[1] == btor_node_invert (e[1]))
-        break;
+        return cur;
       for (i = 0; i < arity && equal; i++)
         if (cur->e[i] != e[i]) equal = false;
-      if (equal) break;
+      if (equal) return cur;
 #ifndef NDEBUG
       if (btor_opt_get (btor, BTOR_OPT_SORT_EXP) > 0
           && btor_node_is_binary_commutative_kind (kind))
@@ -1587,10 +1763,8 @@ find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
                     || !(cur->e[0] == e[1] && cur->e[1] == e[0]));
 #endif
     }
-    result = &(cur->next);
-    cur    = *result;
   }
-  return result;
+  return 0;
 }
 
 static int32_t compare_binder_exp (Btor *btor,
@@ -1599,7 +1773,7 @@ static int32_t compare_binder_exp (Btor *btor,
                                    BtorNode *binder,
                                    BtorPtrHashTable *map);
 
-static BtorNode **
+static BtorNode *
 find_binder_exp (Btor *btor,
                  BtorNodeKind kind,
                  BtorNode *param,
@@ -1614,10 +1788,12 @@ find_binder_exp (Btor *btor,
   assert (btor_node_is_regular (param));
   assert (btor_node_is_param (param));
 
-  BtorNode *cur, **result;
-  uint32_t hash;
+  BtorNodeUniqueTable *table;
+  BtorNode *cur, *result;
+  uint32_t hash, pos, dist;
 
-  hash = hash_binder_exp (btor, param, body, params);
+  table = &btor->nodes_unique_table;
+  hash  = hash_binder_exp (btor, param, body, params);
 
   BTORLOG (2,
            "find binder %s %s (hash: %u)",
@@ -1626,29 +1802,25 @@ find_binder_exp (Btor *btor,
            hash);
 
   if (binder_hash) *binder_hash = hash;
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
-  cur    = *result;
-  while (cur)
+  result = 0;
+  BTOR_UNIQUE_TABLE_PROBE (table, hash, pos, dist, cur)
   {
     assert (btor_node_is_regular (cur));
-    if (cur->kind == kind
+    if (table->hashes[pos] == hash && cur->kind == kind
         && ((!map && param == cur->e[0] && body == cur->e[1])
             || (((map || !cur->parameterized)
                  && compare_binder_exp (btor, param, body, cur, map)))))
-      break;
-    else
     {
-      result = &cur->next;
-      cur    = *result;
+      result = cur;
+      break;
     }
   }
-  assert (!*result || btor_node_is_binder (*result));
+  assert (!result || btor_node_is_binder (result));
   BTORLOG (2,
            "found binder %s %s -> %s",
            btor_util_node2string (param),
            btor_util_node2string (body),
-           btor_util_node2string (*result));
+           btor_util_node2string (result));
   return result;
 }
 
@@ -1756,13 +1928,13 @@ compare_binder_exp (Btor *btor,
 
       if (btor_node_is_binder (real_cur))
       {
-        result = *find_binder_exp (btor,
-                                   real_cur->kind,
-                                   real_cur->e[0],
-                                   real_cur->e[1],
-                                   0,
-                                   0,
-                                   param_map);
+        result = find_binder_exp (btor,
+                                  real_cur->kind,
+                                  real_cur->e[0],
+                                  real_cur->e[1],
+                                  0,
+                                  0,
+                                  param_map);
         if (result)
         {
           b->data.as_ptr = result;
@@ -1789,10 +1961,11 @@ compare_binder_exp (Btor *btor,
 
       if (btor_node_is_bv_slice (real_cur))
       {
-        result = *find_slice_exp (btor,
-                                  e[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
+        result = find_slice_exp (btor,
+                                 e[0],
+                                 btor_node_bv_slice_get_upper (real_cur),
+                                 btor_node_bv_slice_get_lower (real_cur),
+                                 0);
       }
       else if (btor_node_is_param (real_cur))
       {
@@ -1804,7 +1977,7 @@ compare_binder_exp (Btor *btor,
       else
       {
         assert (!btor_node_is_binder (real_cur));
-        result = *find_bv_exp (btor, real_cur->kind, e, real_cur->arity);
+        result = find_bv_exp (btor, real_cur->kind, e, real_cur->arity, 0);
       }
 
       if (!result)
@@ -1835,12 +2008,12 @@ NOT_EQUAL:
   return equal;
 }
 
-static BtorNode **
+static BtorNode *
 find_exp (Btor *btor,
           BtorNodeKind kind,
           BtorNode *e[],
           uint32_t arity,
-          uint32_t *binder_hash,
+          uint32_t *hash,
           BtorIntHashTable *params)
 {
   assert (btor);
@@ -1854,11 +2027,9 @@ find_exp (Btor *btor,
 
   if (kind == BTOR_LAMBDA_NODE || kind == BTOR_FORALL_NODE
       || kind == BTOR_EXISTS_NODE)
-    return find_binder_exp (btor, kind, e[0], e[1], binder_hash, params, 0);
-  else if (binder_hash)
-    *binder_hash = 0;
+    return find_binder_exp (btor, kind, e[0], e[1], hash, params, 0);
 
-  return find_bv_exp (btor, kind, e, arity);
+  return find_bv_exp (btor, kind, e, arity, hash);
 }
 
 /*------------------------------------------------------------------------*/
@@ -2178,8 +2349,8 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
   assert (e);
 
   uint32_t i;
-  uint32_t binder_hash;
-  BtorNode **lookup, *simp_e[3], *simp;
+  uint32_t hash;
+  BtorNode *lookup, *simp_e[3], *simp;
   BtorIntHashTable *params = 0;
 
   for (i = 0; i < arity; i++)
@@ -2193,72 +2364,63 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
       || kind == BTOR_FORALL_NODE || kind == BTOR_EXISTS_NODE)
     params = btor_hashint_table_new (btor->mm);
 
-  lookup = find_exp (btor, kind, simp_e, arity, &binder_hash, params);
-  if (!*lookup)
+  lookup = find_exp (btor, kind, simp_e, arity, &hash, params);
+  if (!lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_exp (btor, kind, simp_e, arity, &binder_hash, 0);
-    }
-
     switch (kind)
     {
       case BTOR_LAMBDA_NODE:
         assert (arity == 2);
-        *lookup = new_lambda_exp_node (btor, simp_e[0], simp_e[1]);
-        btor_hashptr_table_get (btor->lambdas, *lookup)->data.as_int =
-            binder_hash;
+        lookup = new_lambda_exp_node (btor, simp_e[0], simp_e[1]);
+        btor_hashptr_table_get (btor->lambdas, lookup)->data.as_int = hash;
         BTORLOG (2,
                  "new lambda: %s (hash: %u, param: %u)",
-                 btor_util_node2string (*lookup),
-                 binder_hash,
-                 (*lookup)->parameterized);
+                 btor_util_node2string (lookup),
+                 hash,
+                 lookup->parameterized);
         break;
       case BTOR_FORALL_NODE:
       case BTOR_EXISTS_NODE:
         assert (arity == 2);
-        *lookup = new_quantifier_exp_node (btor, kind, e[0], e[1]);
-        btor_hashptr_table_get (btor->quantifiers, *lookup)->data.as_int =
-            binder_hash;
+        lookup = new_quantifier_exp_node (btor, kind, e[0], e[1]);
+        btor_hashptr_table_get (btor->quantifiers, lookup)->data.as_int =
+            hash;
         break;
       case BTOR_ARGS_NODE:
-        *lookup = new_args_exp_node (btor, arity, simp_e);
+        lookup = new_args_exp_node (btor, arity, simp_e);
         break;
-      default: *lookup = new_node (btor, kind, arity, simp_e);
+      default: lookup = new_node (btor, kind, arity, simp_e);
     }
 
     if (params)
     {
-      assert (btor_node_is_binder (*lookup));
+      assert (btor_node_is_binder (lookup));
       if (params->count > 0)
       {
-        btor_hashptr_table_add (btor->parameterized, *lookup)->data.as_ptr =
+        btor_hashptr_table_add (btor->parameterized, lookup)->data.as_ptr =
             params;
-        (*lookup)->parameterized = 1;
+        lookup->parameterized = 1;
       }
       else
         btor_hashint_table_delete (params);
     }
 
-    assert (btor->nodes_unique_table.num_elements < INT32_MAX);
-    btor->nodes_unique_table.num_elements++;
-    (*lookup)->unique = 1;
+    add_to_nodes_unique_table (btor, lookup, hash);
   }
   else
   {
-    inc_exp_ref_counter (btor, *lookup);
+    inc_exp_ref_counter (btor, lookup);
     if (params) btor_hashint_table_delete (params);
   }
-  assert (btor_node_is_regular (*lookup));
-  if (btor_node_is_simplified (*lookup))
+  assert (btor_node_is_regular (lookup));
+  if (btor_node_is_simplified (lookup))
   {
     assert (btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
-    simp = btor_node_copy (btor, btor_node_get_simplified (btor, *lookup));
-    btor_node_release (btor, *lookup);
+    simp = btor_node_copy (btor, btor_node_get_simplified (btor, lookup));
+    btor_node_release (btor, lookup);
     return simp;
   }
-  return *lookup;
+  return lookup;
 }
 
 /*------------------------------------------------------------------------*/
@@ -2270,8 +2432,9 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
   assert (bits);
 
   bool inv;
+  uint32_t hash;
   BtorBitVector *lookupbits;
-  BtorNode **lookup;
+  BtorNode *lookup;
 
   /* normalize constants, constants are always even */
   if (btor_bv_get_bit (bits, 0))
@@ -2285,28 +2448,21 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
     inv        = false;
   }
 
-  lookup = find_const_exp (btor, lookupbits);
-  if (!*lookup)
+  lookup = find_const_exp (btor, lookupbits, &hash);
+  if (!lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_const_exp (btor, lookupbits);
-    }
-    *lookup = new_const_exp_node (btor, lookupbits);
-    assert (btor->nodes_unique_table.num_elements < INT32_MAX);
-    btor->nodes_unique_table.num_elements += 1;
-    (*lookup)->unique = 1;
+    lookup = new_const_exp_node (btor, lookupbits);
+    add_to_nodes_unique_table (btor, lookup, hash);
   }
   else
-    inc_exp_ref_counter (btor, *lookup);
+    inc_exp_ref_counter (btor, lookup);
 
-  assert (btor_node_is_regular (*lookup));
+  assert (btor_node_is_regular (lookup));
 
   btor_bv_free (btor->mm, lookupbits);
 
-  if (inv) return btor_node_invert (*lookup);
-  return *lookup;
+  if (inv) return btor_node_invert (lookup);
+  return lookup;
 }
 
 BtorNode *
@@ -2380,7 +2536,8 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
   assert (btor == btor_node_real_addr (exp)->btor);
 
   bool inv;
-  BtorNode **lookup;
+  uint32_t hash;
+  BtorNode *lookup;
 
   exp = btor_simplify_exp (btor, exp);
 
@@ -2397,24 +2554,17 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
   else
     inv = false;
 
-  lookup = find_slice_exp (btor, exp, upper, lower);
-  if (!*lookup)
+  lookup = find_slice_exp (btor, exp, upper, lower, &hash);
+  if (!lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_slice_exp (btor, exp, upper, lower);
-    }
-    *lookup = new_slice_exp_node (btor, exp, upper, lower);
-    assert (btor->nodes_unique_table.num_elements < INT32_MAX);
-    btor->nodes_unique_table.num_elements++;
-    (*lookup)->unique = 1;
+    lookup = new_slice_exp_node (btor, exp, upper, lower);
+    add_to_nodes_unique_table (btor, lookup, hash);
   }
   else
-    inc_exp_ref_counter (btor, *lookup);
-  assert (btor_node_is_regular (*lookup));
-  if (inv) return btor_node_invert (*lookup);
-  return *lookup;
+    inc_exp_ref_counter (btor, lookup);
+  assert (btor_node_is_regular (lookup));
+  if (inv) return btor_node_invert (lookup);
+  return lookup;
 }
 
 BtorNode *
@@ -102,29 +102,50 @@ extern const char *const g_btor_op2str[BTOR_NUM_OPS_NODE];
       BtorAIGVec *av;        /* synthesized AIG vector */                  \
       BtorPtrHashTable *rho; /* for finding array conflicts */             \
     };                                                                     \
-    BtorNode *next;         /* next in unique table */                     \
-    BtorNode *simplified;   /* simplified expression */                    \
-    Btor *btor;             /* boolector instance */                       \
-    BtorNode *first_parent; /* head of parent list */                      \
-    BtorNode *last_parent;  /* tail of parent list */                      \
+    BtorNode *simplified; /* simplified expression */                      \
+    Btor *btor;           /* boolector instance */                         \
   }
 
-#define BTOR_BV_ADDITIONAL_NODE_STRUCT                             \
-  struct                                                           \
-  {                                                                \
-    BtorNode *e[3];           /* expression children */            \
-    BtorNode *prev_parent[3]; /* prev in parent list of child i */ \
-    BtorNode *next_parent[3]; /* next in parent list of child i */ \
+#define BTOR_BV_ADDITIONAL_NODE_STRUCT        \
+  struct                                      \
+  {                                           \
+    BtorNode *e[3]; /* expression children */ \
   }
 
-#define BTOR_FP_ADDITIONAL_NODE_STRUCT                             \
-  struct                                                           \
-  {                                                                \
-    BtorNode *e[4];           /* expression children */            \
-    BtorNode *prev_parent[4]; /* prev in parent list of child i */ \
-    BtorNode *next_parent[4]; /* next in parent list of child i */ \
+#define BTOR_FP_ADDITIONAL_NODE_STRUCT        \
+  struct                                      \
+  {                                           \
+    BtorNode *e[4]; /* expression children */ \
   }
 
+/* Parent list links of a node.  These are only touched when connecting or
+ * disconnecting children and when iterating over parents.  In order to keep
+ * the nodes compact for traversals, they are not stored in the node itself
+ * but in 'btor->parent_links', indexed by node id.  A link refers to a parent
+ * by its id, tagged with the position of the child in the parent
+ * ('id << 2 | pos'), 0 indicates that there is no link.
+ *
+ * The links of a node in the parent lists of its children are only
+ * allocated for its 'arity' children, consecutively in 'btor->sibling_links'
+ * starting at index 'siblings'. */
+struct BtorNodeParentLinks
+{
+  uint32_t first_parent; /* head of parent list */
+  uint32_t last_parent;  /* tail of parent list */
+  uint32_t siblings;     /* links of child 0 in 'btor->sibling_links' */
+};
+typedef struct BtorNodeParentLinks BtorNodeParentLinks;
+
+struct BtorNodeSiblingLinks
+{
+  uint32_t prev_parent; /* prev in parent list of child */
+  uint32_t next_parent; /* next in parent list of child */
+};
+typedef struct BtorNodeSiblingLinks BtorNodeSiblingLinks;
+
+BTOR_DECLARE_STACK (BtorNodeParentLinks, BtorNodeParentLinks);
+BTOR_DECLARE_STACK (BtorNodeSiblingLinks, BtorNodeSiblingLinks);
+
 /*------------------------------------------------------------------------*/
 
 struct BtorBVVarNode
@@ -649,6 +670,19 @@ BtorNode *btor_node_match_by_id (Btor *btor, int32_t id);
 
 /*------------------------------------------------------------------------*/
 
+/* Get the first (resp. last) parent of 'exp', 0 if 'exp' has no parents.
+ * The parent is tagged with the position of 'exp' in the parent. */
+BtorNode *btor_node_get_first_parent (Btor *btor, const BtorNode *exp);
+BtorNode *btor_node_get_last_parent (Btor *btor, const BtorNode *exp);
+
+/* Get the next (resp. previous) parent in the parent list 'parent' belongs
+ * to, where 'parent' is tagged with the position of the child the list
+ * belongs to.  Returns 0 if there is no such parent. */
+BtorNode *btor_node_get_next_parent (Btor *btor, const BtorNode *parent);
+BtorNode *btor_node_get_prev_parent (Btor *btor, const BtorNode *parent);
+
+/*------------------------------------------------------------------------*/
+
 /* Gets the symbol of an expression. */
 char *btor_node_get_symbol (Btor *btor, const BtorNode *exp);
 
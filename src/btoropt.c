@@ -26,6 +26,7 @@ const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1] = {
     [BTOR_SAT_ENGINE_MINISAT]   = "MiniSat",
     [BTOR_SAT_ENGINE_CADICAL]   = "CaDiCaL",
     [BTOR_SAT_ENGINE_CMS]       = "CryptoMiniSat",
+    [BTOR_SAT_ENGINE_EXTERNAL]  = "External",
 };
 
 /*------------------------------------------------------------------------*/
@@ -192,6 +193,11 @@ btor_opt_init_opts (Btor *btor)
                 "smt2",
                 BTOR_INPUT_FORMAT_SMT2,
                 "force SMT-LIB v2 input format");
+  add_opt_help (mm,
+                opts,
+                "btorbin",
+                BTOR_INPUT_FORMAT_BTOR_BINARY,
+                "force binary BTOR input format");
   btor->options[BTOR_OPT_INPUT_FORMAT].options = opts;
 
   init_opt (btor,
@@ -260,6 +266,11 @@ btor_opt_init_opts (Btor *btor)
                 "aigerbin",
                 BTOR_OUTPUT_FORMAT_AIGER_BINARY,
                 "use the AIGER binary format as output file format");
+  add_opt_help (mm,
+                opts,
+                "btorbin",
+                BTOR_OUTPUT_FORMAT_BTOR_BINARY,
+                "use the binary BTOR format as output file format");
   btor->options[BTOR_OPT_OUTPUT_FORMAT].options = opts;
 
   init_opt (btor,
@@ -324,6 +335,11 @@ btor_opt_init_opts (Btor *btor)
                 "cms",
                 BTOR_SAT_ENGINE_CMS,
                 "use cryptominisat as back end SAT solver");
+  add_opt_help (mm,
+                opts,
+                "external",
+                BTOR_SAT_ENGINE_EXTERNAL,
+                "use external SAT solver process (see BTORSATCMD)");
   add_opt_help (mm,
                 opts,
                 "lingeling",
@@ -340,6 +356,36 @@ btor_opt_init_opts (Btor *btor)
                 BTOR_SAT_ENGINE_PICOSAT,
                 "use picosat as back end SAT solver");
   btor->options[BTOR_OPT_SAT_ENGINE].options = opts;
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+            false,
+            false,
+            "sat-engine-portfolio",
+            0,
+            0,
+            0,
+            1024,
+            "number of SAT solver instances run in parallel");
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_CUBES,
+            false,
+            false,
+            "sat-engine-cubes",
+            0,
+            0,
+            0,
+            20,
+            "split depth of cube-and-conquer solving");
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_SHARE_LBD,
+            false,
+            false,
+            "sat-engine-share-lbd",
+            0,
+            2,
+            0,
+            32,
+            "maximum LBD of learned clauses shared between SAT solvers");
 
   init_opt (btor,
             BTOR_OPT_AUTO_CLEANUP,
@@ -401,6 +447,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             UINT32_MAX,
             "increase loglevel");
+  init_opt (btor,
+            BTOR_OPT_THREAD_SAFE,
+            false,
+            true,
+            "thread-safe",
+            0,
+            0,
+            0,
+            1,
+            "serialize concurrent term construction");
 
   /* simplifier --------------------------------------------------------- */
   init_opt (btor,
@@ -413,6 +469,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             3,
             "rewrite level");
+  init_opt (btor,
+            BTOR_OPT_RW_CACHE_SIZE,
+            false,
+            false,
+            "rw-cache-size",
+            0,
+            128,
+            1,
+            65536,
+            "memory budget of rewrite cache in MB");
   init_opt (btor,
             BTOR_OPT_SKELETON_PREPROC,
             false,
@@ -515,6 +581,36 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "normalize addition operators");
+  init_opt (btor,
+            BTOR_OPT_AIG_REWRITE,
+            false,
+            true,
+            "aig-rewrite",
+            "aigrw",
+            0,
+            0,
+            1,
+            "cut based AIG rewriting before CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_FRAIG,
+            false,
+            true,
+            "aig-fraig",
+            "aigfr",
+            0,
+            0,
+            1,
+            "SAT sweeping of AIGs before CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_POLARITY,
+            false,
+            true,
+            "aig-polarity",
+            "aigpol",
+            0,
+            0,
+            1,
+            "polarity-aware CNF encoding of AIGs");
   init_opt (btor,
             BTOR_OPT_NORMALIZE,
             false,
@@ -688,6 +784,49 @@ btor_opt_init_opts (Btor *btor)
       0,
       1,
       "Print CNF formula sent to SAT solver in DIMACS format and terminate.");
+  init_opt (btor,
+            BTOR_OPT_CNF_STREAM_FORMAT,
+            false,
+            false,
+            "cnf-stream-format",
+            0,
+            BTOR_CNF_STREAM_FORMAT_DFLT,
+            BTOR_CNF_STREAM_FORMAT_MIN,
+            BTOR_CNF_STREAM_FORMAT_MAX,
+            "format of the CNF stream");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (mm,
+                opts,
+                "icnf",
+                BTOR_CNF_STREAM_FORMAT_ICNF,
+                "incremental CNF with assumptions");
+  add_opt_help (mm,
+                opts,
+                "dimacs",
+                BTOR_CNF_STREAM_FORMAT_DIMACS,
+                "DIMACS without assumptions (seekable files only)");
+  btor->options[BTOR_OPT_CNF_STREAM_FORMAT].options = opts;
+  init_opt (btor,
+            BTOR_OPT_CNF_STREAM_BINARY,
+            false,
+            true,
+            "cnf-stream-binary",
+            0,
+            0,
+            0,
+            1,
+            "write clauses of the CNF stream in binary encoding");
+  init_opt (btor,
+            BTOR_OPT_PARSE_PIPELINE,
+            false,
+            true,
+            "parse-pipeline",
+            "pp",
+            0,
+            0,
+            1,
+            "read and tokenize SMT-LIB v2 input in separate thread");
 
   /* SLS engine ---------------------------------------------------------- */
   init_opt (btor,
@@ -63,7 +63,7 @@ typedef struct BtorOptHelp BtorOptHelp;
 /* enums for option values are defined in btortypes.h */
 
 #define BTOR_SAT_ENGINE_MIN BTOR_SAT_ENGINE_LINGELING
-#define BTOR_SAT_ENGINE_MAX BTOR_SAT_ENGINE_CMS
+#define BTOR_SAT_ENGINE_MAX BTOR_SAT_ENGINE_EXTERNAL
 #ifdef BTOR_USE_CADICAL
 #define BTOR_SAT_ENGINE_DFLT BTOR_SAT_ENGINE_CADICAL
 #elif BTOR_USE_LINGELING
@@ -82,7 +82,7 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_ENGINE_DFLT BTOR_ENGINE_FUN
 
 #define BTOR_INPUT_FORMAT_MIN BTOR_INPUT_FORMAT_NONE
-#define BTOR_INPUT_FORMAT_MAX BTOR_INPUT_FORMAT_SMT2
+#define BTOR_INPUT_FORMAT_MAX BTOR_INPUT_FORMAT_BTOR_BINARY
 #define BTOR_INPUT_FORMAT_DFLT BTOR_INPUT_FORMAT_NONE
 
 #define BTOR_OUTPUT_BASE_MIN BTOR_OUTPUT_BASE_BIN
@@ -90,9 +90,13 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_OUTPUT_BASE_DFLT BTOR_OUTPUT_BASE_BIN
 
 #define BTOR_OUTPUT_FORMAT_MIN BTOR_OUTPUT_FORMAT_NONE
-#define BTOR_OUTPUT_FORMAT_MAX BTOR_OUTPUT_FORMAT_AIGER_BINARY
+#define BTOR_OUTPUT_FORMAT_MAX BTOR_OUTPUT_FORMAT_BTOR_BINARY
 #define BTOR_OUTPUT_FORMAT_DFLT BTOR_OUTPUT_FORMAT_NONE
 
+#define BTOR_CNF_STREAM_FORMAT_MIN BTOR_CNF_STREAM_FORMAT_ICNF
+#define BTOR_CNF_STREAM_FORMAT_MAX BTOR_CNF_STREAM_FORMAT_DIMACS
+#define BTOR_CNF_STREAM_FORMAT_DFLT BTOR_CNF_STREAM_FORMAT_ICNF
+
 #define BTOR_DP_QSORT_MIN BTOR_DP_QSORT_JUST
 #define BTOR_DP_QSORT_MAX BTOR_DP_QSORT_DESC
 #define BTOR_DP_QSORT_DFLT BTOR_DP_QSORT_JUST
@@ -10,6 +10,8 @@
 #include "boolector.h"
 #include "btorcore.h"
 #include "btoropt.h"
+#include "dumper/btordumpbin.h"
+#include "parser/btorbin.h"
 #include "parser/btorbtor.h"
 #include "parser/btorbtor2.h"
 #include "parser/btorsmt.h"
@@ -147,6 +149,11 @@ btor_parse (Btor *btor,
     parser_api = btor_parsebtor2_parser_api ();
     sprintf (msg, "parsing '%s'", infile_name);
   }
+  else if (has_compressed_suffix (infile_name, ".btorbin"))
+  {
+    parser_api = btor_parsebin_parser_api ();
+    sprintf (msg, "parsing '%s'", infile_name);
+  }
   else if (has_compressed_suffix (infile_name, ".smt2"))
   {
     parser_api = btor_parsesmt2_parser_api ();
@@ -193,7 +200,13 @@ btor_parse (Btor *btor,
     if (ch != EOF && ch)
     {
       assert (first && second);
-      if (first == '(')
+      if (first == BTOR_BIN_MAGIC[0] && second == BTOR_BIN_MAGIC[1])
+      {
+        parser_api = btor_parsebin_parser_api ();
+        sprintf (
+            msg, "assuming binary BTOR input,  parsing '%s'", infile_name);
+      }
+      else if (first == '(')
       {
         if (second == 'b')
         {
@@ -298,6 +311,27 @@ btor_parse_btor2 (Btor *btor,
       btor, infile, 0, infile_name, outfile, parser_api, error_msg, status, 0);
 }
 
+int32_t
+btor_parse_btor_binary (Btor *btor,
+                        FILE *infile,
+                        const char *infile_name,
+                        FILE *outfile,
+                        char **error_msg,
+                        int32_t *status)
+{
+  assert (btor);
+  assert (infile);
+  assert (infile_name);
+  assert (outfile);
+  assert (error_msg);
+  assert (status);
+
+  const BtorParserAPI *parser_api;
+  parser_api = btor_parsebin_parser_api ();
+  return parse_aux (
+      btor, infile, 0, infile_name, outfile, parser_api, error_msg, status, 0);
+}
+
 int32_t
 btor_parse_smt1 (Btor *btor,
                  FILE *infile,
@@ -0,0 +1,481 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorrescache.h"
+#include "btorcore.h"
+#include "btorsort.h"
+#include "utils/btorhashint.h"
+#include "utils/btorstack.h"
+
+#include <string.h>
+
+#ifndef _WIN32
+#define BTOR_HAVE_MMAP_RESULT_CACHE
+#endif
+
+#ifdef BTOR_HAVE_MMAP_RESULT_CACHE
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+BtorResultCache *
+btor_result_cache_new (BtorMemMgr *mm, const char *path)
+{
+  assert (mm);
+  assert (path);
+
+  BtorResultCache *res;
+
+  BTOR_CNEW (mm, res);
+  res->mm   = mm;
+  res->path = btor_mem_strdup (mm, path);
+  return res;
+}
+
+void
+btor_result_cache_delete (BtorResultCache *cache)
+{
+  assert (cache);
+  btor_mem_freestr (cache->mm, cache->path);
+  BTOR_DELETE (cache->mm, cache);
+}
+
+/*------------------------------------------------------------------------*/
+
+BTOR_DECLARE_STACK (BtorResultCacheKey, BtorResultCacheKey);
+
+static void
+key_init (BtorResultCacheKey *key, uint64_t v)
+{
+  key->h[0] = 0x243f6a8885a308d3ull ^ v;
+  key->h[1] = 0x13198a2e03707344ull ^ (v << 32 | v >> 32);
+}
+
+static uint64_t
+hash_mix (uint64_t h, uint64_t v)
+{
+  h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+static void
+key_add (BtorResultCacheKey *key, uint64_t v)
+{
+  key->h[0] = hash_mix (key->h[0], v);
+  key->h[1] = hash_mix (key->h[1], ~v);
+}
+
+static void
+key_add_key (BtorResultCacheKey *key, const BtorResultCacheKey *k, bool inv)
+{
+  key_add (key, k->h[0] ^ inv);
+  key_add (key, k->h[1]);
+}
+
+static void
+key_add_sort (Btor *btor, BtorResultCacheKey *key, BtorSortId sort)
+{
+  BtorTupleSortIterator it;
+
+  if (btor_sort_is_bv (btor, sort))
+  {
+    key_add (key, 1);
+    key_add (key, btor_sort_bv_get_width (btor, sort));
+  }
+  else if (btor_sort_is_array (btor, sort))
+  {
+    key_add (key, 2);
+    key_add_sort (btor, key, btor_sort_array_get_index (btor, sort));
+    key_add_sort (btor, key, btor_sort_array_get_element (btor, sort));
+  }
+  else if (btor_sort_is_fun (btor, sort))
+  {
+    key_add (key, 3);
+    key_add_sort (btor, key, btor_sort_fun_get_domain (btor, sort));
+    key_add_sort (btor, key, btor_sort_fun_get_codomain (btor, sort));
+  }
+  else
+  {
+    assert (btor_sort_is_tuple (btor, sort));
+    key_add (key, 4);
+    key_add (key, btor_sort_tuple_get_arity (btor, sort));
+    btor_iter_tuple_sort_init (&it, btor, sort);
+    while (btor_iter_tuple_sort_has_next (&it))
+      key_add_sort (btor, key, btor_iter_tuple_sort_next (&it));
+  }
+}
+
+static void
+key_add_bits (BtorResultCacheKey *key, const BtorBitVector *bv)
+{
+  uint32_t i, width;
+  uint64_t word;
+
+  width = btor_bv_get_width (bv);
+  for (i = 0, word = 0; i < width; i++)
+  {
+    word = word << 1 | btor_bv_get_bit (bv, i);
+    if (i % 64 == 63 || i + 1 == width)
+    {
+      key_add (key, word);
+      word = 0;
+    }
+  }
+}
+
+/* Compute the keys of all nodes in the cone of 'root'. Inputs (variables,
+ * parameters and uninterpreted functions) are identified by the order in
+ * which they are reached, node ids and symbols are ignored. */
+static void
+key_add_root (Btor *btor,
+              BtorResultCacheKey *key,
+              BtorNode *root,
+              BtorIntHashTable *cache,
+              BtorResultCacheKeyStack *keys,
+              uint32_t *num_inputs)
+{
+  uint32_t i;
+  BtorNode *cur, *e;
+  BtorNodePtrStack visit;
+  BtorHashTableData *d;
+  BtorResultCacheKey k;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, root);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    d   = btor_hashint_map_get (cache, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (cache, cur->id)->as_int = 0;
+      BTOR_PUSH_STACK (visit, cur);
+      for (i = 1; i <= cur->arity; i++)
+        BTOR_PUSH_STACK (visit, cur->e[cur->arity - i]);
+    }
+    else if (!d->as_int)
+    {
+      key_init (&k, cur->kind);
+      key_add_sort (btor, &k, btor_node_get_sort_id (cur));
+      if (btor_node_is_bv_const (cur))
+        key_add_bits (&k, btor_node_bv_const_get_bits (cur));
+      else if (btor_node_is_bv_var (cur) || btor_node_is_param (cur)
+               || btor_node_is_uf (cur))
+        key_add (&k, (*num_inputs)++);
+      else if (btor_node_is_bv_slice (cur))
+      {
+        key_add (&k, btor_node_bv_slice_get_upper (cur));
+        key_add (&k, btor_node_bv_slice_get_lower (cur));
+      }
+      for (i = 0; i < cur->arity; i++)
+      {
+        e = cur->e[i];
+        d = btor_hashint_map_get (cache, btor_node_real_addr (e)->id);
+        assert (d && d->as_int);
+        key_add_key (
+            &k, keys->start + d->as_int - 1, btor_node_is_inverted (e));
+      }
+      BTOR_PUSH_STACK (*keys, k);
+      d         = btor_hashint_map_get (cache, cur->id);
+      d->as_int = BTOR_COUNT_STACK (*keys);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  d = btor_hashint_map_get (cache, btor_node_real_addr (root)->id);
+  assert (d && d->as_int);
+  key_add_key (key, keys->start + d->as_int - 1, btor_node_is_inverted (root));
+}
+
+void
+btor_result_cache_key (Btor *btor, BtorResultCacheKey *key)
+{
+  assert (btor);
+  assert (key);
+
+  uint32_t num_inputs = 0;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+  BtorResultCacheKeyStack keys;
+
+  cache = btor_hashint_map_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, keys);
+
+  key_init (key, 0);
+  key_add (key, btor->unsynthesized_constraints->count
+                    + btor->synthesized_constraints->count
+                    + btor->embedded_constraints->count);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    key_add_root (
+        btor, key, btor_iter_hashptr_next (&it), cache, &keys, &num_inputs);
+
+  key_add (key, btor->assumptions->count);
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    key_add_root (
+        btor, key, btor_iter_hashptr_next (&it), cache, &keys, &num_inputs);
+
+  BTOR_RELEASE_STACK (keys);
+  btor_hashint_map_delete (cache);
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_MMAP_RESULT_CACHE
+
+#define BTOR_RESULT_CACHE_MAGIC 0x43525442u /* "BTRC" */
+#define BTOR_RESULT_CACHE_VERSION 1
+#define BTOR_RESULT_CACHE_INIT_SIZE 1024
+#define BTOR_RESULT_CACHE_MAX_SIZE (1u << 28)
+
+/* Layout of the cache file: header followed by 'size' records. */
+struct BtorResultCacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;  /* Number of records (power of 2). */
+  uint32_t count; /* Number of used records. */
+};
+
+typedef struct BtorResultCacheHeader BtorResultCacheHeader;
+
+struct BtorResultCacheRecord
+{
+  uint64_t key[2];
+  uint32_t result; /* BTOR_RESULT_UNKNOWN if the record is unused. */
+  uint32_t reserved;
+};
+
+typedef struct BtorResultCacheRecord BtorResultCacheRecord;
+
+static size_t
+cache_file_size (uint32_t size)
+{
+  return sizeof (BtorResultCacheHeader)
+         + (size_t) size * sizeof (BtorResultCacheRecord);
+}
+
+static BtorResultCacheRecord *
+get_records (BtorResultCacheHeader *header)
+{
+  return (BtorResultCacheRecord *) (header + 1);
+}
+
+/* Map the cache file 'fd' into memory, returns 0 if the file is not a valid
+ * cache file. */
+static BtorResultCacheHeader *
+map_cache_file (int fd, bool write, size_t *len)
+{
+  struct stat st;
+  BtorResultCacheHeader *res;
+
+  if (fstat (fd, &st) || (size_t) st.st_size < sizeof (*res)) return 0;
+  *len = (size_t) st.st_size;
+  res  = mmap (0,
+              *len,
+              write ? PROT_READ | PROT_WRITE : PROT_READ,
+              MAP_SHARED,
+              fd,
+              0);
+  if (res == MAP_FAILED) return 0;
+  if (res->magic != BTOR_RESULT_CACHE_MAGIC
+      || res->version != BTOR_RESULT_CACHE_VERSION || res->size == 0
+      || (res->size & (res->size - 1)) || res->count >= res->size
+      || cache_file_size (res->size) != *len)
+  {
+    munmap (res, *len);
+    return 0;
+  }
+  return res;
+}
+
+/* Find the record with key 'key' or the unused record where it would have to
+ * be inserted (linear probing). Returns 0 if there is no such record, which
+ * only happens if the file is corrupted ('count' does not match the used
+ * records), hence at most 'size' records are probed. */
+static BtorResultCacheRecord *
+find_record (BtorResultCacheHeader *header, const BtorResultCacheKey *key)
+{
+  uint32_t i, n, mask;
+  BtorResultCacheRecord *records;
+
+  records = get_records (header);
+  mask    = header->size - 1;
+  for (i = key->h[0] & mask, n = 0; n < header->size; i = (i + 1) & mask, n++)
+  {
+    if (!records[i].result
+        || (records[i].key[0] == key->h[0] && records[i].key[1] == key->h[1]))
+      return &records[i];
+  }
+  return 0;
+}
+
+/* Double the size of the cache file and rehash all records. */
+static BtorResultCacheHeader *
+enlarge_cache_file (BtorMemMgr *mm,
+                    int fd,
+                    BtorResultCacheHeader *header,
+                    size_t *len)
+{
+  uint32_t i, size, new_size;
+  size_t old_len;
+  BtorResultCacheKey key;
+  BtorResultCacheRecord *records, *rec;
+
+  size     = header->size;
+  new_size = size * 2;
+  if (new_size > BTOR_RESULT_CACHE_MAX_SIZE) return header;
+
+  BTOR_NEWN (mm, records, size);
+  memcpy (records, get_records (header), size * sizeof (*records));
+  munmap (header, *len);
+
+  header  = 0;
+  old_len = *len;
+  if (!ftruncate (fd, cache_file_size (new_size)))
+  {
+    *len   = cache_file_size (new_size);
+    header = mmap (0, *len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (header == MAP_FAILED)
+    {
+      /* the header still holds the old size, restore the old file size
+       * to keep the cache file valid */
+      header = 0;
+      (void) ftruncate (fd, old_len);
+    }
+    else
+    {
+      memset (get_records (header), 0, new_size * sizeof (*records));
+      header->size = new_size;
+      for (i = 0; i < size; i++)
+      {
+        if (!records[i].result) continue;
+        key.h[0] = records[i].key[0];
+        key.h[1] = records[i].key[1];
+        rec      = find_record (header, &key);
+        assert (rec);
+        *rec = records[i];
+      }
+    }
+  }
+  BTOR_DELETEN (mm, records, size);
+  return header;
+}
+
+#endif
+
+BtorSolverResult
+btor_result_cache_get (BtorResultCache *cache, const BtorResultCacheKey *key)
+{
+  assert (cache);
+  assert (key);
+
+  BtorSolverResult res = BTOR_RESULT_UNKNOWN;
+#ifdef BTOR_HAVE_MMAP_RESULT_CACHE
+  int fd;
+  size_t len;
+  BtorResultCacheHeader *header;
+  BtorResultCacheRecord *rec;
+
+  cache->num_get++;
+  if ((fd = open (cache->path, O_RDONLY)) < 0) return res;
+  if (!flock (fd, LOCK_SH))
+  {
+    if ((header = map_cache_file (fd, false, &len)))
+    {
+      if ((rec = find_record (header, key))) res = rec->result;
+      munmap (header, len);
+    }
+    flock (fd, LOCK_UN);
+  }
+  close (fd);
+  if (res != BTOR_RESULT_SAT && res != BTOR_RESULT_UNSAT)
+    res = BTOR_RESULT_UNKNOWN;
+  else
+    cache->num_hit++;
+#else
+  (void) cache;
+  (void) key;
+#endif
+  return res;
+}
+
+void
+btor_result_cache_add (BtorResultCache *cache,
+                       const BtorResultCacheKey *key,
+                       BtorSolverResult result)
+{
+  assert (cache);
+  assert (key);
+  assert (result == BTOR_RESULT_SAT || result == BTOR_RESULT_UNSAT);
+
+#ifdef BTOR_HAVE_MMAP_RESULT_CACHE
+  int fd;
+  size_t len;
+  struct stat st;
+  BtorResultCacheHeader *header, init;
+  BtorResultCacheRecord *rec;
+
+  if ((fd = open (cache->path, O_RDWR | O_CREAT, 0644)) < 0) return;
+  if (flock (fd, LOCK_EX))
+  {
+    close (fd);
+    return;
+  }
+
+  if (!fstat (fd, &st) && st.st_size == 0)
+  {
+    init.magic   = BTOR_RESULT_CACHE_MAGIC;
+    init.version = BTOR_RESULT_CACHE_VERSION;
+    init.size    = BTOR_RESULT_CACHE_INIT_SIZE;
+    init.count   = 0;
+    if (ftruncate (fd, cache_file_size (init.size))
+        || pwrite (fd, &init, sizeof (init), 0) != sizeof (init))
+      goto DONE;
+  }
+
+  if ((header = map_cache_file (fd, true, &len)))
+  {
+    rec = find_record (header, key);
+    if (rec && !rec->result && 4 * (header->count + 1) > 3 * header->size)
+    {
+      header = enlarge_cache_file (cache->mm, fd, header, &len);
+      if (header) rec = find_record (header, key);
+    }
+    if (header && rec && !rec->result && header->count + 1 < header->size)
+    {
+      rec->key[0] = key->h[0];
+      rec->key[1] = key->h[1];
+      rec->result = result;
+      header->count++;
+      cache->num_add++;
+    }
+    if (header) munmap (header, len);
+  }
+DONE:
+  flock (fd, LOCK_UN);
+  close (fd);
+#else
+  (void) cache;
+  (void) key;
+  (void) result;
+#endif
+}
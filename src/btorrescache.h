@@ -0,0 +1,65 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORRESCACHE_H_INCLUDED
+#define BTORRESCACHE_H_INCLUDED
+
+#include "btortypes.h"
+#include "utils/btormem.h"
+
+#include <stdint.h>
+
+/* 128 bit structural hash of a query (simplified constraints and
+ * assumptions), which is independent of node ids and symbols. */
+struct BtorResultCacheKey
+{
+  uint64_t h[2];
+};
+
+typedef struct BtorResultCacheKey BtorResultCacheKey;
+
+/* Persistent cache of SAT/UNSAT results shared between processes.
+ *
+ * The cache is a file that consists of a header and an open addressing hash
+ * table of (key, result) records, which is mapped into memory for lookups and
+ * updates. Readers hold a shared and writers an exclusive lock on the file.
+ * The table is grown in place by the writer that exceeds a load of 3/4.
+ *
+ * If memory mapped files are not supported, every lookup misses. */
+struct BtorResultCache
+{
+  BtorMemMgr *mm;
+  char *path;
+  uint64_t num_get; /* Number of lookups. */
+  uint64_t num_hit; /* Number of lookups that returned a result. */
+  uint64_t num_add; /* Number of results added to the cache file. */
+};
+
+typedef struct BtorResultCache BtorResultCache;
+
+/* Create a result cache stored in file 'path'. The file is created on the
+ * first insertion. */
+BtorResultCache *btor_result_cache_new (BtorMemMgr *mm, const char *path);
+
+/* Delete the result cache (the cache file is kept). */
+void btor_result_cache_delete (BtorResultCache *cache);
+
+/* Compute the key of the current query of 'btor', which must be simplified. */
+void btor_result_cache_key (Btor *btor, BtorResultCacheKey *key);
+
+/* Get the cached result of the query with key 'key', BTOR_RESULT_UNKNOWN if
+ * there is no such entry. */
+BtorSolverResult btor_result_cache_get (BtorResultCache *cache,
+                                        const BtorResultCacheKey *key);
+
+/* Store the result 'result' (SAT or UNSAT) of the query with key 'key'. */
+void btor_result_cache_add (BtorResultCache *cache,
+                            const BtorResultCacheKey *key,
+                            BtorSolverResult result);
+
+#endif
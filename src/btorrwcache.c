@@ -9,34 +9,74 @@
 #include "btorrwcache.h"
 #include "btorcore.h"
 
+#include <string.h>
+
 static uint32_t hash_primes[] = {
     333444569u, 76891121u, 456790003u, 2654435761u};
 
-static int32_t
-compare_rw_cache_tuple (const BtorRwCacheTuple *t0, const BtorRwCacheTuple *t1)
+#define BTOR_RW_CACHE_INIT_SETS 64
+
+static uint32_t
+hash_rw_cache_tuple (BtorNodeKind kind, int32_t n0, int32_t n1, int32_t n2)
 {
-  assert (t0);
-  assert (t1);
+  uint32_t hash;
+  hash = hash_primes[0] * (uint32_t) kind;
+  hash += hash_primes[1] * (uint32_t) n0;
+  hash += hash_primes[2] * (uint32_t) n1;
+  hash += hash_primes[3] * (uint32_t) n2;
+  return hash;
+}
 
-  if (t0->kind == t1->kind && t0->n[0] == t1->n[0] && t0->n[1] == t1->n[1]
-      && t0->n[2] == t1->n[2])
-  {
-    return 0;
-  }
-  return 1;
+/* Get the set of entries with key (kind, n0, n1, n2). */
+static BtorRwCacheTuple *
+get_set (BtorRwCache *rwc,
+         BtorNodeKind kind,
+         int32_t n0,
+         int32_t n1,
+         int32_t n2)
+{
+  uint32_t hash;
+  hash = hash_rw_cache_tuple (kind, n0, n1, n2);
+  /* the upper bits of the hash value are better distributed */
+  hash = (hash ^ (hash >> 16)) & (rwc->num_sets - 1);
+  return rwc->entries + (size_t) hash * BTOR_RW_CACHE_WAYS;
 }
 
+static bool
+is_valid_entry (BtorRwCache *rwc, BtorRwCacheTuple *t)
+{
+  return t->stamp && t->stamp >= rwc->valid_from;
+}
+
+static bool
+matches (BtorRwCacheTuple *t,
+         BtorNodeKind kind,
+         int32_t n0,
+         int32_t n1,
+         int32_t n2)
+{
+  return t->kind == kind && t->n[0] == n0 && t->n[1] == n1 && t->n[2] == n2;
+}
+
+/* Returns the next time stamp. If the time stamps are exhausted, all entries
+ * are invalidated. */
 static uint32_t
-hash_rw_cache_tuple (const BtorRwCacheTuple *t)
+next_stamp (BtorRwCache *rwc)
 {
-  uint32_t hash;
-  hash = hash_primes[0] * (uint32_t) t->kind;
-  hash += hash_primes[1] * (uint32_t) t->n[0];
-  hash += hash_primes[2] * (uint32_t) t->n[1];
-  hash += hash_primes[3] * (uint32_t) t->n[2];
-  return hash;
+  if (rwc->stamp == UINT32_MAX)
+  {
+    memset (rwc->entries,
+            0,
+            (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS
+                * sizeof (BtorRwCacheTuple));
+    rwc->num_entries = 0;
+    rwc->stamp       = 0;
+    rwc->valid_from  = 1;
+  }
+  return ++rwc->stamp;
 }
 
+#ifndef NDEBUG
 static bool
 is_valid_node (Btor *btor, int32_t id)
 {
@@ -47,6 +87,68 @@ is_valid_node (Btor *btor, int32_t id)
   }
   return true;
 }
+#endif
+
+/* An entry is dead if it refers to deallocated nodes, i.e., it will never
+ * be hit again. */
+static bool
+is_dead_entry (Btor *btor, BtorRwCacheTuple *t)
+{
+  if (!btor_node_get_by_id (btor, t->n[0])) return true;
+  if (!btor_node_get_by_id (btor, t->result)) return true;
+  if (t->kind == BTOR_BV_SLICE_NODE) return false;
+  if (t->n[1] && !btor_node_get_by_id (btor, t->n[1])) return true;
+  if (t->n[2] && !btor_node_get_by_id (btor, t->n[2])) return true;
+  return false;
+}
+
+/* Doubles the number of sets and reinserts all valid entries that are not
+ * dead. */
+static void
+enlarge_rw_cache (BtorRwCache *rwc)
+{
+  uint32_t num_sets, i, j;
+  BtorRwCacheTuple *entries, *t, *set;
+  Btor *btor;
+
+  btor     = rwc->btor;
+  num_sets = rwc->num_sets;
+  entries  = rwc->entries;
+
+  rwc->num_sets *= 2;
+  rwc->num_entries = 0;
+  BTOR_CNEWN (btor->mm,
+              rwc->entries,
+              (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS);
+
+  for (i = 0; i < num_sets * BTOR_RW_CACHE_WAYS; i++)
+  {
+    t = entries + i;
+    if (!is_valid_entry (rwc, t) || is_dead_entry (btor, t)) continue;
+    set = get_set (rwc, t->kind, t->n[0], t->n[1], t->n[2]);
+    for (j = 0; j < BTOR_RW_CACHE_WAYS; j++)
+    {
+      if (is_valid_entry (rwc, set + j)) continue;
+      set[j] = *t;
+      rwc->num_entries++;
+      break;
+    }
+  }
+  BTOR_DELETEN (btor->mm, entries, (size_t) num_sets * BTOR_RW_CACHE_WAYS);
+}
+
+/* Check if the rewrite cache may grow within the memory budget. */
+static bool
+may_enlarge_rw_cache (BtorRwCache *rwc)
+{
+  uint64_t budget;
+
+  /* enlarge only if the cache is at least half full */
+  if (rwc->num_entries < rwc->num_sets * (BTOR_RW_CACHE_WAYS / 2)) return false;
+  budget = (uint64_t) btor_opt_get (rwc->btor, BTOR_OPT_RW_CACHE_SIZE) << 20;
+  return 2 * (uint64_t) btor_rw_cache_size (rwc) <= budget
+         && rwc->num_sets < (UINT32_MAX >> 2) / BTOR_RW_CACHE_WAYS;
+}
 
 int32_t
 btor_rw_cache_get (BtorRwCache *rwc,
@@ -65,12 +167,18 @@ btor_rw_cache_get (BtorRwCache *rwc,
   }
 #endif
 
-  BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-  BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-  if (b)
+  uint32_t i;
+  BtorRwCacheTuple *set;
+
+  set = get_set (rwc, kind, nid0, nid1, nid2);
+  for (i = 0; i < BTOR_RW_CACHE_WAYS; i++)
   {
-    BtorRwCacheTuple *cached = b->key;
-    return cached->result;
+    if (is_valid_entry (rwc, set + i)
+        && matches (set + i, kind, nid0, nid1, nid2))
+    {
+      set[i].stamp = next_stamp (rwc);
+      return set[i].result;
+    }
   }
   return 0;
 }
@@ -96,58 +204,80 @@ btor_rw_cache_add (BtorRwCache *rwc,
   }
 #endif
 
-  /* The bruttomesso benchmark family produces extremely many distinct slice
-   * nodes that let's the cache grow to several GB in some cases. For now, we
-   * will disable caching of slice nodes until we find a better solution.
-   * Note: Calling btor_rw_cache_gc(...) does not help here. */
-  if (kind == BTOR_BV_SLICE_NODE)
+  uint32_t i;
+  BtorRwCacheTuple *set, *t, *victim;
+
+  set    = get_set (rwc, kind, nid0, nid1, nid2);
+  victim = 0;
+  for (i = 0; i < BTOR_RW_CACHE_WAYS; i++)
   {
-    return;
+    t = set + i;
+    if (!is_valid_entry (rwc, t))
+    {
+      if (!victim || is_valid_entry (rwc, victim)) victim = t;
+      continue;
+    }
+    if (matches (t, kind, nid0, nid1, nid2))
+    {
+      /* This can only happen if the node corresponding to the cached result
+       * does not exist anymore (= deallocated). */
+      if (t->result != result)
+      {
+        assert (btor_node_get_by_id (rwc->btor, t->result) == 0);
+        t->result = result;
+        rwc->num_update++;
+      }
+      t->stamp = next_stamp (rwc);
+      return;
+    }
+    if (!victim || (is_valid_entry (rwc, victim) && t->stamp < victim->stamp))
+      victim = t;
   }
 
-  int32_t cached_result_id;
-  if ((cached_result_id = btor_rw_cache_get (rwc, kind, nid0, nid1, nid2)))
+  assert (victim);
+  if (is_valid_entry (rwc, victim))
   {
-    /* This can only happen if the node corresponding to cached_result_id does
-     * not exist anymore (= deallocated). */
-    if (cached_result_id != result)
+    if (may_enlarge_rw_cache (rwc))
+    {
+      enlarge_rw_cache (rwc);
+      btor_rw_cache_add (rwc, kind, nid0, nid1, nid2, result);
+      return;
+    }
+    /* prefer entries that will never be hit again */
+    for (i = 0; i < BTOR_RW_CACHE_WAYS; i++)
     {
-      assert (btor_node_get_by_id (rwc->btor, cached_result_id) == 0);
-      BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-      BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-      assert (b);
-      BtorRwCacheTuple *cached = b->key;
-      cached->result           = result;  // Update the result
-      rwc->num_update++;
+      if (is_dead_entry (rwc->btor, set + i))
+      {
+        victim = set + i;
+        break;
+      }
     }
-    return;
+    rwc->num_remove++;
   }
+  else
+    rwc->num_entries++;
 
-  BtorRwCacheTuple *t;
-  BTOR_CNEW (rwc->btor->mm, t);
-  t->kind   = kind;
-  t->n[0]   = nid0;
-  t->n[1]   = nid1;
-  t->n[2]   = nid2;
-  t->result = result;
+  victim->kind   = kind;
+  victim->n[0]   = nid0;
+  victim->n[1]   = nid1;
+  victim->n[2]   = nid2;
+  victim->result = result;
+  victim->stamp  = next_stamp (rwc);
   rwc->num_add++;
-
-  btor_hashptr_table_add (rwc->cache, t);
-
-  if (rwc->num_add % 100000 == 0)
-  {
-    btor_rw_cache_gc (rwc);
-  }
 }
 
 void
 btor_rw_cache_init (BtorRwCache *rwc, Btor *btor)
 {
   assert (rwc);
-  rwc->btor       = btor;
-  rwc->cache      = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) hash_rw_cache_tuple,
-                                       (BtorCmpPtr) compare_rw_cache_tuple);
+  rwc->btor        = btor;
+  rwc->num_sets    = BTOR_RW_CACHE_INIT_SETS;
+  rwc->num_entries = 0;
+  rwc->stamp       = 0;
+  rwc->valid_from  = 1;
+  BTOR_CNEWN (btor->mm,
+              rwc->entries,
+              (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS);
   rwc->num_add    = 0;
   rwc->num_get    = 0;
   rwc->num_update = 0;
@@ -158,82 +288,42 @@ void
 btor_rw_cache_delete (BtorRwCache *rwc)
 {
   assert (rwc);
-
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
-
-  btor_iter_hashptr_init (&it, rwc->cache);
-  while (btor_iter_hashptr_has_next (&it))
-  {
-    t = btor_iter_hashptr_next (&it);
-    BTOR_DELETE (rwc->btor->mm, t);
-  }
-  btor_hashptr_table_delete (rwc->cache);
+  BTOR_DELETEN (rwc->btor->mm,
+                rwc->entries,
+                (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS);
 }
 
 void
-btor_rw_cache_reset (BtorRwCache *rwc)
+btor_rw_cache_clone (BtorRwCache *rwc, BtorRwCache *res, Btor *clone)
 {
   assert (rwc);
-  assert (rwc->btor->mm);
-  assert (rwc->cache);
+  assert (res);
+  assert (clone);
 
-  Btor *btor = rwc->btor;
-  btor_rw_cache_delete (rwc);
-  btor_rw_cache_init (rwc, btor);
+  size_t n;
+
+  *res      = *rwc;
+  res->btor = clone;
+  n         = (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS;
+  BTOR_NEWN (clone->mm, res->entries, n);
+  memcpy (res->entries, rwc->entries, n * sizeof (BtorRwCacheTuple));
 }
 
 void
-btor_rw_cache_gc (BtorRwCache *rwc)
+btor_rw_cache_reset (BtorRwCache *rwc)
 {
+  assert (rwc);
   assert (rwc->btor->mm);
-  assert (rwc->cache);
-
-  bool remove;
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
-  BtorNodeKind kind;
-
-  Btor *btor            = rwc->btor;
-  BtorPtrHashTable *old = rwc->cache;
-
-  rwc->cache = btor_hashptr_table_new (btor->mm, old->hash, old->cmp);
-
-  /* We remove all cache entries that store invalid children node ids. An
-   * invalid node is either a node that does not exist anymore (deallocated) or
-   * if the node id belongs to a proxy node. Proxy nodes are never used to
-   * query the cache and are therefore useless cache entries. */
-  btor_iter_hashptr_init (&it, old);
-  while (btor_iter_hashptr_has_next (&it))
-  {
-    t = btor_iter_hashptr_next (&it);
-    kind = t->kind;
-
-    remove = !is_valid_node (btor, t->n[0]);
-
-    if (!remove && kind != BTOR_BV_SLICE_NODE)
-    {
-      if (t->n[1])
-      {
-        remove = remove || !is_valid_node (btor, t->n[1]);
-      }
-      if (!remove && t->n[2])
-      {
-        remove = remove || !is_valid_node (btor, t->n[2]);
-      }
+  assert (rwc->entries);
 
-      remove = remove || !btor_node_get_by_id (btor, t->result);
-    }
+  rwc->num_entries = 0;
+  rwc->valid_from  = next_stamp (rwc);
+}
 
-    if (remove)
-    {
-      BTOR_DELETE (btor->mm, t);
-      rwc->num_remove++;
-    }
-    else
-    {
-      btor_hashptr_table_add (rwc->cache, t);
-    }
-  }
-  btor_hashptr_table_delete (old);
+size_t
+btor_rw_cache_size (BtorRwCache *rwc)
+{
+  assert (rwc);
+  return (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS
+         * sizeof (BtorRwCacheTuple);
 }
@@ -10,7 +10,9 @@
 #define BTORRWCACHE_H_INCLUDED
 
 #include "btornode.h"
-#include "utils/btorhashptr.h"
+
+/* Number of entries per set of the (set-associative) rewrite cache. */
+#define BTOR_RW_CACHE_WAYS 4
 
 /* Cache entry that stores the result of rewriting a node with kind 'kind' and
  * it's children 'n'.
@@ -21,20 +23,35 @@ struct BtorRwCacheTuple
   BtorNodeKind kind;
   int32_t n[3];
   int32_t result;
+  uint32_t stamp; /* time of last access, entry is valid if >= valid_from */
 };
 
 typedef struct BtorRwCacheTuple BtorRwCacheTuple;
 
-/* Stores all cache entries and some statistics. Note that the statistics are
- * not reset if btor_rw_cache_reset() or btor_rw_cache_gc() is called. */
+/* Flat set-associative cache with BTOR_RW_CACHE_WAYS entries per set. The
+ * number of sets is doubled on demand until the memory budget given by option
+ * BTOR_OPT_RW_CACHE_SIZE is reached, after which the least recently used
+ * entry of a set is replaced.
+ *
+ * Node ids are never reused, hence entries that refer to deallocated nodes
+ * never match again and do not need to be removed explicitly. They are
+ * preferably replaced on insertion. Resetting the cache only starts a new
+ * generation (all entries with a stamp less than 'valid_from' are invalid).
+ *
+ * Note that the statistics are not reset if btor_rw_cache_reset() is
+ * called. */
 struct BtorRwCache
 {
   Btor *btor;
-  BtorPtrHashTable *cache;  /* Hash table of BtorRwCacheTuple. */
-  uint64_t num_add;         /* Number of cached rewrite rules. */
-  uint64_t num_get;         /* Number of cache checks. */
-  uint64_t num_update;      /* Number of updated cache entries. */
-  uint64_t num_remove;      /* Number of removed cache entries (GC). */
+  BtorRwCacheTuple *entries; /* BTOR_RW_CACHE_WAYS * 'num_sets' entries */
+  uint32_t num_sets;         /* Number of sets (power of 2). */
+  uint32_t num_entries;      /* Number of valid entries. */
+  uint32_t stamp;            /* Current time. */
+  uint32_t valid_from;       /* First time stamp of current generation. */
+  uint64_t num_add;          /* Number of cached rewrite rules. */
+  uint64_t num_get;          /* Number of cache checks. */
+  uint64_t num_update;       /* Number of updated cache entries. */
+  uint64_t num_remove;       /* Number of replaced valid cache entries. */
 };
 
 typedef struct BtorRwCache BtorRwCache;
@@ -60,11 +77,13 @@ void btor_rw_cache_init (BtorRwCache *cache, Btor *mm);
 /* Delete the rewrite cache. */
 void btor_rw_cache_delete (BtorRwCache *cache);
 
+/* Clone the rewrite cache 'cache' into 'res' of Btor instance 'clone'. */
+void btor_rw_cache_clone (BtorRwCache *cache, BtorRwCache *res, Btor *clone);
+
 /* Reset the rewrite cache. */
 void btor_rw_cache_reset (BtorRwCache *cache);
 
-/* Remove all cache entries that contain invalid nodes (= deallocated) or
- * proxies as children. */
-void btor_rw_cache_gc (BtorRwCache *cache);
+/* Get the number of bytes allocated by the rewrite cache. */
+size_t btor_rw_cache_size (BtorRwCache *cache);
 
 #endif
@@ -16,8 +16,10 @@
 #include "btorabort.h"
 #include "btorconfig.h"
 #include "btorcore.h"
+#include "btorlookahead.h"
 #include "sat/btorcadical.h"
 #include "sat/btorcms.h"
+#include "sat/btorext.h"
 #include "sat/btorlgl.h"
 #include "sat/btorminisat.h"
 #include "sat/btorpicosat.h"
@@ -32,6 +34,9 @@
 #endif
 
 static bool enable_dimacs_printer (BtorSATMgr *smgr);
+#ifdef BTOR_HAVE_PTHREADS
+static bool enable_portfolio (BtorSATMgr *smgr, uint32_t size);
+#endif
 
 /*------------------------------------------------------------------------*/
 /* wrapper functions for SAT solver API                                   */
@@ -75,6 +80,12 @@ enable_verbosity (BtorSATMgr *smgr, int32_t level)
   if (smgr->api.enable_verbosity) smgr->api.enable_verbosity (smgr, level);
 }
 
+static inline void
+diversify (BtorSATMgr *smgr, uint32_t seed)
+{
+  if (smgr->api.diversify) smgr->api.diversify (smgr, seed);
+}
+
 static inline int32_t
 failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -287,15 +298,10 @@ btor_sat_set_output (BtorSATMgr *smgr, FILE *output)
   btor_mem_free (smgr->btor->mm, prefix, strlen (smgr->name) + 4);
 }
 
-void
-btor_sat_enable_solver (BtorSATMgr *smgr)
+static void
+enable_engine (BtorSATMgr *smgr, uint32_t engine)
 {
-  assert (smgr);
-
-  uint32_t opt;
-
-  opt = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
-  switch (opt)
+  switch (engine)
   {
 #ifdef BTOR_USE_LINGELING
     case BTOR_SAT_ENGINE_LINGELING: btor_sat_enable_lingeling (smgr); break;
@@ -312,8 +318,23 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
 #ifdef BTOR_USE_CMS
     case BTOR_SAT_ENGINE_CMS: btor_sat_enable_cms (smgr); break;
 #endif
+    case BTOR_SAT_ENGINE_EXTERNAL: btor_sat_enable_external (smgr); break;
     default: BTOR_ABORT (1, "no sat solver configured");
   }
+}
+
+void
+btor_sat_enable_solver (BtorSATMgr *smgr)
+{
+  assert (smgr);
+
+  uint32_t engine;
+#ifdef BTOR_HAVE_PTHREADS
+  uint32_t size;
+#endif
+
+  engine = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  enable_engine (smgr, engine);
 
   BTOR_MSG (smgr->btor->msg,
             1,
@@ -321,12 +342,38 @@ btor_sat_enable_solver (BtorSATMgr *smgr)
             smgr->name,
             smgr->api.assume ? "both incremental and " : "");
 
-  if (btor_opt_get (smgr->btor, BTOR_OPT_PRINT_DIMACS))
+#ifdef BTOR_HAVE_PTHREADS
+  size = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO);
+  /* the external solver can not be terminated by the portfolio */
+  if (size > 1 && engine == BTOR_SAT_ENGINE_EXTERNAL)
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s does not support termination, disabling portfolio",
+              smgr->name);
+  else if (size > 1)
+    enable_portfolio (smgr, size);
+#endif
+
+  if (btor_opt_get (smgr->btor, BTOR_OPT_PRINT_DIMACS)
+      || smgr->btor->cnf_stream)
   {
     enable_dimacs_printer (smgr);
   }
 }
 
+void
+btor_sat_enable_side_solver (BtorSATMgr *smgr)
+{
+  assert (smgr);
+
+  uint32_t engine;
+
+  engine = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  /* do not start another external solver process */
+  if (engine == BTOR_SAT_ENGINE_EXTERNAL) engine = BTOR_SAT_ENGINE_DFLT;
+  enable_engine (smgr, engine);
+}
+
 static void
 init_flags (BtorSATMgr *smgr)
 {
@@ -480,6 +527,34 @@ btor_sat_failed (BtorSATMgr *smgr, int32_t lit)
 /* DIMACS printer                                                         */
 /*------------------------------------------------------------------------*/
 
+/* Open the CNF stream configured via 'boolector_set_cnf_stream' ("-" denotes
+ * stdout). */
+static void
+open_cnf_stream (BtorSATMgr *smgr, BtorCnfPrinter *printer)
+{
+  Btor *btor       = smgr->btor;
+  const char *path = btor->cnf_stream;
+  bool icnf, binary;
+
+  icnf   = btor_opt_get (btor, BTOR_OPT_CNF_STREAM_FORMAT)
+         == BTOR_CNF_STREAM_FORMAT_ICNF;
+  binary = btor_opt_get (btor, BTOR_OPT_CNF_STREAM_BINARY);
+
+  printer->stream = strcmp (path, "-") ? fopen (path, "wb") : stdout;
+  BTOR_ABORT (!printer->stream, "failed to open CNF stream '%s'", path);
+  BTOR_ABORT (!icnf && !btor_dumpcnf_is_seekable (printer->stream),
+              "DIMACS output requires seekable CNF stream, "
+              "use iCNF format for '%s'",
+              path);
+  printer->writer = btor_dumpcnf_new (btor->mm, printer->stream, icnf, binary);
+  BTOR_MSG (btor->msg,
+            1,
+            "streaming CNF in %s%s format to '%s'",
+            binary ? "binary " : "",
+            icnf ? "iCNF" : "DIMACS",
+            path);
+}
+
 static void *
 dimacs_printer_init (BtorSATMgr *smgr)
 {
@@ -488,7 +563,9 @@ dimacs_printer_init (BtorSATMgr *smgr)
 
   BTOR_INIT_STACK (smgr->btor->mm, printer->clauses);
   BTOR_INIT_STACK (smgr->btor->mm, printer->assumptions);
-  printer->out = stdout;
+  printer->out  = stdout;
+  printer->dump = btor_opt_get (smgr->btor, BTOR_OPT_PRINT_DIMACS);
+  if (smgr->btor->cnf_stream) open_cnf_stream (smgr, printer);
 
   /* Note: We need to explicitly do the initialization steps for 'wrapped_smgr'
    * here instead of calling btor_sat_init on 'wrapped_smgr'. Otherwise, not all
@@ -504,7 +581,8 @@ static void
 dimacs_printer_add (BtorSATMgr *smgr, int32_t lit)
 {
   BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
-  BTOR_PUSH_STACK (printer->clauses, lit);
+  if (printer->dump) BTOR_PUSH_STACK (printer->clauses, lit);
+  if (printer->writer) btor_dumpcnf_add (printer->writer, lit);
   add (printer->smgr, lit);
 }
 
@@ -556,9 +634,16 @@ dimacs_printer_reset (BtorSATMgr *smgr)
 {
   BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
   BtorSATMgr *wrapped_smgr = printer->smgr;
+  bool ok;
 
   reset (wrapped_smgr);
 
+  if (printer->writer)
+  {
+    ok = btor_dumpcnf_delete (printer->writer);
+    if (printer->stream != stdout) ok = !fclose (printer->stream) && ok;
+    BTOR_WARN (!ok, "failed to write CNF stream '%s'", smgr->btor->cnf_stream);
+  }
   BTOR_DELETE (smgr->btor->mm, wrapped_smgr);
   BTOR_RELEASE_STACK (printer->clauses);
   BTOR_RELEASE_STACK (printer->assumptions);
@@ -606,13 +691,22 @@ dimacs_printer_sat (BtorSATMgr *smgr, int32_t limit)
   BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
   BtorSATMgr *wrapped_smgr = printer->smgr;
 
-  print_dimacs (smgr);
+  if (printer->writer)
+    BTOR_ABORT (!btor_dumpcnf_query (printer->writer,
+                                     printer->assumptions.start,
+                                     BTOR_COUNT_STACK (printer->assumptions)),
+                "failed to write CNF stream '%s'",
+                smgr->btor->cnf_stream);
+  if (printer->dump) print_dimacs (smgr);
+  /* assumptions are only valid for one call */
+  BTOR_RESET_STACK (printer->assumptions);
 
   wrapped_smgr->inc_required = smgr->inc_required;
   wrapped_smgr->satcalls     = smgr->satcalls;
 
-  /* If incremental is disabled, we only print the CNF and return unknown. */
-  return smgr->inc_required ? sat (wrapped_smgr, limit) : 0;
+  /* If incremental is disabled, we only print the CNF and return unknown.
+   * A streamed CNF is always solved. */
+  return !printer->dump || smgr->inc_required ? sat (wrapped_smgr, limit) : 0;
 }
 
 static void
@@ -666,6 +760,8 @@ dimacs_printer_clone (Btor *btor, BtorSATMgr *smgr)
   clone_int_stack (mm, &printer_clone->assumptions, &printer->assumptions);
   clone_int_stack (mm, &printer_clone->clauses, &printer->clauses);
   printer_clone->out  = printer->out;
+  printer_clone->dump = printer->dump;
+  /* the clone does not write to the CNF stream */
   printer_clone->smgr = btor_sat_mgr_clone (btor, printer->smgr);
 
   return printer_clone;
@@ -701,8 +797,9 @@ dimacs_printer_melt (BtorSATMgr *smgr, int32_t lit)
 
 /* The DIMACS printer is a SAT manager that wraps the currently configured SAT
  * mangager. It records the CNF sent to the SAT solver and forwards all API
- * calls to the wrapped SAT manager. The DIMACS printer assumes a SAT solver
- * was already enabled. */
+ * calls to the wrapped SAT manager. If a CNF stream is configured, the CNF is
+ * written to the stream as it is added instead of being recorded. The DIMACS
+ * printer assumes a SAT solver was already enabled. */
 static bool
 enable_dimacs_printer (BtorSATMgr *smgr)
 {
@@ -744,3 +841,1030 @@ enable_dimacs_printer (BtorSATMgr *smgr)
 
   return true;
 }
+
+/*------------------------------------------------------------------------*/
+/* SAT solver portfolio                                                   */
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+/* Initial decision/conflict limit for solvers that can not be terminated via
+ * 'setterm' and are thus run in slices of increasing limits. */
+#define BTOR_SAT_SLICE 10000
+
+/* Number of slots of the ring of shared learned clauses. */
+#define BTOR_SAT_SHARE_SIZE (1u << 12)
+
+static const uint32_t g_sat_engines[] = {
+#ifdef BTOR_USE_LINGELING
+    BTOR_SAT_ENGINE_LINGELING,
+#endif
+#ifdef BTOR_USE_PICOSAT
+    BTOR_SAT_ENGINE_PICOSAT,
+#endif
+#ifdef BTOR_USE_MINISAT
+    BTOR_SAT_ENGINE_MINISAT,
+#endif
+#ifdef BTOR_USE_CADICAL
+    BTOR_SAT_ENGINE_CADICAL,
+#endif
+#ifdef BTOR_USE_CMS
+    BTOR_SAT_ENGINE_CMS,
+#endif
+};
+
+/* Callbacks of the clause sharing hooks, 'state' is the client of the
+ * solver instance. */
+static void
+share_export (void *state, int32_t *lits, int32_t lbd)
+{
+  (void) btor_sat_share_export ((BtorSATShareClient *) state, lits, lbd);
+}
+
+static void
+share_import (void *state, int32_t **lits, int32_t *lbd)
+{
+  *lits = btor_sat_share_import ((BtorSATShareClient *) state, lbd);
+}
+
+/* Connect the initialized solver instance 'smgr' to the clause sharing ring
+ * 'share' as client 'client' with id 'id'. */
+static void
+share_connect (BtorSATMgr *smgr,
+               BtorSATShare *share,
+               BtorSATShareClient *client,
+               uint32_t id)
+{
+  btor_sat_share_init_client (share, client, id);
+  if (smgr->api.export_clauses)
+    smgr->api.export_clauses (smgr, share_export, client);
+  if (smgr->api.import_clauses)
+    smgr->api.import_clauses (smgr, share_import, client);
+}
+
+/* Solvers without 'import_clauses' hook get the shared clauses added in
+ * between SAT calls. */
+static void
+share_add_imported (BtorSATMgr *smgr, BtorSATShareClient *client)
+{
+  int32_t *lits, lbd;
+
+  if (!client->share || smgr->api.import_clauses) return;
+  while ((lits = btor_sat_share_import (client, &lbd)))
+  {
+    for (; *lits; lits++) add (smgr, *lits);
+    add (smgr, 0);
+  }
+}
+
+/* Solve under the 'n' assumptions 'assumptions' with limit 'limit'. Solvers
+ * without terminate callback can not be stopped while solving, they are
+ * called with increasing limits and 'terminate' is checked in between. */
+static int32_t
+solve_interruptible (BtorSATMgr *smgr,
+                     BtorSATShareClient *share,
+                     const int32_t *assumptions,
+                     size_t n,
+                     int32_t limit,
+                     int32_t (*terminate) (void *),
+                     void *state)
+{
+  int32_t res, slice;
+  size_t i;
+
+  if (limit >= 0 || smgr->api.setterm)
+  {
+    share_add_imported (smgr, share);
+    for (i = 0; i < n; i++) assume (smgr, assumptions[i]);
+    return sat (smgr, limit);
+  }
+
+  for (slice = BTOR_SAT_SLICE;;)
+  {
+    share_add_imported (smgr, share);
+    /* assumptions are only valid for one call */
+    for (i = 0; i < n; i++) assume (smgr, assumptions[i]);
+    res = sat (smgr, slice);
+    if (res || terminate (state)) return res;
+    if (slice < INT32_MAX / 2) slice *= 2;
+  }
+}
+
+/* Terminate callback of all solver instances. */
+static int32_t
+portfolio_terminate (void *state)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) state;
+
+  if (__atomic_load_n (&portfolio->winner, __ATOMIC_ACQUIRE) >= 0) return 1;
+  return portfolio->term.fun && portfolio->term.fun (portfolio->term.state);
+}
+
+/* Copy the state the SAT layer maintains for 'smgr' to a solver instance. */
+static void
+portfolio_sync (BtorSATMgr *smgr, BtorSATMgr *wsmgr)
+{
+  wsmgr->inc_required = smgr->inc_required;
+  wsmgr->satcalls     = smgr->satcalls;
+  wsmgr->clauses      = smgr->clauses;
+  wsmgr->maxvar       = smgr->maxvar;
+}
+
+/* The SAT manager that answered the last SAT call. */
+static BtorSATMgr *
+portfolio_winner (BtorSATPortfolio *portfolio)
+{
+  return portfolio->workers[portfolio->winner >= 0 ? portfolio->winner : 0]
+      .smgr;
+}
+
+static void *portfolio_thread (void *state);
+
+static void *
+portfolio_init (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATPortfolioWorker *w;
+  uint32_t i;
+
+  for (i = 0; i < portfolio->size; i++)
+  {
+    w = portfolio->workers + i;
+    BTOR_MSG (smgr->btor->msg, 1, "initialized %s (%u)", w->smgr->name, i);
+    init_flags (w->smgr);
+    w->smgr->solver = init (w->smgr);
+    if (w->seed) diversify (w->smgr, w->seed);
+    w->smgr->term.fun   = portfolio_terminate;
+    w->smgr->term.state = portfolio;
+    setterm (w->smgr);
+    if (portfolio->share)
+      share_connect (w->smgr, portfolio->share, &w->share, i);
+  }
+  portfolio->winner = -1;
+
+  /* The first solver instance runs in the calling thread. */
+  pthread_mutex_init (&portfolio->lock, 0);
+  pthread_cond_init (&portfolio->start, 0);
+  pthread_cond_init (&portfolio->done, 0);
+  for (i = 1; i < portfolio->size; i++)
+  {
+    w = portfolio->workers + i;
+    BTOR_ABORT (pthread_create (&w->thread, 0, portfolio_thread, w),
+                "failed to create SAT solver thread");
+  }
+  return portfolio;
+}
+
+static void
+portfolio_add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  for (uint32_t i = 0; i < portfolio->size; i++)
+    add (portfolio->workers[i].smgr, lit);
+}
+
+static void
+portfolio_assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BTOR_PUSH_STACK (portfolio->assumptions, lit);
+}
+
+static int32_t
+portfolio_deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  return deref (portfolio_winner (portfolio), lit);
+}
+
+static int32_t
+portfolio_repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  return repr (portfolio_winner (portfolio), lit);
+}
+
+static int32_t
+portfolio_failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  return failed (portfolio_winner (portfolio), lit);
+}
+
+static int32_t
+portfolio_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  return fixed (portfolio_winner (portfolio), lit);
+}
+
+static void
+portfolio_enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  for (uint32_t i = 0; i < portfolio->size; i++)
+    enable_verbosity (portfolio->workers[i].smgr, level);
+}
+
+static int32_t
+portfolio_inc_max_var (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *wsmgr;
+  int32_t res = 0, wres;
+
+  for (uint32_t i = 0; i < portfolio->size; i++)
+  {
+    wsmgr = portfolio->workers[i].smgr;
+    portfolio_sync (smgr, wsmgr);
+    wres          = inc_max_var (wsmgr);
+    wsmgr->maxvar = wres;
+    /* all solvers number their variables consecutively */
+    assert (!i || wres == res);
+    res = wres;
+  }
+  return res;
+}
+
+static void
+portfolio_melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *wsmgr;
+
+  for (uint32_t i = 0; i < portfolio->size; i++)
+  {
+    wsmgr               = portfolio->workers[i].smgr;
+    wsmgr->inc_required = smgr->inc_required;
+    melt (wsmgr, lit);
+  }
+}
+
+static void
+portfolio_reset (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorMemMgr *mm              = smgr->btor->mm;
+  BtorSATMgr *wsmgr;
+
+  pthread_mutex_lock (&portfolio->lock);
+  portfolio->quit = true;
+  pthread_cond_broadcast (&portfolio->start);
+  pthread_mutex_unlock (&portfolio->lock);
+  for (uint32_t i = 1; i < portfolio->size; i++)
+    pthread_join (portfolio->workers[i].thread, 0);
+  pthread_mutex_destroy (&portfolio->lock);
+  pthread_cond_destroy (&portfolio->start);
+  pthread_cond_destroy (&portfolio->done);
+
+  for (uint32_t i = 0; i < portfolio->size; i++)
+  {
+    wsmgr = portfolio->workers[i].smgr;
+    reset (wsmgr);
+    BTOR_DELETE (mm, wsmgr);
+  }
+  BTOR_DELETEN (mm, portfolio->workers, portfolio->size);
+  BTOR_RELEASE_STACK (portfolio->assumptions);
+  if (portfolio->share) btor_sat_share_delete (portfolio->share);
+  BTOR_DELETE (mm, portfolio);
+  smgr->solver = 0;
+}
+
+/* Solve with one solver instance, called concurrently for all instances. */
+static void
+portfolio_solve (BtorSATPortfolioWorker *w)
+{
+  BtorSATPortfolio *portfolio = w->portfolio;
+  int32_t winner              = -1;
+
+  w->res = solve_interruptible (w->smgr,
+                                &w->share,
+                                portfolio->assumptions.start,
+                                BTOR_COUNT_STACK (portfolio->assumptions),
+                                portfolio->limit,
+                                portfolio_terminate,
+                                portfolio);
+  if (w->res)
+    __atomic_compare_exchange_n (&portfolio->winner,
+                                 &winner,
+                                 (int32_t) (w - portfolio->workers),
+                                 false,
+                                 __ATOMIC_ACQ_REL,
+                                 __ATOMIC_ACQUIRE);
+}
+
+/* Worker thread of solver instance 'state', solves on every SAT call until
+ * the portfolio is reset. */
+static void *
+portfolio_thread (void *state)
+{
+  BtorSATPortfolioWorker *w   = (BtorSATPortfolioWorker *) state;
+  BtorSATPortfolio *portfolio = w->portfolio;
+
+  pthread_mutex_lock (&portfolio->lock);
+  for (;;)
+  {
+    while (!portfolio->quit && w->calls == portfolio->calls)
+      pthread_cond_wait (&portfolio->start, &portfolio->lock);
+    if (portfolio->quit) break;
+    w->calls = portfolio->calls;
+    pthread_mutex_unlock (&portfolio->lock);
+    portfolio_solve (w);
+    pthread_mutex_lock (&portfolio->lock);
+    if (--portfolio->running == 0) pthread_cond_signal (&portfolio->done);
+  }
+  pthread_mutex_unlock (&portfolio->lock);
+  return 0;
+}
+
+static int32_t
+portfolio_sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATPortfolioWorker *w;
+  uint32_t i;
+  int32_t res;
+
+  portfolio->winner     = -1;
+  portfolio->limit      = limit;
+  portfolio->term.fun   = smgr->term.fun;
+  portfolio->term.state = smgr->term.state;
+  for (i = 0; i < portfolio->size; i++)
+    portfolio_sync (smgr, portfolio->workers[i].smgr);
+
+  pthread_mutex_lock (&portfolio->lock);
+  portfolio->calls += 1;
+  portfolio->running = portfolio->size - 1;
+  pthread_cond_broadcast (&portfolio->start);
+  pthread_mutex_unlock (&portfolio->lock);
+
+  portfolio_solve (portfolio->workers);
+
+  pthread_mutex_lock (&portfolio->lock);
+  while (portfolio->running)
+    pthread_cond_wait (&portfolio->done, &portfolio->lock);
+  pthread_mutex_unlock (&portfolio->lock);
+
+  BTOR_RESET_STACK (portfolio->assumptions);
+  if (portfolio->winner < 0) return 0;
+
+  w   = portfolio->workers + portfolio->winner;
+  res = w->res;
+  w->wins += 1;
+  BTOR_MSG (smgr->btor->msg,
+            2,
+            "SAT call %d answered by %s (%d)",
+            smgr->satcalls,
+            w->smgr->name,
+            portfolio->winner);
+#ifndef NDEBUG
+  for (i = 0; i < portfolio->size; i++)
+    assert (!portfolio->workers[i].res || portfolio->workers[i].res == res);
+#endif
+  return res;
+}
+
+static void
+portfolio_set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  for (uint32_t i = 0; i < portfolio->size; i++)
+    btor_sat_set_output (portfolio->workers[i].smgr, output);
+}
+
+static void
+portfolio_stats (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATPortfolioWorker *w;
+
+  for (uint32_t i = 0; i < portfolio->size; i++)
+  {
+    w = portfolio->workers + i;
+    stats (w->smgr);
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s (%u) answered %u of %d SAT calls",
+              w->smgr->name,
+              i,
+              w->wins,
+              smgr->satcalls);
+    if (portfolio->share)
+      BTOR_MSG (smgr->btor->msg,
+                1,
+                "%s (%u) exported %lld and imported %lld clauses",
+                w->smgr->name,
+                i,
+                (long long) w->share.num_exported,
+                (long long) w->share.num_imported);
+  }
+}
+
+static void
+portfolio_setterm (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  portfolio->term.fun         = smgr->term.fun;
+  portfolio->term.state       = smgr->term.state;
+}
+
+/* The portfolio is a SAT manager that wraps 'size' instances of the currently
+ * configured SAT manager. The first instance uses the configured SAT solver,
+ * the others cycle through all SAT solvers that are compiled in and use
+ * diversified configurations if a solver occurs more than once. Instances of
+ * solvers without 'diversify' hook are only used once, and the portfolio is
+ * not enabled if that leaves a single instance. Clauses are added to all
+ * instances, and on 'sat' all instances run concurrently until the first one
+ * answers, which terminates the others via 'setterm'. The worker threads are
+ * started once on 'init' and wait for the next SAT call in between. */
+static bool
+enable_portfolio (BtorSATMgr *smgr, uint32_t size)
+{
+  assert (smgr);
+  assert (smgr->name);
+  assert (size > 1);
+  assert (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE)
+          != BTOR_SAT_ENGINE_EXTERNAL);
+
+  BtorSATPortfolio *portfolio;
+  BtorSATPortfolioWorker *w;
+  BtorMemMgr *mm;
+  uint32_t i, n, engine, num_engines, first;
+  bool inc;
+
+  mm          = smgr->btor->mm;
+  engine      = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  num_engines = sizeof (g_sat_engines) / sizeof (*g_sat_engines);
+  for (first = 0; first < num_engines && g_sat_engines[first] != engine;
+       first++)
+    ;
+  if (first == num_engines) first = 0;
+
+  BTOR_CNEW (mm, portfolio);
+  BTOR_CNEWN (mm, portfolio->workers, size);
+  BTOR_INIT_STACK (mm, portfolio->assumptions);
+  portfolio->size = size;
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_SHARE_LBD))
+    portfolio->share = btor_sat_share_new (
+        mm,
+        BTOR_SAT_SHARE_SIZE,
+        btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_SHARE_LBD));
+
+  inc = btor_sat_mgr_has_incremental_support (smgr);
+  for (i = 0, n = 0; i < size; i++)
+  {
+    w            = portfolio->workers + n;
+    w->portfolio = portfolio;
+    w->seed      = i / num_engines;
+    if (i == 0)
+    {
+      BTOR_CNEW (mm, w->smgr);
+      memcpy (w->smgr, smgr, sizeof (BtorSATMgr));
+    }
+    else
+    {
+      w->smgr = btor_sat_mgr_new (smgr->btor);
+      enable_engine (w->smgr, g_sat_engines[(first + i) % num_engines]);
+      if (inc && !btor_sat_mgr_has_incremental_support (w->smgr))
+      {
+        enable_engine (w->smgr, engine);
+        w->seed = i;
+      }
+      /* an instance that can not be diversified would be an identical copy
+       * of the first instance of its engine */
+      if (w->seed && !w->smgr->api.diversify)
+      {
+        btor_sat_mgr_delete (w->smgr);
+        w->smgr = 0;
+        continue;
+      }
+    }
+#ifdef BTOR_USE_LINGELING
+    /* forking allocates memory that is not accounted for thread-safely */
+    w->smgr->fork = false;
+#endif
+    smgr->have_restore |= w->smgr->have_restore;
+    n += 1;
+  }
+
+  if (n < size)
+  {
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "dropped %u SAT solver instances that can not be diversified",
+              size - n);
+    BTOR_REALLOC (mm, portfolio->workers, size, n);
+    portfolio->size = n;
+  }
+  if (n == 1)
+  {
+    BTOR_WARN (true,
+               "%s can not be diversified, disabling SAT solver portfolio",
+               smgr->name);
+    BTOR_DELETE (mm, portfolio->workers[0].smgr);
+    BTOR_DELETEN (mm, portfolio->workers, 1);
+    BTOR_RELEASE_STACK (portfolio->assumptions);
+    if (portfolio->share) btor_sat_share_delete (portfolio->share);
+    BTOR_DELETE (mm, portfolio);
+    return false;
+  }
+
+  /* Clear API */
+  memset (&smgr->api, 0, sizeof (smgr->api));
+
+  smgr->solver               = portfolio;
+  smgr->name                 = "Portfolio";
+  smgr->api.add              = portfolio_add;
+  smgr->api.deref            = portfolio_deref;
+  smgr->api.enable_verbosity = portfolio_enable_verbosity;
+  smgr->api.fixed            = portfolio_fixed;
+  smgr->api.inc_max_var      = portfolio_inc_max_var;
+  smgr->api.init             = portfolio_init;
+  smgr->api.melt             = portfolio_melt;
+  smgr->api.repr             = portfolio_repr;
+  smgr->api.reset            = portfolio_reset;
+  smgr->api.sat              = portfolio_sat;
+  smgr->api.set_output       = portfolio_set_output;
+  smgr->api.stats            = portfolio_stats;
+  smgr->api.setterm          = portfolio_setterm;
+
+  /* These function are used in btor_sat_mgr_has_* testers and should only be
+   * set if all instances support them. */
+  smgr->api.assume = inc ? portfolio_assume : 0;
+  smgr->api.failed = inc ? portfolio_failed : 0;
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "using portfolio of %u SAT solver instances",
+            n);
+  return true;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+/* Cube-and-conquer                                                       */
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+/* Terminate callback of all workers. */
+static int32_t
+cubes_terminate (void *state)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) state;
+
+  if (__atomic_load_n (&cubes->stop, __ATOMIC_ACQUIRE)) return 1;
+  return cubes->term.fun && cubes->term.fun (cubes->term.state);
+}
+
+/* The SAT manager that found a satisfiable cube in the last SAT call. */
+static BtorSATMgr *
+cubes_winner (BtorSATCubes *cubes)
+{
+  return cubes->workers[cubes->winner >= 0 ? cubes->winner : 0].smgr;
+}
+
+static void *
+cubes_init (BtorSATMgr *smgr)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorSATMgr *wsmgr   = cubes->workers[0].smgr;
+
+  BTOR_MSG (smgr->btor->msg, 1, "initialized %s", wsmgr->name);
+  init_flags (wsmgr);
+  wsmgr->solver = init (wsmgr);
+  if (cubes->share)
+    share_connect (wsmgr, cubes->share, &cubes->workers[0].share, 0);
+  cubes->winner = -1;
+  return cubes;
+}
+
+static void
+cubes_add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BTOR_PUSH_STACK (cubes->clauses, lit);
+  add (cubes->workers[0].smgr, lit);
+}
+
+static void
+cubes_assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BTOR_PUSH_STACK (cubes->assumptions, lit);
+}
+
+static int32_t
+cubes_deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  return deref (cubes_winner (cubes), lit);
+}
+
+static int32_t
+cubes_failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+
+  for (size_t i = 0; i < BTOR_COUNT_STACK (cubes->failed); i++)
+    if (BTOR_PEEK_STACK (cubes->failed, i) == lit) return 1;
+  return 0;
+}
+
+static int32_t
+cubes_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  return fixed (cubes->workers[0].smgr, lit);
+}
+
+static int32_t
+cubes_repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  return repr (cubes->workers[0].smgr, lit);
+}
+
+static void
+cubes_enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  enable_verbosity (cubes->workers[0].smgr, level);
+}
+
+static int32_t
+cubes_inc_max_var (BtorSATMgr *smgr)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorSATMgr *wsmgr   = cubes->workers[0].smgr;
+
+  /* workers always solve under assumptions */
+  wsmgr->inc_required = true;
+  wsmgr->maxvar       = smgr->maxvar;
+  wsmgr->maxvar       = inc_max_var (wsmgr);
+  return wsmgr->maxvar;
+}
+
+static void
+cubes_melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  melt (cubes->workers[0].smgr, lit);
+}
+
+static void
+cubes_reset (BtorSATMgr *smgr)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorMemMgr *mm      = smgr->btor->mm;
+  BtorSATMgr *wsmgr;
+
+  for (uint32_t i = 0; i < cubes->size; i++)
+  {
+    if ((wsmgr = cubes->workers[i].smgr))
+    {
+      reset (wsmgr);
+      BTOR_DELETE (mm, wsmgr);
+    }
+    BTOR_RELEASE_STACK (cubes->workers[i].assumptions);
+  }
+  BTOR_DELETEN (mm, cubes->workers, cubes->size);
+  BTOR_RELEASE_STACK (cubes->clauses);
+  BTOR_RELEASE_STACK (cubes->assumptions);
+  BTOR_RELEASE_STACK (cubes->cubes);
+  BTOR_RELEASE_STACK (cubes->starts);
+  BTOR_RELEASE_STACK (cubes->failed);
+  if (cubes->share) btor_sat_share_delete (cubes->share);
+  BTOR_DELETE (mm, cubes);
+  smgr->solver = 0;
+}
+
+/* Create the SAT manager of worker 'w' > 0, either as clone of the wrapped
+ * SAT manager or as fresh instance of the configured SAT solver, which then
+ * gets all clauses added so far in 'cubes_solve'. */
+static void
+cubes_new_worker (BtorSATMgr *smgr, BtorSATCubesWorker *w)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorSATMgr *wsmgr   = cubes->workers[0].smgr;
+
+  if (btor_sat_mgr_has_clone_support (wsmgr))
+  {
+    w->smgr     = btor_sat_mgr_clone (smgr->btor, wsmgr);
+    w->replayed = BTOR_COUNT_STACK (cubes->clauses);
+  }
+  else
+  {
+    w->smgr = btor_sat_mgr_new (smgr->btor);
+    enable_engine (w->smgr, btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE));
+    init_flags (w->smgr);
+    w->smgr->solver = init (w->smgr);
+    enable_verbosity (w->smgr, btor_opt_get (smgr->btor, BTOR_OPT_VERBOSITY));
+  }
+#ifdef BTOR_USE_LINGELING
+  /* forking allocates memory that is not accounted for thread-safely */
+  w->smgr->fork = false;
+#endif
+  w->smgr->term.fun   = cubes_terminate;
+  w->smgr->term.state = cubes;
+  if (cubes->share)
+    share_connect (w->smgr,
+                   cubes->share,
+                   &w->share,
+                   (uint32_t) (w - cubes->workers));
+}
+
+/* Worker loop, called concurrently for all workers. */
+static void *
+cubes_solve (void *state)
+{
+  BtorSATCubesWorker *w = (BtorSATCubesWorker *) state;
+  BtorSATCubes *cubes   = w->cubes;
+  BtorSATMgr *wsmgr     = w->smgr;
+  BtorIntStack *clauses = &cubes->clauses;
+  size_t i, n, num_assumptions, num_cubes;
+  int32_t *lits, *cube, winner = -1;
+  uint32_t next;
+
+  /* add clauses added since the last call */
+  wsmgr->inc_required = true;
+  while (wsmgr->maxvar < cubes->maxvar) wsmgr->maxvar = inc_max_var (wsmgr);
+  for (; w->replayed < BTOR_COUNT_STACK (*clauses); w->replayed++)
+    add (wsmgr, BTOR_PEEK_STACK (*clauses, w->replayed));
+  setterm (wsmgr);
+
+  num_assumptions = BTOR_COUNT_STACK (cubes->assumptions);
+  num_cubes       = BTOR_COUNT_STACK (cubes->starts);
+  lits            = w->assumptions.start;
+  for (;;)
+  {
+    if (cubes_terminate (cubes)) break;
+    next = __atomic_fetch_add (&cubes->next, 1, __ATOMIC_RELAXED);
+    if (next >= num_cubes) break;
+
+    /* solve under the assumptions followed by the cube (there is enough room
+     * in 'w->assumptions' for any cube) */
+    cube = cubes->cubes.start + BTOR_PEEK_STACK (cubes->starts, next);
+    for (n = num_assumptions; *cube; cube++) lits[n++] = *cube;
+    assert (n <= BTOR_SIZE_STACK (w->assumptions));
+    wsmgr->satcalls += 1;
+    w->res = solve_interruptible (
+        wsmgr, &w->share, lits, n, cubes->limit, cubes_terminate, cubes);
+    w->num_cubes += 1;
+
+    if (w->res == 10)
+    {
+      if (__atomic_compare_exchange_n (&cubes->winner,
+                                       &winner,
+                                       (int32_t) (w - cubes->workers),
+                                       false,
+                                       __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE))
+        __atomic_store_n (&cubes->stop, 1, __ATOMIC_RELEASE);
+      break;
+    }
+    if (w->res != 20)
+    {
+      /* terminated or limit reached, the call is unknown */
+      __atomic_store_n (&cubes->stop, 1, __ATOMIC_RELEASE);
+      break;
+    }
+    for (i = 0; i < num_assumptions; i++)
+      if (!__atomic_load_n (cubes->failed_marks + i, __ATOMIC_RELAXED)
+          && failed (wsmgr, lits[i]))
+        __atomic_store_n (cubes->failed_marks + i, 1, __ATOMIC_RELAXED);
+  }
+  return 0;
+}
+
+static int32_t
+cubes_sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorMemMgr *mm      = smgr->btor->mm;
+  BtorSATCubesWorker *w;
+  size_t i, num_assumptions, num_marks;
+  double start;
+  int32_t res;
+
+  cubes->maxvar     = smgr->maxvar;
+  cubes->limit      = limit;
+  cubes->term.fun   = smgr->term.fun;
+  cubes->term.state = smgr->term.state;
+  cubes->next       = 0;
+  cubes->winner     = -1;
+  cubes->stop       = 0;
+  num_assumptions   = BTOR_COUNT_STACK (cubes->assumptions);
+
+  start = btor_util_time_stamp ();
+  BTOR_RESET_STACK (cubes->cubes);
+  BTOR_RESET_STACK (cubes->starts);
+  btor_lookahead_cubes (mm,
+                        smgr->maxvar,
+                        &cubes->clauses,
+                        &cubes->assumptions,
+                        cubes->depth,
+                        &cubes->cubes);
+  BTOR_PUSH_STACK (cubes->starts, 0);
+  for (i = 0; i + 1 < BTOR_COUNT_STACK (cubes->cubes); i++)
+    if (!BTOR_PEEK_STACK (cubes->cubes, i))
+      BTOR_PUSH_STACK (cubes->starts, i + 1);
+  cubes->num_cubes += BTOR_COUNT_STACK (cubes->starts);
+  cubes->lookahead_time += btor_util_time_stamp () - start;
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "split SAT call %d into %zu cubes in %.2f seconds",
+            smgr->satcalls,
+            BTOR_COUNT_STACK (cubes->starts),
+            btor_util_time_stamp () - start);
+
+  /* worker 0 got all clauses via 'cubes_add' */
+  cubes->workers[0].replayed = BTOR_COUNT_STACK (cubes->clauses);
+
+  num_marks = num_assumptions ? num_assumptions : 1;
+  BTOR_CNEWN (mm, cubes->failed_marks, num_marks);
+  for (i = 0; i < cubes->size; i++)
+  {
+    w = cubes->workers + i;
+    if (!w->smgr) cubes_new_worker (smgr, w);
+    w->smgr->satcalls = smgr->satcalls;
+    w->smgr->clauses  = smgr->clauses;
+    BTOR_RESET_STACK (w->assumptions);
+    for (size_t j = 0; j < num_assumptions; j++)
+      BTOR_PUSH_STACK (w->assumptions,
+                       BTOR_PEEK_STACK (cubes->assumptions, j));
+    if (BTOR_SIZE_STACK (w->assumptions) < num_assumptions + cubes->depth)
+      BTOR_ENLARGE_STACK_TO_SIZE (w->assumptions,
+                                  num_assumptions + cubes->depth);
+  }
+
+  /* The first worker runs in the calling thread. */
+  for (i = 1; i < cubes->size; i++)
+  {
+    w = cubes->workers + i;
+    BTOR_ABORT (pthread_create (&w->thread, 0, cubes_solve, w),
+                "failed to create SAT solver thread");
+  }
+  cubes_solve (cubes->workers);
+  for (i = 1; i < cubes->size; i++) pthread_join (cubes->workers[i].thread, 0);
+
+  BTOR_RESET_STACK (cubes->failed);
+  if (cubes->winner >= 0)
+    res = 10;
+  else if (cubes->stop || cubes->next < BTOR_COUNT_STACK (cubes->starts))
+    res = 0;
+  else
+  {
+    /* all cubes refuted, the failed assumptions of all cubes form a core */
+    res = 20;
+    for (i = 0; i < num_assumptions; i++)
+      if (cubes->failed_marks[i])
+        BTOR_PUSH_STACK (cubes->failed,
+                         BTOR_PEEK_STACK (cubes->assumptions, i));
+  }
+  BTOR_DELETEN (mm, cubes->failed_marks, num_marks);
+  BTOR_RESET_STACK (cubes->assumptions);
+  return res;
+}
+
+static void
+cubes_set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  btor_sat_set_output (cubes->workers[0].smgr, output);
+}
+
+static void
+cubes_stats (BtorSATMgr *smgr)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  BtorSATCubesWorker *w;
+
+  for (uint32_t i = 0; i < cubes->size; i++)
+  {
+    w = cubes->workers + i;
+    if (!w->smgr) continue;
+    stats (w->smgr);
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "worker %u solved %u cubes",
+              i,
+              w->num_cubes);
+    if (cubes->share)
+      BTOR_MSG (smgr->btor->msg,
+                1,
+                "worker %u exported %lld and imported %lld clauses",
+                i,
+                (long long) w->share.num_exported,
+                (long long) w->share.num_imported);
+  }
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%lld cubes generated in %.1f seconds",
+            (long long) cubes->num_cubes,
+            cubes->lookahead_time);
+}
+
+static void
+cubes_setterm (BtorSATMgr *smgr)
+{
+  BtorSATCubes *cubes = (BtorSATCubes *) smgr->solver;
+  cubes->term.fun     = smgr->term.fun;
+  cubes->term.state   = smgr->term.state;
+}
+
+/* The cube-and-conquer SAT manager wraps the currently enabled SAT manager
+ * (worker 0) and records all clauses. On 'sat', the clauses are split into
+ * cubes via lookahead, which are distributed to the workers via a shared
+ * queue. Workers other than worker 0 are created on the first call and get
+ * the clauses added since their last call before solving. */
+void
+btor_sat_enable_cubes (BtorSATMgr *smgr, uint32_t depth, uint32_t num_workers)
+{
+  assert (smgr);
+  assert (smgr->name);
+  assert (!smgr->initialized);
+  assert (num_workers > 0);
+
+  BtorSATCubes *cubes;
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  if (!btor_sat_mgr_has_incremental_support (smgr))
+  {
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s does not support assumptions, disabling cube-and-conquer",
+              smgr->name);
+    return;
+  }
+  /* the external solver can not be terminated if another cube is satisfiable
+   * and would be started for every worker */
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE)
+      == BTOR_SAT_ENGINE_EXTERNAL)
+  {
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s does not support termination, disabling cube-and-conquer",
+              smgr->name);
+    return;
+  }
+
+  mm = smgr->btor->mm;
+  BTOR_CNEW (mm, cubes);
+  BTOR_CNEWN (mm, cubes->workers, num_workers);
+  cubes->size  = num_workers;
+  cubes->depth = depth;
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_SHARE_LBD))
+    cubes->share = btor_sat_share_new (
+        mm,
+        BTOR_SAT_SHARE_SIZE,
+        btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_SHARE_LBD));
+  BTOR_INIT_STACK (mm, cubes->clauses);
+  BTOR_INIT_STACK (mm, cubes->assumptions);
+  BTOR_INIT_STACK (mm, cubes->cubes);
+  BTOR_INIT_STACK (mm, cubes->starts);
+  BTOR_INIT_STACK (mm, cubes->failed);
+  for (i = 0; i < num_workers; i++)
+  {
+    cubes->workers[i].cubes = cubes;
+    BTOR_INIT_STACK (mm, cubes->workers[i].assumptions);
+  }
+  BTOR_CNEW (mm, cubes->workers[0].smgr);
+  memcpy (cubes->workers[0].smgr, smgr, sizeof (BtorSATMgr));
+  cubes->workers[0].smgr->term.fun   = cubes_terminate;
+  cubes->workers[0].smgr->term.state = cubes;
+#ifdef BTOR_USE_LINGELING
+  cubes->workers[0].smgr->fork = false;
+#endif
+
+  /* Clear API */
+  memset (&smgr->api, 0, sizeof (smgr->api));
+
+  smgr->solver               = cubes;
+  smgr->name                 = "Cube-and-Conquer";
+  smgr->api.add              = cubes_add;
+  smgr->api.assume           = cubes_assume;
+  smgr->api.deref            = cubes_deref;
+  smgr->api.enable_verbosity = cubes_enable_verbosity;
+  smgr->api.failed           = cubes_failed;
+  smgr->api.fixed            = cubes_fixed;
+  smgr->api.inc_max_var      = cubes_inc_max_var;
+  smgr->api.init             = cubes_init;
+  smgr->api.melt             = cubes_melt;
+  smgr->api.repr             = cubes_repr;
+  smgr->api.reset            = cubes_reset;
+  smgr->api.sat              = cubes_sat;
+  smgr->api.set_output       = cubes_set_output;
+  smgr->api.stats            = cubes_stats;
+  smgr->api.setterm          = cubes_setterm;
+
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "using cube-and-conquer with depth %u and %u workers",
+            depth,
+            num_workers);
+}
+
+#endif
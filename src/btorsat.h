@@ -11,8 +11,13 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
 
+#include "btorsatshare.h"
 #include "btortypes.h"
+#include "dumper/btordumpcnf.h"
 #include "utils/btormem.h"
 #include "utils/btorstack.h"
 
@@ -71,6 +76,21 @@ struct BtorSATMgr
     void (*stats) (BtorSATMgr *);
     void *(*clone) (Btor *btor, BtorSATMgr *);
     void (*setterm) (BtorSATMgr *);
+    /* Configure the solver (after 'init') as variant 'seed' > 0 of its
+     * default configuration, e.g., for portfolio solving. */
+    void (*diversify) (BtorSATMgr *, uint32_t seed);
+    /* Register a callback that is called with each (0-terminated) learned
+     * clause and its LBD, e.g., for clause sharing between parallel solver
+     * instances. */
+    void (*export_clauses) (BtorSATMgr *,
+                            void (*fun) (void *, int32_t *, int32_t),
+                            void *state);
+    /* Register a callback that is called at restarts to get clauses to be
+     * added, which stores the next 0-terminated clause and its LBD or 0 if
+     * there is none. Imported clauses must be implied by the formula. */
+    void (*import_clauses) (BtorSATMgr *,
+                            void (*fun) (void *, int32_t **, int32_t *),
+                            void *state);
   } api;
 };
 
@@ -81,13 +101,102 @@ struct BtorCnfPrinter
   FILE *out;
   BtorIntStack clauses;
   BtorIntStack assumptions;
-  BtorSATMgr *smgr; /* SAT manager wrapped by DIMACS printer. */
+  BtorSATMgr *smgr;      /* SAT manager wrapped by DIMACS printer. */
+  bool dump;             /* print the recorded CNF on 'sat' */
+  BtorCnfWriter *writer; /* streams the CNF to 'stream', 0 if disabled */
+  FILE *stream;
 };
 
 typedef struct BtorCnfPrinter BtorCnfPrinter;
 
 /*------------------------------------------------------------------------*/
 
+#ifdef BTOR_HAVE_PTHREADS
+
+struct BtorSATPortfolioWorker
+{
+  BtorSATMgr *smgr; /* SAT manager of the solver instance */
+  struct BtorSATPortfolio *portfolio;
+  pthread_t thread;
+  uint32_t calls; /* number of SAT calls started by the thread */
+  uint32_t seed;  /* passed to 'diversify' if > 0 */
+  int32_t res;   /* result of the last SAT call */
+  uint32_t wins; /* number of SAT calls answered first */
+  BtorSATShareClient share;
+};
+
+typedef struct BtorSATPortfolioWorker BtorSATPortfolioWorker;
+
+struct BtorSATPortfolio
+{
+  BtorSATPortfolioWorker *workers;
+  uint32_t size;            /* number of solver instances */
+  int32_t winner;           /* worker that answered the last SAT call */
+  int32_t limit;            /* limit of the current SAT call */
+  BtorIntStack assumptions; /* assumptions of the next SAT call */
+  BtorSATShare *share;      /* learned clauses, 0 if sharing is disabled */
+  struct
+  {
+    int32_t (*fun) (void *);
+    void *state;
+  } term; /* termination callback of the portfolio SAT manager */
+  /* The worker threads are started on 'init' and wait for SAT calls. */
+  pthread_mutex_t lock;
+  pthread_cond_t start; /* signals a new SAT call or 'quit' */
+  pthread_cond_t done;  /* signals that all workers finished the SAT call */
+  uint32_t calls;       /* number of SAT calls */
+  uint32_t running;     /* number of workers solving the current SAT call */
+  bool quit;            /* terminate the worker threads */
+};
+
+typedef struct BtorSATPortfolio BtorSATPortfolio;
+
+struct BtorSATCubesWorker
+{
+  BtorSATMgr *smgr; /* SAT manager of the worker */
+  struct BtorSATCubes *cubes;
+  pthread_t thread;
+  size_t replayed;          /* number of clause literals added to solver */
+  BtorIntStack assumptions; /* assumptions of the call and the cube */
+  int32_t res;              /* result of the last cube */
+  uint32_t num_cubes;       /* number of cubes solved */
+  BtorSATShareClient share;
+};
+
+typedef struct BtorSATCubesWorker BtorSATCubesWorker;
+
+struct BtorSATCubes
+{
+  BtorSATCubesWorker *workers; /* worker 0 uses the wrapped SAT manager */
+  uint32_t size;               /* number of workers */
+  uint32_t depth;              /* split depth, at most 2^depth cubes */
+  int32_t maxvar;              /* number of variables of the current call */
+  int32_t limit;               /* limit of the current call */
+  BtorIntStack clauses;        /* all clauses added so far */
+  BtorIntStack assumptions;    /* assumptions of the current call */
+  BtorIntStack cubes;          /* cubes of the current call */
+  BtorIntStack starts;         /* start of each cube in 'cubes' */
+  BtorIntStack failed;         /* failed assumptions of the last call */
+  BtorSATShare *share;         /* learned clauses, 0 if sharing is disabled */
+  int8_t *failed_marks;        /* 'assumptions' that failed in some cube */
+  uint32_t next;               /* next cube to solve */
+  int32_t winner;              /* worker that found a satisfiable cube */
+  int32_t stop;                /* terminate all workers */
+  uint64_t num_cubes;          /* number of cubes generated */
+  double lookahead_time;
+  struct
+  {
+    int32_t (*fun) (void *);
+    void *state;
+  } term; /* termination callback of the cube-and-conquer SAT manager */
+};
+
+typedef struct BtorSATCubes BtorSATCubes;
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 /* Creates new SAT manager.
  * A SAT manager is used by nearly all functions of the SAT layer.
  */
@@ -121,6 +230,12 @@ int32_t btor_get_last_cnf_id_sat_mgr (BtorSATMgr * smgr);
 
 void btor_sat_enable_solver (BtorSATMgr *smgr);
 
+/* Enables the configured SAT solver for SAT managers used internally next to
+ * the main SAT manager, e.g., for fraiging. Unlike 'btor_sat_enable_solver',
+ * no portfolio is enabled and the CNF is neither printed nor streamed. The
+ * default SAT solver is used instead of an external SAT solver. */
+void btor_sat_enable_side_solver (BtorSATMgr *smgr);
+
 /* Inits the SAT solver. */
 void btor_sat_init (BtorSATMgr *smgr);
 
@@ -174,4 +289,14 @@ int32_t btor_sat_fixed (BtorSATMgr *smgr, int32_t lit);
 /* Resets the status of the SAT solver. */
 void btor_sat_reset (BtorSATMgr *smgr);
 
+#ifdef BTOR_HAVE_PTHREADS
+/* Wraps the enabled SAT solver into a cube-and-conquer SAT manager, which
+ * splits each SAT call into cubes via lookahead and solves the cubes on
+ * 'num_workers' threads. Requires a SAT solver with incremental support and
+ * must be called before 'btor_sat_init'. */
+void btor_sat_enable_cubes (BtorSATMgr *smgr,
+                            uint32_t depth,
+                            uint32_t num_workers);
+#endif
+
 #endif
@@ -0,0 +1,146 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorsatshare.h"
+
+#include <assert.h>
+
+/* A slot holds the clause exported at position 'pos' if 'seq' is 2*pos+2,
+ * and is being written if 'seq' is 2*pos+1. All fields are accessed
+ * atomically, the data of a slot is valid if 'seq' did not change while it
+ * was read (sequence lock). Data is stored with release and loaded with
+ * acquire semantics, which orders it after setting and before re-reading
+ * 'seq', respectively. */
+struct BtorSATShareSlot
+{
+  uint64_t seq;
+  uint32_t id;
+  int32_t lbd;
+  int32_t lits[BTOR_SAT_SHARE_MAX_SIZE + 1];
+};
+
+typedef struct BtorSATShareSlot BtorSATShareSlot;
+
+BtorSATShare *
+btor_sat_share_new (BtorMemMgr *mm, uint32_t size, int32_t max_lbd)
+{
+  assert (mm);
+  assert (size > 0);
+  assert (!(size & (size - 1)));
+
+  BtorSATShare *res;
+
+  BTOR_CNEW (mm, res);
+  BTOR_CNEWN (mm, res->slots, size);
+  res->mm      = mm;
+  res->size    = size;
+  res->max_lbd = max_lbd;
+  return res;
+}
+
+void
+btor_sat_share_delete (BtorSATShare *share)
+{
+  assert (share);
+  BTOR_DELETEN (share->mm, share->slots, share->size);
+  BTOR_DELETE (share->mm, share);
+}
+
+void
+btor_sat_share_init_client (BtorSATShare *share,
+                            BtorSATShareClient *client,
+                            uint32_t id)
+{
+  assert (share);
+  assert (client);
+
+  BTOR_CLR (client);
+  client->share = share;
+  client->id    = id;
+  client->tail  = __atomic_load_n (&share->head, __ATOMIC_ACQUIRE);
+}
+
+bool
+btor_sat_share_export (BtorSATShareClient *client,
+                       const int32_t *lits,
+                       int32_t lbd)
+{
+  assert (client);
+  assert (lits);
+
+  BtorSATShare *share = client->share;
+  BtorSATShareSlot *slot;
+  uint64_t pos, seq;
+  uint32_t i, n;
+
+  if (lbd > share->max_lbd) return false;
+  for (n = 0; lits[n]; n++)
+    if (n == BTOR_SAT_SHARE_MAX_SIZE) return false;
+
+  pos  = __atomic_fetch_add (&share->head, 1, __ATOMIC_RELAXED);
+  slot = share->slots + (pos & (share->size - 1));
+  seq  = __atomic_load_n (&slot->seq, __ATOMIC_RELAXED);
+
+  /* drop the clause if another export is writing or already reused the
+   * slot, which only happens if the ring is full */
+  if ((seq & 1) || seq > 2 * pos
+      || !__atomic_compare_exchange_n (&slot->seq,
+                                       &seq,
+                                       2 * pos + 1,
+                                       false,
+                                       __ATOMIC_RELAXED,
+                                       __ATOMIC_RELAXED))
+    return false;
+
+  __atomic_store_n (&slot->id, client->id, __ATOMIC_RELEASE);
+  __atomic_store_n (&slot->lbd, lbd, __ATOMIC_RELEASE);
+  for (i = 0; i <= n; i++)
+    __atomic_store_n (slot->lits + i, lits[i], __ATOMIC_RELEASE);
+  __atomic_store_n (&slot->seq, 2 * pos + 2, __ATOMIC_RELEASE);
+
+  client->num_exported += 1;
+  return true;
+}
+
+int32_t *
+btor_sat_share_import (BtorSATShareClient *client, int32_t *lbd)
+{
+  assert (client);
+  assert (lbd);
+
+  BtorSATShare *share = client->share;
+  BtorSATShareSlot *slot;
+  uint64_t head, pos, seq;
+  uint32_t i;
+
+  head = __atomic_load_n (&share->head, __ATOMIC_ACQUIRE);
+  /* skip clauses that have already been overwritten */
+  if (head - client->tail > share->size) client->tail = head - share->size;
+
+  while (client->tail < head)
+  {
+    pos  = client->tail++;
+    slot = share->slots + (pos & (share->size - 1));
+    seq  = __atomic_load_n (&slot->seq, __ATOMIC_ACQUIRE);
+    /* dropped, not written yet or already overwritten */
+    if (seq != 2 * pos + 2) continue;
+    if (__atomic_load_n (&slot->id, __ATOMIC_ACQUIRE) == client->id) continue;
+
+    *lbd = __atomic_load_n (&slot->lbd, __ATOMIC_ACQUIRE);
+    for (i = 0; i < BTOR_SAT_SHARE_MAX_SIZE; i++)
+      if (!(client->lits[i] =
+                __atomic_load_n (slot->lits + i, __ATOMIC_ACQUIRE)))
+        break;
+    client->lits[i] = 0;
+
+    if (__atomic_load_n (&slot->seq, __ATOMIC_RELAXED) != seq) continue;
+    client->num_imported += 1;
+    return client->lits;
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATSHARE_H_INCLUDED
+#define BTORSATSHARE_H_INCLUDED
+
+#include "utils/btormem.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Maximum number of literals of a shared clause. */
+#define BTOR_SAT_SHARE_MAX_SIZE 8
+
+/* Lock-free ring buffer of short learned clauses shared between parallel SAT
+ * solver instances.
+ *
+ * Every instance exports its learned clauses with an LBD of at most
+ * 'max_lbd' into the ring and imports the clauses exported by all other
+ * instances. Each slot of the ring is protected by a sequence number, i.e.,
+ * exports never wait and an import ignores clauses that are being written or
+ * have already been overwritten. Clauses are thus dropped if the ring is
+ * full, which is fine since they are implied by the formula anyway. */
+struct BtorSATShare
+{
+  BtorMemMgr *mm;
+  struct BtorSATShareSlot *slots;
+  uint32_t size;   /* number of slots, a power of 2 */
+  int32_t max_lbd; /* maximum LBD of exported clauses */
+  uint64_t head;   /* number of clauses exported so far */
+};
+
+typedef struct BtorSATShare BtorSATShare;
+
+/* Per solver instance state, only accessed by the thread of the instance. */
+struct BtorSATShareClient
+{
+  BtorSATShare *share;
+  uint32_t id;   /* clauses exported by this client are not imported */
+  uint64_t tail; /* number of clauses consumed by this client */
+  int32_t lits[BTOR_SAT_SHARE_MAX_SIZE + 1]; /* last imported clause */
+  uint64_t num_exported;
+  uint64_t num_imported;
+};
+
+typedef struct BtorSATShareClient BtorSATShareClient;
+
+/* Create a ring of 'size' (a power of 2) slots for clauses with an LBD of at
+ * most 'max_lbd'. */
+BtorSATShare *btor_sat_share_new (BtorMemMgr *mm,
+                                  uint32_t size,
+                                  int32_t max_lbd);
+
+void btor_sat_share_delete (BtorSATShare *share);
+
+/* Initialize 'client' with the unique id 'id'. Only clauses exported after
+ * the initialization are imported. */
+void btor_sat_share_init_client (BtorSATShare *share,
+                                 BtorSATShareClient *client,
+                                 uint32_t id);
+
+/* Export the 0-terminated clause 'lits' with LBD 'lbd'. Returns false if the
+ * clause is too long, its LBD too large, or its slot is currently written. */
+bool btor_sat_share_export (BtorSATShareClient *client,
+                            const int32_t *lits,
+                            int32_t lbd);
+
+/* Import the next clause exported by some other client. Returns the
+ * 0-terminated clause, which is valid until the next call, and stores its
+ * LBD in 'lbd', or returns 0 if there is no such clause. */
+int32_t *btor_sat_share_import (BtorSATShareClient *client, int32_t *lbd);
+
+#endif
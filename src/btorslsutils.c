@@ -53,37 +53,6 @@
  *
  * ========================================================================== */
 
-static uint32_t
-hamming_distance (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
-{
-  assert (bv1);
-  assert (bv2);
-  assert (btor_bv_get_width (bv1) == btor_bv_get_width (bv2));
-#ifndef BTOR_USE_GMP
-  assert (btor_bv_get_len (bv1) == btor_bv_get_len (bv2));
-#endif
-
-  uint32_t res, bw;
-  BtorBitVector *bv, *bvdec = 0, *zero, *ones, *tmp;
-
-  bw   = btor_bv_get_width (bv1);
-  zero = btor_bv_new (btor->mm, bw);
-  ones = btor_bv_ones (btor->mm, bw);
-  bv   = btor_bv_xor (btor->mm, bv1, bv2);
-  for (res = 0; !btor_bv_is_zero (bv); res++)
-  {
-    bvdec = btor_bv_add (btor->mm, bv, ones);
-    tmp   = bv;
-    bv    = btor_bv_and (btor->mm, bv, bvdec);
-    btor_bv_free (btor->mm, tmp);
-    btor_bv_free (btor->mm, bvdec);
-  }
-  btor_bv_free (btor->mm, bv);
-  btor_bv_free (btor->mm, ones);
-  btor_bv_free (btor->mm, zero);
-  return res;
-}
-
 // TODO find a better heuristic this might be too expensive
 // this is not necessarily the actual minimum, but the minimum if you flip
 // bits in bv1 s.t. bv1 < bv2 (if bv2 is 0, we need to flip 1 bit in bv2, too,
@@ -102,7 +71,7 @@ min_flip (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
   BtorBitVector *tmp;
 
   if (btor_bv_is_zero (bv2))
-    res = hamming_distance (btor, bv1, bv2);
+    res = btor_bv_hamming_distance (bv1, bv2);
   else
   {
     tmp = btor_bv_copy (btor->mm, bv1);
@@ -283,7 +252,7 @@ btor_slsutils_compute_score_node (Btor *btor,
                 ? 1.0
                 : BTOR_SLS_SCORE_CFACT
                       * (1.0
-                         - hamming_distance (btor, bv0, bv1)
+                         - btor_bv_hamming_distance (bv0, bv1)
                                / (double) btor_bv_get_width (bv0));
   }
   /* ------------------------------------------------------------------------ */
@@ -216,6 +216,17 @@ configure_sat_mgr (Btor *btor)
   smgr = btor_get_sat_mgr (btor);
   if (btor_sat_is_initialized (smgr)) return;
   btor_sat_enable_solver (smgr);
+#ifdef BTOR_HAVE_PTHREADS
+  /* cube-and-conquer is only used for pure bit-vector formulas */
+  if (btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_CUBES) && btor->ufs->count == 0
+      && btor->lambdas->count == 0)
+  {
+    btor_sat_enable_cubes (
+        smgr,
+        btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_CUBES),
+        btor_opt_get (btor, BTOR_OPT_SAT_ENGINE_N_THREADS));
+  }
+#endif
   btor_sat_init (smgr);
 
   /* reset SAT solver to non-incremental if all functions have been
@@ -2835,7 +2846,7 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
   assert (exp);
   assert (btor->bv_model);
 
-  uint32_t i;
+  uint32_t i, bw;
   double start;
   BtorMemMgr *mm;
   BtorNodePtrStack work_stack;
@@ -2844,10 +2855,11 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
   BtorPtrHashTable *cache;
   BtorPtrHashBucket *b;
   BtorPtrHashTableIterator it;
-  BtorBitVector *result = 0, *inv_result, **e;
+  BtorBitVector *result = 0, *cached, **e;
   BtorFunSolver *slv;
   BtorIntHashTable *mark;
   BtorHashTableData *d;
+  BtorBitVectorPool *pool;
 
   start = btor_util_time_stamp ();
   mm    = btor->mm;
@@ -2860,6 +2872,9 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
                                   (BtorHashPtr) btor_node_hash_by_id,
                                   (BtorCmpPtr) btor_node_compare_by_id);
   mark  = btor_hashint_map_new (mm);
+  /* intermediate results are reused to avoid allocating a bit-vector for
+   * every evaluated node */
+  pool = btor_bv_pool_new (mm);
 
   BTOR_PUSH_STACK (work_stack, exp);
   while (!BTOR_EMPTY_STACK (work_stack))
@@ -2880,7 +2895,9 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
       }
       else if (btor_node_is_bv_const (real_cur))
       {
-        result = btor_bv_copy (mm, btor_node_bv_const_get_bits (real_cur));
+        bw     = btor_node_bv_get_width (btor, real_cur);
+        result = btor_bv_pool_get (pool, bw);
+        btor_bv_copy_into (result, btor_node_bv_const_get_bits (real_cur));
         goto EVAL_EXP_PUSH_RESULT;
       }
       /* substitute param with its assignment */
@@ -2912,91 +2929,64 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
       arg_stack.top -= real_cur->arity;
       e = (BtorBitVector **) arg_stack.top; /* arguments in reverse order */
 
+      bw     = btor_node_bv_get_width (btor, real_cur);
+      result = btor_bv_pool_get (pool, bw);
+
       switch (real_cur->kind)
       {
         case BTOR_BV_SLICE_NODE:
-          result = btor_bv_slice (mm,
-                                  e[0],
-                                  btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
-          btor_bv_free (mm, e[0]);
+          btor_bv_slice_into (result,
+                              e[0],
+                              btor_node_bv_slice_get_upper (real_cur),
+                              btor_node_bv_slice_get_lower (real_cur));
           break;
         case BTOR_BV_AND_NODE:
-          result = btor_bv_and (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_and_into (result, e[1], e[0]);
           break;
         case BTOR_BV_EQ_NODE:
-          result = btor_bv_eq (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_eq_into (result, e[1], e[0]);
           break;
         case BTOR_BV_ADD_NODE:
-          result = btor_bv_add (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_add_into (result, e[1], e[0]);
           break;
         case BTOR_BV_MUL_NODE:
-          result = btor_bv_mul (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_mul_into (mm, result, e[1], e[0]);
           break;
         case BTOR_BV_ULT_NODE:
-          result = btor_bv_ult (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_ult_into (result, e[1], e[0]);
           break;
         case BTOR_BV_SLL_NODE:
-          result = btor_bv_sll (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_sll_into (result, e[1], e[0]);
           break;
         case BTOR_BV_SRL_NODE:
-          result = btor_bv_srl (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_srl_into (result, e[1], e[0]);
           break;
         case BTOR_BV_UDIV_NODE:
-          result = btor_bv_udiv (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_udiv_into (mm, result, e[1], e[0]);
           break;
         case BTOR_BV_UREM_NODE:
-          result = btor_bv_urem (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_urem_into (mm, result, e[1], e[0]);
           break;
         case BTOR_BV_CONCAT_NODE:
-          result = btor_bv_concat (mm, e[1], e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
+          btor_bv_concat_into (result, e[1], e[0]);
           break;
         case BTOR_COND_NODE:
-          if (btor_bv_is_true (e[2]))
-            result = btor_bv_copy (mm, e[1]);
-          else
-            result = btor_bv_copy (mm, e[0]);
-          btor_bv_free (mm, e[0]);
-          btor_bv_free (mm, e[1]);
-          btor_bv_free (mm, e[2]);
+          btor_bv_copy_into (result, btor_bv_is_true (e[2]) ? e[1] : e[0]);
           break;
         default:
           BTORLOG (1, "  *** %s", btor_util_node2string (real_cur));
           /* should be unreachable */
           assert (0);
       }
+      for (i = 0; i < real_cur->arity; i++) btor_bv_pool_put (pool, e[i]);
 
       assert (!btor_hashptr_table_get (cache, real_cur));
-      btor_hashptr_table_add (cache, real_cur)->data.as_ptr =
-          btor_bv_copy (mm, result);
+      cached = btor_bv_pool_get (pool, bw);
+      btor_bv_copy_into (cached, result);
+      btor_hashptr_table_add (cache, real_cur)->data.as_ptr = cached;
 
     EVAL_EXP_PUSH_RESULT:
-      if (btor_node_is_inverted (cur))
-      {
-        inv_result = btor_bv_not (mm, result);
-        btor_bv_free (mm, result);
-        result = inv_result;
-      }
+      if (btor_node_is_inverted (cur)) btor_bv_not_into (result, result);
 
       BTOR_PUSH_STACK (arg_stack, result);
     }
@@ -3005,7 +2995,9 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
       assert (d->as_int == 1);
       b = btor_hashptr_table_get (cache, real_cur);
       assert (b);
-      result = btor_bv_copy (mm, (BtorBitVector *) b->data.as_ptr);
+      cached = b->data.as_ptr;
+      result = btor_bv_pool_get (pool, btor_bv_get_width (cached));
+      btor_bv_copy_into (result, cached);
       goto EVAL_EXP_PUSH_RESULT;
     }
   }
@@ -3015,8 +3007,8 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
 
   while (!BTOR_EMPTY_STACK (arg_stack))
   {
-    inv_result = BTOR_POP_STACK (arg_stack);
-    btor_bv_free (mm, inv_result);
+    cached = BTOR_POP_STACK (arg_stack);
+    btor_bv_free (mm, cached);
   }
 
   btor_iter_hashptr_init (&it, cache);
@@ -3030,6 +3022,7 @@ btor_eval_exp (Btor *btor, BtorNode *exp)
   BTOR_RELEASE_STACK (arg_stack);
   btor_hashptr_table_delete (cache);
   btor_hashint_map_delete (mark);
+  btor_bv_pool_delete (pool);
 
   //  BTORLOG ("%s: %s '%s'", __FUNCTION__, btor_util_node2string (exp),
   //  result);
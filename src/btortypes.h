@@ -88,6 +88,9 @@ enum BtorOption
         `SMT-LIB v1 <http://smtlib.cs.uiowa.edu/papers/format-v1.2-r06.08.30.pdf>`_ format
       * BTOR_INPUT_FORMAT_SMT2:
         `SMT-LIB v2 <http://smtlib.cs.uiowa.edu/papers/smt-lib-reference-v2.0-r12.09.09.pdf>`_ format
+      * BTOR_INPUT_FORMAT_BTOR_BINARY:
+        binary BTOR format (as written by
+        :c:func:`boolector_dump_btor_binary`)
   */
 
   BTOR_OPT_INPUT_FORMAT,
@@ -121,6 +124,10 @@ enum BtorOption
         `Aiger ascii format <http://fmv.jku.at/papers/BiereHeljankoWieringa-FMV-TR-11-2.pdf>`_
       * BTOR_OUTPUT_FORMAT_AIGER_BINARY:
         `Aiger binary format <http://fmv.jku.at/papers/BiereHeljankoWieringa-FMV-TR-11-2.pdf>`_
+      * BTOR_OUTPUT_FORMAT_BTOR_BINARY:
+        binary BTOR format, a compact serialization of the simplified
+        formula that is reloaded without parsing text (terms are rebuilt
+        via the expression layer and thus rewritten again)
   */
   BTOR_OPT_OUTPUT_FORMAT,
 
@@ -155,6 +162,9 @@ enum BtorOption
         `CaDiCaL <https://fmv.jku.at/cadical>`_
       * BTOR_SAT_ENGINE_CMS:
         `CryptoMiniSat <https://github.com/msoos/cryptominisat>`_
+      * BTOR_SAT_ENGINE_EXTERNAL:
+        external SAT solver process communicating via pipes, see
+        :c:func:`boolector_set_external_sat_solver`
       * BTOR_SAT_ENGINE_LINGELING:
         `Lingeling <https://fmv.jku.at/lingeling>`_
       * BTOR_SAT_ENGINE_MINISAT:
@@ -164,6 +174,56 @@ enum BtorOption
   */
   BTOR_OPT_SAT_ENGINE,
 
+  /*!
+    * **BTOR_OPT_SAT_ENGINE_PORTFOLIO**
+
+      | Set the number of SAT solver instances to run in parallel.
+      | Boolector uses a single SAT solver instance by default (``value``: 0
+        or 1). With more instances, all clauses are passed to every instance
+        and each SAT call returns the result of the instance that finishes
+        first, after terminating the others. The first instance uses the SAT
+        solver selected via BTOR_OPT_SAT_ENGINE, further instances use the
+        other configured SAT solvers and then diversified configurations
+        (e.g., different seeds) of these solvers. Solvers that do not
+        support diversification (MiniSat, CryptoMiniSat) are used at most
+        once, hence the number of instances may be smaller than requested.
+        The external SAT solver does not support termination and is never
+        used in a portfolio.
+      | A termination callback (see :c:func:`boolector_set_term`) may be
+        called concurrently from all instances.
+      | This option must be set before calling :c:func:`boolector_sat`.
+  */
+  BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+
+  /*!
+    * **BTOR_OPT_SAT_ENGINE_CUBES**
+
+      | Enable cube-and-conquer solving of pure bit-vector formulas with the
+        given split depth (``value``: 0 disables cube-and-conquer).
+      | Each SAT call is split into at most 2^depth cubes via lookahead, and
+        the cubes are solved in parallel by the number of workers given by
+        BTOR_OPT_SAT_ENGINE_N_THREADS. The call is satisfiable if one cube is
+        satisfiable and unsatisfiable if all cubes are refuted.
+      | Requires a SAT solver with incremental support other than the
+        external SAT solver.
+      | This option must be set before calling :c:func:`boolector_sat`.
+  */
+  BTOR_OPT_SAT_ENGINE_CUBES,
+
+  /*!
+    * **BTOR_OPT_SAT_ENGINE_SHARE_LBD**
+
+      | Share learned clauses with an LBD of at most ``value`` between the
+        parallel SAT solver instances of :c:enum:`BTOR_OPT_SAT_ENGINE_PORTFOLIO`
+        and :c:enum:`BTOR_OPT_SAT_ENGINE_CUBES`
+        (``value``: 0 disables clause sharing).
+      | Clauses are exported by SAT solvers that support it (Lingeling) and
+        imported by all SAT solvers, either during solving or in between
+        SAT calls.
+      | This option must be set before calling :c:func:`boolector_sat`.
+  */
+  BTOR_OPT_SAT_ENGINE_SHARE_LBD,
+
   /*!
     * **BTOR_OPT_AUTO_CLEANUP**
 
@@ -213,6 +273,24 @@ enum BtorOption
   */
   BTOR_OPT_LOGLEVEL,
 
+  /*!
+    * **BTOR_OPT_THREAD_SAFE**
+
+      Enable (``value``: 1) or disable (``value``: 0) thread-safe term
+      construction.
+
+      When enabled, API functions may be called concurrently from several
+      threads on the same instance. All calls that access the instance
+      (including getters, solving and model queries) are serialized by a
+      lock of the instance, i.e., a call to :c:func:`boolector_sat` blocks
+      all other threads until it returns.
+      Exceptions are :c:func:`boolector_delete`, which must not be called
+      concurrently with any other call on the instance, and
+      :c:func:`boolector_terminate`, which does not take the lock.
+      This option must be set before creating any expressions.
+  */
+  BTOR_OPT_THREAD_SAFE,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Simplifier Options:**
@@ -236,6 +314,16 @@ enum BtorOption
   */
   BTOR_OPT_REWRITE_LEVEL,
 
+  /*!
+    * **BTOR_OPT_RW_CACHE_SIZE**
+
+      | Set the memory budget of the rewrite cache in MB.
+      | Boolector uses 128 MB by default. The rewrite cache grows on demand
+        up to this size, after which least recently used entries are
+        replaced.
+  */
+  BTOR_OPT_RW_CACHE_SIZE,
+
   /*!
     * **BTOR_OPT_SKELETON_PREPROC**
 
@@ -316,6 +404,43 @@ enum BtorOption
   */
   BTOR_OPT_NORMALIZE_ADD,
 
+  /*!
+    * **BTOR_OPT_AIG_REWRITE**
+
+      Enable (``value``: 1) or disable (``value``: 0) cut based rewriting of
+      AIGs before they are encoded to CNF.
+
+      When enabled, AND nodes are resynthesized from their 4-input cuts if
+      this reduces the number of AIG nodes (and hence the size of the CNF).
+  */
+  BTOR_OPT_AIG_REWRITE,
+
+  /*!
+    * **BTOR_OPT_AIG_FRAIG**
+
+      Enable (``value``: 1) or disable (``value``: 0) SAT sweeping of AIGs
+      before they are encoded to CNF.
+
+      When enabled, AND nodes that are equivalent (or complementary) under
+      random simulation are checked for equivalence with a separate,
+      incremental SAT solver (with a conflict limit), and merged if proven
+      equivalent.
+  */
+  BTOR_OPT_AIG_FRAIG,
+
+  /*!
+    * **BTOR_OPT_AIG_POLARITY**
+
+      Enable (``value``: 1) or disable (``value``: 0) polarity-aware
+      (Plaisted-Greenbaum) CNF encoding of AIGs.
+
+      When enabled, AIGs are encoded to CNF on demand when they are asserted
+      or assumed, and only the clauses for the polarities in which they occur
+      are added. AIGs are upgraded to full encoding when they later occur in
+      the other polarity.
+  */
+  BTOR_OPT_AIG_POLARITY,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Fun Engine Options:**
@@ -419,6 +544,44 @@ enum BtorOption
    */
   BTOR_OPT_PRINT_DIMACS,
 
+  /*!
+    * **BTOR_OPT_CNF_STREAM_FORMAT**
+
+      | Format of the CNF stream configured via
+        :c:func:`boolector_set_cnf_stream`.
+      | Values:
+
+          * **BTOR_CNF_STREAM_FORMAT_ICNF** [default]:
+            incremental CNF ('p inccnf', assumptions as 'a' lines), can be
+            written to a pipe
+          * **BTOR_CNF_STREAM_FORMAT_DIMACS**:
+            plain DIMACS without assumptions, requires a seekable file
+  */
+  BTOR_OPT_CNF_STREAM_FORMAT,
+
+  /*!
+    * **BTOR_OPT_CNF_STREAM_BINARY**
+
+      | Enable (``value``: 1) or disable (``value``: 0) binary encoding of
+        the clauses of the CNF stream configured via
+        :c:func:`boolector_set_cnf_stream`.
+  */
+  BTOR_OPT_CNF_STREAM_BINARY,
+
+  /*!
+    * **BTOR_OPT_PARSE_PIPELINE**
+
+      Enable (``value``: 1) or disable (``value``: 0) reading and
+      tokenizing SMT-LIB v2 input in a separate thread.
+
+      When enabled, the input is read ahead and split into tokens, which are
+      handed to the parser command by command while the parser builds terms
+      and solves (in particular, with incremental scripts). Building terms
+      and solving of consecutive commands still run one after the other.
+      The option is ignored (with a warning) if threads are not supported.
+   */
+  BTOR_OPT_PARSE_PIPELINE,
+
 
   /* --------------------------------------------------------------------- */
   /*!
@@ -877,6 +1040,7 @@ enum BtorOptSatEngine
   BTOR_SAT_ENGINE_MINISAT,
   BTOR_SAT_ENGINE_CADICAL,
   BTOR_SAT_ENGINE_CMS,
+  BTOR_SAT_ENGINE_EXTERNAL,
 };
 typedef enum BtorOptSatEngine BtorOptSatEngine;
 
@@ -897,6 +1061,7 @@ enum BtorOptInputFormat
   BTOR_INPUT_FORMAT_BTOR2,
   BTOR_INPUT_FORMAT_SMT1,
   BTOR_INPUT_FORMAT_SMT2,
+  BTOR_INPUT_FORMAT_BTOR_BINARY,
 };
 typedef enum BtorOptInputFormat BtorOptInputFormat;
 
@@ -916,9 +1081,17 @@ enum BtorOptOutputFormat
   BTOR_OUTPUT_FORMAT_SMT2,
   BTOR_OUTPUT_FORMAT_AIGER_ASCII,
   BTOR_OUTPUT_FORMAT_AIGER_BINARY,
+  BTOR_OUTPUT_FORMAT_BTOR_BINARY,
 };
 typedef enum BtorOptOutputFormat BtorOptOutputFormat;
 
+enum BtorOptCnfStreamFormat
+{
+  BTOR_CNF_STREAM_FORMAT_ICNF = 1,
+  BTOR_CNF_STREAM_FORMAT_DIMACS,
+};
+typedef enum BtorOptCnfStreamFormat BtorOptCnfStreamFormat;
+
 enum BtorOptDPQsort
 {
   BTOR_DP_QSORT_JUST = 1,
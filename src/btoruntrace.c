@@ -411,8 +411,9 @@ hmap_clear (BtorPtrHashTable *hmap)
 
   BtorPtrHashBucket *bucket;
 
-  for (bucket = hmap->first; bucket; bucket = hmap->first)
+  while (hmap->count)
   {
+    bucket    = btor_hashptr_table_first (hmap);
     char *key = (char *) bucket->key;
     btor_hashptr_table_remove (hmap, key, NULL, NULL);
     BTOR_DELETEN (hmap->mm, key, (strlen (key) + 1));
@@ -782,6 +783,21 @@ NEXT:
       PARSE_ARGS1 (tok, str);
       boolector_set_sat_solver (btor, arg1_str);
     }
+    else if (!strcmp (tok, "set_result_cache"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_result_cache (btor, arg1_str);
+    }
+    else if (!strcmp (tok, "set_cnf_stream"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_cnf_stream (btor, arg1_str);
+    }
+    else if (!strcmp (tok, "set_external_sat_solver"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_external_sat_solver (btor, arg1_str);
+    }
     else if (!strcmp (tok, "set_opt"))
     {
       opt = parse_opt (&arg1_str);
@@ -1926,7 +1942,8 @@ NEXT:
       PARSE_ARGS1 (tok, str);
       boolector_dump_smt2_node (btor, stdout, hmap_get (hmap, arg1_str));
     }
-    else if (!strcmp (tok, "dump_btor") || !strcmp (tok, "dump_smt2"))
+    else if (!strcmp (tok, "dump_btor") || !strcmp (tok, "dump_btor_binary")
+             || !strcmp (tok, "dump_smt2"))
     {
       PARSE_ARGS0 (tok);
 
@@ -1934,6 +1951,8 @@ NEXT:
       {
         if (!strcmp (tok, "dump_btor"))
           boolector_dump_btor (btor, stdout);
+        else if (!strcmp (tok, "dump_btor_binary"))
+          boolector_dump_btor_binary (btor, stdout);
         else
           boolector_dump_smt2 (btor, stdout);
       }
@@ -1954,6 +1973,13 @@ NEXT:
           assert (outfile);
           boolector_dump_btor (btor, outfile);
         }
+        else if (!strcmp (tok, "dump_btor_binary"))
+        {
+          sprintf (outfilename, "/tmp/%s.%s", basename, "btorbin");
+          outfile = fopen (outfilename, "w");
+          assert (outfile);
+          boolector_dump_btor_binary (btor, outfile);
+        }
         else
         {
           sprintf (outfilename, "/tmp/%s.%s", basename, "smt2");
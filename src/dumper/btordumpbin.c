@@ -0,0 +1,457 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btordumpbin.h"
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btornode.h"
+#include "btorsort.h"
+#include "utils/btorhashptr.h"
+#include "utils/btormem.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorstack.h"
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_BIN_BUF_SIZE (1 << 16)
+
+typedef struct BtorDumpBin BtorDumpBin;
+
+struct BtorDumpBin
+{
+  Btor *btor;
+  FILE *file;
+  uint32_t *node_ids; /* maps node ids to record ids */
+  uint32_t size_node_ids;
+  uint32_t *sort_ids; /* maps sort ids to record ids */
+  uint32_t size_sort_ids;
+  BtorNodePtrStack nodes;
+  BtorNodePtrStack roots;
+  BtorSortPtrStack sorts;
+  uint8_t *buf;
+  size_t nbuf;
+};
+
+/* marks nodes that are currently being visited */
+#define BTOR_BIN_VISITING UINT32_MAX
+
+/*------------------------------------------------------------------------*/
+
+static void
+flush_bin (BtorDumpBin *bin)
+{
+  if (bin->nbuf) fwrite (bin->buf, 1, bin->nbuf, bin->file);
+  bin->nbuf = 0;
+}
+
+static void
+write_varint_bin (BtorDumpBin *bin, uint64_t val)
+{
+  /* at most 10 bytes for 64 bit values */
+  if (bin->nbuf + 10 > BTOR_BIN_BUF_SIZE) flush_bin (bin);
+  while (val >= 0x80)
+  {
+    bin->buf[bin->nbuf++] = (uint8_t) (val | 0x80);
+    val >>= 7;
+  }
+  bin->buf[bin->nbuf++] = (uint8_t) val;
+}
+
+static void
+write_bytes_bin (BtorDumpBin *bin, const char *bytes, size_t len)
+{
+  if (bin->nbuf + len > BTOR_BIN_BUF_SIZE)
+  {
+    flush_bin (bin);
+    if (len > BTOR_BIN_BUF_SIZE)
+    {
+      fwrite (bytes, 1, len, bin->file);
+      return;
+    }
+  }
+  memcpy (bin->buf + bin->nbuf, bytes, len);
+  bin->nbuf += len;
+}
+
+static void
+write_symbol_bin (BtorDumpBin *bin, BtorNode *node)
+{
+  char *symbol;
+  size_t len;
+
+  symbol = btor_node_get_symbol (bin->btor, node);
+  len    = symbol ? strlen (symbol) : 0;
+  write_varint_bin (bin, len);
+  write_bytes_bin (bin, symbol, len);
+}
+
+static uint32_t
+get_id_bin (BtorDumpBin *bin, BtorNode *node)
+{
+  uint32_t id;
+  id = bin->node_ids[btor_node_real_addr (node)->id];
+  assert (id > 0);
+  assert (id != BTOR_BIN_VISITING);
+  return id;
+}
+
+/* node references are relative to the id of the referring node */
+static void
+write_ref_bin (BtorDumpBin *bin, uint32_t id, BtorNode *node)
+{
+  uint32_t ref;
+  ref = get_id_bin (bin, node);
+  assert (ref < id);
+  write_varint_bin (
+      bin, ((uint64_t) (id - ref) << 1) | btor_node_is_inverted (node));
+}
+
+static uint32_t
+get_sort_id_bin (BtorDumpBin *bin, BtorSort *sort)
+{
+  assert (sort->id < bin->size_sort_ids);
+  assert (bin->sort_ids[sort->id]);
+  return bin->sort_ids[sort->id];
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorNode *
+get_child_bin (BtorDumpBin *bin, BtorNode *node, uint32_t i)
+{
+  assert (i < node->arity);
+  return btor_node_get_simplified (bin->btor, node->e[i]);
+}
+
+static void
+push_children_bin (BtorDumpBin *bin, BtorNodePtrStack *visit, BtorNode *node)
+{
+  uint32_t i;
+  BtorArgsIterator ait;
+  BtorPtrHashTable *rho;
+  BtorPtrHashTableIterator it;
+
+  if (btor_node_is_args (node))
+  {
+    /* args nodes are dumped as flat list of arguments */
+    btor_iter_args_init (&ait, node);
+    while (btor_iter_args_has_next (&ait))
+      BTOR_PUSH_STACK (*visit,
+                       btor_node_get_simplified (bin->btor,
+                                                 btor_iter_args_next (&ait)));
+    return;
+  }
+
+  for (i = 0; i < node->arity; i++)
+    BTOR_PUSH_STACK (*visit, get_child_bin (bin, node, i));
+
+  if (btor_node_is_lambda (node)
+      && (rho = btor_node_lambda_get_static_rho (node)))
+  {
+    btor_iter_hashptr_init (&it, rho);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      BTOR_PUSH_STACK (
+          *visit, btor_node_get_simplified (bin->btor, it.bucket->data.as_ptr));
+      BTOR_PUSH_STACK (*visit, btor_iter_hashptr_next (&it));
+    }
+  }
+}
+
+static void
+collect_nodes_bin (BtorDumpBin *bin, BtorNode *root)
+{
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+
+  BTOR_INIT_STACK (bin->btor->mm, visit);
+  BTOR_PUSH_STACK (visit, root);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    if (cur)
+    {
+      cur = btor_node_real_addr (cur);
+      assert (!btor_node_is_proxy (cur));
+      assert ((uint32_t) cur->id < bin->size_node_ids);
+      /* an unfinished node can not be reached again in a DAG */
+      if (bin->node_ids[cur->id]) continue;
+      bin->node_ids[cur->id] = BTOR_BIN_VISITING;
+      BTOR_PUSH_STACK (visit, cur);
+      BTOR_PUSH_STACK (visit, 0);
+      push_children_bin (bin, &visit, cur);
+    }
+    else
+    {
+      cur = BTOR_POP_STACK (visit);
+      assert (bin->node_ids[cur->id] == BTOR_BIN_VISITING);
+      BTOR_PUSH_STACK (bin->nodes, cur);
+      bin->node_ids[cur->id] = BTOR_COUNT_STACK (bin->nodes);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+}
+
+static void
+collect_sort_bin (BtorDumpBin *bin, BtorSort *sort)
+{
+  uint32_t i;
+
+  assert (sort->id < bin->size_sort_ids);
+  if (bin->sort_ids[sort->id]) return;
+
+  if (sort->kind == BTOR_TUPLE_SORT)
+  {
+    for (i = 0; i < sort->tuple.num_elements; i++)
+      collect_sort_bin (bin, sort->tuple.elements[i]);
+  }
+  else if (sort->kind == BTOR_FUN_SORT)
+  {
+    collect_sort_bin (bin, sort->fun.domain);
+    collect_sort_bin (bin, sort->fun.codomain);
+  }
+  else
+    assert (sort->kind == BTOR_BV_SORT);
+
+  BTOR_PUSH_STACK (bin->sorts, sort);
+  bin->sort_ids[sort->id] = BTOR_COUNT_STACK (bin->sorts);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+write_sort_bin (BtorDumpBin *bin, BtorSort *sort)
+{
+  uint32_t i;
+
+  switch (sort->kind)
+  {
+    case BTOR_BV_SORT:
+      write_varint_bin (bin, BTOR_BIN_SORT_BV);
+      write_varint_bin (bin, sort->bitvec.width);
+      break;
+    case BTOR_TUPLE_SORT:
+      write_varint_bin (bin, BTOR_BIN_SORT_TUPLE);
+      write_varint_bin (bin, sort->tuple.num_elements);
+      for (i = 0; i < sort->tuple.num_elements; i++)
+        write_varint_bin (bin, get_sort_id_bin (bin, sort->tuple.elements[i]));
+      break;
+    default:
+      assert (sort->kind == BTOR_FUN_SORT);
+      write_varint_bin (bin, BTOR_BIN_SORT_FUN);
+      write_varint_bin (bin, get_sort_id_bin (bin, sort->fun.domain));
+      write_varint_bin (bin, get_sort_id_bin (bin, sort->fun.codomain));
+      write_varint_bin (bin, sort->fun.is_array);
+  }
+}
+
+static void
+write_const_bin (BtorDumpBin *bin, BtorNode *node)
+{
+  BtorMemMgr *mm;
+  BtorBitVector *bits, *limb;
+  uint32_t i, width, upper;
+
+  mm    = bin->btor->mm;
+  bits  = btor_node_bv_const_get_bits (node);
+  width = btor_bv_get_width (bits);
+
+  write_varint_bin (bin, BTOR_BIN_NODE_CONST);
+  write_varint_bin (bin, width);
+  if (width <= 64)
+  {
+    write_varint_bin (bin, btor_bv_to_uint64 (bits));
+    return;
+  }
+  for (i = 0; i < width; i += 64)
+  {
+    upper = width - i > 64 ? i + 63 : width - 1;
+    limb  = btor_bv_slice (mm, bits, upper, i);
+    write_varint_bin (bin, btor_bv_to_uint64 (limb));
+    btor_bv_free (mm, limb);
+  }
+}
+
+static void
+write_node_bin (BtorDumpBin *bin, uint32_t id, BtorNode *node)
+{
+  Btor *btor;
+  BtorSort *sort;
+  BtorArgsIterator ait;
+  BtorPtrHashTable *rho;
+  BtorPtrHashTableIterator it;
+  BtorNode *value;
+  uint32_t i, tag;
+
+  btor = bin->btor;
+  assert (btor_node_is_regular (node));
+
+  switch (node->kind)
+  {
+    case BTOR_BV_CONST_NODE: write_const_bin (bin, node); return;
+
+    case BTOR_VAR_NODE:
+    case BTOR_PARAM_NODE:
+    case BTOR_UF_NODE:
+      tag = btor_node_is_bv_var (node)
+                ? BTOR_BIN_NODE_VAR
+                : (btor_node_is_param (node) ? BTOR_BIN_NODE_PARAM
+                                             : BTOR_BIN_NODE_UF);
+      sort = btor_sort_get_by_id (btor, btor_node_get_sort_id (node));
+      write_varint_bin (bin, tag);
+      write_varint_bin (bin, get_sort_id_bin (bin, sort));
+      write_symbol_bin (bin, node);
+      if (tag == BTOR_BIN_NODE_UF) write_varint_bin (bin, node->is_array);
+      return;
+
+    case BTOR_BV_SLICE_NODE:
+      write_varint_bin (bin, BTOR_BIN_NODE_SLICE);
+      write_ref_bin (bin, id, get_child_bin (bin, node, 0));
+      write_varint_bin (bin, btor_node_bv_slice_get_upper (node));
+      write_varint_bin (bin, btor_node_bv_slice_get_lower (node));
+      return;
+
+    case BTOR_ARGS_NODE:
+      write_varint_bin (bin, BTOR_BIN_NODE_ARGS);
+      write_varint_bin (bin, btor_node_args_get_arity (btor, node));
+      btor_iter_args_init (&ait, node);
+      while (btor_iter_args_has_next (&ait))
+        write_ref_bin (
+            bin,
+            id,
+            btor_node_get_simplified (btor, btor_iter_args_next (&ait)));
+      return;
+
+    case BTOR_LAMBDA_NODE:
+      write_varint_bin (bin, BTOR_BIN_NODE_LAMBDA);
+      write_ref_bin (bin, id, get_child_bin (bin, node, 0));
+      write_ref_bin (bin, id, get_child_bin (bin, node, 1));
+      write_varint_bin (bin, node->is_array);
+      rho = btor_node_lambda_get_static_rho (node);
+      write_varint_bin (bin, rho ? rho->count : 0);
+      if (rho)
+      {
+        btor_iter_hashptr_init (&it, rho);
+        while (btor_iter_hashptr_has_next (&it))
+        {
+          value = btor_node_get_simplified (btor, it.bucket->data.as_ptr);
+          write_ref_bin (bin, id, btor_iter_hashptr_next (&it));
+          write_ref_bin (bin, id, value);
+        }
+      }
+      return;
+
+    case BTOR_BV_AND_NODE: tag = BTOR_BIN_NODE_AND; break;
+    case BTOR_BV_EQ_NODE:
+    case BTOR_FUN_EQ_NODE: tag = BTOR_BIN_NODE_EQ; break;
+    case BTOR_BV_ADD_NODE: tag = BTOR_BIN_NODE_ADD; break;
+    case BTOR_BV_MUL_NODE: tag = BTOR_BIN_NODE_MUL; break;
+    case BTOR_BV_ULT_NODE: tag = BTOR_BIN_NODE_ULT; break;
+    case BTOR_BV_SLL_NODE: tag = BTOR_BIN_NODE_SLL; break;
+    case BTOR_BV_SRL_NODE: tag = BTOR_BIN_NODE_SRL; break;
+    case BTOR_BV_UDIV_NODE: tag = BTOR_BIN_NODE_UDIV; break;
+    case BTOR_BV_UREM_NODE: tag = BTOR_BIN_NODE_UREM; break;
+    case BTOR_BV_CONCAT_NODE: tag = BTOR_BIN_NODE_CONCAT; break;
+    case BTOR_COND_NODE: tag = BTOR_BIN_NODE_COND; break;
+    case BTOR_APPLY_NODE: tag = BTOR_BIN_NODE_APPLY; break;
+    case BTOR_FORALL_NODE: tag = BTOR_BIN_NODE_FORALL; break;
+    case BTOR_EXISTS_NODE: tag = BTOR_BIN_NODE_EXISTS; break;
+    default:
+      assert (node->kind == BTOR_UPDATE_NODE);
+      tag = BTOR_BIN_NODE_UPDATE;
+  }
+
+  write_varint_bin (bin, tag);
+  for (i = 0; i < node->arity; i++)
+    write_ref_bin (bin, id, get_child_bin (bin, node, i));
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_dumpbin_dump (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  BtorDumpBin bin;
+  BtorMemMgr *mm;
+  BtorNode *node, *tmp;
+  BtorPtrHashTableIterator it;
+  uint32_t i;
+
+  mm = btor->mm;
+  BTOR_CLR (&bin);
+  bin.btor          = btor;
+  bin.file          = file;
+  bin.size_node_ids = BTOR_COUNT_STACK (btor->nodes_id_table);
+  bin.size_sort_ids = BTOR_COUNT_STACK (btor->sorts_unique_table.id2sort);
+  BTOR_CNEWN (mm, bin.node_ids, bin.size_node_ids);
+  BTOR_CNEWN (mm, bin.sort_ids, bin.size_sort_ids);
+  BTOR_NEWN (mm, bin.buf, BTOR_BIN_BUF_SIZE);
+  BTOR_INIT_STACK (mm, bin.nodes);
+  BTOR_INIT_STACK (mm, bin.roots);
+  BTOR_INIT_STACK (mm, bin.sorts);
+
+  if (btor->inconsistent)
+  {
+    tmp = btor_exp_false (btor);
+    BTOR_PUSH_STACK (bin.roots, tmp);
+  }
+  else
+  {
+    btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+    btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+    while (btor_iter_hashptr_has_next (&it))
+      BTOR_PUSH_STACK (bin.roots,
+                       btor_node_copy (btor, btor_iter_hashptr_next (&it)));
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (bin.roots); i++)
+    collect_nodes_bin (&bin, BTOR_PEEK_STACK (bin.roots, i));
+
+  for (i = 0; i < BTOR_COUNT_STACK (bin.nodes); i++)
+  {
+    node = BTOR_PEEK_STACK (bin.nodes, i);
+    if (btor_node_is_bv_var (node) || btor_node_is_param (node)
+        || btor_node_is_uf (node))
+      collect_sort_bin (
+          &bin, btor_sort_get_by_id (btor, btor_node_get_sort_id (node)));
+  }
+
+  write_bytes_bin (&bin, BTOR_BIN_MAGIC, BTOR_BIN_MAGIC_LEN);
+  write_varint_bin (&bin, BTOR_BIN_VERSION);
+  write_varint_bin (&bin, BTOR_COUNT_STACK (bin.sorts));
+  write_varint_bin (&bin, BTOR_COUNT_STACK (bin.nodes));
+  write_varint_bin (&bin, BTOR_COUNT_STACK (bin.roots));
+
+  for (i = 0; i < BTOR_COUNT_STACK (bin.sorts); i++)
+    write_sort_bin (&bin, BTOR_PEEK_STACK (bin.sorts, i));
+
+  for (i = 0; i < BTOR_COUNT_STACK (bin.nodes); i++)
+    write_node_bin (&bin, i + 1, BTOR_PEEK_STACK (bin.nodes, i));
+
+  for (i = 0; i < BTOR_COUNT_STACK (bin.roots); i++)
+  {
+    node = BTOR_PEEK_STACK (bin.roots, i);
+    write_varint_bin (&bin,
+                      ((uint64_t) get_id_bin (&bin, node) << 1)
+                          | btor_node_is_inverted (node));
+  }
+  flush_bin (&bin);
+
+  while (!BTOR_EMPTY_STACK (bin.roots))
+    btor_node_release (btor, BTOR_POP_STACK (bin.roots));
+  BTOR_RELEASE_STACK (bin.roots);
+  BTOR_RELEASE_STACK (bin.nodes);
+  BTOR_RELEASE_STACK (bin.sorts);
+  BTOR_DELETEN (mm, bin.buf, BTOR_BIN_BUF_SIZE);
+  BTOR_DELETEN (mm, bin.sort_ids, bin.size_sort_ids);
+  BTOR_DELETEN (mm, bin.node_ids, bin.size_node_ids);
+}
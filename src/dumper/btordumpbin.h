@@ -0,0 +1,72 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+#ifndef BTORDUMPBIN_H_INCLUDED
+#define BTORDUMPBIN_H_INCLUDED
+
+#include <stdio.h>
+#include "btortypes.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Binary BTOR format.
+ *
+ *   <magic> <version> <#sorts> <#nodes> <#roots> <sort>* <node>* <root>*
+ *
+ * All numbers are unsigned LEB128 varints.  Sorts and nodes are numbered
+ * consecutively (starting with 1) in the order of their records, every
+ * record only refers to records preceding it.  Node references within node
+ * records are given relative to the referring node as '(id - ref) << 1 | s'
+ * where 's' denotes an inverted (negated) reference, root references are
+ * given as 'ref << 1 | s'.  Symbols are stored as length followed by the
+ * raw bytes (length 0 if no symbol is given), constants as bit-width
+ * followed by the value in 64-bit limbs (least significant limb first). */
+
+#define BTOR_BIN_MAGIC "\177BTB"
+#define BTOR_BIN_MAGIC_LEN 4
+#define BTOR_BIN_VERSION 1
+
+enum BtorBinSortTag
+{
+  BTOR_BIN_SORT_BV = 1, /* <width> */
+  BTOR_BIN_SORT_TUPLE,  /* <n> <sort>^n */
+  BTOR_BIN_SORT_FUN,    /* <domain> <codomain> <is_array> */
+};
+typedef enum BtorBinSortTag BtorBinSortTag;
+
+enum BtorBinNodeTag
+{
+  BTOR_BIN_NODE_CONST = 1, /* <width> <limb>* */
+  BTOR_BIN_NODE_VAR,       /* <sort> <symbol> */
+  BTOR_BIN_NODE_PARAM,     /* <sort> <symbol> */
+  BTOR_BIN_NODE_UF,        /* <sort> <symbol> <is_array> */
+  BTOR_BIN_NODE_SLICE,     /* <e> <upper> <lower> */
+  BTOR_BIN_NODE_AND,       /* <e0> <e1> */
+  BTOR_BIN_NODE_EQ,        /* <e0> <e1> */
+  BTOR_BIN_NODE_ADD,       /* <e0> <e1> */
+  BTOR_BIN_NODE_MUL,       /* <e0> <e1> */
+  BTOR_BIN_NODE_ULT,       /* <e0> <e1> */
+  BTOR_BIN_NODE_SLL,       /* <e0> <e1> */
+  BTOR_BIN_NODE_SRL,       /* <e0> <e1> */
+  BTOR_BIN_NODE_UDIV,      /* <e0> <e1> */
+  BTOR_BIN_NODE_UREM,      /* <e0> <e1> */
+  BTOR_BIN_NODE_CONCAT,    /* <e0> <e1> */
+  BTOR_BIN_NODE_COND,      /* <cond> <then> <else> */
+  BTOR_BIN_NODE_ARGS,      /* <n> <e>^n */
+  BTOR_BIN_NODE_APPLY,     /* <fun> <args> */
+  BTOR_BIN_NODE_LAMBDA,    /* <param> <body> <is_array> <n> (<args> <e>)^n */
+  BTOR_BIN_NODE_FORALL,    /* <param> <body> */
+  BTOR_BIN_NODE_EXISTS,    /* <param> <body> */
+  BTOR_BIN_NODE_UPDATE,    /* <fun> <args> <value> */
+};
+typedef enum BtorBinNodeTag BtorBinNodeTag;
+
+/*------------------------------------------------------------------------*/
+
+void btor_dumpbin_dump (Btor *btor, FILE *file);
+
+#endif
@@ -0,0 +1,241 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "dumper/btordumpcnf.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BTOR_DUMPCNF_BUF_SIZE (1 << 16)
+
+/* The DIMACS header is padded with spaces to this width (without newline),
+ * enough for 'p cnf' followed by a 32 bit and a 64 bit number. */
+#define BTOR_DUMPCNF_HEADER_WIDTH 40
+
+/*------------------------------------------------------------------------*/
+
+static void
+flush_buf (BtorCnfWriter *writer)
+{
+  size_t n;
+
+  /* after an error the output is incomplete anyway, drop the rest */
+  if (writer->pos && !writer->error)
+  {
+    if (writer->write.fun)
+      n = writer->write.fun (writer->write.state, writer->buf, writer->pos);
+    else
+      n = fwrite (writer->buf, 1, writer->pos, writer->file);
+    if (n < writer->pos) writer->error = true;
+  }
+  writer->pos = 0;
+}
+
+/* Make room for 'n' bytes in the buffer. */
+static inline void
+reserve (BtorCnfWriter *writer, size_t n)
+{
+  if (writer->pos + n > BTOR_DUMPCNF_BUF_SIZE) flush_buf (writer);
+}
+
+static inline void
+put_char (BtorCnfWriter *writer, char ch)
+{
+  reserve (writer, 1);
+  writer->buf[writer->pos++] = ch;
+}
+
+static void
+put_lit (BtorCnfWriter *writer, int32_t lit)
+{
+  char digits[10];
+  uint32_t u, n;
+
+  u = lit < 0 ? -(uint32_t) lit : (uint32_t) lit;
+  if (writer->binary)
+  {
+    reserve (writer, 5);
+    u = 2 * u + (lit < 0);
+    while (u > 0x7f)
+    {
+      writer->buf[writer->pos++] = (char) (0x80 | (u & 0x7f));
+      u >>= 7;
+    }
+    writer->buf[writer->pos++] = (char) u;
+    return;
+  }
+
+  reserve (writer, 12);
+  if (lit < 0) writer->buf[writer->pos++] = '-';
+  n = 0;
+  do
+  {
+    digits[n++] = '0' + u % 10;
+    u /= 10;
+  } while (u);
+  while (n) writer->buf[writer->pos++] = digits[--n];
+  writer->buf[writer->pos++] = ' ';
+}
+
+/* Write the header at the current position of the buffer. */
+static void
+put_header (BtorCnfWriter *writer)
+{
+  char line[BTOR_DUMPCNF_HEADER_WIDTH + 2];
+  int n;
+
+  if (writer->icnf)
+    n = snprintf (line, sizeof (line), "p inccnf\n");
+  else
+  {
+    n = snprintf (line,
+                  sizeof (line),
+                  "p cnf %d %llu",
+                  writer->maxvar,
+                  (unsigned long long) writer->clauses);
+    assert (n > 0 && n <= BTOR_DUMPCNF_HEADER_WIDTH);
+    memset (line + n, ' ', BTOR_DUMPCNF_HEADER_WIDTH - n);
+    n         = BTOR_DUMPCNF_HEADER_WIDTH;
+    line[n++] = '\n';
+  }
+  reserve (writer, n);
+  memcpy (writer->buf + writer->pos, line, n);
+  writer->pos += n;
+}
+
+/* Flush the buffer and overwrite the DIMACS header with the current
+ * numbers of variables and clauses. */
+static void
+update_header (BtorCnfWriter *writer)
+{
+  long pos;
+
+  flush_buf (writer);
+  if (writer->icnf || writer->error) return;
+  pos = ftell (writer->file);
+  if (pos < 0 || fseek (writer->file, writer->header, SEEK_SET))
+  {
+    writer->error = true;
+    return;
+  }
+  put_header (writer);
+  flush_buf (writer);
+  if (fseek (writer->file, pos, SEEK_SET)) writer->error = true;
+}
+
+/* Flush all output and return true if it has been written successfully. */
+static bool
+flush_all (BtorCnfWriter *writer)
+{
+  update_header (writer);
+  if (fflush (writer->file) || ferror (writer->file)) writer->error = true;
+  return !writer->error;
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_dumpcnf_is_seekable (FILE *file)
+{
+  assert (file);
+  return ftell (file) >= 0 && !fseek (file, 0, SEEK_CUR);
+}
+
+BtorCnfWriter *
+btor_dumpcnf_new (BtorMemMgr *mm, FILE *file, bool icnf, bool binary)
+{
+  assert (mm);
+  assert (file);
+  assert (icnf || btor_dumpcnf_is_seekable (file));
+
+  BtorCnfWriter *res;
+
+  BTOR_CNEW (mm, res);
+  BTOR_NEWN (mm, res->buf, BTOR_DUMPCNF_BUF_SIZE);
+  res->mm     = mm;
+  res->file   = file;
+  res->icnf   = icnf;
+  res->binary = binary;
+  res->header = icnf ? -1 : ftell (file);
+  put_header (res);
+  return res;
+}
+
+bool
+btor_dumpcnf_delete (BtorCnfWriter *writer)
+{
+  assert (writer);
+  assert (!writer->in_clause);
+
+  bool res;
+
+  res = flush_all (writer);
+  BTOR_DELETEN (writer->mm, writer->buf, BTOR_DUMPCNF_BUF_SIZE);
+  BTOR_DELETE (writer->mm, writer);
+  return res;
+}
+
+void
+btor_dumpcnf_add (BtorCnfWriter *writer, int32_t lit)
+{
+  assert (writer);
+
+  if (lit)
+  {
+    if (!writer->in_clause && writer->binary) put_char (writer, 'a');
+    writer->in_clause = true;
+    if (abs (lit) > writer->maxvar) writer->maxvar = abs (lit);
+    put_lit (writer, lit);
+  }
+  else
+  {
+    if (writer->binary)
+    {
+      if (!writer->in_clause) put_char (writer, 'a');
+      put_char (writer, 0);
+    }
+    else
+    {
+      put_char (writer, '0');
+      put_char (writer, '\n');
+    }
+    writer->in_clause = false;
+    writer->clauses += 1;
+  }
+}
+
+bool
+btor_dumpcnf_query (BtorCnfWriter *writer,
+                    const int32_t *assumptions,
+                    size_t n)
+{
+  assert (writer);
+  assert (!writer->in_clause);
+  assert (!n || assumptions);
+
+  if (writer->icnf)
+  {
+    if (writer->binary)
+    {
+      put_char (writer, 'q');
+      for (size_t i = 0; i < n; i++) put_lit (writer, assumptions[i]);
+      put_char (writer, 0);
+    }
+    else
+    {
+      put_char (writer, 'a');
+      put_char (writer, ' ');
+      for (size_t i = 0; i < n; i++) put_lit (writer, assumptions[i]);
+      put_char (writer, '0');
+      put_char (writer, '\n');
+    }
+  }
+  writer->queries += 1;
+  return flush_all (writer);
+}
@@ -0,0 +1,88 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORDUMPCNF_H_INCLUDED
+#define BTORDUMPCNF_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "utils/btormem.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Streaming CNF writer.
+ *
+ * Clauses are written (buffered) as they are added instead of being collected
+ * in memory first. Two formats are supported:
+ *
+ *   DIMACS: 'p cnf <vars> <clauses>' followed by the clauses. Since the
+ *           numbers are not known in advance, the header is written with
+ *           padding and updated in place on every query and when the writer
+ *           is deleted, which requires a seekable output. Assumptions are not
+ *           written.
+ *
+ *   iCNF:   'p inccnf' followed by the clauses, where every query is written
+ *           as 'a <assumptions> 0' line (incremental CNF as supported by,
+ *           e.g., Lingeling and CaDiCaL). Does not require a seekable
+ *           output, i.e., can be written to a pipe.
+ *
+ * In binary encoding, the header line is written as text and all following
+ * clauses as 'a' followed by the literals and a terminating 0 byte, and
+ * queries as 'q' followed by the assumptions and a terminating 0 byte. A
+ * literal is encoded as unsigned LEB128 varint of 2 * |lit| + (lit < 0), as in
+ * binary DRAT proofs. */
+
+struct BtorCnfWriter
+{
+  BtorMemMgr *mm;
+  FILE *file;
+  bool icnf;
+  bool binary;
+  char *buf;        /* output buffer */
+  size_t pos;       /* number of bytes in 'buf' */
+  long header;      /* offset of the DIMACS header in 'file' */
+  bool in_clause;   /* literals of an unterminated clause have been added */
+  int32_t maxvar;   /* maximum variable of all clauses */
+  uint64_t clauses; /* number of clauses written */
+  uint64_t queries; /* number of queries written */
+  bool error;       /* writing failed, no further output is written */
+  struct
+  {
+    size_t (*fun) (void *state, const char *buf, size_t n);
+    void *state;
+  } write; /* writes the buffer instead of 'fwrite' to 'file' if set */
+};
+
+typedef struct BtorCnfWriter BtorCnfWriter;
+
+/* Returns true if 'file' is seekable, i.e., supports DIMACS output. */
+bool btor_dumpcnf_is_seekable (FILE *file);
+
+/* Create a writer that writes to 'file', which must be seekable for DIMACS
+ * output. The header is written immediately. */
+BtorCnfWriter *btor_dumpcnf_new (BtorMemMgr *mm,
+                                 FILE *file,
+                                 bool icnf,
+                                 bool binary);
+
+/* Flush the buffer, update the header, and delete the writer ('file' is not
+ * closed). Returns false if writing the output failed. */
+bool btor_dumpcnf_delete (BtorCnfWriter *writer);
+
+/* Add literal 'lit' to the current clause, 0 terminates the clause. */
+void btor_dumpcnf_add (BtorCnfWriter *writer, int32_t lit);
+
+/* Write a query under the 'n' assumptions 'assumptions' and flush the
+ * output, e.g., before a SAT call. Returns false if writing the output
+ * failed. */
+bool btor_dumpcnf_query (BtorCnfWriter *writer,
+                         const int32_t *assumptions,
+                         size_t n);
+
+#endif
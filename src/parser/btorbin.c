@@ -0,0 +1,814 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "parser/btorbin.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btormsg.h"
+#include "btornode.h"
+#include "btorsort.h"
+#include "dumper/btordumpbin.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+#include <limits.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Parser for the binary BTOR format written by 'btor_dumpbin_dump'.  Nodes
+ * are created via the expression layer and thus rewritten with respect to
+ * the current rewrite level, which is cheap for an already simplified
+ * formula. */
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_BIN_READ_SIZE (1 << 16)
+
+struct BtorBinParser
+{
+  BtorMemMgr *mm;
+  Btor *btor;
+  char *error;
+  const char *infile_name;
+  BtorCharStack input;
+  BtorCharStack symbol;
+  BtorNodePtrStack args;
+  const uint8_t *cur, *end;
+  uint32_t nsorts, nnodes;
+  BtorSortId *sorts;
+  BtorNode **nodes;
+  bool found_funs, found_quantifiers;
+};
+
+typedef struct BtorBinParser BtorBinParser;
+
+/*------------------------------------------------------------------------*/
+
+/* binary input has no lines, report the byte offset instead */
+static bool
+perr_bin (BtorBinParser *parser, const char *fmt, ...)
+{
+  size_t bytes;
+  int32_t offset;
+  va_list ap;
+
+  if (!parser->error)
+  {
+    offset = parser->cur - (uint8_t *) parser->input.start;
+
+    va_start (ap, fmt);
+    bytes = btor_mem_parse_error_msg_length (parser->infile_name, fmt, ap);
+    va_end (ap);
+
+    va_start (ap, fmt);
+    parser->error = btor_mem_parse_error_msg (
+        parser->mm, parser->infile_name, offset, 0, fmt, ap, bytes);
+    va_end (ap);
+  }
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorBinParser *
+new_bin_parser (Btor *btor)
+{
+  BtorMemMgr *mm = btor_mem_mgr_new ();
+  BtorBinParser *res;
+
+  BTOR_NEW (mm, res);
+  BTOR_CLR (res);
+
+  res->mm   = mm;
+  res->btor = btor;
+  BTOR_INIT_STACK (mm, res->input);
+  BTOR_INIT_STACK (mm, res->symbol);
+  BTOR_INIT_STACK (mm, res->args);
+
+  return res;
+}
+
+static void
+delete_bin_parser (BtorBinParser *parser)
+{
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  mm = parser->mm;
+  if (parser->nodes)
+  {
+    for (i = 0; i < parser->nnodes; i++)
+      if (parser->nodes[i]) btor_node_release (parser->btor, parser->nodes[i]);
+    BTOR_DELETEN (mm, parser->nodes, parser->nnodes);
+  }
+  if (parser->sorts)
+  {
+    for (i = 0; i < parser->nsorts; i++)
+      if (parser->sorts[i]) btor_sort_release (parser->btor, parser->sorts[i]);
+    BTOR_DELETEN (mm, parser->sorts, parser->nsorts);
+  }
+  BTOR_RELEASE_STACK (parser->args);
+  BTOR_RELEASE_STACK (parser->symbol);
+  BTOR_RELEASE_STACK (parser->input);
+  btor_mem_freestr (mm, parser->error);
+  BTOR_DELETE (mm, parser);
+  btor_mem_mgr_delete (mm);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+read_input_bin (BtorBinParser *parser, BtorIntStack *prefix, FILE *infile)
+{
+  size_t i, n, size;
+  int32_t ch;
+
+  if (prefix)
+  {
+    for (i = 0; i < BTOR_COUNT_STACK (*prefix); i++)
+    {
+      ch = BTOR_PEEK_STACK (*prefix, i);
+      if (ch == EOF) break;
+      BTOR_PUSH_STACK (parser->input, ch);
+    }
+  }
+
+  for (;;)
+  {
+    size = BTOR_SIZE_STACK (parser->input);
+    if (size - BTOR_COUNT_STACK (parser->input) < BTOR_BIN_READ_SIZE)
+    {
+      size = 2 * size + BTOR_BIN_READ_SIZE;
+      BTOR_ENLARGE_STACK_TO_SIZE (parser->input, size);
+    }
+    n = fread (parser->input.top, 1, BTOR_BIN_READ_SIZE, infile);
+    parser->input.top += n;
+    if (n < BTOR_BIN_READ_SIZE) break;
+  }
+
+  parser->cur = (uint8_t *) parser->input.start;
+  parser->end = (uint8_t *) parser->input.top;
+}
+
+static bool
+read_varint_bin (BtorBinParser *parser, uint64_t *res)
+{
+  uint32_t shift;
+  uint8_t byte;
+
+  *res = 0;
+  for (shift = 0;; shift += 7)
+  {
+    if (parser->cur == parser->end)
+      return perr_bin (parser, "unexpected end of file");
+    byte = *parser->cur++;
+    if (shift == 63 && byte > 1) return perr_bin (parser, "invalid number");
+    *res |= (uint64_t) (byte & 0x7f) << shift;
+    if (!(byte & 0x80)) break;
+  }
+  return true;
+}
+
+static bool
+read_uint32_bin (BtorBinParser *parser, uint32_t *res)
+{
+  uint64_t val;
+
+  *res = 0;
+  if (!read_varint_bin (parser, &val)) return false;
+  if (val > UINT32_MAX) return perr_bin (parser, "number exceeds UINT32_MAX");
+  *res = val;
+  return true;
+}
+
+/* every record needs at least one byte */
+static bool
+read_count_bin (BtorBinParser *parser, const char *what, uint32_t *res)
+{
+  if (!read_uint32_bin (parser, res)) return false;
+  if (*res > (size_t) (parser->end - parser->cur))
+    return perr_bin (parser, "invalid number of %s '%u'", what, *res);
+  return true;
+}
+
+static bool
+read_sort_bin (BtorBinParser *parser, uint32_t id, BtorSortId *res)
+{
+  uint32_t ref;
+
+  if (!read_uint32_bin (parser, &ref)) return false;
+  if (!ref || ref >= id) return perr_bin (parser, "invalid sort '%u'", ref);
+  *res = parser->sorts[ref - 1];
+  return true;
+}
+
+static bool
+read_ref_bin (BtorBinParser *parser, uint32_t id, BtorNode **res)
+{
+  uint64_t val, delta;
+  BtorNode *node;
+
+  if (!read_varint_bin (parser, &val)) return false;
+  delta = val >> 1;
+  if (!delta || delta >= id) return perr_bin (parser, "invalid reference");
+  node = parser->nodes[id - delta - 1];
+  if (val & 1)
+  {
+    if (btor_node_is_fun (node) || btor_node_is_args (node))
+      return perr_bin (parser, "invalid inverted reference");
+    node = btor_node_invert (node);
+  }
+  *res = node;
+  return true;
+}
+
+static bool
+read_symbol_bin (BtorBinParser *parser, char **res)
+{
+  uint32_t len;
+
+  *res = 0;
+  if (!read_uint32_bin (parser, &len)) return false;
+  if (!len) return true;
+  if (len > (size_t) (parser->end - parser->cur))
+    return perr_bin (parser, "unexpected end of file");
+  if (memchr (parser->cur, 0, len)) return perr_bin (parser, "invalid symbol");
+  BTOR_RESET_STACK (parser->symbol);
+  BTOR_FIT_STACK (parser->symbol, len);
+  memcpy (parser->symbol.start, parser->cur, len);
+  parser->symbol.start[len] = 0;
+  parser->cur += len;
+  if (btor_hashptr_table_get (parser->btor->symbols, parser->symbol.start))
+    return perr_bin (
+        parser, "symbol '%s' already defined", parser->symbol.start);
+  *res = parser->symbol.start;
+  return true;
+}
+
+static bool
+read_flag_bin (BtorBinParser *parser, bool *res)
+{
+  uint64_t val;
+
+  if (!read_varint_bin (parser, &val)) return false;
+  if (val > 1) return perr_bin (parser, "invalid flag");
+  *res = val;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+parse_sort_bin (BtorBinParser *parser, uint32_t id)
+{
+  Btor *btor;
+  BtorSortId res, domain, codomain, index;
+  BtorSortIdStack elements;
+  uint32_t tag, i, n, width;
+  bool is_array = false;
+
+  btor = parser->btor;
+  res  = 0;
+  if (!read_uint32_bin (parser, &tag)) return false;
+
+  switch (tag)
+  {
+    case BTOR_BIN_SORT_BV:
+      if (!read_uint32_bin (parser, &width)) return false;
+      if (!width) return perr_bin (parser, "invalid bit-width '0'");
+      res = btor_sort_bv (btor, width);
+      break;
+
+    case BTOR_BIN_SORT_TUPLE:
+      if (!read_count_bin (parser, "elements", &n)) return false;
+      if (!n) return perr_bin (parser, "empty tuple sort");
+      BTOR_INIT_STACK (parser->mm, elements);
+      for (i = 0; i < n; i++)
+      {
+        if (!read_sort_bin (parser, id, &index)) break;
+        if (!btor_sort_is_bv (btor, index))
+        {
+          perr_bin (parser, "expected bit-vector sort");
+          break;
+        }
+        BTOR_PUSH_STACK (elements, index);
+      }
+      if (i < n)
+      {
+        BTOR_RELEASE_STACK (elements);
+        return false;
+      }
+      res = btor_sort_tuple (btor, elements.start, n);
+      BTOR_RELEASE_STACK (elements);
+      break;
+
+    case BTOR_BIN_SORT_FUN:
+      if (!read_sort_bin (parser, id, &domain)
+          || !read_sort_bin (parser, id, &codomain)
+          || !read_flag_bin (parser, &is_array))
+        return false;
+      if (!btor_sort_is_tuple (btor, domain))
+        return perr_bin (parser, "expected tuple sort");
+      if (!btor_sort_is_bv (btor, codomain))
+        return perr_bin (parser, "expected bit-vector sort");
+      if (is_array)
+      {
+        if (btor_sort_tuple_get_arity (btor, domain) != 1)
+          return perr_bin (parser, "invalid array sort");
+        index = btor_sort_get_by_id (btor, domain)->tuple.elements[0]->id;
+        res   = btor_sort_array (btor, index, codomain);
+      }
+      else
+        res = btor_sort_fun (btor, domain, codomain);
+      break;
+
+    default: return perr_bin (parser, "invalid sort tag '%u'", tag);
+  }
+
+  parser->sorts[id - 1] = res;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+parse_const_bin (BtorBinParser *parser, BtorNode **res)
+{
+  BtorMemMgr *mm;
+  BtorBitVector *bits, *limb, *tmp;
+  uint64_t val;
+  uint32_t i, width, lwidth;
+
+  mm = parser->btor->mm;
+  if (!read_uint32_bin (parser, &width)) return false;
+  if (!width) return perr_bin (parser, "invalid bit-width '0'");
+
+  bits = 0;
+  for (i = 0; i < width; i += 64)
+  {
+    lwidth = width - i > 64 ? 64 : width - i;
+    if (!read_varint_bin (parser, &val)
+        || (lwidth < 64 && val >> lwidth
+            && !perr_bin (parser, "constant exceeds bit-width")))
+    {
+      if (bits) btor_bv_free (mm, bits);
+      return false;
+    }
+    limb = btor_bv_uint64_to_bv (mm, val, lwidth);
+    if (bits)
+    {
+      tmp = btor_bv_concat (mm, limb, bits);
+      btor_bv_free (mm, limb);
+      btor_bv_free (mm, bits);
+      bits = tmp;
+    }
+    else
+      bits = limb;
+  }
+  *res = btor_exp_bv_const (parser->btor, bits);
+  btor_bv_free (mm, bits);
+  return true;
+}
+
+static bool
+parse_input_bin (BtorBinParser *parser, uint32_t id, uint32_t tag)
+{
+  Btor *btor;
+  BtorSortId sort;
+  BtorNode *node;
+  char *symbol;
+  bool is_array = false;
+
+  btor = parser->btor;
+  if (!read_sort_bin (parser, parser->nsorts + 1, &sort)) return false;
+  if (tag == BTOR_BIN_NODE_UF)
+  {
+    if (!btor_sort_is_fun (btor, sort))
+      return perr_bin (parser, "expected function sort");
+  }
+  else if (!btor_sort_is_bv (btor, sort))
+    return perr_bin (parser, "expected bit-vector sort");
+  if (!read_symbol_bin (parser, &symbol)) return false;
+
+  if (tag == BTOR_BIN_NODE_VAR)
+    node = btor_exp_var (btor, sort, symbol);
+  else if (tag == BTOR_BIN_NODE_PARAM)
+    node = btor_exp_param (btor, sort, symbol);
+  else
+  {
+    if (!read_flag_bin (parser, &is_array)) return false;
+    if (is_array
+        && btor_sort_tuple_get_arity (btor,
+                                      btor_sort_fun_get_domain (btor, sort))
+               != 1)
+      return perr_bin (parser, "invalid array sort");
+    node               = btor_exp_uf (btor, sort, symbol);
+    node->is_array     = is_array;
+    parser->found_funs = true;
+  }
+  parser->nodes[id - 1] = node;
+  return true;
+}
+
+static bool
+parse_args_bin (BtorBinParser *parser, uint32_t id, BtorNode **res)
+{
+  BtorNode *arg;
+  uint32_t i, n;
+
+  if (!read_count_bin (parser, "arguments", &n)) return false;
+  if (!n) return perr_bin (parser, "empty argument list");
+  BTOR_RESET_STACK (parser->args);
+  for (i = 0; i < n; i++)
+  {
+    if (!read_ref_bin (parser, id, &arg)) return false;
+    if (btor_node_is_fun (arg) || btor_node_is_args (arg))
+      return perr_bin (parser, "expected bit-vector argument");
+    BTOR_PUSH_STACK (parser->args, arg);
+  }
+  *res = btor_exp_args (parser->btor, parser->args.start, n);
+  return true;
+}
+
+static bool
+check_args_bin (BtorBinParser *parser, BtorNode *fun, BtorNode *args)
+{
+  Btor *btor = parser->btor;
+
+  if (!btor_node_is_fun (fun))
+    return perr_bin (parser, "expected function");
+  if (!btor_node_is_args (args))
+    return perr_bin (parser, "expected argument list");
+  if (btor_node_get_sort_id (args)
+      != btor_sort_fun_get_domain (btor, btor_node_get_sort_id (fun)))
+    return perr_bin (parser, "arguments do not match function domain");
+  return true;
+}
+
+static bool
+parse_lambda_bin (BtorBinParser *parser, uint32_t id, BtorNode **res)
+{
+  Btor *btor;
+  BtorNode *e[2], *lambda, *args, *value;
+  BtorPtrHashTable *rho;
+  BtorPtrHashBucket *b;
+  BtorSortId codomain;
+  uint32_t i, n;
+  bool is_array = false;
+
+  btor = parser->btor;
+  if (!read_ref_bin (parser, id, &e[0]) || !read_ref_bin (parser, id, &e[1])
+      || !read_flag_bin (parser, &is_array)
+      || !read_count_bin (parser, "static rho entries", &n))
+    return false;
+  if (!btor_node_is_regular (e[0]) || !btor_node_is_param (e[0])
+      || btor_node_param_is_bound (e[0]))
+    return perr_bin (parser, "expected unbound parameter");
+  if (btor_node_is_args (e[1])
+      || (btor_node_is_fun (e[1]) && !btor_node_is_lambda (e[1])))
+    return perr_bin (parser, "invalid lambda body");
+
+  /* rewriting may yield a function other than a fresh lambda, in which case
+   * the array flag and the static rho entries are checked but dropped */
+  lambda = btor_exp_lambda (btor, e[0], e[1]);
+  *res   = lambda;
+  if (!btor_node_is_lambda (lambda)) lambda = 0;
+  if (lambda && is_array) lambda->is_array = 1;
+  if (!n) return true;
+
+  codomain = btor_sort_fun_get_codomain (btor, btor_node_get_sort_id (*res));
+  rho      = lambda ? btor_node_lambda_get_static_rho (lambda) : 0;
+  if (lambda && !rho)
+  {
+    rho = btor_hashptr_table_new (btor->mm,
+                                  (BtorHashPtr) btor_node_hash_by_id,
+                                  (BtorCmpPtr) btor_node_compare_by_id);
+    btor_node_lambda_set_static_rho (lambda, rho);
+  }
+  for (i = 0; i < n; i++)
+  {
+    if (!read_ref_bin (parser, id, &args) || !read_ref_bin (parser, id, &value)
+        || !check_args_bin (parser, *res, args))
+      return false;
+    if (btor_node_get_sort_id (value) != codomain)
+      return perr_bin (parser, "value does not match function codomain");
+    if (!rho || btor_hashptr_table_get (rho, args)) continue;
+    b              = btor_hashptr_table_add (rho, btor_node_copy (btor, args));
+    b->data.as_ptr = btor_node_copy (btor, value);
+  }
+  return true;
+}
+
+static bool
+parse_node_bin (BtorBinParser *parser, uint32_t id)
+{
+  Btor *btor;
+  BtorNode *e[3], *node;
+  uint32_t tag, i, arity, upper, lower, width;
+
+  btor = parser->btor;
+  node = 0;
+  if (!read_uint32_bin (parser, &tag)) return false;
+
+  switch (tag)
+  {
+    case BTOR_BIN_NODE_CONST:
+      if (!parse_const_bin (parser, &node)) return false;
+      break;
+
+    case BTOR_BIN_NODE_VAR:
+    case BTOR_BIN_NODE_PARAM:
+    case BTOR_BIN_NODE_UF: return parse_input_bin (parser, id, tag);
+
+    case BTOR_BIN_NODE_SLICE:
+      if (!read_ref_bin (parser, id, &e[0]) || !read_uint32_bin (parser, &upper)
+          || !read_uint32_bin (parser, &lower))
+        return false;
+      if (btor_node_is_fun (e[0]) || btor_node_is_args (e[0]))
+        return perr_bin (parser, "expected bit-vector");
+      if (upper >= btor_node_bv_get_width (btor, e[0]) || lower > upper)
+        return perr_bin (parser, "invalid slice indices");
+      node = btor_exp_bv_slice (btor, e[0], upper, lower);
+      break;
+
+    case BTOR_BIN_NODE_ARGS:
+      if (!parse_args_bin (parser, id, &node)) return false;
+      break;
+
+    case BTOR_BIN_NODE_LAMBDA:
+      parser->found_funs = true;
+      if (!parse_lambda_bin (parser, id, &node))
+      {
+        if (node) parser->nodes[id - 1] = node;
+        return false;
+      }
+      break;
+
+    case BTOR_BIN_NODE_AND:
+    case BTOR_BIN_NODE_EQ:
+    case BTOR_BIN_NODE_ADD:
+    case BTOR_BIN_NODE_MUL:
+    case BTOR_BIN_NODE_ULT:
+    case BTOR_BIN_NODE_SLL:
+    case BTOR_BIN_NODE_SRL:
+    case BTOR_BIN_NODE_UDIV:
+    case BTOR_BIN_NODE_UREM:
+    case BTOR_BIN_NODE_CONCAT:
+    case BTOR_BIN_NODE_APPLY:
+    case BTOR_BIN_NODE_FORALL:
+    case BTOR_BIN_NODE_EXISTS:
+      arity = 2;
+      goto PARSE_CHILDREN;
+
+    case BTOR_BIN_NODE_COND:
+    case BTOR_BIN_NODE_UPDATE:
+      arity = 3;
+    PARSE_CHILDREN:
+      for (i = 0; i < arity; i++)
+        if (!read_ref_bin (parser, id, &e[i])) return false;
+      break;
+
+    default: return perr_bin (parser, "invalid node tag '%u'", tag);
+  }
+
+  /* check sorts of children before creating operator nodes */
+  switch (tag)
+  {
+    case BTOR_BIN_NODE_AND:
+    case BTOR_BIN_NODE_ADD:
+    case BTOR_BIN_NODE_MUL:
+    case BTOR_BIN_NODE_ULT:
+    case BTOR_BIN_NODE_SLL:
+    case BTOR_BIN_NODE_SRL:
+    case BTOR_BIN_NODE_UDIV:
+    case BTOR_BIN_NODE_UREM:
+    case BTOR_BIN_NODE_CONCAT:
+      if (btor_node_is_fun (e[0]) || btor_node_is_args (e[0])
+          || btor_node_is_fun (e[1]) || btor_node_is_args (e[1]))
+        return perr_bin (parser, "expected bit-vector operands");
+      if (tag == BTOR_BIN_NODE_CONCAT)
+      {
+        width = btor_node_bv_get_width (btor, e[0]);
+        if (width > INT32_MAX - btor_node_bv_get_width (btor, e[1]))
+          return perr_bin (parser, "bit-width of concatenation too large");
+      }
+      else if (btor_node_get_sort_id (e[0]) != btor_node_get_sort_id (e[1]))
+        return perr_bin (parser, "operands do not match");
+      break;
+
+    case BTOR_BIN_NODE_EQ:
+      if (btor_node_is_args (e[0])
+          || btor_node_get_sort_id (e[0]) != btor_node_get_sort_id (e[1]))
+        return perr_bin (parser, "operands do not match");
+      break;
+
+    case BTOR_BIN_NODE_COND:
+      if (btor_node_is_fun (e[0]) || btor_node_is_args (e[0])
+          || btor_node_bv_get_width (btor, e[0]) != 1)
+        return perr_bin (parser, "expected bit-vector of bit-width 1");
+      if (btor_node_is_args (e[1])
+          || btor_node_get_sort_id (e[1]) != btor_node_get_sort_id (e[2]))
+        return perr_bin (parser, "operands do not match");
+      break;
+
+    case BTOR_BIN_NODE_APPLY:
+      if (!check_args_bin (parser, e[0], e[1])) return false;
+      break;
+
+    case BTOR_BIN_NODE_UPDATE:
+      if (!check_args_bin (parser, e[0], e[1])) return false;
+      if (btor_node_get_sort_id (e[2])
+          != btor_sort_fun_get_codomain (btor, btor_node_get_sort_id (e[0])))
+        return perr_bin (parser, "value does not match function codomain");
+      break;
+
+    case BTOR_BIN_NODE_FORALL:
+    case BTOR_BIN_NODE_EXISTS:
+      if (!btor_node_is_regular (e[0]) || !btor_node_is_param (e[0])
+          || btor_node_param_is_bound (e[0]))
+        return perr_bin (parser, "expected unbound parameter");
+      if (btor_node_is_fun (e[1]) || btor_node_is_args (e[1])
+          || btor_node_bv_get_width (btor, e[1]) != 1)
+        return perr_bin (parser, "expected bit-vector of bit-width 1");
+      parser->found_quantifiers = true;
+      break;
+
+    default: break;
+  }
+
+  switch (tag)
+  {
+    case BTOR_BIN_NODE_AND:
+      node = btor_exp_bv_and (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_EQ: node = btor_exp_eq (btor, e[0], e[1]); break;
+    case BTOR_BIN_NODE_ADD:
+      node = btor_exp_bv_add (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_MUL:
+      node = btor_exp_bv_mul (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_ULT:
+      node = btor_exp_bv_ult (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_SLL:
+      node = btor_exp_bv_sll (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_SRL:
+      node = btor_exp_bv_srl (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_UDIV:
+      node = btor_exp_bv_udiv (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_UREM:
+      node = btor_exp_bv_urem (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_CONCAT:
+      node = btor_exp_bv_concat (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_APPLY:
+      node = btor_exp_apply (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_FORALL:
+      node = btor_exp_forall (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_EXISTS:
+      node = btor_exp_exists (btor, e[0], e[1]);
+      break;
+    case BTOR_BIN_NODE_COND:
+      node = btor_exp_cond (btor, e[0], e[1], e[2]);
+      break;
+    case BTOR_BIN_NODE_UPDATE:
+      node = btor_exp_update (btor, e[0], e[1], e[2]);
+      break;
+    default: assert (node);
+  }
+
+  parser->nodes[id - 1] = node;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+
+static const char *
+parse_bin_parser (BtorBinParser *parser,
+                  BtorIntStack *prefix,
+                  FILE *infile,
+                  const char *infile_name,
+                  FILE *outfile,
+                  BtorParseResult *res)
+{
+  assert (parser);
+  assert (infile);
+  assert (infile_name);
+  (void) outfile;
+
+  Btor *btor;
+  BtorMsg *msg;
+  BtorNode *root;
+  uint64_t val;
+  uint32_t i, version, nroots;
+  double start, delta;
+
+  btor  = parser->btor;
+  msg   = boolector_get_btor_msg (btor);
+  start = btor_util_time_stamp ();
+
+  BTOR_MSG (msg, 1, "parsing %s", infile_name);
+
+  BTOR_CLR (res);
+  parser->infile_name = infile_name;
+
+  read_input_bin (parser, prefix, infile);
+
+  if (parser->end - parser->cur < BTOR_BIN_MAGIC_LEN
+      || memcmp (parser->cur, BTOR_BIN_MAGIC, BTOR_BIN_MAGIC_LEN))
+  {
+    perr_bin (parser, "invalid binary BTOR header");
+    goto DONE;
+  }
+  parser->cur += BTOR_BIN_MAGIC_LEN;
+
+  if (!read_uint32_bin (parser, &version)) goto DONE;
+  if (version != BTOR_BIN_VERSION)
+  {
+    perr_bin (parser, "unsupported binary BTOR version '%u'", version);
+    goto DONE;
+  }
+
+  if (!read_count_bin (parser, "sorts", &parser->nsorts)) goto DONE;
+  if (!read_count_bin (parser, "nodes", &parser->nnodes)) goto DONE;
+  if (!read_count_bin (parser, "roots", &nroots)) goto DONE;
+
+  if (parser->nsorts) BTOR_CNEWN (parser->mm, parser->sorts, parser->nsorts);
+  if (parser->nnodes) BTOR_CNEWN (parser->mm, parser->nodes, parser->nnodes);
+
+  for (i = 1; i <= parser->nsorts; i++)
+    if (!parse_sort_bin (parser, i)) goto DONE;
+
+  for (i = 1; i <= parser->nnodes; i++)
+    if (!parse_node_bin (parser, i)) goto DONE;
+
+  for (i = 0; i < nroots; i++)
+  {
+    if (!read_varint_bin (parser, &val)) goto DONE;
+    if (!(val >> 1) || (val >> 1) > parser->nnodes)
+    {
+      perr_bin (parser, "invalid root");
+      goto DONE;
+    }
+    root = parser->nodes[(val >> 1) - 1];
+    if (val & 1) root = btor_node_invert (root);
+    if (btor_node_is_fun (root) || btor_node_is_args (root)
+        || btor_node_bv_get_width (btor, root) != 1
+        || btor_node_real_addr (root)->parameterized)
+    {
+      perr_bin (parser, "invalid root");
+      goto DONE;
+    }
+    btor_assert_exp (btor, root);
+  }
+
+  if (parser->cur != parser->end) perr_bin (parser, "trailing garbage");
+
+  delta = btor_util_time_stamp () - start;
+  BTOR_MSG (msg,
+            1,
+            "parsed %u sorts, %u nodes and %u roots in %.2f seconds",
+            parser->nsorts,
+            parser->nnodes,
+            nroots,
+            delta);
+DONE:
+  if (parser->found_quantifiers)
+    res->logic = BTOR_LOGIC_BV;
+  else if (parser->found_funs)
+    res->logic = BTOR_LOGIC_QF_AUFBV;
+  else
+    res->logic = BTOR_LOGIC_QF_BV;
+  res->status = BOOLECTOR_UNKNOWN;
+
+  if (parser->error) return parser->error;
+  return 0;
+}
+
+static BtorParserAPI parsebin_parser_api = {
+    (BtorInitParser) new_bin_parser,
+    (BtorResetParser) delete_bin_parser,
+    (BtorParse) parse_bin_parser,
+};
+
+const BtorParserAPI *
+btor_parsebin_parser_api ()
+{
+  return &parsebin_parser_api;
+}
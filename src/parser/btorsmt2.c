@@ -8,6 +8,7 @@
 
 #include "btorsmt2.h"
 
+#include "btorabort.h"
 #include "btorbv.h"
 #include "btorcore.h"
 #include "btormsg.h"
@@ -19,6 +20,20 @@
 #include <limits.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#define BTOR_HAVE_MMAP_SMT2
+#endif
+
+#ifdef BTOR_HAVE_MMAP_SMT2
+#include <sys/mman.h>
+#endif
+
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -276,9 +291,25 @@ typedef struct BtorSMT2Node
   char *name;
   BoolectorNode *exp;
   BoolectorSort sort_alias;
-  struct BtorSMT2Node *next;
+  struct BtorSMT2Node *next; /* next (shadowed) symbol with the same name */
+  struct BtorSMT2Node *scope_prev, *scope_next; /* symbols of same scope */
 } BtorSMT2Node;
 
+BTOR_DECLARE_STACK (BtorSMT2NodePtr, BtorSMT2Node *);
+
+/* Interned symbol name. Names are compared modulo quoting, i.e., symbols
+ * '|x|' and 'x' have the same name (and key 'x'). All symbols with the same
+ * name are kept in the list 'nodes', the most recently inserted (and thus
+ * visible) symbol first. Names are removed when their last symbol is
+ * removed. */
+typedef struct BtorSMT2Name
+{
+  const char *key; /* name without enclosing pipes, 0 for empty slots */
+  uint32_t len;    /* length of 'key' */
+  uint32_t hash;   /* hash value of 'key' */
+  BtorSMT2Node *nodes;
+} BtorSMT2Name;
+
 typedef struct BtorSMT2Item
 {
   BtorSMT2Tag tag;
@@ -301,7 +332,6 @@ typedef struct BtorSMT2Item
 } BtorSMT2Item;
 
 BTOR_DECLARE_STACK (BtorSMT2Item, BtorSMT2Item);
-BTOR_DECLARE_STACK (BtorSMT2NodePtr, BtorSMT2Node *);
 BTOR_DECLARE_STACK (BtorPtr, Btor *);
 BTOR_DECLARE_STACK (BoolectorSort, BoolectorSort);
 
@@ -360,6 +390,16 @@ typedef struct BtorSMT2Parser
   unsigned char cc[256];
   FILE *infile;
   char *infile_name;
+  struct
+  {
+    char *start, *cur, *end; /* buffered input, 'cur' is the next character */
+    size_t size;             /* size of mapping or allocated block */
+    long offset;             /* file offset of 'start' */
+    bool active;             /* read from buffer rather than via 'getc' */
+    bool mapped;             /* 'start' is memory mapped */
+  } buf;
+  struct BtorSMT2Pipeline *pipeline; /* tokens are read from the pipeline */
+  bool scanning; /* lexer running on the reader thread of the pipeline */
   FILE *outfile;
   double parse_start;
   bool store_tokens; /* needed for parsing terms in get-value */
@@ -374,13 +414,21 @@ typedef struct BtorSMT2Parser
   uint32_t scope_level;
   struct
   {
-    uint32_t size, count;
-    BtorSMT2Node **table;
+    uint32_t size, count;  /* number of slots and interned names */
+    BtorSMT2Name *table;   /* open addressing with linear probing */
+    BtorMemStrArena *keys; /* storage for interned keys */
+    size_t live, dead;     /* bytes of used and removed keys in 'keys' */
+    BtorMemSlab *nodes;    /* storage for symbols */
+    BtorSMT2NodePtrStack scopes; /* symbols inserted per scope level */
   } symbol;
   struct
   {
     int32_t all, set_logic, asserts, check_sat, exits, model;
   } commands;
+  struct
+  {
+    uint_least64_t tokens, lookups;
+  } stats;
 
   /* SMT2 options */
   bool print_success;
@@ -498,26 +546,138 @@ static uint32_t btor_primes_smt2[] = {
 #define BTOR_NPRIMES_SMT2 (sizeof btor_primes_smt2 / sizeof *btor_primes_smt2)
 
 static uint32_t
-hash_name_smt2 (BtorSMT2Parser *parser, const char *name)
+hash_name_smt2 (const char *key, uint32_t len)
 {
-  uint32_t res = 0, i = 0;
-  size_t len, pos     = 0;
+  uint32_t res = 0, i = 0, pos;
 
-  /* Ignore pipes in quoted symbols. Symbol |x| and x should have the same hash
-   * value. */
-  len = strlen (name);
-  if (name[0] == '|' && name[len - 1] == '|')
+  for (pos = 0; pos < len; pos++)
   {
-    pos = 1;
-    len -= 1;
-  }
-  for (; pos < len; pos++)
-  {
-    res += name[pos];
+    res += key[pos];
     res *= btor_primes_smt2[i++];
     if (i == BTOR_NPRIMES_SMT2) i = 0;
   }
-  return res & (parser->symbol.size - 1);
+  return res;
+}
+
+/* Determine key of 'name', i.e., ignore pipes in quoted symbols. Symbol |x|
+ * and x should have the same key. */
+static const char *
+get_key_smt2 (const char *name, uint32_t *len)
+{
+  size_t l = strlen (name);
+
+  if (l >= 2 && name[0] == '|' && name[l - 1] == '|')
+  {
+    *len = l - 2;
+    return name + 1;
+  }
+  *len = l;
+  return name;
+}
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_BLOCK_SIZE_SMT2 (1 << 16)
+
+/* Regular input files are memory mapped (or, if that fails, read in blocks
+ * of BTOR_BLOCK_SIZE_SMT2 bytes) and the lexer reads directly from the
+ * buffer. Pipes and terminals are read character-wise via 'getc' in order
+ * to not block on input that is not available yet (interactive mode). */
+static void
+open_input_smt2 (BtorSMT2Parser *parser)
+{
+  struct stat st;
+  long offset;
+  bool regular;
+  int fd;
+
+  BTOR_CLR (&parser->buf);
+  if (!parser->infile) return;
+  fd      = fileno (parser->infile);
+  regular = fd >= 0 && !fstat (fd, &st) && S_ISREG (st.st_mode);
+  if (!regular) return;
+  if ((offset = ftell (parser->infile)) < 0) return;
+
+  parser->buf.active = true;
+  parser->buf.offset = offset;
+#ifdef BTOR_HAVE_MMAP_SMT2
+  if (st.st_size > offset && (uintmax_t) st.st_size <= SIZE_MAX)
+  {
+    void *map;
+    map = mmap (0, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED)
+    {
+#ifdef POSIX_MADV_SEQUENTIAL
+      (void) posix_madvise (map, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+      parser->buf.mapped = true;
+      parser->buf.size   = (size_t) st.st_size;
+      parser->buf.start  = map;
+      parser->buf.cur    = parser->buf.start + offset;
+      parser->buf.end    = parser->buf.start + parser->buf.size;
+      parser->buf.offset = 0;
+      return;
+    }
+  }
+#endif
+  parser->buf.size = BTOR_BLOCK_SIZE_SMT2;
+  BTOR_NEWN (parser->mem, parser->buf.start, parser->buf.size);
+  parser->buf.cur = parser->buf.end = parser->buf.start;
+}
+
+/* Release the input buffer and leave 'infile' positioned right after the
+ * last character consumed by the lexer. */
+static void
+close_input_smt2 (BtorSMT2Parser *parser)
+{
+  long pos;
+
+  if (!parser->buf.active) return;
+  pos = parser->buf.offset + (long) (parser->buf.cur - parser->buf.start);
+#ifdef BTOR_HAVE_MMAP_SMT2
+  if (parser->buf.mapped)
+    munmap (parser->buf.start, parser->buf.size);
+  else
+#endif
+    BTOR_DELETEN (parser->mem, parser->buf.start, parser->buf.size);
+  (void) fseek (parser->infile, pos, SEEK_SET);
+  BTOR_CLR (&parser->buf);
+}
+
+static int32_t
+refill_input_smt2 (BtorSMT2Parser *parser)
+{
+  size_t n;
+
+  assert (parser->buf.active);
+  assert (parser->buf.cur == parser->buf.end);
+  if (parser->buf.mapped) return EOF;
+  parser->buf.offset += (long) (parser->buf.end - parser->buf.start);
+  n = fread (parser->buf.start, 1, parser->buf.size, parser->infile);
+  parser->buf.cur = parser->buf.start;
+  parser->buf.end = parser->buf.start + n;
+  if (!n) return EOF;
+  return (unsigned char) *parser->buf.cur++;
+}
+
+static int32_t
+getc_smt2 (BtorSMT2Parser *parser)
+{
+  int32_t res;
+#ifdef BTOR_HAVE_PTHREADS
+  /* the reader thread of the pipeline may be cancelled while waiting for
+   * input (only) */
+  if (parser->scanning)
+  {
+    pthread_setcancelstate (PTHREAD_CANCEL_ENABLE, 0);
+    pthread_testcancel ();
+    res = getc (parser->infile);
+    pthread_setcancelstate (PTHREAD_CANCEL_DISABLE, 0);
+    return res;
+  }
+#endif
+  res = getc (parser->infile);
+  return res;
 }
 
 static int32_t
@@ -529,8 +689,12 @@ nextch_smt2 (BtorSMT2Parser *parser)
   else if (parser->prefix
            && parser->nprefix < BTOR_COUNT_STACK (*parser->prefix))
     res = parser->prefix->start[parser->nprefix++];
+  else if (parser->buf.cur < parser->buf.end)
+    res = (unsigned char) *parser->buf.cur++;
+  else if (parser->buf.active)
+    res = refill_input_smt2 (parser);
   else
-    res = getc (parser->infile);
+    res = getc_smt2 (parser);
   if (res == '\n')
   {
     parser->nextcoo.x++;
@@ -543,104 +707,216 @@ nextch_smt2 (BtorSMT2Parser *parser)
   return res;
 }
 
+/* Skip all characters up to (excluding) the next new line that are
+ * available in the input buffer. */
+static void
+skip_to_eol_smt2 (BtorSMT2Parser *parser)
+{
+  const char *eol;
+  size_t n;
+
+  if (parser->saved
+      || (parser->prefix
+          && parser->nprefix < BTOR_COUNT_STACK (*parser->prefix)))
+    return;
+  n = parser->buf.end - parser->buf.cur;
+  if (!n) return;
+  if ((eol = memchr (parser->buf.cur, '\n', n))) n = eol - parser->buf.cur;
+  parser->nextcoo.y += n;
+  parser->buf.cur += n;
+}
+
+#define BTOR_SYMBOL_TABLE_INIT_SIZE_SMT2 256
+#define BTOR_SYMBOL_KEYS_MIN_DEAD_SMT2 (1 << 16)
+
 static void
 enlarge_symbol_table_smt2 (BtorSMT2Parser *parser)
 {
-  uint32_t old_size        = parser->symbol.size;
-  uint32_t new_size        = old_size ? 2 * old_size : 1;
-  BtorSMT2Node **old_table = parser->symbol.table, *p, **q;
-  BtorSMT2NodePtrStack chain;
-  uint32_t h, i;
+  uint32_t old_size = parser->symbol.size, new_size, mask, h, i;
+  BtorSMT2Name *old_table = parser->symbol.table;
+
+  new_size = old_size ? 2 * old_size : BTOR_SYMBOL_TABLE_INIT_SIZE_SMT2;
+  mask     = new_size - 1;
   BTOR_CNEWN (parser->mem, parser->symbol.table, new_size);
   parser->symbol.size = new_size;
 
-  /* Note: A symbol can occur multiple times in the collision chain due to
-   *       shadowing of symbols in binders. Thus, it's important that the
-   *       order of the symbols stays the same. Otherwise, find_symbol_smt2
-   *       won't find the correct symbol for the current scope. */
-  BTOR_INIT_STACK (parser->mem, chain);
+  /* Hash values are stored, keys do not have to be rehashed. The lists of
+   * (shadowed) symbols are moved as a whole and keep their order. */
   for (i = 0; i < old_size; i++)
   {
-    for (p = old_table[i]; p; p = p->next)
-    {
-      BTOR_PUSH_STACK (chain, p);
-    }
-    while (!BTOR_EMPTY_STACK (chain))
-    {
-      p       = BTOR_POP_STACK (chain);
-      h       = hash_name_smt2 (parser, p->name);
-      p->next = *(q = parser->symbol.table + h);
-      *q      = p;
-    }
+    if (!old_table[i].key) continue;
+    for (h = old_table[i].hash & mask; parser->symbol.table[h].key;
+         h = (h + 1) & mask)
+      ;
+    parser->symbol.table[h] = old_table[i];
   }
-  BTOR_RELEASE_STACK (chain);
   BTOR_DELETEN (parser->mem, old_table, old_size);
 }
 
-static BtorSMT2Node *
-find_symbol_smt2 (BtorSMT2Parser *parser, const char *name)
+/* Find slot of name with given key, or the empty slot where it has to be
+ * inserted. */
+static BtorSMT2Name *
+find_name_smt2 (BtorSMT2Parser *parser,
+                const char *key,
+                uint32_t len,
+                uint32_t hash)
+{
+  BtorSMT2Name *n;
+  uint32_t mask, h;
+
+  assert (parser->symbol.size);
+  mask = parser->symbol.size - 1;
+  for (h = hash & mask;; h = (h + 1) & mask)
+  {
+    n = parser->symbol.table + h;
+    if (!n->key) break;
+    if (n->hash == hash && n->len == len && !memcmp (n->key, key, len)) break;
+  }
+  return n;
+}
+
+/* Returns the interned name of 'name', which is added if 'add' is true. */
+static BtorSMT2Name *
+get_name_smt2 (BtorSMT2Parser *parser, const char *name, bool add)
 {
-  unsigned h;
-  BtorSMT2Node *s;
-  size_t len_name, len_s;
-  bool name_quoted, s_quoted;
+  BtorSMT2Name *n;
+  const char *key;
+  uint32_t len, hash;
+
+  key  = get_key_smt2 (name, &len);
+  hash = hash_name_smt2 (key, len);
+
+  if (add && 2 * (parser->symbol.count + 1) > parser->symbol.size)
+    enlarge_symbol_table_smt2 (parser);
+  if (!parser->symbol.size) return 0;
 
-  if (parser->symbol.size == 0) return 0;
+  n = find_name_smt2 (parser, key, len, hash);
+  if (n->key || !add) return n->key ? n : 0;
 
-  len_name    = strlen (name);
-  name_quoted = name[0] == '|' && name[len_name - 1] == '|';
+  n->key  = btor_mem_strarena_add (parser->symbol.keys, key, len);
+  n->len  = len;
+  n->hash = hash;
+  parser->symbol.count++;
+  parser->symbol.live += len + 1;
+  return n;
+}
 
-  h = hash_name_smt2 (parser, name);
-  for (s = parser->symbol.table[h]; s; s = s->next)
+/* Copy all keys into a new arena once more than half of the arena is
+ * occupied by keys of removed names. */
+static void
+compact_keys_smt2 (BtorSMT2Parser *parser)
+{
+  BtorMemStrArena *keys;
+  uint32_t i;
+
+  if (parser->symbol.dead < BTOR_SYMBOL_KEYS_MIN_DEAD_SMT2
+      || parser->symbol.dead < parser->symbol.live)
+    return;
+
+  keys = btor_mem_strarena_new (parser->mem);
+  for (i = 0; i < parser->symbol.size; i++)
   {
-    len_s    = strlen (s->name);
-    s_quoted = s->name[0] == '|' && s->name[len_s - 1] == '|';
+    if (!parser->symbol.table[i].key) continue;
+    parser->symbol.table[i].key = btor_mem_strarena_add (
+        keys, parser->symbol.table[i].key, parser->symbol.table[i].len);
+  }
+  btor_mem_strarena_delete (parser->symbol.keys);
+  parser->symbol.keys = keys;
+  parser->symbol.dead = 0;
+}
 
-    if (s_quoted == name_quoted)
-    {
-      if (!strcmp (s->name, name))
-      {
-        break;
-      }
-    }
-    /* Check if 's' is quoted but 'name' is not quoted. */
-    else if (s_quoted)
-    {
-      if (len_s - 2 == len_name && !strncmp (s->name + 1, name, len_name))
-      {
-        break;
-      }
-    }
-    /* Check if 'name' is quoted but 's' is not quoted. */
-    else if (name_quoted)
-    {
-      if (len_name - 2 == len_s && !strncmp (s->name, name + 1, len_s))
-      {
-        break;
-      }
-    }
+/* Remove name 'n' from the table. Following names of the same cluster are
+ * moved back (backward shift deletion), such that no tombstones are needed.
+ */
+static void
+delete_name_smt2 (BtorSMT2Parser *parser, BtorSMT2Name *n)
+{
+  BtorSMT2Name *table = parser->symbol.table;
+  uint32_t mask, i, j, h;
+
+  assert (n->key);
+  assert (!n->nodes);
+
+  parser->symbol.count--;
+  parser->symbol.live -= n->len + 1;
+  parser->symbol.dead += n->len + 1;
+
+  mask = parser->symbol.size - 1;
+  i    = n - table;
+  for (j = (i + 1) & mask; table[j].key; j = (j + 1) & mask)
+  {
+    /* keep names whose home slot 'h' is cyclically in (i, j] */
+    h = table[j].hash & mask;
+    if (i <= j ? (i < h && h <= j) : (i < h || h <= j)) continue;
+    table[i] = table[j];
+    i        = j;
   }
-  return s;
+  BTOR_CLR (table + i);
+
+  compact_keys_smt2 (parser);
 }
 
+static BtorSMT2Node *
+find_symbol_smt2 (BtorSMT2Parser *parser, const char *name)
+{
+  BtorSMT2Name *n;
+
+  parser->stats.lookups++;
+  n = get_name_smt2 (parser, name, false);
+  return n ? n->nodes : 0;
+}
+
+/* Add 'symbol' to the list of symbols of its scope level. */
 static void
-insert_symbol_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
+link_scope_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
 {
-  unsigned h;
-  BtorSMT2Node *p;
+  BtorSMT2Node **head;
+
+  assert (symbol->scope_level < BTOR_COUNT_STACK (parser->symbol.scopes));
+  head               = parser->symbol.scopes.start + symbol->scope_level;
+  symbol->scope_prev = 0;
+  symbol->scope_next = *head;
+  if (*head) (*head)->scope_prev = symbol;
+  *head = symbol;
+}
 
-  if (parser->symbol.size <= parser->symbol.count)
-    enlarge_symbol_table_smt2 (parser);
+static void
+unlink_scope_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
+{
+  assert (symbol->scope_level < BTOR_COUNT_STACK (parser->symbol.scopes));
+  if (symbol->scope_prev)
+    symbol->scope_prev->scope_next = symbol->scope_next;
+  else
+    parser->symbol.scopes.start[symbol->scope_level] = symbol->scope_next;
+  if (symbol->scope_next) symbol->scope_next->scope_prev = symbol->scope_prev;
+}
 
-  /* always add new symbol as first element to collision chain (required for
-   * scoping) */
-  h = hash_name_smt2 (parser, symbol->name);
-  p = parser->symbol.table[h];
+/* Remove 'symbol' from the list of symbols with the same name, and the name
+ * if it was its last symbol. */
+static void
+unlink_name_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
+{
+  BtorSMT2Node **p;
+  BtorSMT2Name *n;
 
-  parser->symbol.table[h] = symbol;
-  symbol->next            = p;
-  parser->symbol.count++;
-  assert (parser->symbol.count > 0);
+  n = get_name_smt2 (parser, symbol->name, false);
+  assert (n);
+  for (p = &n->nodes; *p != symbol; p = &(*p)->next) assert (*p);
+  *p = symbol->next;
+  if (!n->nodes) delete_name_smt2 (parser, n);
+}
+
+static void
+insert_symbol_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
+{
+  BtorSMT2Name *n;
+
+  /* always add new symbol as first element to list of symbols with the
+   * same name (required for scoping) */
+  n            = get_name_smt2 (parser, symbol->name, true);
+  symbol->next = n->nodes;
+  n->nodes     = symbol;
+  link_scope_smt2 (parser, symbol);
   BTOR_MSG (parser->btor->msg,
             2,
             "insert symbol '%s' at scope level %u",
@@ -652,7 +928,7 @@ static BtorSMT2Node *
 new_node_smt2 (BtorSMT2Parser *parser, BtorSMT2Tag tag)
 {
   BtorSMT2Node *res;
-  BTOR_CNEW (parser->mem, res);
+  res              = btor_mem_slab_alloc (parser->symbol.nodes);
   res->tag         = tag;
   res->scope_level = parser->scope_level;
   return res;
@@ -664,31 +940,21 @@ release_symbol_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
   assert (symbol->tag != BTOR_PARENT_TAG_SMT2);
   if (symbol->exp) boolector_release (parser->btor, symbol->exp);
   btor_mem_freestr (parser->mem, symbol->name);
-  BTOR_DELETE (parser->mem, symbol);
+  btor_mem_slab_free (parser->symbol.nodes, symbol);
 }
 
 static void
 remove_symbol_smt2 (BtorSMT2Parser *parser, BtorSMT2Node *symbol)
 {
-  BtorSMT2Node **p, *s;
-  unsigned h;
-
   BTOR_MSG (parser->btor->msg,
             2,
             "remove symbol '%s' at scope level %u",
             symbol->name,
             parser->scope_level);
 
-  h = hash_name_smt2 (parser, symbol->name);
-  for (p = parser->symbol.table + h;
-       (s = *p) && (strcmp (s->name, symbol->name) || s != symbol);
-       p = &s->next)
-    ;
-  assert (*p == symbol);
-  *p = symbol->next;
+  unlink_name_smt2 (parser, symbol);
+  unlink_scope_smt2 (parser, symbol);
   release_symbol_smt2 (parser, symbol);
-  assert (parser->symbol.count > 0);
-  parser->symbol.count--;
 }
 
 static void
@@ -697,9 +963,12 @@ release_symbols_smt2 (BtorSMT2Parser *parser)
   BtorSMT2Node *p, *next;
   uint32_t i;
   for (i = 0; i < parser->symbol.size; i++)
-    for (p = parser->symbol.table[i]; p; p = next)
+    for (p = parser->symbol.table[i].nodes; p; p = next)
       next = p->next, release_symbol_smt2 (parser, p);
   BTOR_DELETEN (parser->mem, parser->symbol.table, parser->symbol.size);
+  btor_mem_strarena_delete (parser->symbol.keys);
+  btor_mem_slab_delete (parser->symbol.nodes);
+  BTOR_RELEASE_STACK (parser->symbol.scopes);
 }
 
 static void
@@ -717,6 +986,7 @@ static void
 open_new_scope (BtorSMT2Parser *parser)
 {
   parser->scope_level++;
+  BTOR_PUSH_STACK (parser->symbol.scopes, 0);
 
   BTOR_MSG (parser->btor->msg,
             2,
@@ -728,24 +998,30 @@ static void
 close_current_scope (BtorSMT2Parser *parser)
 {
   double start;
-  uint32_t i;
   BtorSMT2Node *node, *next;
 
   start = btor_util_time_stamp ();
 
-  if (!parser->global_declarations)
+  assert (BTOR_COUNT_STACK (parser->symbol.scopes) == parser->scope_level + 1);
+  node = BTOR_POP_STACK (parser->symbol.scopes);
+  for (; node; node = next)
   {
-    /* delete symbols from current scope */
-    for (i = 0; i < parser->symbol.size; i++)
+    next = node->scope_next;
+    if (parser->global_declarations)
     {
-      node = parser->symbol.table[i];
-      while (node)
-      {
-        next = node->next;
-        if (node->scope_level == parser->scope_level)
-          remove_symbol_smt2 (parser, node);
-        node = next;
-      }
+      /* keep symbols, they now belong to the enclosing scope */
+      node->scope_level--;
+      link_scope_smt2 (parser, node);
+    }
+    else
+    {
+      BTOR_MSG (parser->btor->msg,
+                2,
+                "remove symbol '%s' at scope level %u",
+                node->name,
+                parser->scope_level);
+      unlink_name_smt2 (parser, node);
+      release_symbol_smt2 (parser, node);
     }
   }
 
@@ -1011,6 +1287,11 @@ new_smt2_parser (Btor *btor)
   BTOR_INIT_STACK (mem, res->token);
   BTOR_INIT_STACK (mem, res->tokens);
 
+  res->symbol.keys  = btor_mem_strarena_new (mem);
+  res->symbol.nodes = btor_mem_slab_new (mem, sizeof (BtorSMT2Node));
+  BTOR_INIT_STACK (mem, res->symbol.scopes);
+  BTOR_PUSH_STACK (res->symbol.scopes, 0);
+
   init_char_classes_smt2 (res);
 
   insert_keywords_smt2 (res);
@@ -1103,10 +1384,14 @@ pushch_smt2 (BtorSMT2Parser *parser, int32_t ch)
   storech_smt2 (parser, ch);
 }
 
+/* Read the next token from the input. Symbols and keywords are returned as
+ * BTOR_SYMBOL_TAG_SMT2 and BTOR_ATTRIBUTE_TAG_SMT2 and resolved via the symbol
+ * table by 'read_token_smt2', i.e., this does not depend on the state of the
+ * parser except for the input and can run on the reader thread of the input
+ * pipeline. */
 static int32_t
 read_token_aux_smt2 (BtorSMT2Parser *parser)
 {
-  BtorSMT2Node *node;
   unsigned char cc;
   int32_t ch;
   assert (!BTOR_INVALID_TAG_SMT2);  // error code:          0
@@ -1124,6 +1409,7 @@ RESTART:
   } while (isspace_smt2 (ch));
   if (ch == ';')
   {
+    skip_to_eol_smt2 (parser);
     while ((ch = nextch_smt2 (parser)) != '\n')
       if (ch == EOF)
       {
@@ -1229,14 +1515,6 @@ RESTART:
       if (ch == '|')
       {
         pushch_smt2 (parser, 0);
-        if (!(node = find_symbol_smt2 (parser, parser->token.start)))
-        {
-          node       = new_node_smt2 (parser, BTOR_SYMBOL_TAG_SMT2);
-          node->name = btor_mem_strdup (parser->mem, parser->token.start);
-          assert (!find_symbol_smt2 (parser, node->name));
-          insert_symbol_smt2 (parser, node);
-        }
-        parser->last_node = node;
         return BTOR_SYMBOL_TAG_SMT2;
       }
     }
@@ -1257,15 +1535,7 @@ RESTART:
     }
     savech_smt2 (parser, ch);
     pushch_smt2 (parser, 0);
-    if (!(node = find_symbol_smt2 (parser, parser->token.start)))
-    {
-      node       = new_node_smt2 (parser, BTOR_ATTRIBUTE_TAG_SMT2);
-      node->name = btor_mem_strdup (parser->mem, parser->token.start);
-      assert (!find_symbol_smt2 (parser, node->name));
-      insert_symbol_smt2 (parser, node);
-    }
-    parser->last_node = node;
-    return node->tag;
+    return BTOR_ATTRIBUTE_TAG_SMT2;
   }
   else if (ch == '0')
   {
@@ -1338,15 +1608,7 @@ RESTART:
     savech_smt2 (parser, ch);
     pushch_smt2 (parser, 0);
     if (!strcmp (parser->token.start, "_")) return BTOR_UNDERSCORE_TAG_SMT2;
-    if (!(node = find_symbol_smt2 (parser, parser->token.start)))
-    {
-      node       = new_node_smt2 (parser, BTOR_SYMBOL_TAG_SMT2);
-      node->name = btor_mem_strdup (parser->mem, parser->token.start);
-      assert (!find_symbol_smt2 (parser, node->name));
-      insert_symbol_smt2 (parser, node);
-    }
-    parser->last_node = node;
-    return node->tag;
+    return BTOR_SYMBOL_TAG_SMT2;
   }
   else
     return !cerr_smt2 (parser, "illegal", ch, 0);
@@ -1354,12 +1616,311 @@ RESTART:
   return !perr_smt2 (parser, "internal token reading error");
 }
 
+/* Resolve symbol or keyword token 'tag' as returned by 'read_token_aux_smt2'
+ * via the symbol table. */
+static int32_t
+find_token_symbol_smt2 (BtorSMT2Parser *parser, int32_t tag)
+{
+  BtorSMT2Node *node;
+
+  assert (tag == BTOR_SYMBOL_TAG_SMT2 || tag == BTOR_ATTRIBUTE_TAG_SMT2);
+
+  if (!(node = find_symbol_smt2 (parser, parser->token.start)))
+  {
+    node       = new_node_smt2 (parser, tag);
+    node->name = btor_mem_strdup (parser->mem, parser->token.start);
+    assert (!find_symbol_smt2 (parser, node->name));
+    insert_symbol_smt2 (parser, node);
+  }
+  parser->last_node = node;
+  /* quoted symbols are never reserved words, commands or keywords */
+  if (parser->token.start[0] == '|') return BTOR_SYMBOL_TAG_SMT2;
+  return node->tag;
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+#define BTOR_PIPELINE_SLOTS_SMT2 64
+#define BTOR_PIPELINE_CHUNK_SIZE_SMT2 (1 << 14)
+
+/* Input pipeline (option BTOR_OPT_PARSE_PIPELINE). A reader thread reads and
+ * tokenizes the input with its own lexer ('scanner') while the parser builds
+ * terms and solves, and hands the tokens over in chunks through a bounded ring
+ * of BTOR_PIPELINE_SLOTS_SMT2 slots. The parser only resolves symbols, which
+ * requires the symbol table. A chunk ends right after a complete top-level
+ * command (or after BTOR_PIPELINE_CHUNK_SIZE_SMT2 tokens), i.e., the parser
+ * can process a command as soon as it has been read completely. The last
+ * chunk ends with an end-of-file or error token.
+ *
+ * The scanner and the slots are only modified by the reader thread, which
+ * allocates from its own memory manager, until the pipeline is stopped.
+ */
+typedef struct BtorSMT2Token
+{
+  int32_t tag;     /* as returned by 'read_token_aux_smt2' */
+  BtorSMT2Coo coo; /* start of the token */
+  uint32_t text;   /* token (error message if invalid) in 'chars' */
+  uint32_t len;    /* number of characters of the token */
+} BtorSMT2Token;
+
+BTOR_DECLARE_STACK (BtorSMT2Token, BtorSMT2Token);
+
+typedef struct BtorSMT2Chunk
+{
+  BtorSMT2TokenStack tokens;
+  BtorCharStack chars;
+} BtorSMT2Chunk;
+
+typedef struct BtorSMT2Pipeline
+{
+  BtorMemMgr *mm;
+  BtorSMT2Parser *scanner;
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t produced, consumed;
+  BtorSMT2Chunk slots[BTOR_PIPELINE_SLOTS_SMT2];
+  uint32_t head;        /* first filled slot */
+  uint32_t count;       /* number of filled slots */
+  BtorSMT2Chunk *chunk; /* chunk read by the parser (slot 'head') */
+  size_t next;          /* next token in 'chunk' */
+  bool stop;
+} BtorSMT2Pipeline;
+
+static void *
+pipeline_scan_smt2 (void *state)
+{
+  BtorSMT2Pipeline *pl    = state;
+  BtorSMT2Parser *scanner = pl->scanner;
+  BtorSMT2Chunk *chunk;
+  BtorSMT2Token *token;
+  const char *text;
+  uint32_t depth, len;
+  bool flush, done, stop;
+  int32_t tag;
+
+  /* only allow cancellation while waiting for input */
+  pthread_setcancelstate (PTHREAD_CANCEL_DISABLE, 0);
+  depth = 0;
+  done  = false;
+  while (!done)
+  {
+    pthread_mutex_lock (&pl->mutex);
+    while (!pl->stop && pl->count == BTOR_PIPELINE_SLOTS_SMT2)
+      pthread_cond_wait (&pl->consumed, &pl->mutex);
+    stop  = pl->stop;
+    chunk = pl->slots + (pl->head + pl->count) % BTOR_PIPELINE_SLOTS_SMT2;
+    pthread_mutex_unlock (&pl->mutex);
+    if (stop) break;
+
+    BTOR_RESET_STACK (chunk->tokens);
+    BTOR_RESET_STACK (chunk->chars);
+    flush = false;
+    while (!flush
+           && BTOR_COUNT_STACK (chunk->tokens) < BTOR_PIPELINE_CHUNK_SIZE_SMT2)
+    {
+      /* no aggregate locals live while cancellable in 'getc', they would
+       * not be unpoisoned by the sanitizers when unwinding */
+      tag = read_token_aux_smt2 (scanner);
+      if (tag == BTOR_INVALID_TAG_SMT2)
+      {
+        text = scanner->error;
+        len  = strlen (text) + 1;
+      }
+      else
+      {
+        text = scanner->token.start;
+        len  = BTOR_COUNT_STACK (scanner->token);
+      }
+      if (BTOR_FULL_STACK (chunk->tokens)) BTOR_ENLARGE_STACK (chunk->tokens);
+      token       = chunk->tokens.top++;
+      token->tag  = tag;
+      token->coo  = scanner->coo;
+      token->text = BTOR_COUNT_STACK (chunk->chars);
+      token->len  = len;
+      for (uint32_t i = 0; i < len; i++)
+        BTOR_PUSH_STACK (chunk->chars, text[i]);
+
+      if (tag == BTOR_LPAR_TAG_SMT2)
+        depth++;
+      else if (tag == BTOR_RPAR_TAG_SMT2)
+      {
+        /* unbalanced parentheses are reported by the parser */
+        if (depth) depth--;
+        flush = !depth;
+      }
+      else if (tag == EOF || tag == BTOR_INVALID_TAG_SMT2)
+        flush = done = true;
+    }
+
+    pthread_mutex_lock (&pl->mutex);
+    pl->count++;
+    pthread_cond_signal (&pl->produced);
+    pthread_mutex_unlock (&pl->mutex);
+  }
+  return 0;
+}
+
+static void
+delete_pipeline_smt2 (BtorSMT2Parser *parser, BtorSMT2Pipeline *pl)
+{
+  BtorSMT2Parser *scanner = pl->scanner;
+  uint32_t i;
+
+  close_input_smt2 (scanner);
+  BTOR_RELEASE_STACK (scanner->token);
+  if (scanner->error) btor_mem_freestr (pl->mm, scanner->error);
+  BTOR_DELETE (pl->mm, scanner);
+  for (i = 0; i < BTOR_PIPELINE_SLOTS_SMT2; i++)
+  {
+    BTOR_RELEASE_STACK (pl->slots[i].tokens);
+    BTOR_RELEASE_STACK (pl->slots[i].chars);
+  }
+  pthread_cond_destroy (&pl->consumed);
+  pthread_cond_destroy (&pl->produced);
+  pthread_mutex_destroy (&pl->mutex);
+  btor_mem_mgr_delete (pl->mm);
+  BTOR_DELETE (parser->mem, pl);
+}
+
+static void
+start_pipeline_smt2 (BtorSMT2Parser *parser)
+{
+  BtorSMT2Pipeline *pl;
+  BtorSMT2Parser *scanner;
+  uint32_t i;
+
+  BTOR_CNEW (parser->mem, pl);
+  pl->mm = btor_mem_mgr_new ();
+  for (i = 0; i < BTOR_PIPELINE_SLOTS_SMT2; i++)
+  {
+    BTOR_INIT_STACK (pl->mm, pl->slots[i].tokens);
+    BTOR_INIT_STACK (pl->mm, pl->slots[i].chars);
+  }
+  pthread_mutex_init (&pl->mutex, 0);
+  pthread_cond_init (&pl->produced, 0);
+  pthread_cond_init (&pl->consumed, 0);
+
+  BTOR_CNEW (pl->mm, scanner);
+  scanner->mem         = pl->mm;
+  scanner->infile      = parser->infile;
+  scanner->infile_name = parser->infile_name;
+  scanner->prefix      = parser->prefix;
+  scanner->nextcoo     = parser->nextcoo;
+  scanner->scanning    = true;
+  memcpy (scanner->cc, parser->cc, sizeof (parser->cc));
+  BTOR_INIT_STACK (pl->mm, scanner->token);
+  open_input_smt2 (scanner);
+  pl->scanner = scanner;
+
+  if (pthread_create (&pl->thread, 0, pipeline_scan_smt2, pl))
+  {
+    delete_pipeline_smt2 (parser, pl);
+    BTOR_WARN (true,
+               "failed to start reader thread, option '%s' ignored",
+               btor_opt_get_lng (parser->btor, BTOR_OPT_PARSE_PIPELINE));
+    return;
+  }
+  parser->pipeline = pl;
+  BTOR_MSG (boolector_get_btor_msg (parser->btor),
+            1,
+            "reading and tokenizing '%s' in separate thread",
+            parser->infile_name);
+}
+
+/* Stop the reader thread (which may be blocked waiting for input if the
+ * parser did not read the input completely). 'infile' is left positioned
+ * after the last character read by the reader thread, which may have read
+ * ahead. */
+static void
+stop_pipeline_smt2 (BtorSMT2Parser *parser)
+{
+  BtorSMT2Pipeline *pl;
+
+  pl = parser->pipeline;
+  pthread_mutex_lock (&pl->mutex);
+  pl->stop = true;
+  pthread_cond_signal (&pl->consumed);
+  pthread_mutex_unlock (&pl->mutex);
+  pthread_cancel (pl->thread);
+  pthread_join (pl->thread, 0);
+  delete_pipeline_smt2 (parser, pl);
+  parser->pipeline = 0;
+}
+
+/* Release the chunk read so far and wait for the next one. */
+static void
+next_chunk_smt2 (BtorSMT2Pipeline *pl)
+{
+  pthread_mutex_lock (&pl->mutex);
+  if (pl->chunk)
+  {
+    pl->head = (pl->head + 1) % BTOR_PIPELINE_SLOTS_SMT2;
+    pl->count--;
+    pthread_cond_signal (&pl->consumed);
+  }
+  while (!pl->count) pthread_cond_wait (&pl->produced, &pl->mutex);
+  pl->chunk = pl->slots + pl->head;
+  pthread_mutex_unlock (&pl->mutex);
+  pl->next = 0;
+}
+
+/* Take the next token from the pipeline, the end-of-file and error tokens
+ * are returned on every further call. */
+static int32_t
+next_token_smt2 (BtorSMT2Parser *parser)
+{
+  BtorSMT2Pipeline *pl = parser->pipeline;
+  BtorSMT2Token *token;
+  const char *text;
+
+  BTOR_RESET_STACK (parser->token);
+  parser->last_node = 0;
+  if (!pl->chunk || pl->next == BTOR_COUNT_STACK (pl->chunk->tokens))
+    next_chunk_smt2 (pl);
+  token       = pl->chunk->tokens.start + pl->next;
+  text        = pl->chunk->chars.start + token->text;
+  parser->coo = token->coo;
+  if (token->tag == BTOR_INVALID_TAG_SMT2)
+  {
+    if (!parser->error) parser->error = btor_mem_strdup (parser->mem, text);
+    return BTOR_INVALID_TAG_SMT2;
+  }
+  if (token->tag == EOF) return EOF;
+  pl->next++;
+  for (uint32_t i = 0; i < token->len; i++) pushch_smt2 (parser, text[i]);
+  return token->tag;
+}
+
+#else
+
+static void
+start_pipeline_smt2 (BtorSMT2Parser *parser)
+{
+  BTOR_WARN (true,
+             "no thread support, option '%s' ignored",
+             btor_opt_get_lng (parser->btor, BTOR_OPT_PARSE_PIPELINE));
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 static int32_t
 read_token_smt2 (BtorSMT2Parser *parser)
 {
   int32_t res;
   parser->lastcoo = parser->coo;
-  res             = read_token_aux_smt2 (parser);
+#ifdef BTOR_HAVE_PTHREADS
+  if (parser->pipeline)
+    res = next_token_smt2 (parser);
+  else
+#endif
+    res = read_token_aux_smt2 (parser);
+  if (res == BTOR_SYMBOL_TAG_SMT2 || res == BTOR_ATTRIBUTE_TAG_SMT2)
+    res = find_token_symbol_smt2 (parser, res);
+  parser->stats.tokens++;
   if (boolector_get_opt (parser->btor, BTOR_OPT_VERBOSITY) >= 4)
   {
     printf ("[btorsmt2] line %-8d column %-4d token %08x %s\n",
@@ -4943,9 +5504,18 @@ parse_smt2_parser (BtorSMT2Parser *parser,
   BTOR_CLR (res);
   parser->res = res;
 
+  if (boolector_get_opt (parser->btor, BTOR_OPT_PARSE_PIPELINE))
+    start_pipeline_smt2 (parser);
+  if (!parser->pipeline) open_input_smt2 (parser);
   while (read_command_smt2 (parser) && !parser->done
          && !boolector_terminate (parser->btor))
     ;
+#ifdef BTOR_HAVE_PTHREADS
+  if (parser->pipeline)
+    stop_pipeline_smt2 (parser);
+  else
+#endif
+    close_input_smt2 (parser);
 
   if (parser->error) return parser->error;
 
@@ -4987,6 +5557,21 @@ parse_smt2_parser (BtorSMT2Parser *parser,
             "parsed %d commands in %.2f seconds",
             parser->commands.all,
             delta);
+  if (delta > 0)
+    BTOR_MSG (boolector_get_btor_msg (parser->btor),
+              1,
+              "read %lld tokens (%.0f per second) and looked up %lld symbols "
+              "(%.0f per second)",
+              parser->stats.tokens,
+              parser->stats.tokens / delta,
+              parser->stats.lookups,
+              parser->stats.lookups / delta);
+  else
+    BTOR_MSG (boolector_get_btor_msg (parser->btor),
+              1,
+              "read %lld tokens and looked up %lld symbols",
+              parser->stats.tokens,
+              parser->stats.lookups);
 
   if (parser->need_functions && parser->need_arrays
       && parser->res->logic == BTOR_LOGIC_QF_BV)
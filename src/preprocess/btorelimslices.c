@@ -103,7 +103,8 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
   BtorNode *var, *cur, *result, *lambda_var, *temp;
   BtorSortId sort;
   BtorSlice *s1, *s2, *new_s1, *new_s2, *new_s3, **sorted_slices;
-  BtorPtrHashBucket *b_var, *b1, *b2;
+  BtorPtrHashBucket *b_var;
+  BtorPtrHashTableIterator it1, it2;
   BtorNodeIterator it;
   BtorPtrHashTable *slices;
   int32_t i;
@@ -122,10 +123,12 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
 
   mm = btor->mm;
   BTOR_INIT_STACK (mm, vars);
-  for (b_var = btor->bv_vars->first; b_var != NULL; b_var = b_var->next)
+  btor_iter_hashptr_init (&it1, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it1))
   {
+    b_var = it1.bucket;
+    var   = btor_iter_hashptr_next (&it1);
     if (b_var->data.flag) continue;
-    var = (BtorNode *) b_var->key;
     BTOR_PUSH_STACK (vars, var);
     /* mark as processed, required for non-destructive substiution */
     b_var->data.flag = true;
@@ -180,12 +183,14 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
     btor_hashptr_table_add (slices, s1);
 
   BTOR_SPLIT_SLICES_RESTART:
-    for (b1 = slices->last; b1 != NULL; b1 = b1->prev)
+    btor_iter_hashptr_init_reversed (&it1, slices);
+    while (btor_iter_hashptr_has_next (&it1))
     {
-      s1 = (BtorSlice *) b1->key;
-      for (b2 = b1->prev; b2 != NULL; b2 = b2->prev)
+      s1  = btor_iter_hashptr_next (&it1);
+      it2 = it1;
+      while (btor_iter_hashptr_has_next (&it2))
       {
-        s2 = (BtorSlice *) b2->key;
+        s2 = btor_iter_hashptr_next (&it2);
 
         assert (compare_slices (s1, s2));
 
@@ -274,9 +279,10 @@ btor_eliminate_slices_on_bv_vars (Btor *btor)
     assert (slices->count > 1u);
     BTOR_NEWN (mm, sorted_slices, slices->count);
     i = 0;
-    for (b1 = slices->first; b1 != NULL; b1 = b1->next)
+    btor_iter_hashptr_init (&it1, slices);
+    while (btor_iter_hashptr_has_next (&it1))
     {
-      s1                 = (BtorSlice *) b1->key;
+      s1                 = btor_iter_hashptr_next (&it1);
       sorted_slices[i++] = s1;
     }
     qsort (sorted_slices,
@@ -127,7 +127,7 @@ btor_merge_lambdas (Btor *btor)
     }
 
     /* found top lambda */
-    parent = btor_node_real_addr (lambda->first_parent);
+    parent = btor_node_real_addr (btor_node_get_first_parent (btor, lambda));
     if (lambda->parents > 1
         || lambda->parents == 0
         /* case lambda->parents == 1 */
@@ -29,7 +29,7 @@ is_uc_write (BtorNode *cond)
 
   if (cond->parents != 1) return false;
 
-  lambda = btor_node_real_addr (cond->first_parent);
+  lambda = btor_node_real_addr (btor_node_get_first_parent (cond->btor, cond));
   if (!btor_node_is_lambda (lambda)) return false;
 
   return btor_node_lambda_get_static_rho (lambda) != 0;
@@ -126,7 +126,7 @@ btor_optimize_unconstrained (Btor *btor)
 
     if (cur->parents == 1)
     {
-      cur_parent = btor_node_real_addr (cur->first_parent);
+      cur_parent = btor_node_real_addr (btor_node_get_first_parent (btor, cur));
       btor_hashint_table_add (ucs, cur->id);
       BTORLOG (2, "found uc input %s", btor_util_node2string (cur));
       // TODO (ma): why not just collect ufs and vars?
@@ -251,8 +251,9 @@ btor_optimize_unconstrained (Btor *btor)
             assert (cur->parents <= 1);
             if (ucp[1]
                 /* only consider head lambda of curried lambdas */
-                && (!cur->first_parent
-                    || !btor_node_is_lambda (cur->first_parent)))
+                && (!btor_node_get_first_parent (btor, cur)
+                    || !btor_node_is_lambda (
+                        btor_node_get_first_parent (btor, cur))))
               mark_uc (btor, ucs, cur);
             break;
           default: break;
@@ -228,7 +228,7 @@ btor_substitute_var_exps (Btor *btor)
      * and empty the global substitution table */
     while (varsubst_constraints->count > 0u)
     {
-      b   = varsubst_constraints->first;
+      b   = btor_hashptr_table_first (varsubst_constraints);
       cur = (BtorNode *) b->key;
       right = (BtorNode *) b->data.as_ptr;
       simp  = btor_node_get_simplified (btor, cur);
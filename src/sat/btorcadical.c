@@ -82,6 +82,13 @@ sat (BtorSATMgr *smgr, int32_t limit)
   return ccadical_sat (smgr->solver);
 }
 
+static void
+diversify (BtorSATMgr *smgr, uint32_t seed)
+{
+  ccadical_set_option (smgr->solver, "seed", seed);
+  ccadical_set_option (smgr->solver, "phase", seed % 2 == 0);
+}
+
 static void
 setterm (BtorSATMgr *smgr)
 {
@@ -139,6 +146,7 @@ btor_sat_enable_cadical (BtorSATMgr *smgr)
   smgr->api.set_prefix       = 0;
   smgr->api.stats            = 0;
   smgr->api.setterm          = setterm;
+  smgr->api.diversify        = diversify;
 
   if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_CADICAL_FREEZE))
   {
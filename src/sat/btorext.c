@@ -0,0 +1,401 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "sat/btorext.h"
+#include "btorabort.h"
+
+#ifndef _WIN32
+#define BTOR_HAVE_EXTERNAL_SAT
+#endif
+
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_HAVE_EXTERNAL_SAT
+/*------------------------------------------------------------------------*/
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "btorcore.h"
+#include "dumper/btordumpcnf.h"
+
+typedef struct BtorExtSAT BtorExtSAT;
+
+struct BtorExtSAT
+{
+  pid_t pid;
+  FILE *to;              /* stdin of the solver */
+  FILE *from;            /* stdout of the solver */
+  BtorCnfWriter *writer; /* writes iCNF to 'to' */
+  BtorIntStack assumptions;
+  int8_t *vals;   /* assignment of the last satisfiable call */
+  int8_t *failed; /* failed assumptions of the last unsatisfiable call */
+  size_t size;    /* number of elements of 'vals' and 'failed' */
+  uint32_t calls;
+};
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+#define BTOR_EXT_SIGMASK pthread_sigmask
+#else
+#define BTOR_EXT_SIGMASK sigprocmask
+#endif
+
+/* A solver that terminates early would kill us with SIGPIPE on the next
+ * write. SIGPIPE is blocked in the calling thread while writing to the solver
+ * and a SIGPIPE raised by these writes is discarded, such that the error is
+ * detected when reading the answer of the solver instead. Returns true if
+ * SIGPIPE was already pending before. */
+static bool
+block_sigpipe (sigset_t *old)
+{
+  sigset_t set;
+
+  sigemptyset (&set);
+  sigaddset (&set, SIGPIPE);
+  BTOR_EXT_SIGMASK (SIG_BLOCK, &set, old);
+  return !sigpending (&set) && sigismember (&set, SIGPIPE);
+}
+
+static void
+unblock_sigpipe (sigset_t *old, bool pending)
+{
+  sigset_t set;
+  int sig;
+
+  if (!pending && !sigpending (&set) && sigismember (&set, SIGPIPE))
+  {
+    sigemptyset (&set);
+    sigaddset (&set, SIGPIPE);
+    (void) sigwait (&set, &sig);
+  }
+  BTOR_EXT_SIGMASK (SIG_SETMASK, old, 0);
+}
+
+/* Writes the buffer of the CNF writer to the solver, 'to' is unbuffered, i.e.,
+ * this is the only place where we write to the pipe. */
+static size_t
+write_to_solver (void *state, const char *buf, size_t n)
+{
+  BtorExtSAT *ext = state;
+  sigset_t mask;
+  bool pending;
+  size_t res;
+
+  pending = block_sigpipe (&mask);
+  res     = fwrite (buf, 1, n, ext->to);
+  unblock_sigpipe (&mask, pending);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+next_char (BtorExtSAT *ext)
+{
+  int32_t ch = getc (ext->from);
+  BTOR_ABORT (ch == EOF, "external SAT solver terminated unexpectedly");
+  return ch;
+}
+
+static void
+skip_line (BtorExtSAT *ext)
+{
+  while (next_char (ext) != '\n')
+    ;
+}
+
+/* Skip comments and empty lines and return the first character of the next
+ * line, which must be 'type'. */
+static void
+next_line (BtorExtSAT *ext, int32_t type)
+{
+  int32_t ch;
+
+  for (;;)
+  {
+    ch = next_char (ext);
+    if (ch == 'c')
+      skip_line (ext);
+    else if (ch != '\n' && ch != '\r')
+      break;
+  }
+  BTOR_ABORT (ch != type,
+              "expected '%c' line from external SAT solver but got '%c'",
+              type,
+              ch);
+}
+
+/* Read the literals of 'type' lines up to the terminating 0 and store their
+ * signs in 'marks'. */
+static void
+read_lits (BtorExtSAT *ext, int32_t type, int8_t *marks)
+{
+  int32_t ch, sign, var;
+
+  next_line (ext, type);
+  for (;;)
+  {
+    ch = next_char (ext);
+    if (ch == ' ' || ch == '\t' || ch == '\r') continue;
+    if (ch == '\n')
+    {
+      next_line (ext, type);
+      continue;
+    }
+    sign = 1;
+    if (ch == '-')
+    {
+      sign = -1;
+      ch   = next_char (ext);
+    }
+    BTOR_ABORT (ch < '0' || ch > '9',
+                "invalid literal in '%c' line of external SAT solver",
+                type);
+    for (var = 0; ch >= '0' && ch <= '9'; ch = next_char (ext))
+    {
+      BTOR_ABORT (var > (INT32_MAX - 9) / 10,
+                  "literal too large in '%c' line of external SAT solver",
+                  type);
+      var = 10 * var + (ch - '0');
+    }
+    if (!var)
+    {
+      if (ch != '\n') skip_line (ext);
+      return;
+    }
+    /* ignore solver internal variables */
+    if ((size_t) var < ext->size) marks[var] = sign;
+    if (ch == '\n') next_line (ext, type);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static void *
+init (BtorSATMgr *smgr)
+{
+  Btor *btor      = smgr->btor;
+  const char *cmd = btor->ext_sat_cmd;
+  BtorExtSAT *res;
+  int in[2], out[2];
+  pid_t pid;
+
+  BTOR_ABORT (!cmd,
+              "no external SAT solver set, "
+              "use 'boolector_set_external_sat_solver' or BTORSATCMD");
+  BTOR_ABORT (pipe (in), "failed to create pipe to external SAT solver");
+  BTOR_ABORT (pipe (out), "failed to create pipe from external SAT solver");
+  fflush (stdout);
+  fflush (stderr);
+  pid = fork ();
+  BTOR_ABORT (pid < 0, "failed to start external SAT solver '%s'", cmd);
+  if (!pid)
+  {
+    dup2 (in[0], STDIN_FILENO);
+    dup2 (out[1], STDOUT_FILENO);
+    close (in[0]);
+    close (in[1]);
+    close (out[0]);
+    close (out[1]);
+    execl ("/bin/sh", "sh", "-c", cmd, (char *) 0);
+    _exit (127);
+  }
+  close (in[0]);
+  close (out[1]);
+  /* do not leak our ends into other solver processes */
+  fcntl (in[1], F_SETFD, FD_CLOEXEC);
+  fcntl (out[0], F_SETFD, FD_CLOEXEC);
+
+  BTOR_CNEW (btor->mm, res);
+  res->pid  = pid;
+  res->to   = fdopen (in[1], "w");
+  res->from = fdopen (out[0], "r");
+  BTOR_ABORT (!res->to || !res->from,
+              "failed to open pipes of external SAT solver");
+  setvbuf (res->to, 0, _IONBF, 0);
+  res->writer              = btor_dumpcnf_new (btor->mm, res->to, true, false);
+  res->writer->write.fun   = write_to_solver;
+  res->writer->write.state = res;
+  BTOR_INIT_STACK (btor->mm, res->assumptions);
+
+  BTOR_MSG (btor->msg,
+            1,
+            "started external SAT solver '%s' (pid %d)",
+            cmd,
+            (int) pid);
+  return res;
+}
+
+static void
+add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorExtSAT *ext = smgr->solver;
+  btor_dumpcnf_add (ext->writer, lit);
+}
+
+static void
+assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorExtSAT *ext = smgr->solver;
+  BTOR_PUSH_STACK (ext->assumptions, lit);
+}
+
+static int32_t
+sat (BtorSATMgr *smgr, int32_t limit)
+{
+  (void) limit;
+
+  BtorExtSAT *ext = smgr->solver;
+  BtorMemMgr *mm  = smgr->btor->mm;
+  char status[32];
+  size_t n;
+  int32_t ch, res;
+
+  BTOR_ABORT (!btor_dumpcnf_query (ext->writer,
+                                   ext->assumptions.start,
+                                   BTOR_COUNT_STACK (ext->assumptions)),
+              "failed to write to external SAT solver");
+  BTOR_RESET_STACK (ext->assumptions);
+  ext->calls += 1;
+
+  if (ext->size <= (size_t) smgr->maxvar)
+  {
+    if (ext->vals) BTOR_DELETEN (mm, ext->vals, ext->size);
+    if (ext->failed) BTOR_DELETEN (mm, ext->failed, ext->size);
+    ext->size = 2 * (size_t) smgr->maxvar + 1;
+    BTOR_NEWN (mm, ext->vals, ext->size);
+    BTOR_NEWN (mm, ext->failed, ext->size);
+  }
+  BTOR_CLRN (ext->vals, ext->size);
+  BTOR_CLRN (ext->failed, ext->size);
+
+  next_line (ext, 's');
+  n = 0;
+  while ((ch = next_char (ext)) != '\n')
+    if (ch != ' ' && ch != '\r' && n + 1 < sizeof (status)) status[n++] = ch;
+  status[n] = 0;
+
+  if (!strcmp (status, "SATISFIABLE"))
+  {
+    res = 10;
+    read_lits (ext, 'v', ext->vals);
+  }
+  else if (!strcmp (status, "UNSATISFIABLE"))
+  {
+    res = 20;
+    read_lits (ext, 'f', ext->failed);
+  }
+  else
+  {
+    BTOR_ABORT (strcmp (status, "UNKNOWN"),
+                "invalid status line 's %s' of external SAT solver",
+                status);
+    res = 0;
+  }
+  return res;
+}
+
+static int32_t
+deref (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorExtSAT *ext = smgr->solver;
+  int32_t res;
+
+  if ((size_t) abs (lit) >= ext->size) return 0;
+  res = ext->vals[abs (lit)];
+  return lit < 0 ? -res : res;
+}
+
+static int32_t
+failed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorExtSAT *ext = smgr->solver;
+
+  if ((size_t) abs (lit) >= ext->size) return 0;
+  return ext->failed[abs (lit)] == (lit < 0 ? -1 : 1);
+}
+
+static void
+reset (BtorSATMgr *smgr)
+{
+  BtorExtSAT *ext = smgr->solver;
+  BtorMemMgr *mm  = smgr->btor->mm;
+  int status;
+
+  /* closing stdin of the solver terminates it, clauses added after the last
+   * query are not needed, i.e., write errors can be ignored */
+  btor_dumpcnf_delete (ext->writer);
+  fclose (ext->to);
+  fclose (ext->from);
+  while (waitpid (ext->pid, &status, 0) < 0 && errno == EINTR)
+    ;
+  BTOR_RELEASE_STACK (ext->assumptions);
+  if (ext->vals) BTOR_DELETEN (mm, ext->vals, ext->size);
+  if (ext->failed) BTOR_DELETEN (mm, ext->failed, ext->size);
+  BTOR_DELETE (mm, ext);
+  smgr->solver = 0;
+}
+
+static void
+stats (BtorSATMgr *smgr)
+{
+  BtorExtSAT *ext = smgr->solver;
+  BTOR_MSG (smgr->btor->msg,
+            1,
+            "%u calls to external SAT solver, %lld clauses sent",
+            ext->calls,
+            (long long) ext->writer->clauses);
+}
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_external (BtorSATMgr *smgr)
+{
+  assert (smgr != NULL);
+
+  BTOR_ABORT (smgr->initialized,
+              "'btor_sat_init' called before 'btor_sat_enable_external'");
+
+  smgr->name = "External";
+
+  BTOR_CLR (&smgr->api);
+  smgr->api.add    = add;
+  smgr->api.assume = assume;
+  smgr->api.deref  = deref;
+  smgr->api.failed = failed;
+  smgr->api.init   = init;
+  smgr->api.reset  = reset;
+  smgr->api.sat    = sat;
+  smgr->api.stats  = stats;
+  return true;
+}
+
+/*------------------------------------------------------------------------*/
+#else
+/*------------------------------------------------------------------------*/
+
+bool
+btor_sat_enable_external (BtorSATMgr *smgr)
+{
+  (void) smgr;
+  BTOR_ABORT (true, "external SAT solvers are not supported on this platform");
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
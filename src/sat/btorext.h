@@ -0,0 +1,34 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSATEXT_H_INCLUDED
+#define BTORSATEXT_H_INCLUDED
+
+#include "btorsat.h"
+
+/* External SAT solver process.
+ *
+ * The solver is started as '/bin/sh -c <cmd>' with the command set via
+ * 'boolector_set_external_sat_solver' and gets the CNF in iCNF format on its
+ * stdin, i.e., 'p inccnf' followed by the clauses, where every SAT call is
+ * sent as 'a <assumptions> 0' line. For every such line, the solver must
+ * answer on its stdout with
+ *
+ *   s SATISFIABLE     followed by 'v' lines with the model terminated by 0,
+ *   s UNSATISFIABLE   followed by 'f' lines with the failed assumptions
+ *                     terminated by 0, or
+ *   s UNKNOWN.
+ *
+ * Lines starting with 'c' are ignored. The solver has to terminate when its
+ * stdin is closed. Limits and termination callbacks are not supported, hence
+ * the external solver is not used in a portfolio or for cube-and-conquer.
+ * SIGPIPE is blocked while writing to the solver such that a solver that
+ * terminates early is reported as error. Not available on Windows. */
+bool btor_sat_enable_external (BtorSATMgr *smgr);
+
+#endif
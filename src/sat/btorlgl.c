@@ -295,6 +295,32 @@ setterm (BtorSATMgr *smgr)
   lglseterm (blgl->lgl, smgr->term.fun, smgr->term.state);
 }
 
+static void
+diversify (BtorSATMgr *smgr, uint32_t seed)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetopt (blgl->lgl, "seed", seed);
+  lglsetopt (blgl->lgl, "phase", (int32_t) (seed % 3) - 1);
+}
+
+static void
+export_clauses (BtorSATMgr *smgr,
+                void (*fun) (void *, int32_t *, int32_t),
+                void *state)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetproducecls (blgl->lgl, fun, state);
+}
+
+static void
+import_clauses (BtorSATMgr *smgr,
+                void (*fun) (void *, int32_t **, int32_t *),
+                void *state)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetconsumecls (blgl->lgl, fun, state);
+}
+
 /*------------------------------------------------------------------------*/
 
 bool
@@ -326,6 +352,9 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
   smgr->api.stats            = stats;
   smgr->api.clone            = clone;
   smgr->api.setterm          = setterm;
+  smgr->api.diversify        = diversify;
+  smgr->api.export_clauses   = export_clauses;
+  smgr->api.import_clauses   = import_clauses;
   return true;
 }
 
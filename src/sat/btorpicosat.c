@@ -94,6 +94,14 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return picosat_deref_toplevel (smgr->solver, lit);
 }
 
+static void
+diversify (BtorSATMgr *smgr, uint32_t seed)
+{
+  /* cycle through default phases true, Jeroslow-Wang, random, false */
+  picosat_set_global_default_phase (smgr->solver, seed % 4);
+  picosat_set_seed (smgr->solver, seed);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -136,6 +144,7 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
   smgr->api.set_output       = set_output;
   smgr->api.set_prefix       = set_prefix;
   smgr->api.stats            = stats;
+  smgr->api.diversify        = diversify;
   return true;
 }
 /*------------------------------------------------------------------------*/
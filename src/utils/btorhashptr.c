@@ -20,35 +20,117 @@ btor_compare_ptr (const void *p, const void *q)
   return ((uintptr_t) p) != ((uintptr_t) q);
 }
 
+/* Marks removed buckets. */
+static const char btor_removed_ptr_hash_key;
+#define BTOR_PTR_HASH_REMOVED ((void *) &btor_removed_ptr_hash_key)
+
+#define BTOR_PTR_HASH_TABLE_INIT_SIZE 4
+
+/* Compute the hash value of 'key', mixed such that the lower bits used for
+ * indexing depend on all bits of the (user provided) hash value. Mixing is a
+ * bijection, hence collisions are not increased. */
+static uint32_t
+btor_hash_key_ptr_hash_table (const BtorPtrHashTable *p2iht, const void *key)
+{
+  uint32_t h;
+  h = p2iht->hash (key);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+static void
+btor_insert_into_ptr_hash_table_index (BtorPtrHashTable *p2iht,
+                                       uint32_t pos,
+                                       uint32_t hash)
+{
+  uint32_t i, mask;
+
+  mask = p2iht->size - 1;
+  for (i = hash & mask; p2iht->table[i].pos; i = (i + 1) & mask)
+    ;
+  p2iht->table[i].pos  = pos + 1;
+  p2iht->table[i].hash = hash;
+}
+
+/* Double the size of the index table (keeps the load factor <= 1/2). */
 static void
 btor_enlarge_ptr_hash_table (BtorPtrHashTable *p2iht)
 {
-  BtorPtrHashBucket *p, *chain, **old_table, **new_table;
-  uint32_t old_size, new_size, i, h;
-  BtorHashPtr hash;
+  BtorPtrHashSlot *old_table;
+  uint32_t old_size, i;
 
   old_size  = p2iht->size;
   old_table = p2iht->table;
 
-  new_size = old_size ? 2 * old_size : 1;
-  BTOR_CNEWN (p2iht->mm, new_table, new_size);
-
-  hash = p2iht->hash;
+  p2iht->size = old_size ? 2 * old_size : BTOR_PTR_HASH_TABLE_INIT_SIZE;
+  BTOR_CNEWN (p2iht->mm, p2iht->table, p2iht->size);
 
   for (i = 0; i < old_size; i++)
-    for (p = old_table[i]; p; p = chain)
+  {
+    if (!old_table[i].pos) continue;
+    btor_insert_into_ptr_hash_table_index (
+        p2iht, old_table[i].pos - 1, old_table[i].hash);
+  }
+
+  BTOR_DELETEN (p2iht->mm, old_table, old_size);
+}
+
+/* Make room for a new bucket. If at least half of the buckets are removed,
+ * the bucket array is compacted (which preserves the chronological order),
+ * and doubled in size otherwise. */
+static void
+btor_enlarge_ptr_hash_table_buckets (BtorPtrHashTable *p2iht)
+{
+  uint32_t i, j, new_max;
+  BtorPtrHashBucket *b;
+
+  assert (p2iht->num_buckets == p2iht->max_buckets);
+
+  if (2 * p2iht->count <= p2iht->num_buckets && p2iht->num_buckets > 0)
+  {
+    BTOR_CLRN (p2iht->table, p2iht->size);
+    for (i = p2iht->first_pos, j = 0; i < p2iht->num_buckets; i++)
     {
-      chain = p->chain;
-      h     = hash (p->key);
-      h &= new_size - 1;
-      p->chain     = new_table[h];
-      new_table[h] = p;
+      b = p2iht->buckets + i;
+      if (b->key == BTOR_PTR_HASH_REMOVED) continue;
+      p2iht->buckets[j] = *b;
+      btor_insert_into_ptr_hash_table_index (
+          p2iht, j++, btor_hash_key_ptr_hash_table (p2iht, b->key));
     }
+    assert (j == p2iht->count);
+    p2iht->first_pos       = 0;
+    p2iht->num_buckets = j;
+  }
+  else
+  {
+    new_max = p2iht->max_buckets ? 2 * p2iht->max_buckets : 1;
+    BTOR_REALLOC (p2iht->mm, p2iht->buckets, p2iht->max_buckets, new_max);
+    p2iht->max_buckets = new_max;
+  }
+}
 
-  BTOR_DELETEN (p2iht->mm, old_table, old_size);
+/* Find the index table slot of 'key', returns 'size' if 'key' is not in the
+ * table. */
+static uint32_t
+btor_find_in_ptr_hash_table (BtorPtrHashTable *p2iht,
+                             const void *key,
+                             uint32_t hash)
+{
+  uint32_t i, mask;
+  BtorPtrHashSlot *slot;
 
-  p2iht->size  = new_size;
-  p2iht->table = new_table;
+  mask = p2iht->size - 1;
+  for (i = hash & mask; (slot = p2iht->table + i)->pos; i = (i + 1) & mask)
+  {
+    if (slot->hash == hash
+        && !p2iht->cmp (p2iht->buckets[slot->pos - 1].key, key))
+      return i;
+  }
+  return p2iht->size;
 }
 
 BtorPtrHashTable *
@@ -89,6 +171,8 @@ btor_hashptr_table_clone (BtorMemMgr *mm,
   res = btor_hashptr_table_new (mm, table->hash, table->cmp);
   while (res->size < table->size) btor_enlarge_ptr_hash_table (res);
   assert (res->size == table->size);
+  BTOR_NEWN (mm, res->buckets, table->max_buckets);
+  res->max_buckets = table->max_buckets;
 
   btor_iter_hashptr_init (&it, table);
   while (btor_iter_hashptr_has_next (&it))
@@ -113,14 +197,7 @@ btor_hashptr_table_clone (BtorMemMgr *mm,
 void
 btor_hashptr_table_delete (BtorPtrHashTable *p2iht)
 {
-  BtorPtrHashBucket *p, *next;
-
-  for (p = p2iht->first; p; p = next)
-  {
-    next = p->next;
-    BTOR_DELETE (p2iht->mm, p);
-  }
-
+  BTOR_DELETEN (p2iht->mm, p2iht->buckets, p2iht->max_buckets);
   BTOR_DELETEN (p2iht->mm, p2iht->table, p2iht->size);
   BTOR_DELETE (p2iht->mm, p2iht);
 }
@@ -128,69 +205,55 @@ btor_hashptr_table_delete (BtorPtrHashTable *p2iht)
 BtorPtrHashBucket *
 btor_hashptr_table_get (BtorPtrHashTable *p2iht, const void *key)
 {
-  BtorPtrHashBucket *res, **p, *b;
-  uint32_t i, h;
+  uint32_t i;
 
   assert (p2iht->size > 0);
 
-  res = 0;
-  h   = p2iht->hash (key);
-  h &= p2iht->size - 1;
-
-  for (i = 0, p = p2iht->table + h; i < p2iht->count; i++, p = &b->chain)
-  {
-    if (!(b = *p)) break;
-    if (!p2iht->cmp (b->key, key))
-    {
-      res = b;
-      break;
-    }
-  }
-
-  return res;
+  if (!p2iht->count) return 0;
+  i = btor_find_in_ptr_hash_table (
+      p2iht, key, btor_hash_key_ptr_hash_table (p2iht, key));
+  if (i == p2iht->size) return 0;
+  return p2iht->buckets + p2iht->table[i].pos - 1;
 }
 
-static BtorPtrHashBucket **
-btor_findpos_in_ptr_hash_table_pos (BtorPtrHashTable *p2iht, void *key)
+BtorPtrHashBucket *
+btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key)
 {
-  BtorPtrHashBucket **p, *b;
-  uint32_t h;
+  BtorPtrHashBucket *res;
+  uint32_t hash;
 
-  if (p2iht->count == p2iht->size) btor_enlarge_ptr_hash_table (p2iht);
+  assert (key);
+  assert (key != BTOR_PTR_HASH_REMOVED);
 
-  assert (p2iht->size > 0);
+  hash = btor_hash_key_ptr_hash_table (p2iht, key);
+  assert (btor_find_in_ptr_hash_table (p2iht, key, hash) == p2iht->size);
 
-  h = p2iht->hash (key);
-  h &= p2iht->size - 1;
+  if (2 * (p2iht->count + 1) > p2iht->size) btor_enlarge_ptr_hash_table (p2iht);
+  if (p2iht->num_buckets == p2iht->max_buckets)
+    btor_enlarge_ptr_hash_table_buckets (p2iht);
 
-  for (p = p2iht->table + h; (b = *p) && p2iht->cmp (b->key, key);
-       p = &b->chain)
-    ;
+  btor_insert_into_ptr_hash_table_index (p2iht, p2iht->num_buckets, hash);
+  res = p2iht->buckets + p2iht->num_buckets++;
+  BTOR_CLR (res);
+  res->key = key;
+  p2iht->count++;
+#ifndef NDEBUG
+  p2iht->num_adds++;
+#endif
 
-  return p;
+  return res;
 }
 
 BtorPtrHashBucket *
-btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key)
+btor_hashptr_table_first (BtorPtrHashTable *p2iht)
 {
-  BtorPtrHashBucket **p, *res;
-  p = btor_findpos_in_ptr_hash_table_pos (p2iht, key);
-  assert (!*p);
-  BTOR_CNEW (p2iht->mm, res);
-  res->key = key;
-  *p       = res;
-  p2iht->count++;
-
-  res->prev = p2iht->last;
-
-  if (p2iht->first)
-    p2iht->last->next = res;
-  else
-    p2iht->first = res;
-
-  p2iht->last = res;
+  return p2iht->count ? p2iht->buckets + p2iht->first_pos : 0;
+}
 
-  return res;
+BtorPtrHashBucket *
+btor_hashptr_table_last (BtorPtrHashTable *p2iht)
+{
+  return p2iht->count ? p2iht->buckets + p2iht->num_buckets - 1 : 0;
 }
 
 /*
@@ -218,23 +281,27 @@ btor_hashptr_table_remove (BtorPtrHashTable *table,
                            void **stored_key_ptr,
                            BtorHashTableData *stored_data_ptr)
 {
-  BtorPtrHashBucket **p, *bucket;
-
-  p      = btor_findpos_in_ptr_hash_table_pos (table, key);
-  bucket = *p;
-
-  assert (bucket);
-  *p = bucket->chain;
-
-  if (bucket->prev)
-    bucket->prev->next = bucket->next;
-  else
-    table->first = bucket->next;
-
-  if (bucket->next)
-    bucket->next->prev = bucket->prev;
-  else
-    table->last = bucket->prev;
+  BtorPtrHashBucket *bucket;
+  uint32_t i, j, mask, pos;
+
+  i = btor_find_in_ptr_hash_table (
+      table, key, btor_hash_key_ptr_hash_table (table, key));
+  assert (i < table->size);
+  pos    = table->table[i].pos - 1;
+  bucket = table->buckets + pos;
+
+  /* backward shift deletion */
+  mask = table->size - 1;
+  for (j = (i + 1) & mask; table->table[j].pos; j = (j + 1) & mask)
+  {
+    /* move slot 'j' to the gap at 'i' if 'i' lies on its probe sequence */
+    if (((j - (table->table[j].hash & mask)) & mask) >= ((j - i) & mask))
+    {
+      table->table[i] = table->table[j];
+      i               = j;
+    }
+  }
+  table->table[i].pos = 0;
 
   assert (table->count > 0);
   table->count--;
@@ -243,25 +310,74 @@ btor_hashptr_table_remove (BtorPtrHashTable *table,
 
   if (stored_data_ptr) *stored_data_ptr = bucket->data;
 
-  BTOR_DELETE (table->mm, bucket);
+  bucket->key = BTOR_PTR_HASH_REMOVED;
+
+  while (table->num_buckets > 0
+         && table->buckets[table->num_buckets - 1].key == BTOR_PTR_HASH_REMOVED)
+    table->num_buckets--;
+  while (table->first_pos < table->num_buckets
+         && table->buckets[table->first_pos].key == BTOR_PTR_HASH_REMOVED)
+    table->first_pos++;
+  if (table->first_pos >= table->num_buckets) table->first_pos = 0;
 }
 
 /*------------------------------------------------------------------------*/
 /* iterators     		                                          */
 /*------------------------------------------------------------------------*/
 
+/* Find the next (previous if 'reversed') bucket starting at position 'idx'
+ * of table 'it->stack[it->pos]' and continue with the queued tables if there
+ * is none. */
+static void
+btor_iter_hashptr_find (BtorPtrHashTableIterator *it, int64_t idx)
+{
+  const BtorPtrHashTable *t;
+
+  it->bucket = 0;
+  while (it->pos < it->num_queued)
+  {
+    t = it->stack[it->pos];
+    if (it->reversed)
+    {
+      for (; idx >= (int64_t) t->first_pos; idx--)
+        if (t->buckets[idx].key != BTOR_PTR_HASH_REMOVED) break;
+      if (idx >= (int64_t) t->first_pos && t->count) break;
+    }
+    else
+    {
+      for (; idx < t->num_buckets; idx++)
+        if (t->buckets[idx].key != BTOR_PTR_HASH_REMOVED) break;
+      if (idx < t->num_buckets) break;
+    }
+    it->pos += 1;
+    if (it->pos < it->num_queued)
+    {
+      t   = it->stack[it->pos];
+      idx = it->reversed ? (int64_t) t->num_buckets - 1 : t->first_pos;
+    }
+  }
+  if (it->pos < it->num_queued)
+  {
+    it->idx    = (uint32_t) idx;
+    it->bucket = it->stack[it->pos]->buckets + idx;
+  }
+  it->cur = it->bucket ? it->bucket->key : 0;
+}
+
 void
 btor_iter_hashptr_init (BtorPtrHashTableIterator *it, const BtorPtrHashTable *t)
 {
   assert (it);
   assert (t);
 
-  it->bucket                  = t->first;
-  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->reversed                = false;
   it->num_queued              = 0;
   it->pos                     = 0;
+#ifndef NDEBUG
+  it->num_adds[it->num_queued] = t->num_adds;
+#endif
   it->stack[it->num_queued++] = t;
+  btor_iter_hashptr_find (it, t->first_pos);
 }
 
 void
@@ -271,12 +387,14 @@ btor_iter_hashptr_init_reversed (BtorPtrHashTableIterator *it,
   assert (it);
   assert (t);
 
-  it->bucket                  = t->last;
-  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->reversed                = true;
   it->num_queued              = 0;
   it->pos                     = 0;
+#ifndef NDEBUG
+  it->num_adds[it->num_queued] = t->num_adds;
+#endif
   it->stack[it->num_queued++] = t;
+  btor_iter_hashptr_find (it, (int64_t) t->num_buckets - 1);
 }
 
 void
@@ -287,14 +405,14 @@ btor_iter_hashptr_queue (BtorPtrHashTableIterator *it,
   assert (t);
   assert (it->num_queued < BTOR_PTR_HASH_TABLE_ITERATOR_STACK_SIZE);
 
-  /* if initial table is empty, initialize with queued table */
-  if (!it->bucket)
-  {
-    it->bucket = it->reversed ? t->last : t->first;
-    it->cur    = it->bucket ? it->bucket->key : 0;
-    it->pos += 1;
-  }
+#ifndef NDEBUG
+  it->num_adds[it->num_queued] = t->num_adds;
+#endif
   it->stack[it->num_queued++] = t;
+  /* if all previous tables are empty, continue with queued table */
+  if (!it->bucket)
+    btor_iter_hashptr_find (
+        it, it->reversed ? (int64_t) t->num_buckets - 1 : t->first_pos);
 }
 
 bool
@@ -310,21 +428,13 @@ btor_iter_hashptr_next (BtorPtrHashTableIterator *it)
   assert (it);
   assert (it->bucket);
   assert (it->cur);
+  /* keys must not be added while iterating */
+  assert (it->stack[it->pos]->num_adds == it->num_adds[it->pos]);
 
   void *res;
   res = it->cur;
-  if (it->bucket)
-    it->bucket = it->reversed ? it->bucket->prev : it->bucket->next;
-
-  while (!it->bucket)
-  {
-    it->pos += 1;
-    if (it->pos >= it->num_queued) break;
-    it->bucket =
-        it->reversed ? it->stack[it->pos]->last : it->stack[it->pos]->first;
-  }
-
-  it->cur = it->bucket ? it->bucket->key : 0;
+  btor_iter_hashptr_find (it,
+                          it->reversed ? (int64_t) it->idx - 1 : it->idx + 1);
   return res;
 }
 
@@ -337,7 +447,7 @@ btor_iter_hashptr_next_data (BtorPtrHashTableIterator *it)
 
   void *res;
 
-  res = &it->bucket->data;
+  res = &it->stack[it->pos]->buckets[it->idx].data;
   btor_iter_hashptr_next (it);
   return res;
 }
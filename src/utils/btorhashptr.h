@@ -31,33 +31,46 @@ typedef void (*BtorCloneDataPtr) (BtorMemMgr *mm,
 
 struct BtorPtrHashBucket
 {
-  /* public:
-   */
   void *key;
-
   BtorHashTableData data;
+};
 
-  BtorPtrHashBucket *next; /* chronologically */
-  BtorPtrHashBucket *prev; /* chronologically */
+typedef struct BtorPtrHashSlot BtorPtrHashSlot;
 
-  /* private:
-   */
-  BtorPtrHashBucket *chain; /* collision chain */
+struct BtorPtrHashSlot
+{
+  uint32_t pos;  /* position of bucket + 1, 0 if slot is empty */
+  uint32_t hash; /* full hash value of bucket key */
 };
 
+/* Hash table with open addressing (linear probing). Buckets are stored in
+ * chronological order in the dense array 'buckets', slots of the index table
+ * 'table' refer to buckets by position. Removed buckets are only marked as
+ * removed and reclaimed when the bucket array is full.
+ *
+ * Note: Adding a key may move buckets, i.e., pointers to buckets obtained via
+ *       btor_hashptr_table_get/add are invalidated by subsequent calls to
+ *       btor_hashptr_table_add on the same table.  For the same reason, keys
+ *       must not be added to a table while iterating over it, iterators may
+ *       skip or revisit buckets afterwards (checked in debug builds). */
 struct BtorPtrHashTable
 {
   BtorMemMgr *mm;
 
-  uint32_t size;
-  uint32_t count;
-  BtorPtrHashBucket **table;
+  uint32_t size;  /* size of 'table' (power of 2) */
+  uint32_t count; /* number of keys */
+  BtorPtrHashSlot *table;
+
+  BtorPtrHashBucket *buckets; /* chronologically */
+  uint32_t first_pos;         /* position of first bucket */
+  uint32_t num_buckets;       /* number of used positions in 'buckets' */
+  uint32_t max_buckets;       /* number of allocated positions in 'buckets' */
 
   BtorHashPtr hash;
   BtorCmpPtr cmp;
-
-  BtorPtrHashBucket *first; /* chronologically */
-  BtorPtrHashBucket *last;  /* chronologically */
+#ifndef NDEBUG
+  uint32_t num_adds; /* detects adding while iterating */
+#endif
 };
 
 /*------------------------------------------------------------------------*/
@@ -87,15 +100,18 @@ BtorPtrHashBucket *btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key);
 /* Remove from hash table the bucket with the key.  The key has to be an
  * element of the hash table.  If 'stored_data_ptr' is non zero, then data
  * to which the given key was mapped is copied to this location.   The same
- * applies to 'stored_key_ptr'.  If you traverse/iterate a hash table
- * through the chronological chains, then you can remove elements while
- * traversing the hash table.
+ * applies to 'stored_key_ptr'.  If you iterate a hash table, then you can
+ * remove elements that were already visited while traversing the hash table.
  */
 void btor_hashptr_table_remove (BtorPtrHashTable *,
                                 void *key,
                                 void **stored_key_ptr,
                                 BtorHashTableData *stored_data_ptr);
 
+/* Get the chronologically first (last) bucket, 0 if the table is empty. */
+BtorPtrHashBucket *btor_hashptr_table_first (BtorPtrHashTable *p2iht);
+BtorPtrHashBucket *btor_hashptr_table_last (BtorPtrHashTable *p2iht);
+
 uint32_t btor_hash_str (const void *str);
 
 #define btor_compare_str ((BtorCmpPtr) strcmp)
@@ -109,11 +125,15 @@ uint32_t btor_hash_str (const void *str);
 typedef struct BtorPtrHashTableIterator
 {
   BtorPtrHashBucket *bucket;
+  uint32_t idx; /* position of 'bucket' */
   void *cur;
   bool reversed;
   uint8_t num_queued;
   uint8_t pos;
   const BtorPtrHashTable *stack[BTOR_PTR_HASH_TABLE_ITERATOR_STACK_SIZE];
+#ifndef NDEBUG
+  uint32_t num_adds[BTOR_PTR_HASH_TABLE_ITERATOR_STACK_SIZE];
+#endif
 } BtorPtrHashTableIterator;
 
 void btor_iter_hashptr_init (BtorPtrHashTableIterator *it,
@@ -24,13 +24,38 @@
     if (mm->maxallocated < mm->allocated) mm->maxallocated = mm->allocated; \
   } while (0)
 
-#define SAT_ADJUST()                              \
+/* The SAT solver instances of a portfolio allocate concurrently. */
+#ifdef BTOR_HAVE_PTHREADS
+#define SAT_ADD(size)                                                      \
+  do                                                                       \
+  {                                                                        \
+    size_t cur, max;                                                       \
+    cur = __atomic_add_fetch (&mm->sat_allocated, size, __ATOMIC_RELAXED); \
+    max = __atomic_load_n (&mm->sat_maxallocated, __ATOMIC_RELAXED);       \
+    while (max < cur                                                       \
+           && !__atomic_compare_exchange_n (&mm->sat_maxallocated,         \
+                                            &max,                          \
+                                            cur,                           \
+                                            true,                          \
+                                            __ATOMIC_RELAXED,              \
+                                            __ATOMIC_RELAXED))             \
+      ;                                                                    \
+  } while (0)
+
+#define SAT_SUB(size) \
+  __atomic_sub_fetch (&mm->sat_allocated, size, __ATOMIC_RELAXED)
+#else
+#define SAT_ADD(size)                             \
   do                                              \
   {                                               \
+    mm->sat_allocated += size;                    \
     if (mm->sat_maxallocated < mm->sat_allocated) \
       mm->sat_maxallocated = mm->sat_allocated;   \
   } while (0)
 
+#define SAT_SUB(size) (mm->sat_allocated -= size)
+#endif
+
 /*------------------------------------------------------------------------*/
 /* This enables logging of all memory allocations.
  */
@@ -85,8 +110,7 @@ btor_mem_sat_malloc (BtorMemMgr *mm, size_t size)
   assert (mm);
   result = malloc (size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_sat_malloc'");
-  mm->sat_allocated += size;
-  SAT_ADJUST ();
+  SAT_ADD (size);
   return result;
 }
 
@@ -116,9 +140,8 @@ btor_mem_sat_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
   assert (mm->sat_allocated >= old_size);
   result = realloc (p, new_size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_sat_realloc'");
-  mm->sat_allocated -= old_size;
-  mm->sat_allocated += new_size;
-  SAT_ADJUST ();
+  SAT_SUB (old_size);
+  SAT_ADD (new_size);
   return result;
 }
 
@@ -151,7 +174,7 @@ void
 btor_mem_sat_free (BtorMemMgr *mm, void *p, size_t freed)
 {
   assert (mm);
-  if (p) mm->sat_allocated -= freed;
+  if (p) SAT_SUB (freed);
   free (p);
 }
 
@@ -185,6 +208,183 @@ btor_mem_mgr_delete (BtorMemMgr *mm)
   free (mm);
 }
 
+/*------------------------------------------------------------------------*/
+
+#define BTOR_MEM_SLAB_MIN_CHUNK_SIZE 64
+#define BTOR_MEM_SLAB_MAX_CHUNK_SIZE 16384
+
+/* Every chunk starts with a header that links it to the previously
+ * allocated chunk and records its size for deallocation. */
+struct BtorMemSlabChunk
+{
+  struct BtorMemSlabChunk *next;
+  size_t bytes;
+};
+
+typedef struct BtorMemSlabChunk BtorMemSlabChunk;
+
+BtorMemSlab *
+btor_mem_slab_new (BtorMemMgr *mm, size_t size)
+{
+  assert (mm);
+  assert (size > 0);
+
+  BtorMemSlab *slab;
+
+  BTOR_CNEW (mm, slab);
+  slab->mm = mm;
+  /* objects must be able to hold the free list link and keep pointer
+   * alignment */
+  if (size < sizeof (void *)) size = sizeof (void *);
+  slab->size       = (size + sizeof (void *) - 1) & ~(sizeof (void *) - 1);
+  slab->chunk_size = BTOR_MEM_SLAB_MIN_CHUNK_SIZE;
+  return slab;
+}
+
+void
+btor_mem_slab_delete (BtorMemSlab *slab)
+{
+  assert (slab);
+
+  BtorMemSlabChunk *chunk, *next;
+  BtorMemMgr *mm;
+
+  mm = slab->mm;
+  for (chunk = slab->chunks; chunk; chunk = next)
+  {
+    next = chunk->next;
+    assert (slab->allocated >= chunk->bytes);
+    slab->allocated -= chunk->bytes;
+    btor_mem_free (mm, chunk, chunk->bytes);
+  }
+  assert (!slab->allocated);
+  BTOR_DELETE (mm, slab);
+}
+
+static void
+new_slab_chunk (BtorMemSlab *slab)
+{
+  BtorMemSlabChunk *chunk;
+  size_t bytes;
+
+  bytes = sizeof (BtorMemSlabChunk) + slab->chunk_size * slab->size;
+  chunk = btor_mem_malloc (slab->mm, bytes);
+
+  chunk->next  = slab->chunks;
+  chunk->bytes = bytes;
+  slab->chunks = chunk;
+  slab->top    = (char *) chunk + sizeof (BtorMemSlabChunk);
+  slab->end    = (char *) chunk + bytes;
+
+  slab->allocated += bytes;
+  if (slab->chunk_size < BTOR_MEM_SLAB_MAX_CHUNK_SIZE) slab->chunk_size *= 2;
+}
+
+void *
+btor_mem_slab_alloc (BtorMemSlab *slab)
+{
+  assert (slab);
+
+  void *res;
+
+  if (slab->free_list)
+  {
+    res             = slab->free_list;
+    slab->free_list = *(void **) res;
+  }
+  else
+  {
+    if (slab->top == slab->end) new_slab_chunk (slab);
+    assert (slab->top + slab->size <= slab->end);
+    res = slab->top;
+    slab->top += slab->size;
+  }
+  memset (res, 0, slab->size);
+  slab->num_objects++;
+  return res;
+}
+
+void
+btor_mem_slab_free (BtorMemSlab *slab, void *p)
+{
+  assert (slab);
+  assert (p);
+  assert (slab->num_objects > 0);
+
+  *(void **) p    = slab->free_list;
+  slab->free_list = p;
+  slab->num_objects--;
+}
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_MEM_STRARENA_CHUNK_SIZE 65536
+
+BtorMemStrArena *
+btor_mem_strarena_new (BtorMemMgr *mm)
+{
+  assert (mm);
+
+  BtorMemStrArena *arena;
+
+  BTOR_CNEW (mm, arena);
+  arena->mm = mm;
+  return arena;
+}
+
+void
+btor_mem_strarena_delete (BtorMemStrArena *arena)
+{
+  assert (arena);
+
+  BtorMemSlabChunk *chunk, *next;
+  BtorMemMgr *mm;
+
+  mm = arena->mm;
+  for (chunk = arena->chunks; chunk; chunk = next)
+  {
+    next = chunk->next;
+    assert (arena->allocated >= chunk->bytes);
+    arena->allocated -= chunk->bytes;
+    btor_mem_free (mm, chunk, chunk->bytes);
+  }
+  assert (!arena->allocated);
+  BTOR_DELETE (mm, arena);
+}
+
+char *
+btor_mem_strarena_add (BtorMemStrArena *arena, const char *str, size_t len)
+{
+  assert (arena);
+  assert (str || !len);
+
+  BtorMemSlabChunk *chunk;
+  size_t bytes;
+  char *res;
+
+  if ((size_t) (arena->end - arena->top) < len + 1)
+  {
+    bytes = sizeof (BtorMemSlabChunk) + len + 1;
+    if (bytes < BTOR_MEM_STRARENA_CHUNK_SIZE)
+      bytes = BTOR_MEM_STRARENA_CHUNK_SIZE;
+    chunk = btor_mem_malloc (arena->mm, bytes);
+
+    chunk->next   = arena->chunks;
+    chunk->bytes  = bytes;
+    arena->chunks = chunk;
+    arena->top    = (char *) chunk + sizeof (BtorMemSlabChunk);
+    arena->end    = (char *) chunk + bytes;
+    arena->allocated += bytes;
+  }
+  res = arena->top;
+  memcpy (res, str, len);
+  res[len] = 0;
+  arena->top += len + 1;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 size_t
 btor_mem_parse_error_msg_length (const char *name, const char *fmt, va_list ap)
 {
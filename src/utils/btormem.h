@@ -77,6 +77,42 @@ typedef struct BtorMemMgr BtorMemMgr;
 
 /*------------------------------------------------------------------------*/
 
+/* Fixed-size object allocator. Objects are carved out of larger chunks that
+ * are allocated via the memory manager (and thus accounted for in
+ * 'allocated'). Released objects are kept in a free list for reuse, chunks
+ * are only freed when the slab is deleted.
+ */
+struct BtorMemSlab
+{
+  BtorMemMgr *mm;
+  size_t size;          /* object size in bytes */
+  uint32_t chunk_size;  /* number of objects in the next chunk */
+  void *chunks;         /* list of allocated chunks */
+  void *free_list;      /* list of released objects */
+  char *top;            /* next unused object in the current chunk */
+  char *end;            /* end of current chunk */
+  size_t allocated;     /* bytes allocated for chunks */
+  size_t num_objects;   /* number of objects currently in use */
+};
+
+typedef struct BtorMemSlab BtorMemSlab;
+
+/* Append-only string storage. Strings are copied into larger chunks, which
+ * are only freed when the arena is deleted.
+ */
+struct BtorMemStrArena
+{
+  BtorMemMgr *mm;
+  void *chunks;     /* list of allocated chunks */
+  char *top;        /* next unused character in the current chunk */
+  char *end;        /* end of current chunk */
+  size_t allocated; /* bytes allocated for chunks */
+};
+
+typedef struct BtorMemStrArena BtorMemStrArena;
+
+/*------------------------------------------------------------------------*/
+
 BtorMemMgr *btor_mem_mgr_new (void);
 
 void btor_mem_mgr_delete (BtorMemMgr *mm);
@@ -99,6 +135,25 @@ char *btor_mem_strdup (BtorMemMgr *mm, const char *str);
 
 void btor_mem_freestr (BtorMemMgr *mm, char *str);
 
+BtorMemSlab *btor_mem_slab_new (BtorMemMgr *mm, size_t size);
+
+void btor_mem_slab_delete (BtorMemSlab *slab);
+
+/* Get zero-initialized object of size 'slab->size'. */
+void *btor_mem_slab_alloc (BtorMemSlab *slab);
+
+void btor_mem_slab_free (BtorMemSlab *slab, void *p);
+
+BtorMemStrArena *btor_mem_strarena_new (BtorMemMgr *mm);
+
+void btor_mem_strarena_delete (BtorMemStrArena *arena);
+
+/* Copy the first 'len' characters of 'str' into the arena and terminate the
+ * copy with '\0'. */
+char *btor_mem_strarena_add (BtorMemStrArena *arena,
+                             const char *str,
+                             size_t len);
+
 size_t btor_mem_parse_error_msg_length (const char *name,
                                         const char *fmt,
                                         va_list ap);
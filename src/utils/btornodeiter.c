@@ -17,7 +17,8 @@ btor_iter_apply_parent_init (BtorNodeIterator *it, const BtorNode *exp)
 {
   assert (it);
   assert (exp);
-  it->cur = btor_node_real_addr (btor_node_real_addr (exp)->last_parent);
+  it->cur = btor_node_real_addr (
+      btor_node_get_last_parent (btor_node_real_addr (exp)->btor, exp));
 }
 
 bool
@@ -36,7 +37,8 @@ btor_iter_apply_parent_next (BtorNodeIterator *it)
   assert (it);
   result = it->cur;
   assert (result);
-  it->cur = btor_node_real_addr (BTOR_PREV_PARENT (result));
+  it->cur = btor_node_real_addr (
+      btor_node_get_prev_parent (result->btor, result));
   assert (btor_node_is_regular (result));
   assert (btor_node_is_apply (result));
   return result;
@@ -49,7 +51,7 @@ btor_iter_parent_init (BtorNodeIterator *it, const BtorNode *exp)
 {
   assert (it);
   assert (exp);
-  it->cur = btor_node_real_addr (exp)->first_parent;
+  it->cur = btor_node_get_first_parent (btor_node_real_addr (exp)->btor, exp);
 }
 
 bool
@@ -67,7 +69,8 @@ btor_iter_parent_next (BtorNodeIterator *it)
   BtorNode *result;
   result = it->cur;
   assert (result);
-  it->cur = BTOR_NEXT_PARENT (result);
+  it->cur = btor_node_get_next_parent (btor_node_real_addr (result)->btor,
+                                       result);
 
   return btor_node_real_addr (result);
 }
@@ -212,7 +215,7 @@ static void
 find_next_unique_node (BtorNodeIterator * it)
 {
   while (!it->cur && it->pos < it->btor->nodes_unique_table.size)
-    it->cur = it->btor->nodes_unique_table.chains[it->pos++];
+    it->cur = it->btor->nodes_unique_table.slots[it->pos++];
   assert (it->cur
 	  || it->num_elements == it->btor->nodes_unique_table.num_elements);
 }
@@ -254,9 +257,8 @@ btor_iter_unique_table_next (BtorNodeIterator * it)
   assert (it->num_elements <= it->btor->nodes_unique_table.num_elements);
   assert (result);
 #endif
-  it->cur = it->cur->next;
-  if (!it->cur)
-    find_next_unique_node (it);
+  it->cur = 0;
+  find_next_unique_node (it);
   return result;
 }
 #endif
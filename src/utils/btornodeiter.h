@@ -25,12 +25,6 @@ typedef struct BtorNodeIterator
   BtorNode *cur;
 } BtorNodeIterator;
 
-#define BTOR_NEXT_PARENT(exp) \
-  (btor_node_real_addr (exp)->next_parent[btor_node_get_tag (exp)])
-
-#define BTOR_PREV_PARENT(exp) \
-  (btor_node_real_addr (exp)->prev_parent[btor_node_get_tag (exp)])
-
 void btor_iter_apply_parent_init (BtorNodeIterator *it, const BtorNode *exp);
 bool btor_iter_apply_parent_has_next (const BtorNodeIterator *it);
 BtorNode *btor_iter_apply_parent_next (BtorNodeIterator *it);
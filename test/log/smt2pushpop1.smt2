@@ -0,0 +1,15 @@
+(set-logic QF_BV)
+(declare-const x (_ BitVec 4))
+(push 1)
+(declare-const y (_ BitVec 4))
+(assert (= x (let ((y #b0001)) y)))
+(assert (= y #b0010))
+(check-sat)
+(pop 1)
+(push 1)
+(declare-const y (_ BitVec 4))
+(assert (distinct x y))
+(assert (= x y))
+(check-sat)
+(pop 1)
+(check-sat)
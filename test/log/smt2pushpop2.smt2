@@ -0,0 +1,13 @@
+(set-option :global-declarations true)
+(set-logic QF_BV)
+(push 1)
+(declare-const y (_ BitVec 4))
+(push 1)
+(declare-const z (_ BitVec 4))
+(pop 2)
+(push 1)
+(pop 1)
+(assert (= y (bvadd z #b0001)))
+(check-sat)
+(assert (= y z))
+(check-sat)
@@ -7,8 +7,14 @@
  */
 #include "test.h"
 
+#include <unordered_map>
+#include <vector>
+
 extern "C" {
 #include "btoraig.h"
+#include "btoraigfraig.h"
+#include "btoraigrw.h"
+#include "btoraigsim.h"
 #include "dumper/btordumpaig.h"
 }
 
@@ -35,6 +41,56 @@ class TestAig : public TestBtor
     btor_aig_release (amgr, aig5);
     btor_aig_mgr_delete (amgr);
   }
+
+  /* truth table of 'aig' over (at most 6) variables 'vars' */
+  uint64_t truth_table (BtorAIGMgr *amgr,
+                        BtorAIG *aig,
+                        BtorAIG **vars,
+                        uint32_t num_vars)
+  {
+    static const uint64_t var_tt[6] = {0xaaaaaaaaaaaaaaaaull,
+                                       0xccccccccccccccccull,
+                                       0xf0f0f0f0f0f0f0f0ull,
+                                       0xff00ff00ff00ff00ull,
+                                       0xffff0000ffff0000ull,
+                                       0xffffffff00000000ull};
+    std::unordered_map<int32_t, uint64_t> cache;
+    std::vector<BtorAIG *> visit;
+    BtorAIG *cur, *l, *r;
+    uint32_t i;
+
+    if (btor_aig_is_const (aig)) return aig == BTOR_AIG_TRUE ? ~0ull : 0;
+
+    for (i = 0; i < num_vars; i++) cache[vars[i]->id] = var_tt[i];
+    visit.push_back (BTOR_REAL_ADDR_AIG (aig));
+    while (!visit.empty ())
+    {
+      cur = visit.back ();
+      if (cache.find (cur->id) != cache.end ())
+      {
+        visit.pop_back ();
+        continue;
+      }
+      assert (btor_aig_is_and (cur));
+      l = BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (amgr, cur));
+      r = BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (amgr, cur));
+      if (cache.find (l->id) == cache.end ())
+        visit.push_back (l);
+      else if (cache.find (r->id) == cache.end ())
+        visit.push_back (r);
+      else
+      {
+        cache[cur->id] =
+            (btor_aig_get_left_child_id (amgr, cur) < 0 ? ~cache[l->id]
+                                                        : cache[l->id])
+            & (btor_aig_get_right_child_id (amgr, cur) < 0 ? ~cache[r->id]
+                                                           : cache[r->id]);
+        visit.pop_back ();
+      }
+    }
+    return BTOR_IS_INVERTED_AIG (aig) ? ~cache[BTOR_REAL_ADDR_AIG (aig)->id]
+                                      : cache[aig->id];
+  }
 };
 
 TEST_F (TestAig, new_delete_aig_mgr)
@@ -143,3 +199,334 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, aig_to_sat_polarity)
+{
+  btor_opt_set (d_btor, BTOR_OPT_AIG_POLARITY, 1);
+
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorAIG *var1    = btor_aig_var (amgr);
+  BtorAIG *var2    = btor_aig_var (amgr);
+  BtorAIG *var3    = btor_aig_var (amgr);
+  BtorAIG *var4    = btor_aig_var (amgr);
+  BtorAIG *and1    = btor_aig_and (amgr, var1, var2);
+  BtorAIG *and2    = btor_aig_and (amgr, var3, var4);
+  BtorAIG *and3    = btor_aig_or (amgr, and1, and2);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+
+  /* and3 is only required to be true */
+  btor_aig_to_sat (amgr, and3);
+  ASSERT_EQ (amgr->num_cnf_clauses, 5u);
+  ASSERT_EQ (BTOR_REAL_ADDR_AIG (and3)->encoded, BTOR_AIG_ENC_NEG);
+  ASSERT_EQ (and1->encoded, BTOR_AIG_ENC_POS);
+  ASSERT_EQ (and2->encoded, BTOR_AIG_ENC_POS);
+
+  /* assignments of partially encoded AIGs are computed from their inputs */
+  btor_sat_add (smgr, btor_aig_get_cnf_id (and3));
+  btor_sat_add (smgr, 0);
+  btor_sat_add (smgr, -btor_aig_get_cnf_id (var1));
+  btor_sat_add (smgr, 0);
+  ASSERT_EQ (btor_sat_check_sat (smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and1), -1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and2), 1);
+  ASSERT_EQ (btor_aig_get_assignment (amgr, and3), 1);
+
+  /* upgrade to full encoding */
+  btor_aig_to_sat_tseitin (amgr, and3);
+  ASSERT_EQ (amgr->num_cnf_clauses, 9u);
+  ASSERT_EQ (BTOR_REAL_ADDR_AIG (and3)->encoded, BTOR_AIG_ENC_FULL);
+  ASSERT_EQ (and1->encoded, BTOR_AIG_ENC_FULL);
+  ASSERT_EQ (and2->encoded, BTOR_AIG_ENC_FULL);
+
+  btor_sat_reset (smgr);
+  btor_aig_release (amgr, var1);
+  btor_aig_release (amgr, var2);
+  btor_aig_release (amgr, var3);
+  btor_aig_release (amgr, var4);
+  btor_aig_release (amgr, and1);
+  btor_aig_release (amgr, and2);
+  btor_aig_release (amgr, and3);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, unique_table)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *vars[64], *ands[64 * 63];
+  uint32_t i, j, n;
+
+  for (i = 0; i < 64; i++) vars[i] = btor_aig_var (amgr);
+
+  /* enough ANDs to enlarge the unique table and the id tables several
+   * times */
+  for (i = 0, n = 0; i < 64; i++)
+    for (j = 0; j < 64; j++)
+    {
+      if (i == j) continue;
+      ands[n] = btor_aig_and (amgr, vars[i], BTOR_INVERT_AIG (vars[j]));
+      ASSERT_TRUE (btor_aig_is_and (ands[n]));
+      BtorAIG *l = btor_aig_get_left_child (amgr, ands[n]);
+      BtorAIG *r = btor_aig_get_right_child (amgr, ands[n]);
+      ASSERT_TRUE ((l == vars[i] && r == BTOR_INVERT_AIG (vars[j]))
+                   || (r == vars[i] && l == BTOR_INVERT_AIG (vars[j])));
+      n++;
+    }
+  ASSERT_EQ (amgr->cur_num_aigs, n);
+
+  for (i = 0, n = 0; i < 64; i++)
+    for (j = 0; j < 64; j++)
+    {
+      if (i == j) continue;
+      BtorAIG *aig = btor_aig_and (amgr, BTOR_INVERT_AIG (vars[j]), vars[i]);
+      ASSERT_EQ (aig, ands[n]);
+      btor_aig_release (amgr, aig);
+      n++;
+    }
+  ASSERT_EQ (amgr->cur_num_aigs, n);
+
+  for (i = 0; i < n; i++) btor_aig_release (amgr, ands[i]);
+  ASSERT_EQ (amgr->cur_num_aigs, 0u);
+  ASSERT_EQ (amgr->table.num_elements, 0u);
+  for (i = 0; i < 64; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, rewrite)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *a, *b, *c, *ab, *ac, *aig, *vars[3];
+  uint64_t tt;
+
+  a  = btor_aig_var (amgr);
+  b  = btor_aig_var (amgr);
+  c  = btor_aig_var (amgr);
+  ab = btor_aig_and (amgr, a, b);
+  ac = btor_aig_and (amgr, a, c);
+  /* (a & b) | (a & c) needs 3 ANDs, a & (b | c) only 2 */
+  aig     = btor_aig_or (amgr, ab, ac);
+  vars[0] = a;
+  vars[1] = b;
+  vars[2] = c;
+  tt      = truth_table (amgr, aig, vars, 3);
+  btor_aig_release (amgr, ab);
+  btor_aig_release (amgr, ac);
+  ASSERT_EQ (amgr->cur_num_aigs, 3u);
+
+  btor_aigrw_rewrite (amgr, &aig, 1);
+  ASSERT_EQ (amgr->cur_num_aigs, 2u);
+  ASSERT_EQ (amgr->num_rw_saved_ands, 1u);
+  ASSERT_EQ (truth_table (amgr, aig, vars, 3), tt);
+
+  btor_aig_release (amgr, aig);
+  ASSERT_EQ (amgr->cur_num_aigs, 0u);
+  btor_aig_release (amgr, a);
+  btor_aig_release (amgr, b);
+  btor_aig_release (amgr, c);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, rewrite_random)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *vars[6], *nodes[6 + 200], *roots[16];
+  uint64_t tts[16];
+  uint32_t i, j, n, rnd, num_aigs;
+
+  rnd = 42;
+  for (j = 0; j < 20; j++)
+  {
+    for (i = 0; i < 6; i++)
+    {
+      vars[i]  = btor_aig_var (amgr);
+      nodes[i] = btor_aig_copy (amgr, vars[i]);
+    }
+    for (n = 6; n < 6 + 200; n++)
+    {
+      BtorAIG *l, *r;
+      rnd = rnd * 1664525u + 1013904223u;
+      l   = nodes[(rnd >> 8) % n];
+      if (rnd & 1) l = BTOR_INVERT_AIG (l);
+      rnd = rnd * 1664525u + 1013904223u;
+      r   = nodes[(rnd >> 8) % n];
+      if (rnd & 1) r = BTOR_INVERT_AIG (r);
+      nodes[n] = btor_aig_and (amgr, l, r);
+    }
+    for (i = 0; i < 16; i++)
+    {
+      roots[i] = btor_aig_copy (amgr, nodes[6 + 200 - 1 - 3 * i]);
+      tts[i]   = truth_table (amgr, roots[i], vars, 6);
+    }
+    for (n = 0; n < 6 + 200; n++) btor_aig_release (amgr, nodes[n]);
+
+    num_aigs = amgr->cur_num_aigs;
+    btor_aigrw_rewrite (amgr, roots, 16);
+    ASSERT_LE (amgr->cur_num_aigs, num_aigs);
+    for (i = 0; i < 16; i++)
+    {
+      ASSERT_EQ (truth_table (amgr, roots[i], vars, 6), tts[i]);
+      btor_aig_release (amgr, roots[i]);
+    }
+    ASSERT_EQ (amgr->cur_num_aigs, 0u);
+    for (i = 0; i < 6; i++) btor_aig_release (amgr, vars[i]);
+  }
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, fraig)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *a, *b, *c, *t0, *t1, *t2, *roots[2], *vars[3];
+
+  a = btor_aig_var (amgr);
+  b = btor_aig_var (amgr);
+  c = btor_aig_var (amgr);
+  /* (a & b) | (a & c) | (b & c) */
+  t0 = btor_aig_and (amgr, a, b);
+  t1 = btor_aig_and (amgr, a, c);
+  t2 = btor_aig_or (amgr, t0, t1);
+  btor_aig_release (amgr, t0);
+  btor_aig_release (amgr, t1);
+  t0       = btor_aig_and (amgr, b, c);
+  roots[0] = btor_aig_or (amgr, t2, t0);
+  btor_aig_release (amgr, t2);
+  /* (a & (b | c)) | (b & c) */
+  t1       = btor_aig_or (amgr, b, c);
+  t2       = btor_aig_and (amgr, a, t1);
+  roots[1] = btor_aig_or (amgr, t2, t0);
+  btor_aig_release (amgr, t0);
+  btor_aig_release (amgr, t1);
+  btor_aig_release (amgr, t2);
+  vars[0] = a;
+  vars[1] = b;
+  vars[2] = c;
+  ASSERT_NE (roots[0], roots[1]);
+  ASSERT_EQ (amgr->cur_num_aigs, 8u);
+  ASSERT_EQ (truth_table (amgr, roots[0], vars, 3),
+             truth_table (amgr, roots[1], vars, 3));
+
+  btor_aigfraig_sweep (amgr, roots, 2);
+  ASSERT_EQ (amgr->cur_num_aigs, 4u);
+  ASSERT_GT (amgr->num_fraig_merged, 0u);
+  ASSERT_EQ (roots[0], roots[1]);
+
+  btor_aig_release (amgr, roots[0]);
+  btor_aig_release (amgr, roots[1]);
+  ASSERT_EQ (amgr->cur_num_aigs, 0u);
+  btor_aig_release (amgr, a);
+  btor_aig_release (amgr, b);
+  btor_aig_release (amgr, c);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, fraig_random)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *vars[6], *nodes[6 + 200], *roots[16];
+  uint64_t tts[16];
+  uint32_t i, j, n, rnd, num_aigs;
+
+  rnd = 4711;
+  for (j = 0; j < 20; j++)
+  {
+    for (i = 0; i < 6; i++)
+    {
+      vars[i]  = btor_aig_var (amgr);
+      nodes[i] = btor_aig_copy (amgr, vars[i]);
+    }
+    for (n = 6; n < 6 + 200; n++)
+    {
+      BtorAIG *l, *r;
+      rnd = rnd * 1664525u + 1013904223u;
+      l   = nodes[(rnd >> 8) % n];
+      if (rnd & 1) l = BTOR_INVERT_AIG (l);
+      rnd = rnd * 1664525u + 1013904223u;
+      r   = nodes[(rnd >> 8) % n];
+      if (rnd & 1) r = BTOR_INVERT_AIG (r);
+      nodes[n] = btor_aig_and (amgr, l, r);
+    }
+    for (i = 0; i < 16; i++)
+    {
+      roots[i] = btor_aig_copy (amgr, nodes[6 + 200 - 1 - 3 * i]);
+      tts[i]   = truth_table (amgr, roots[i], vars, 6);
+    }
+    for (n = 0; n < 6 + 200; n++) btor_aig_release (amgr, nodes[n]);
+
+    num_aigs = amgr->cur_num_aigs;
+    btor_aigfraig_sweep (amgr, roots, 16);
+    ASSERT_LE (amgr->cur_num_aigs, num_aigs);
+    for (i = 0; i < 16; i++)
+    {
+      ASSERT_EQ (truth_table (amgr, roots[i], vars, 6), tts[i]);
+      btor_aig_release (amgr, roots[i]);
+    }
+    ASSERT_EQ (amgr->cur_num_aigs, 0u);
+    for (i = 0; i < 6; i++) btor_aig_release (amgr, vars[i]);
+  }
+  ASSERT_GT (amgr->num_fraig_merged, 0u);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, sim)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *vars[6], *nodes[6 + 200], *aig;
+  BtorAIGSim *sim;
+  BtorRNG rng;
+  uint64_t tt;
+  uint32_t i, n, rnd;
+  int32_t p;
+
+  rnd = 42;
+  for (i = 0; i < 6; i++)
+  {
+    vars[i]  = btor_aig_var (amgr);
+    nodes[i] = btor_aig_copy (amgr, vars[i]);
+  }
+  for (n = 6; n < 6 + 200; n++)
+  {
+    BtorAIG *l, *r;
+    rnd = rnd * 1664525u + 1013904223u;
+    l   = nodes[(rnd >> 8) % n];
+    if (rnd & 1) l = BTOR_INVERT_AIG (l);
+    rnd = rnd * 1664525u + 1013904223u;
+    r   = nodes[(rnd >> 8) % n];
+    if (rnd & 1) r = BTOR_INVERT_AIG (r);
+    nodes[n] = btor_aig_and (amgr, l, r);
+  }
+
+  sim = btor_aigsim_new (amgr, nodes, 6 + 200, 2, false);
+  ASSERT_EQ (btor_aigsim_num_nodes (sim), amgr->cur_num_aigs + 6);
+
+  /* word 0 enumerates all assignments, word 1 is random */
+  memset (&rng, 0, sizeof (rng));
+  btor_rng_init (&rng, 0);
+  btor_aigsim_randomize (sim, &rng, 1);
+  btor_rng_delete (&rng);
+  for (i = 0; i < 6; i++)
+  {
+    p = btor_aigsim_get_pos (sim, vars[i]->id);
+    ASSERT_GE (p, 0);
+    ASSERT_TRUE (btor_aigsim_is_input (sim, p));
+    btor_aigsim_get_words (sim, p)[0] = truth_table (amgr, vars[i], vars, 6);
+  }
+  btor_aigsim_simulate (sim, 0, 2);
+  ASSERT_EQ (amgr->num_sim_patterns, 128u);
+
+  for (n = 0; n < 6 + 200; n++)
+  {
+    aig = nodes[n];
+    if (btor_aig_is_const (aig)) continue;
+    p = btor_aigsim_get_pos (sim, BTOR_REAL_ADDR_AIG (aig)->id);
+    ASSERT_GE (p, 0);
+    tt = btor_aigsim_get_words (sim, p)[0];
+    if (BTOR_IS_INVERTED_AIG (aig)) tt = ~tt;
+    ASSERT_EQ (tt, truth_table (amgr, aig, vars, 6));
+  }
+
+  btor_aigsim_delete (sim);
+  for (n = 0; n < 6 + 200; n++) btor_aig_release (amgr, nodes[n]);
+  for (i = 0; i < 6; i++) btor_aig_release (amgr, vars[i]);
+  btor_aig_mgr_delete (amgr);
+}
@@ -350,6 +350,48 @@ class TestBv : public TestBtor
     btor_bv_free (d_mm, zero);
   }
 
+  void into_bitvec (BtorBitVector *(*bitvec_func) (BtorMemMgr *,
+                                                   const BtorBitVector *,
+                                                   const BtorBitVector *),
+                    void (*into_func) (BtorMemMgr *,
+                                       BtorBitVector *,
+                                       const BtorBitVector *,
+                                       const BtorBitVector *),
+                    uint32_t num_tests,
+                    uint32_t bit_width)
+  {
+    uint32_t i;
+    BtorBitVector *bv1, *bv2, *exp, *res;
+
+    for (i = 0; i < num_tests; i++)
+    {
+      bv1 = btor_bv_new_random (d_mm, d_rng, bit_width);
+      if (i % 10 == 0)
+        bv2 = btor_bv_uint64_to_bv (d_mm, i % bit_width, bit_width);
+      else
+        bv2 = btor_bv_new_random (d_mm, d_rng, bit_width);
+      exp = bitvec_func (d_mm, bv1, bv2);
+      /* result written into separate bit-vector */
+      res = btor_bv_new_random (d_mm, d_rng, bit_width);
+      into_func (d_mm, res, bv1, bv2);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, res);
+      /* result written into first operand */
+      res = btor_bv_copy (d_mm, bv1);
+      into_func (d_mm, res, res, bv2);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, res);
+      /* result written into second operand */
+      res = btor_bv_copy (d_mm, bv2);
+      into_func (d_mm, res, bv1, res);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, res);
+      btor_bv_free (d_mm, exp);
+      btor_bv_free (d_mm, bv1);
+      btor_bv_free (d_mm, bv2);
+    }
+  }
+
   void binary_signed_bitvec (
       int64_t (*int_func) (int64_t, int64_t, uint32_t),
       BtorBitVector *(*bitvec_func) (BtorMemMgr *,
@@ -758,6 +800,121 @@ class TestBv : public TestBtor
     }
   }
 
+  /* Check a = q * b + r with r < b for q = a / b and r = a % b. */
+  void udiv_urem_wide_bitvec (BtorBitVector *a, BtorBitVector *b)
+  {
+    BtorBitVector *q, *r, *mul, *add, *ult;
+
+    q = btor_bv_udiv (d_mm, a, b);
+    r = btor_bv_urem (d_mm, a, b);
+    if (btor_bv_is_zero (b))
+    {
+      EXPECT_TRUE (btor_bv_is_ones (q));
+      EXPECT_EQ (btor_bv_compare (r, a), 0);
+    }
+    else
+    {
+      mul = btor_bv_mul (d_mm, q, b);
+      add = btor_bv_add (d_mm, mul, r);
+      ult = btor_bv_ult (d_mm, r, b);
+      EXPECT_EQ (btor_bv_compare (add, a), 0);
+      EXPECT_TRUE (btor_bv_is_true (ult));
+      btor_bv_free (d_mm, mul);
+      btor_bv_free (d_mm, add);
+      btor_bv_free (d_mm, ult);
+    }
+    btor_bv_free (d_mm, q);
+    btor_bv_free (d_mm, r);
+  }
+
+  void limb_ops_wide_bitvec ()
+  {
+    uint32_t i, j, k, bw[] = {257, 320, 383, 512, 1000, 4096};
+    uint32_t dist;
+    int32_t cmp;
+    BtorBitVector *a, *b, *res, *zero, *ones;
+
+    for (i = 0; i < sizeof (bw) / sizeof (*bw); i++)
+    {
+      zero = btor_bv_new (d_mm, bw[i]);
+      ones = btor_bv_ones (d_mm, bw[i]);
+      ASSERT_TRUE (btor_bv_is_zero (zero));
+      ASSERT_FALSE (btor_bv_is_ones (zero));
+      ASSERT_TRUE (btor_bv_is_ones (ones));
+      ASSERT_FALSE (btor_bv_is_zero (ones));
+      ASSERT_EQ (btor_bv_hamming_distance (zero, ones), bw[i]);
+
+      for (j = 0; j < 100; j++)
+      {
+        a = btor_bv_new_random (d_mm, d_rng, bw[i]);
+        /* make 'b' differ from 'a' in at most one (random) position */
+        b = btor_bv_copy (d_mm, a);
+        if (j % 2)
+          btor_bv_flip_bit (b, btor_rng_pick_rand (d_rng, 0, bw[i] - 1));
+
+        for (k = 0, dist = 0, cmp = 0; k < bw[i]; k++)
+        {
+          if (btor_bv_get_bit (a, k) == btor_bv_get_bit (b, k)) continue;
+          dist += 1;
+          cmp = btor_bv_get_bit (a, k) ? 1 : -1;
+        }
+        ASSERT_EQ (btor_bv_hamming_distance (a, b), dist);
+        ASSERT_EQ (btor_bv_compare (a, b), cmp);
+        res = btor_bv_eq (d_mm, a, b);
+        ASSERT_EQ (btor_bv_is_true (res), cmp == 0);
+        btor_bv_free (d_mm, res);
+        res = btor_bv_ne (d_mm, a, b);
+        ASSERT_EQ (btor_bv_is_true (res), cmp != 0);
+        btor_bv_free (d_mm, res);
+        res = btor_bv_ult (d_mm, a, b);
+        ASSERT_EQ (btor_bv_is_true (res), cmp < 0);
+        btor_bv_free (d_mm, res);
+
+        btor_bv_free (d_mm, b);
+        b = btor_bv_new_random (d_mm, d_rng, bw[i]);
+
+        res = btor_bv_and (d_mm, a, b);
+        for (k = 0; k < bw[i]; k++)
+          ASSERT_EQ (btor_bv_get_bit (res, k),
+                     btor_bv_get_bit (a, k) & btor_bv_get_bit (b, k));
+        btor_bv_free (d_mm, res);
+        res = btor_bv_or (d_mm, a, b);
+        for (k = 0; k < bw[i]; k++)
+          ASSERT_EQ (btor_bv_get_bit (res, k),
+                     btor_bv_get_bit (a, k) | btor_bv_get_bit (b, k));
+        btor_bv_free (d_mm, res);
+        res = btor_bv_xor (d_mm, a, b);
+        for (k = 0; k < bw[i]; k++)
+          ASSERT_EQ (btor_bv_get_bit (res, k),
+                     btor_bv_get_bit (a, k) ^ btor_bv_get_bit (b, k));
+        btor_bv_free (d_mm, res);
+        res = btor_bv_not (d_mm, a);
+        for (k = 0; k < bw[i]; k++)
+          ASSERT_EQ (btor_bv_get_bit (res, k), !btor_bv_get_bit (a, k));
+        btor_bv_free (d_mm, res);
+
+        /* clear / set all but one bit */
+        k   = btor_rng_pick_rand (d_rng, 0, bw[i] - 1);
+        res = btor_bv_copy (d_mm, zero);
+        btor_bv_set_bit (res, k, 1);
+        ASSERT_FALSE (btor_bv_is_zero (res));
+        ASSERT_EQ (btor_bv_get_num_trailing_zeros (res), k);
+        ASSERT_EQ (btor_bv_get_num_leading_zeros (res), bw[i] - 1 - k);
+        btor_bv_free (d_mm, res);
+        res = btor_bv_copy (d_mm, ones);
+        btor_bv_set_bit (res, k, 0);
+        ASSERT_FALSE (btor_bv_is_ones (res));
+        ASSERT_EQ (btor_bv_get_num_leading_ones (res), bw[i] - 1 - k);
+        btor_bv_free (d_mm, res);
+
+        btor_bv_free (d_mm, a);
+        btor_bv_free (d_mm, b);
+      }
+      btor_bv_free (d_mm, zero);
+      btor_bv_free (d_mm, ones);
+    }
+  }
+
   BtorMemMgr *d_mm;
   BtorRNG *d_rng;
 };
@@ -2107,6 +2264,37 @@ TEST_F (TestBv, add)
   binary_bitvec (add, btor_bv_add, BTOR_TEST_BITVEC_TESTS, 33);
 }
 
+TEST_F (TestBv, add_wide)
+{
+  uint32_t bw, i;
+  BtorBitVector *a, *b, *ones, *one, *add, *sub;
+
+  for (bw = 65; bw <= 200; bw += 9)
+  {
+    /* carry across all limbs */
+    ones = btor_bv_ones (d_mm, bw);
+    one  = btor_bv_one (d_mm, bw);
+    add  = btor_bv_add (d_mm, ones, one);
+    ASSERT_TRUE (btor_bv_is_zero (add));
+    btor_bv_free (d_mm, add);
+    btor_bv_free (d_mm, ones);
+    btor_bv_free (d_mm, one);
+
+    for (i = 0; i < 1000; i++)
+    {
+      a   = btor_bv_new_random (d_mm, d_rng, bw);
+      b   = btor_bv_new_random (d_mm, d_rng, bw);
+      add = btor_bv_add (d_mm, a, b);
+      sub = btor_bv_sub (d_mm, add, b);
+      ASSERT_EQ (btor_bv_compare (sub, a), 0);
+      btor_bv_free (d_mm, sub);
+      btor_bv_free (d_mm, add);
+      btor_bv_free (d_mm, b);
+      btor_bv_free (d_mm, a);
+    }
+  }
+}
+
 TEST_F (TestBv, sub)
 {
   binary_bitvec (sub, btor_bv_sub, BTOR_TEST_BITVEC_TESTS, 1);
@@ -2597,6 +2785,226 @@ TEST_F (TestBv, urem)
   binary_bitvec (urem, btor_bv_urem, BTOR_TEST_BITVEC_TESTS, 33);
 }
 
+TEST_F (TestBv, mul_wide)
+{
+  uint32_t i, j, bw[] = {65, 128, 200, 512, 1100, 2100};
+  BtorBitVector *a, *b, *c, *ones, *one, *add, *mul, *mul0, *mul1;
+
+  for (i = 0; i < sizeof (bw) / sizeof (*bw); i++)
+  {
+    ones = btor_bv_ones (d_mm, bw[i]);
+    one  = btor_bv_one (d_mm, bw[i]);
+    mul  = btor_bv_mul (d_mm, ones, ones);
+    ASSERT_EQ (btor_bv_compare (mul, one), 0);
+    btor_bv_free (d_mm, mul);
+    btor_bv_free (d_mm, one);
+    btor_bv_free (d_mm, ones);
+
+    for (j = 0; j < 100; j++)
+    {
+      /* a * (b + c) = a * b + a * c */
+      a    = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      b    = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      c    = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      add  = btor_bv_add (d_mm, b, c);
+      mul  = btor_bv_mul (d_mm, a, add);
+      mul0 = btor_bv_mul (d_mm, a, b);
+      mul1 = btor_bv_mul (d_mm, a, c);
+      btor_bv_free (d_mm, add);
+      add = btor_bv_add (d_mm, mul0, mul1);
+      ASSERT_EQ (btor_bv_compare (mul, add), 0);
+      btor_bv_free (d_mm, add);
+      btor_bv_free (d_mm, mul);
+      btor_bv_free (d_mm, mul0);
+      btor_bv_free (d_mm, mul1);
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+      btor_bv_free (d_mm, c);
+    }
+  }
+}
+
+TEST_F (TestBv, udiv_urem_wide)
+{
+  /* random operands almost never require the add back step (D6) of Knuth's
+   * Algorithm D, these do (some of them several times) */
+  const char *consts[][2] = {
+      {"7fffffff800000000000000000000000", "800000000000000000000001"},
+      {"800000000000000000000003", "200000000000000000000001"},
+  };
+  uint32_t i, j, bw[] = {65, 128, 200, 512, 1100};
+  BtorBitVector *a, *b, *tmp;
+
+  for (i = 0; i < sizeof (bw) / sizeof (*bw); i++)
+  {
+    for (j = 0; j < 100; j++)
+    {
+      a = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      b = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      /* vary the number of significant words of the divisor */
+      tmp = btor_bv_srl_uint64 (d_mm, b, j % bw[i]);
+      btor_bv_free (d_mm, b);
+      b = tmp;
+      udiv_urem_wide_bitvec (a, b);
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+    }
+  }
+
+  for (i = 0; i < sizeof (consts) / sizeof (*consts); i++)
+  {
+    a = btor_bv_consth (d_mm, consts[i][0], 128);
+    b = btor_bv_consth (d_mm, consts[i][1], 128);
+    udiv_urem_wide_bitvec (a, b);
+    btor_bv_free (d_mm, a);
+    btor_bv_free (d_mm, b);
+  }
+
+  /* 0x8000...0 / (2^(k-1) + 1) */
+  for (i = 1; i < sizeof (bw) / sizeof (*bw); i++)
+  {
+    uint32_t k[] = {65, 96, 97, 128, bw[i]};
+    for (j = 0; j < sizeof (k) / sizeof (*k); j++)
+    {
+      if (k[j] > bw[i]) continue;
+      a = btor_bv_min_signed (d_mm, bw[i]);
+      b = btor_bv_one (d_mm, bw[i]);
+      btor_bv_set_bit (b, k[j] - 1, 1);
+      udiv_urem_wide_bitvec (a, b);
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+    }
+  }
+}
+
+TEST_F (TestBv, into)
+{
+  uint32_t i, j, n = 1000, bw[] = {1, 7, 31, 33, 64, 65, 128, 200};
+  BtorBitVector *a, *b, *res, *exp;
+
+  for (i = 0; i < sizeof (bw) / sizeof (*bw); i++)
+  {
+    into_bitvec (btor_bv_add,
+                 [] (BtorMemMgr *,
+                     BtorBitVector *r,
+                     const BtorBitVector *x,
+                     const BtorBitVector *y) { btor_bv_add_into (r, x, y); },
+                 n,
+                 bw[i]);
+    into_bitvec (btor_bv_and,
+                 [] (BtorMemMgr *,
+                     BtorBitVector *r,
+                     const BtorBitVector *x,
+                     const BtorBitVector *y) { btor_bv_and_into (r, x, y); },
+                 n,
+                 bw[i]);
+    into_bitvec (btor_bv_sll,
+                 [] (BtorMemMgr *,
+                     BtorBitVector *r,
+                     const BtorBitVector *x,
+                     const BtorBitVector *y) { btor_bv_sll_into (r, x, y); },
+                 n,
+                 bw[i]);
+    into_bitvec (btor_bv_srl,
+                 [] (BtorMemMgr *,
+                     BtorBitVector *r,
+                     const BtorBitVector *x,
+                     const BtorBitVector *y) { btor_bv_srl_into (r, x, y); },
+                 n,
+                 bw[i]);
+    into_bitvec (btor_bv_mul, btor_bv_mul_into, n, bw[i]);
+    into_bitvec (btor_bv_udiv, btor_bv_udiv_into, n, bw[i]);
+    into_bitvec (btor_bv_urem, btor_bv_urem_into, n, bw[i]);
+
+    for (j = 0; j < n; j++)
+    {
+      a = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      b = j % 2 ? btor_bv_copy (d_mm, a)
+                : btor_bv_new_random (d_mm, d_rng, bw[i]);
+
+      res = btor_bv_new_random (d_mm, d_rng, bw[i]);
+      btor_bv_copy_into (res, b);
+      ASSERT_EQ (btor_bv_compare (res, b), 0);
+      exp = btor_bv_not (d_mm, a);
+      btor_bv_not_into (res, a);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_not_into (res, res);
+      ASSERT_EQ (btor_bv_compare (res, a), 0);
+      btor_bv_free (d_mm, exp);
+      btor_bv_free (d_mm, res);
+
+      res = btor_bv_new_random (d_mm, d_rng, 1);
+      exp = btor_bv_eq (d_mm, a, b);
+      btor_bv_eq_into (res, a, b);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, exp);
+      exp = btor_bv_ult (d_mm, a, b);
+      btor_bv_ult_into (res, a, b);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, exp);
+      btor_bv_free (d_mm, res);
+
+      res = btor_bv_new_random (d_mm, d_rng, 2 * bw[i]);
+      exp = btor_bv_concat (d_mm, a, b);
+      btor_bv_concat_into (res, a, b);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, exp);
+      btor_bv_free (d_mm, res);
+
+      res = btor_bv_new_random (d_mm, d_rng, bw[i] - j % bw[i]);
+      exp = btor_bv_slice (d_mm, a, bw[i] - 1, j % bw[i]);
+      btor_bv_slice_into (res, a, bw[i] - 1, j % bw[i]);
+      ASSERT_EQ (btor_bv_compare (res, exp), 0);
+      btor_bv_free (d_mm, exp);
+      btor_bv_free (d_mm, res);
+
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+    }
+  }
+}
+
+TEST_F (TestBv, pool)
+{
+  BtorBitVectorPool *pool;
+  BtorBitVector *a, *b, *c;
+
+  pool = btor_bv_pool_new (d_mm);
+  a    = btor_bv_pool_get (pool, 100);
+  b    = btor_bv_pool_get (pool, 8);
+  ASSERT_EQ (btor_bv_get_width (a), 100u);
+  ASSERT_EQ (btor_bv_get_width (b), 8u);
+  btor_bv_pool_put (pool, a);
+  btor_bv_pool_put (pool, b);
+  /* bit-vectors are reused per bit-width */
+  c = btor_bv_pool_get (pool, 100);
+  ASSERT_EQ (c, a);
+  btor_bv_pool_put (pool, c);
+  c = btor_bv_pool_get (pool, 8);
+  ASSERT_EQ (c, b);
+  /* bit-vectors from the pool may be freed directly */
+  btor_bv_free (d_mm, c);
+  btor_bv_pool_delete (pool);
+}
+
+TEST_F (TestBv, limb_ops_wide)
+{
+  BtorBvLimbOpsKind kinds[] = {BTOR_BV_LIMB_OPS_SCALAR,
+                               BTOR_BV_LIMB_OPS_SSE42,
+                               BTOR_BV_LIMB_OPS_AVX2};
+
+  /* run on every implementation supported by the CPU */
+  ASSERT_TRUE (btor_bv_set_limb_ops (BTOR_BV_LIMB_OPS_SCALAR));
+  for (BtorBvLimbOpsKind kind : kinds)
+  {
+    if (!btor_bv_set_limb_ops (kind)) continue;
+    SCOPED_TRACE (kind);
+    limb_ops_wide_bitvec ();
+    if (HasFatalFailure ()) break;
+  }
+  ASSERT_TRUE (btor_bv_set_limb_ops (BTOR_BV_LIMB_OPS_AUTO));
+}
+
 TEST_F (TestBv, sdiv)
 {
   binary_signed_bitvec (sdiv, btor_bv_sdiv, BTOR_TEST_BITVEC_TESTS, 1);
@@ -2629,6 +3037,8 @@ TEST_F (TestBv, slice)
   slice_bitvec (BTOR_TEST_BITVEC_TESTS, 31);
   slice_bitvec (BTOR_TEST_BITVEC_TESTS, 33);
   slice_bitvec (BTOR_TEST_BITVEC_TESTS, 64);
+  slice_bitvec (BTOR_TEST_BITVEC_TESTS, 65);
+  slice_bitvec (BTOR_TEST_BITVEC_TESTS, 129);
 }
 
 TEST_F (TestBv, uext)
@@ -3995,6 +4405,8 @@ TEST_F (TestBv, get_num_trailing_zeros)
   test_get_num (76, btor_bv_get_num_trailing_zeros, false);
   test_get_num (128, btor_bv_get_num_trailing_zeros, false);
   test_get_num (176, btor_bv_get_num_trailing_zeros, false);
+  test_get_num (300, btor_bv_get_num_trailing_zeros, false);
+  test_get_num (1000, btor_bv_get_num_trailing_zeros, false);
 }
 
 TEST_F (TestBv, get_num_leading_zeros)
@@ -4004,6 +4416,8 @@ TEST_F (TestBv, get_num_leading_zeros)
   test_get_num (76, btor_bv_get_num_leading_zeros);
   test_get_num (128, btor_bv_get_num_leading_zeros);
   test_get_num (176, btor_bv_get_num_leading_zeros);
+  test_get_num (300, btor_bv_get_num_leading_zeros);
+  test_get_num (1000, btor_bv_get_num_leading_zeros);
 }
 
 TEST_F (TestBv, test_get_num_leading_ones)
@@ -4013,6 +4427,8 @@ TEST_F (TestBv, test_get_num_leading_ones)
   test_get_num (76, btor_bv_get_num_leading_ones, true, false);
   test_get_num (128, btor_bv_get_num_leading_ones, true, false);
   test_get_num (176, btor_bv_get_num_leading_ones, true, false);
+  test_get_num (300, btor_bv_get_num_leading_ones, true, false);
+  test_get_num (1000, btor_bv_get_num_leading_ones, true, false);
 }
 
 // TODO btor_bv_get_assignment
@@ -0,0 +1,243 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btoropt.h"
+}
+
+class TestDumpBin : public TestBoolector
+{
+ protected:
+  void TearDown () override
+  {
+    if (d_reload)
+    {
+      boolector_delete (d_reload);
+      d_reload = nullptr;
+    }
+    TestBoolector::TearDown ();
+  }
+
+  /* Dump the formula in 'd_btor' in binary format, reload it into a fresh
+   * instance and check that both instances yield the expected result. */
+  void test_dumpbin (int32_t expected)
+  {
+    FILE *file;
+    char *err_msg;
+    int32_t status, res;
+
+    file = tmpfile ();
+    ASSERT_NE (file, nullptr);
+    boolector_dump_btor_binary (d_btor, file);
+    rewind (file);
+
+    d_reload = boolector_new ();
+    res      = boolector_parse_btor_binary (
+        d_reload, file, "dumpbin", stdout, &err_msg, &status);
+    fclose (file);
+    ASSERT_EQ (res, BOOLECTOR_PARSE_UNKNOWN);
+    ASSERT_EQ (status, BOOLECTOR_UNKNOWN);
+
+    ASSERT_EQ (boolector_sat (d_reload), expected);
+    ASSERT_EQ (boolector_sat (d_btor), expected);
+  }
+
+  /* Parse 'len' bytes of 'bytes' as binary input, which is expected to fail
+   * with a parse error. */
+  void test_dumpbin_perr (const char *bytes, size_t len)
+  {
+    FILE *file;
+    char *err_msg;
+    int32_t status, res;
+
+    file = tmpfile ();
+    ASSERT_NE (file, nullptr);
+    ASSERT_EQ (fwrite (bytes, 1, len, file), len);
+    rewind (file);
+
+    res = boolector_parse_btor_binary (
+        d_btor, file, "dumpbin", stdout, &err_msg, &status);
+    fclose (file);
+    ASSERT_EQ (res, BOOLECTOR_PARSE_ERROR);
+    ASSERT_NE (err_msg, nullptr);
+  }
+
+  Btor *d_reload = nullptr;
+};
+
+TEST_F (TestDumpBin, empty)
+{
+  test_dumpbin (BOOLECTOR_SAT);
+}
+
+TEST_F (TestDumpBin, bv)
+{
+  BoolectorSort s8, s100;
+  BoolectorNode *x, *y, *z, *c, *mul, *eq, *ult, *slice, *concat, *zext;
+
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  s8   = boolector_bitvec_sort (d_btor, 8);
+  s100 = boolector_bitvec_sort (d_btor, 100);
+  x    = boolector_var (d_btor, s8, "x");
+  y    = boolector_var (d_btor, s8, "y");
+  z    = boolector_var (d_btor, s100, "z");
+  c    = boolector_const (d_btor,
+                          "1000000000000000000000000000000000000000000000000"
+                          "000000000000000000000000000000000000000000000000011");
+
+  mul    = boolector_mul (d_btor, x, y);
+  slice  = boolector_slice (d_btor, z, 7, 0);
+  eq     = boolector_eq (d_btor, mul, slice);
+  ult    = boolector_ult (d_btor, x, y);
+  concat = boolector_concat (d_btor, x, y);
+  zext   = boolector_uext (d_btor, concat, 84);
+  boolector_assert (d_btor, eq);
+  boolector_assert (d_btor, ult);
+  boolector_release (d_btor, eq);
+  eq = boolector_ulte (d_btor, zext, c);
+  boolector_assert (d_btor, eq);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, slice);
+  boolector_release (d_btor, concat);
+  boolector_release (d_btor, zext);
+  boolector_release_sort (d_btor, s8);
+  boolector_release_sort (d_btor, s100);
+
+  test_dumpbin (BOOLECTOR_SAT);
+}
+
+TEST_F (TestDumpBin, bv_unsat)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *add0, *add1, *ne;
+
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  s    = boolector_bitvec_sort (d_btor, 16);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  add0 = boolector_add (d_btor, x, y);
+  add1 = boolector_add (d_btor, y, x);
+  ne   = boolector_ne (d_btor, add0, add1);
+  boolector_assert (d_btor, ne);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, add0);
+  boolector_release (d_btor, add1);
+  boolector_release (d_btor, ne);
+  boolector_release_sort (d_btor, s);
+
+  test_dumpbin (BOOLECTOR_UNSAT);
+}
+
+TEST_F (TestDumpBin, fun)
+{
+  BoolectorSort s, as, fs;
+  BoolectorNode *a, *b, *f, *i, *j, *e, *p, *fun, *wr, *rd, *app, *eq, *ne;
+
+  s  = boolector_bitvec_sort (d_btor, 8);
+  as = boolector_array_sort (d_btor, s, s);
+  fs = boolector_fun_sort (d_btor, &s, 1, s);
+
+  a   = boolector_array (d_btor, as, "a");
+  b   = boolector_array (d_btor, as, "b");
+  f   = boolector_uf (d_btor, fs, "f");
+  i   = boolector_var (d_btor, s, "i");
+  j   = boolector_var (d_btor, s, "j");
+  e   = boolector_var (d_btor, s, "e");
+  p   = boolector_param (d_btor, s, "p");
+  rd  = boolector_add (d_btor, p, i);
+  fun = boolector_fun (d_btor, &p, 1, rd);
+  boolector_release (d_btor, rd);
+
+  wr = boolector_write (d_btor, a, i, e);
+  eq = boolector_eq (d_btor, wr, b);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, eq);
+
+  rd  = boolector_read (d_btor, b, j);
+  app = boolector_apply (d_btor, &rd, 1, f);
+  ne  = boolector_ne (d_btor, app, rd);
+  boolector_assert (d_btor, ne);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, app);
+
+  app = boolector_apply (d_btor, &j, 1, fun);
+  eq  = boolector_eq (d_btor, app, rd);
+  boolector_assert (d_btor, eq);
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, f);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, e);
+  boolector_release (d_btor, p);
+  boolector_release (d_btor, fun);
+  boolector_release (d_btor, wr);
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, app);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+  boolector_release_sort (d_btor, fs);
+
+  test_dumpbin (BOOLECTOR_SAT);
+}
+
+TEST_F (TestDumpBin, quant)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *p, *ult, *forall;
+
+  s      = boolector_bitvec_sort (d_btor, 4);
+  x      = boolector_var (d_btor, s, "x");
+  p      = boolector_param (d_btor, s, "p");
+  ult    = boolector_ult (d_btor, x, p);
+  forall = boolector_forall (d_btor, &p, 1, ult);
+  boolector_assert (d_btor, forall);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, p);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, forall);
+  boolector_release_sort (d_btor, s);
+
+  test_dumpbin (BOOLECTOR_UNSAT);
+}
+
+TEST_F (TestDumpBin, perr_magic)
+{
+  test_dumpbin_perr ("\177BTX\001\000\000\000", 8);
+}
+
+TEST_F (TestDumpBin, perr_version)
+{
+  test_dumpbin_perr ("\177BTB\002\000\000\000", 8);
+}
+
+TEST_F (TestDumpBin, perr_truncated)
+{
+  /* one bit-vector sort of width 8, one variable and missing root */
+  test_dumpbin_perr ("\177BTB\001\001\001\001\001\010\002\001\000", 13);
+}
+
+TEST_F (TestDumpBin, perr_ref)
+{
+  /* root refers to undefined node */
+  test_dumpbin_perr ("\177BTB\001\000\000\001\002", 9);
+}
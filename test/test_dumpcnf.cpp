@@ -0,0 +1,209 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include "btorcore.h"
+#include "dumper/btordumpcnf.h"
+}
+
+class TestDumpCnf : public TestBtor
+{
+ protected:
+  /* Write clauses (1 -2) and (2 3) and a query under assumption -3. */
+  std::string write (bool icnf, bool binary)
+  {
+    BtorCnfWriter *writer;
+    FILE *file;
+    int32_t lits[] = {1, -2, 0, 2, 3, 0}, assumption = -3;
+    std::string res;
+    int ch;
+
+    file = tmpfile ();
+    EXPECT_NE (file, nullptr);
+    writer = btor_dumpcnf_new (d_btor->mm, file, icnf, binary);
+    for (int32_t lit : lits) btor_dumpcnf_add (writer, lit);
+    EXPECT_TRUE (btor_dumpcnf_query (writer, &assumption, 1));
+    EXPECT_EQ (writer->clauses, 2u);
+    EXPECT_EQ (writer->queries, 1u);
+    EXPECT_TRUE (btor_dumpcnf_delete (writer));
+
+    rewind (file);
+    while ((ch = getc (file)) != EOF) res.push_back ((char) ch);
+    fclose (file);
+    return res;
+  }
+};
+
+TEST_F (TestDumpCnf, dimacs)
+{
+  std::string header = "p cnf 3 2";
+
+  header.resize (40, ' ');
+  ASSERT_EQ (write (false, false), header + "\n1 -2 0\n2 3 0\n");
+}
+
+TEST_F (TestDumpCnf, icnf)
+{
+  ASSERT_EQ (write (true, false), "p inccnf\n1 -2 0\n2 3 0\na -3 0\n");
+}
+
+TEST_F (TestDumpCnf, icnf_binary)
+{
+  std::string expected = "p inccnf\na";
+
+  expected += {2, 5, 0, 'a', 4, 6, 0, 'q', 7, 0};
+  ASSERT_EQ (write (true, true), expected);
+}
+
+TEST_F (TestDumpCnf, binary_varint)
+{
+  BtorCnfWriter *writer;
+  FILE *file;
+
+  file = tmpfile ();
+  ASSERT_NE (file, nullptr);
+  writer = btor_dumpcnf_new (d_btor->mm, file, true, true);
+  btor_dumpcnf_add (writer, -200);
+  btor_dumpcnf_add (writer, 0);
+  btor_dumpcnf_delete (writer);
+
+  /* 2 * 200 + 1 = 401 = 0x191 */
+  fseek (file, 9, SEEK_SET);
+  ASSERT_EQ (getc (file), 'a');
+  ASSERT_EQ (getc (file), 0x91);
+  ASSERT_EQ (getc (file), 0x03);
+  ASSERT_EQ (getc (file), 0);
+  ASSERT_EQ (getc (file), EOF);
+  fclose (file);
+}
+
+TEST_F (TestDumpCnf, write_error)
+{
+  std::string path = std::string (BTOR_LOG_DIR) + "dumpcnf_write_error.cnf";
+  BtorCnfWriter *writer;
+  FILE *file;
+  int32_t assumption = 1;
+
+  /* a read-only file is seekable but can not be written */
+  file = fopen (path.c_str (), "w");
+  ASSERT_NE (file, nullptr);
+  fclose (file);
+  file = fopen (path.c_str (), "rb");
+  ASSERT_NE (file, nullptr);
+
+  writer = btor_dumpcnf_new (d_btor->mm, file, false, false);
+  btor_dumpcnf_add (writer, 1);
+  btor_dumpcnf_add (writer, 0);
+  ASSERT_FALSE (btor_dumpcnf_query (writer, &assumption, 1));
+  ASSERT_TRUE (writer->error);
+  btor_dumpcnf_add (writer, -1);
+  btor_dumpcnf_add (writer, 0);
+  ASSERT_FALSE (btor_dumpcnf_delete (writer));
+  fclose (file);
+  std::remove (path.c_str ());
+}
+
+TEST_F (TestDumpCnf, stream)
+{
+  std::string path = std::string (BTOR_LOG_DIR) + "dumpcnf_stream.icnf";
+  BoolectorSort s;
+  BoolectorNode *x, *y, *ult, *eq;
+  FILE *file;
+  char line[64];
+  uint32_t queries = 0;
+
+  boolector_set_cnf_stream (d_btor, path.c_str ());
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+  eq  = boolector_eq (d_btor, x, y);
+  boolector_assert (d_btor, ult);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+
+  file = fopen (path.c_str (), "r");
+  ASSERT_NE (file, nullptr);
+  ASSERT_NE (fgets (line, sizeof (line), file), nullptr);
+  ASSERT_STREQ (line, "p inccnf\n");
+  while (fgets (line, sizeof (line), file))
+    if (line[0] == 'a') queries += 1;
+  fclose (file);
+  std::remove (path.c_str ());
+  ASSERT_EQ (queries, 2u);
+}
+
+TEST_F (TestDumpCnf, stream_fraig)
+{
+  std::string path = std::string (BTOR_LOG_DIR) + "dumpcnf_stream_fraig.icnf";
+  BoolectorSort s;
+  BoolectorNode *x, *y, *z, *ult, *add, *add0, *add1, *ne;
+  FILE *file;
+  char line[64];
+  uint32_t queries = 0;
+
+  /* the SAT solver used for SAT sweeping must not stream its CNF, too */
+  boolector_set_cnf_stream (d_btor, path.c_str ());
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  boolector_set_opt (d_btor, BTOR_OPT_AIG_FRAIG, 1);
+  s    = boolector_bitvec_sort (d_btor, 4);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  z    = boolector_var (d_btor, s, "z");
+  ult  = boolector_ult (d_btor, x, y);
+  /* (x + y) + z and x + (y + z) are merged by SAT sweeping */
+  add  = boolector_add (d_btor, x, y);
+  add0 = boolector_add (d_btor, add, z);
+  boolector_release (d_btor, add);
+  add  = boolector_add (d_btor, y, z);
+  add1 = boolector_add (d_btor, x, add);
+  boolector_release (d_btor, add);
+  ne   = boolector_ne (d_btor, add0, add1);
+  boolector_assert (d_btor, ult);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_assume (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (d_btor->avmgr->amgr->num_fraig_merged, 0u);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, add0);
+  boolector_release (d_btor, add1);
+  boolector_release (d_btor, ne);
+  boolector_release_sort (d_btor, s);
+
+  file = fopen (path.c_str (), "r");
+  ASSERT_NE (file, nullptr);
+  ASSERT_NE (fgets (line, sizeof (line), file), nullptr);
+  ASSERT_STREQ (line, "p inccnf\n");
+  while (fgets (line, sizeof (line), file))
+  {
+    if (line[0] == 'a')
+      queries += 1;
+    else
+      ASSERT_EQ (strspn (line, "-0123456789 "), strlen (line) - 1);
+  }
+  fclose (file);
+  std::remove (path.c_str ());
+  ASSERT_EQ (queries, 2u);
+}
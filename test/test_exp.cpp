@@ -8,7 +8,11 @@
 
 #include "test.h"
 
+#include <algorithm>
+#include <vector>
+
 extern "C" {
+#include "btorclone.h"
 #include "btorcore.h"
 #include "btorexp.h"
 #include "dumper/btordumpbtor.h"
@@ -57,6 +61,37 @@ class TestExp : public TestBtor
     btor_node_release (d_btor, exp3);
   }
 
+  /* Checks that the parent list of 'exp' contains exactly the nodes in
+   * 'parents' and is linked consistently in both directions. */
+  void check_parents (Btor *btor,
+                      BtorNode *exp,
+                      const std::vector<BtorNode *> &parents)
+  {
+    std::vector<BtorNode *> forward, backward;
+    BtorNode *parent, *real_parent;
+
+    for (parent = btor_node_get_first_parent (btor, exp); parent;
+         parent = btor_node_get_next_parent (btor, parent))
+    {
+      ASSERT_LE (forward.size (), parents.size ());
+      real_parent = btor_node_real_addr (parent);
+      ASSERT_EQ (real_parent->e[btor_node_get_tag (parent)], exp);
+      forward.push_back (real_parent);
+    }
+    for (parent = btor_node_get_last_parent (btor, exp); parent;
+         parent = btor_node_get_prev_parent (btor, parent))
+    {
+      ASSERT_LE (backward.size (), parents.size ());
+      backward.insert (backward.begin (), btor_node_real_addr (parent));
+    }
+    ASSERT_EQ (forward, backward);
+    ASSERT_EQ (forward.size (), exp->parents);
+    std::sort (forward.begin (), forward.end ());
+    std::vector<BtorNode *> expected (parents);
+    std::sort (expected.begin (), expected.end ());
+    ASSERT_EQ (forward, expected);
+  }
+
   void ext_exp_test (BtorNode *(*func) (Btor *, BtorNode *, uint32_t))
   {
     BtorNode *exp1, *exp2, *exp3;
@@ -933,3 +968,141 @@ TEST_F (TestExp, dec)
   btor_node_release (d_btor, exp2);
   btor_node_release (d_btor, exp3);
 }
+
+TEST_F (TestExp, unique_table)
+{
+  const uint32_t n = 1000, w = 32;
+  uint32_t i, j, num_elements, num_released;
+  BtorNode *x, *consts[n], *slices[w][w], *exp;
+  BtorBitVector *bv;
+  BtorSortId sort;
+
+  sort         = btor_sort_bv (d_btor, w);
+  x            = btor_exp_var (d_btor, sort, "x");
+  num_elements = d_btor->nodes_unique_table.num_elements;
+
+  for (i = 0; i < n; i++)
+  {
+    bv        = btor_bv_uint64_to_bv (d_btor->mm, i, w);
+    consts[i] = btor_node_create_bv_const (d_btor, bv);
+    btor_bv_free (d_btor->mm, bv);
+  }
+  for (i = 0; i < w; i++)
+    for (j = 0; j <= i; j++)
+      slices[i][j] = btor_node_create_bv_slice (d_btor, x, i, j);
+  ASSERT_EQ (d_btor->nodes_unique_table.num_elements,
+             num_elements + n + w * (w + 1) / 2);
+
+  /* release every other node and look up the remaining ones again */
+  num_released = 0;
+  for (i = 1; i < n; i += 2, num_released++)
+    btor_node_release (d_btor, consts[i]);
+  for (i = 0; i < w; i++)
+    for (j = i % 2; j <= i; j += 2, num_released++)
+      btor_node_release (d_btor, slices[i][j]);
+  ASSERT_EQ (d_btor->nodes_unique_table.num_elements,
+             num_elements + n + w * (w + 1) / 2 - num_released);
+
+  for (i = 0; i < n; i += 2)
+  {
+    bv  = btor_bv_uint64_to_bv (d_btor->mm, i, w);
+    exp = btor_node_create_bv_const (d_btor, bv);
+    ASSERT_EQ (exp, consts[i]);
+    btor_node_release (d_btor, exp);
+    btor_node_release (d_btor, consts[i]);
+    btor_bv_free (d_btor->mm, bv);
+  }
+  for (i = 0; i < w; i++)
+    for (j = 1 - i % 2; j <= i; j += 2)
+    {
+      exp = btor_node_create_bv_slice (d_btor, x, i, j);
+      ASSERT_EQ (exp, slices[i][j]);
+      btor_node_release (d_btor, exp);
+      btor_node_release (d_btor, slices[i][j]);
+    }
+  ASSERT_EQ (d_btor->nodes_unique_table.num_elements, num_elements);
+
+  btor_sort_release (d_btor, sort);
+  btor_node_release (d_btor, x);
+}
+
+TEST_F (TestExp, parent_links)
+{
+  BtorSortId sort, sort1;
+  BtorNode *v1, *v2, *c, *e[5], *cv1, *cv2, *ce[5];
+  Btor *clone;
+  size_t num_siblings, node_bytes;
+  uint32_t i;
+
+  sort  = btor_sort_bv (d_btor, 8);
+  sort1 = btor_sort_bv (d_btor, 1);
+
+  /* links in the parent lists of children are only allocated per child */
+  num_siblings = BTOR_COUNT_STACK (d_btor->sibling_links);
+  v1           = btor_node_create_var (d_btor, sort, "v1");
+  v2           = btor_node_create_var (d_btor, sort, "v2");
+  c            = btor_node_create_var (d_btor, sort1, "c");
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->sibling_links), num_siblings);
+  node_bytes = d_btor->stats.node_bytes_alloc;
+  e[0]       = btor_node_create_bv_and (d_btor, v1, v2);
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->sibling_links), num_siblings + 2);
+  ASSERT_EQ (d_btor->stats.node_bytes_alloc - node_bytes,
+             e[0]->bytes + sizeof (BtorNodeParentLinks)
+                 + 2 * sizeof (BtorNodeSiblingLinks));
+  e[1] = btor_node_create_bv_slice (d_btor, v1, 3, 0);
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->sibling_links), num_siblings + 3);
+  e[2] = btor_node_create_cond (d_btor, c, v2, v1);
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->sibling_links), num_siblings + 6);
+  e[3] = btor_node_create_bv_add (d_btor, v2, v1);
+  e[4] = btor_node_create_bv_ult (d_btor, v2, v1);
+
+  check_parents (d_btor, v1, {e[0], e[1], e[2], e[3], e[4]});
+  check_parents (d_btor, v2, {e[0], e[2], e[3], e[4]});
+  check_parents (d_btor, c, {e[2]});
+
+  /* delete parents from the middle and both ends of the lists */
+  btor_node_release (d_btor, e[3]);
+  check_parents (d_btor, v1, {e[0], e[1], e[2], e[4]});
+  check_parents (d_btor, v2, {e[0], e[2], e[4]});
+  btor_node_release (d_btor, e[0]);
+  btor_node_release (d_btor, e[4]);
+  check_parents (d_btor, v1, {e[1], e[2]});
+  check_parents (d_btor, v2, {e[2]});
+  e[0] = btor_node_create_bv_and (d_btor, v2, v1);
+  check_parents (d_btor, v1, {e[0], e[1], e[2]});
+  check_parents (d_btor, v2, {e[0], e[2]});
+
+  /* clones keep node ids and thus the links */
+  clone = btor_clone_btor (d_btor);
+  cv1   = BTOR_PEEK_STACK (clone->nodes_id_table, v1->id);
+  cv2   = BTOR_PEEK_STACK (clone->nodes_id_table, v2->id);
+  for (i = 0; i < 3; i++)
+    ce[i] = BTOR_PEEK_STACK (clone->nodes_id_table, e[i]->id);
+  check_parents (clone, cv1, {ce[0], ce[1], ce[2]});
+  check_parents (clone, cv2, {ce[0], ce[2]});
+
+  /* and are independent of the original */
+  btor_node_release (clone, ce[1]);
+  ce[3] = btor_node_create_bv_mul (clone, cv1, cv2);
+  check_parents (clone, cv1, {ce[0], ce[2], ce[3]});
+  check_parents (clone, cv2, {ce[0], ce[2], ce[3]});
+  check_parents (d_btor, v1, {e[0], e[1], e[2]});
+  check_parents (d_btor, v2, {e[0], e[2]});
+
+  btor_node_release (clone, ce[0]);
+  btor_node_release (clone, ce[2]);
+  btor_node_release (clone, ce[3]);
+  btor_node_release (clone, BTOR_PEEK_STACK (clone->nodes_id_table, c->id));
+  btor_node_release (clone, cv1);
+  btor_node_release (clone, cv2);
+  btor_sort_release (clone, sort);
+  btor_sort_release (clone, sort1);
+  btor_delete (clone);
+
+  for (i = 0; i < 3; i++) btor_node_release (d_btor, e[i]);
+  btor_node_release (d_btor, c);
+  btor_node_release (d_btor, v1);
+  btor_node_release (d_btor, v2);
+  btor_sort_release (d_btor, sort);
+  btor_sort_release (d_btor, sort1);
+}
@@ -51,6 +51,7 @@ TEST_F (TestHash, traverse_str2i)
 
   BtorPtrHashTable *ht;
   BtorPtrHashBucket *p;
+  BtorPtrHashTableIterator it;
   char buffer[20];
   int32_t i;
 
@@ -71,8 +72,11 @@ TEST_F (TestHash, traverse_str2i)
     ASSERT_EQ (btor_hashptr_table_get (ht, buffer)->data.as_int, i);
   }
 
-  for (p = ht->first; p; p = p->next)
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
   {
+    p = it.bucket;
+    btor_iter_hashptr_next (&it);
     fprintf (d_log_file, "%s %d\n", (char *) p->key, p->data.as_int);
     btor_mem_freestr (d_mm, (char *) p->key);
   }
@@ -86,6 +90,7 @@ TEST_F (TestHash, str2str)
 
   BtorPtrHashTable *ht;
   BtorPtrHashBucket *p;
+  BtorPtrHashTableIterator it;
   BtorHashTableData data;
   char buffer[20];
   void *key;
@@ -119,8 +124,11 @@ TEST_F (TestHash, str2str)
     btor_mem_freestr (d_mm, (char *) key);
   }
 
-  for (p = ht->first; p; p = p->next)
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
   {
+    p = it.bucket;
+    btor_iter_hashptr_next (&it);
     fprintf (d_log_file, "%s -> %s\n", (char *) p->key, p->data.as_str);
     btor_mem_freestr (d_mm, (char *) p->key);
     btor_mem_freestr (d_mm, p->data.as_str);
@@ -128,3 +136,67 @@ TEST_F (TestHash, str2str)
 
   btor_hashptr_table_delete (ht);
 }
+
+TEST_F (TestHash, remove_order)
+{
+  BtorPtrHashTable *ht, *ht2;
+  BtorPtrHashTableIterator it;
+  uintptr_t i, j;
+
+  ht  = btor_hashptr_table_new (d_mm, 0, 0);
+  ht2 = btor_hashptr_table_new (d_mm, 0, 0);
+
+  /* removing and adding keys triggers compaction of the bucket array */
+  for (i = 1; i <= 1000; i++)
+  {
+    btor_hashptr_table_add (ht, (void *) (i * 16))->data.as_int = (int32_t) i;
+    if (i % 3 == 0) btor_hashptr_table_remove (ht, (void *) (i * 16), 0, 0);
+  }
+  for (i = 1; i <= 1000; i++)
+  {
+    if (i % 3 == 0)
+      ASSERT_EQ (btor_hashptr_table_get (ht, (void *) (i * 16)), nullptr);
+    else
+      ASSERT_EQ (btor_hashptr_table_get (ht, (void *) (i * 16))->data.as_int,
+                 (int32_t) i);
+  }
+  ASSERT_EQ (btor_hashptr_table_first (ht)->key, (void *) 16);
+  ASSERT_EQ (btor_hashptr_table_last (ht)->key, (void *) 16000);
+
+  /* iteration is chronological, removing visited keys is allowed */
+  btor_hashptr_table_add (ht2, (void *) 8);
+  btor_iter_hashptr_init (&it, ht);
+  btor_iter_hashptr_queue (&it, ht2);
+  for (i = 1; i <= 1000; i++)
+  {
+    if (i % 3 == 0) continue;
+    ASSERT_TRUE (btor_iter_hashptr_has_next (&it));
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) (i * 16));
+    if (i % 2 == 0) btor_hashptr_table_remove (ht, (void *) (i * 16), 0, 0);
+  }
+  ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) 8);
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  btor_iter_hashptr_init_reversed (&it, ht);
+  for (i = 1000; i >= 1; i--)
+  {
+    if (i % 3 == 0 || i % 2 == 0) continue;
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) (i * 16));
+  }
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  /* removing all keys empties the table */
+  for (i = 1, j = ht->count; i <= 1000; i++)
+  {
+    if (i % 3 == 0 || i % 2 == 0) continue;
+    btor_hashptr_table_remove (ht, (void *) (i * 16), 0, 0);
+    ASSERT_EQ (ht->count, --j);
+  }
+  ASSERT_EQ (btor_hashptr_table_first (ht), nullptr);
+  ASSERT_EQ (btor_hashptr_table_last (ht), nullptr);
+  btor_iter_hashptr_init (&it, ht);
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  btor_hashptr_table_delete (ht);
+  btor_hashptr_table_delete (ht2);
+}
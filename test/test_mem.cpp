@@ -61,3 +61,81 @@ TEST_F (TestMem, strdup)
   ASSERT_EQ (strcmp (test, "test"), 0);
   btor_mem_freestr (d_mm, test);
 }
+
+TEST_F (TestMem, slab)
+{
+  BtorMemSlab *slab;
+  int32_t *a, *b, *c;
+
+  slab = btor_mem_slab_new (d_mm, 3 * sizeof (int32_t));
+  ASSERT_EQ (slab->size % sizeof (void *), 0u);
+  ASSERT_GE (slab->size, 3 * sizeof (int32_t));
+
+  a = (int32_t *) btor_mem_slab_alloc (slab);
+  b = (int32_t *) btor_mem_slab_alloc (slab);
+  ASSERT_NE (a, b);
+  ASSERT_EQ (a[0], 0);
+  ASSERT_EQ (a[2], 0);
+  a[0] = 1;
+  a[2] = 3;
+  ASSERT_EQ (slab->num_objects, 2u);
+  ASSERT_EQ (d_mm->allocated, sizeof (BtorMemSlab) + slab->allocated);
+
+  /* released objects are reused and cleared */
+  btor_mem_slab_free (slab, a);
+  c = (int32_t *) btor_mem_slab_alloc (slab);
+  ASSERT_EQ (c, a);
+  ASSERT_EQ (c[0], 0);
+  ASSERT_EQ (c[2], 0);
+  btor_mem_slab_free (slab, b);
+  btor_mem_slab_free (slab, c);
+  ASSERT_EQ (slab->num_objects, 0u);
+
+  btor_mem_slab_delete (slab);
+  ASSERT_EQ (d_mm->allocated, 0u);
+}
+
+TEST_F (TestMem, slab_many)
+{
+  BtorMemSlab *slab;
+  uint64_t *objs[10000];
+  uint32_t i;
+
+  slab = btor_mem_slab_new (d_mm, sizeof (uint64_t));
+  for (i = 0; i < 10000; i++)
+  {
+    objs[i]  = (uint64_t *) btor_mem_slab_alloc (slab);
+    *objs[i] = i;
+  }
+  for (i = 0; i < 10000; i++) ASSERT_EQ (*objs[i], i);
+  for (i = 0; i < 10000; i += 2) btor_mem_slab_free (slab, objs[i]);
+  ASSERT_EQ (slab->num_objects, 5000u);
+  for (i = 1; i < 10000; i += 2) ASSERT_EQ (*objs[i], i);
+  btor_mem_slab_delete (slab);
+  ASSERT_EQ (d_mm->allocated, 0u);
+}
+
+TEST_F (TestMem, strarena)
+{
+  BtorMemStrArena *arena;
+  char *a, *b, *c, big[100000];
+
+  arena = btor_mem_strarena_new (d_mm);
+  a     = btor_mem_strarena_add (arena, "foobar", 3);
+  b     = btor_mem_strarena_add (arena, "bar", 3);
+  ASSERT_EQ (strcmp (a, "foo"), 0);
+  ASSERT_EQ (strcmp (b, "bar"), 0);
+  ASSERT_EQ (b, a + 4);
+
+  /* strings larger than a chunk get their own chunk */
+  memset (big, 'x', sizeof big);
+  c = btor_mem_strarena_add (arena, big, sizeof big);
+  ASSERT_EQ (c[0], 'x');
+  ASSERT_EQ (c[sizeof big - 1], 'x');
+  ASSERT_EQ (c[sizeof big], 0);
+  ASSERT_EQ (strcmp (a, "foo"), 0);
+  ASSERT_EQ (d_mm->allocated, sizeof (BtorMemStrArena) + arena->allocated);
+
+  btor_mem_strarena_delete (arena);
+  ASSERT_EQ (d_mm->allocated, 0u);
+}
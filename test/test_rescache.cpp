@@ -0,0 +1,173 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+#include <cstdio>
+
+extern "C" {
+#include "btorrescache.h"
+}
+
+class TestResCache : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    d_path = std::string (BTOR_LOG_DIR) + "rescache_"
+             + testing::UnitTest::GetInstance ()->current_test_info ()->name ()
+             + ".cache";
+    std::remove (d_path.c_str ());
+  }
+
+  void TearDown () override
+  {
+    if (d_other)
+    {
+      boolector_delete (d_other);
+      d_other = nullptr;
+    }
+    std::remove (d_path.c_str ());
+    TestBoolector::TearDown ();
+  }
+
+  /* Assert x * y = c with x, y > 1 (unsat if c is prime) and check sat. */
+  int32_t check (Btor *btor, uint32_t c, const char *xname)
+  {
+    BoolectorSort s;
+    BoolectorNode *x, *y, *cn, *one, *mul, *eq, *ugt;
+    int32_t res;
+
+    boolector_set_result_cache (btor, d_path.c_str ());
+    s   = boolector_bitvec_sort (btor, 16);
+    x   = boolector_var (btor, s, xname);
+    y   = boolector_var (btor, s, 0);
+    cn  = boolector_unsigned_int (btor, c, s);
+    one = boolector_one (btor, s);
+    mul = boolector_umulo (btor, x, y);
+    eq  = boolector_not (btor, mul);
+    boolector_assert (btor, eq);
+    boolector_release (btor, eq);
+    boolector_release (btor, mul);
+    mul = boolector_mul (btor, x, y);
+    eq  = boolector_eq (btor, mul, cn);
+    boolector_assert (btor, eq);
+    ugt = boolector_ugt (btor, x, one);
+    boolector_assert (btor, ugt);
+    boolector_release (btor, ugt);
+    ugt = boolector_ugt (btor, y, one);
+    boolector_assert (btor, ugt);
+    res = boolector_sat (btor);
+
+    boolector_release (btor, x);
+    boolector_release (btor, y);
+    boolector_release (btor, cn);
+    boolector_release (btor, one);
+    boolector_release (btor, mul);
+    boolector_release (btor, eq);
+    boolector_release (btor, ugt);
+    boolector_release_sort (btor, s);
+    return res;
+  }
+
+  std::string d_path;
+  Btor *d_other = nullptr;
+};
+
+TEST_F (TestResCache, hit)
+{
+  ASSERT_EQ (check (d_btor, 65521, "x"), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->result_cache->num_hit, 0u);
+  ASSERT_EQ (d_btor->result_cache->num_add, 1u);
+
+  /* symbols do not matter */
+  d_other = boolector_new ();
+  ASSERT_EQ (check (d_other, 65521, "z"), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_other->result_cache->num_hit, 1u);
+  ASSERT_EQ (d_other->result_cache->num_add, 0u);
+}
+
+TEST_F (TestResCache, miss)
+{
+  ASSERT_EQ (check (d_btor, 65521, "x"), BOOLECTOR_UNSAT);
+
+  d_other = boolector_new ();
+  ASSERT_EQ (check (d_other, 65535, "x"), BOOLECTOR_SAT);
+  ASSERT_EQ (d_other->result_cache->num_hit, 0u);
+  ASSERT_EQ (d_other->result_cache->num_add, 1u);
+}
+
+TEST_F (TestResCache, model_gen)
+{
+  ASSERT_EQ (check (d_btor, 65535, "x"), BOOLECTOR_SAT);
+
+  d_other = boolector_new ();
+  boolector_set_opt (d_other, BTOR_OPT_MODEL_GEN, 1);
+  ASSERT_EQ (check (d_other, 65535, "x"), BOOLECTOR_SAT);
+  ASSERT_EQ (d_other->result_cache->num_get, 0u);
+}
+
+TEST_F (TestResCache, enlarge)
+{
+  BtorResultCache *cache;
+  BtorResultCacheKey key;
+  uint32_t i;
+
+  cache = btor_result_cache_new (d_btor->mm, d_path.c_str ());
+  for (i = 0; i < 5000; i++)
+  {
+    key.h[0] = i * 0x9e3779b97f4a7c15ull;
+    key.h[1] = i;
+    btor_result_cache_add (
+        cache, &key, i % 2 ? BTOR_RESULT_SAT : BTOR_RESULT_UNSAT);
+  }
+  for (i = 0; i < 5000; i++)
+  {
+    key.h[0] = i * 0x9e3779b97f4a7c15ull;
+    key.h[1] = i;
+    ASSERT_EQ (btor_result_cache_get (cache, &key),
+               i % 2 ? BTOR_RESULT_SAT : BTOR_RESULT_UNSAT);
+  }
+  key.h[1] = 5000;
+  ASSERT_EQ (btor_result_cache_get (cache, &key), BTOR_RESULT_UNKNOWN);
+  ASSERT_EQ (cache->num_add, 5000u);
+  btor_result_cache_delete (cache);
+}
+
+TEST_F (TestResCache, corrupted)
+{
+  BtorResultCache *cache;
+  BtorResultCacheKey key;
+  FILE *file;
+  uint32_t i, header[4] = {0x43525442u, 1, 4, 0};
+  uint64_t rec[3];
+
+  /* all records used although 'count' is 0 */
+  file = fopen (d_path.c_str (), "wb");
+  ASSERT_NE (file, nullptr);
+  fwrite (header, sizeof (header), 1, file);
+  for (i = 0; i < 4; i++)
+  {
+    rec[0] = i;
+    rec[1] = i;
+    rec[2] = BTOR_RESULT_SAT;
+    fwrite (rec, sizeof (rec), 1, file);
+  }
+  fclose (file);
+
+  cache    = btor_result_cache_new (d_btor->mm, d_path.c_str ());
+  key.h[0] = 0;
+  key.h[1] = 1;
+  ASSERT_EQ (btor_result_cache_get (cache, &key), BTOR_RESULT_UNKNOWN);
+  btor_result_cache_add (cache, &key, BTOR_RESULT_UNSAT);
+  ASSERT_EQ (cache->num_add, 0u);
+  key.h[1] = 0;
+  ASSERT_EQ (btor_result_cache_get (cache, &key), BTOR_RESULT_SAT);
+  btor_result_cache_delete (cache);
+}
@@ -0,0 +1,86 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorrwcache.h"
+}
+
+class TestRwCache : public TestBtor
+{
+ protected:
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+    d_sort = btor_sort_bv (d_btor, 32);
+    d_x    = btor_exp_var (d_btor, d_sort, "x");
+    d_y    = btor_exp_var (d_btor, d_sort, "y");
+    d_rwc  = d_btor->rw_cache;
+  }
+
+  void TearDown () override
+  {
+    btor_node_release (d_btor, d_x);
+    btor_node_release (d_btor, d_y);
+    btor_sort_release (d_btor, d_sort);
+    TestBtor::TearDown ();
+  }
+
+  BtorSortId d_sort;
+  BtorNode *d_x, *d_y;
+  BtorRwCache *d_rwc;
+};
+
+TEST_F (TestRwCache, add_get)
+{
+  int32_t x = btor_node_get_id (d_x), y = btor_node_get_id (d_y);
+
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, x, y, 0), 0);
+  btor_rw_cache_add (d_rwc, BTOR_BV_AND_NODE, x, y, 0, x);
+  btor_rw_cache_add (d_rwc, BTOR_BV_ADD_NODE, x, y, 0, y);
+  btor_rw_cache_add (d_rwc, BTOR_BV_SLICE_NODE, x, 7, 0, y);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, x, y, 0), x);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_ADD_NODE, x, y, 0), y);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_SLICE_NODE, x, 7, 0), y);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_SLICE_NODE, x, 7, 1), 0);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, y, x, 0), 0);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, -x, y, 0), 0);
+}
+
+TEST_F (TestRwCache, reset)
+{
+  int32_t x = btor_node_get_id (d_x), y = btor_node_get_id (d_y);
+
+  btor_rw_cache_add (d_rwc, BTOR_BV_AND_NODE, x, y, 0, x);
+  btor_rw_cache_reset (d_rwc);
+  ASSERT_EQ (d_rwc->num_entries, 0u);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, x, y, 0), 0);
+  btor_rw_cache_add (d_rwc, BTOR_BV_AND_NODE, x, y, 0, y);
+  ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_AND_NODE, x, y, 0), y);
+}
+
+TEST_F (TestRwCache, budget)
+{
+  int32_t x = btor_node_get_id (d_x), y = btor_node_get_id (d_y);
+  uint32_t i, j, n = 0;
+
+  btor_opt_set (d_btor, BTOR_OPT_RW_CACHE_SIZE, 1);
+  for (i = 0; i < 1000; i++)
+    for (j = 0; j < 100; j++, n++)
+    {
+      btor_rw_cache_add (d_rwc, BTOR_BV_SLICE_NODE, x, i, j, y);
+      ASSERT_EQ (btor_rw_cache_get (d_rwc, BTOR_BV_SLICE_NODE, x, i, j), y);
+    }
+  ASSERT_LE (btor_rw_cache_size (d_rwc), (size_t) 1 << 20);
+  ASSERT_LE (d_rwc->num_entries, d_rwc->num_sets * BTOR_RW_CACHE_WAYS);
+  ASSERT_EQ (d_rwc->num_add, n);
+  ASSERT_GT (d_rwc->num_remove, 0u);
+}
@@ -8,8 +8,15 @@
 
 #include "test.h"
 
+#include <csetjmp>
+#include <csignal>
+
 extern "C" {
+#include "boolector.h"
 #include "btoraig.h"
+#include "btorcore.h"
+#include "btorlookahead.h"
+#include "btorsatshare.h"
 #include "dumper/btordumpaig.h"
 }
 
@@ -40,3 +47,351 @@ TEST_F (TestSatMgr, next_cnf_id)
   ASSERT_EQ (btor_sat_mgr_next_cnf_id (d_smgr), 4);
   btor_sat_reset (d_smgr);
 }
+
+#ifndef _WIN32
+TEST_F (TestSatMgr, external)
+{
+  /* answers the first query with model 1 2 -3 and the second with failed
+   * assumption 3 */
+  const char *cmd =
+      "n=0; while read l; do case $l in a*) n=$((n+1)); if [ $n = 1 ]; "
+      "then printf 'c mock\\ns SATISFIABLE\\nv 1 2\\nv -3 0\\n'; "
+      "else printf 's UNSATISFIABLE\\nf 3 0\\n'; fi;; esac; done";
+  int32_t a, b, c;
+
+  d_btor->ext_sat_cmd = btor_mem_strdup (d_btor->mm, cmd);
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_EXTERNAL);
+  /* can not be terminated, hence not used in a portfolio */
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 2);
+  btor_sat_enable_solver (d_smgr);
+  ASSERT_EQ (strcmp (d_smgr->name, "External"), 0);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  c = btor_sat_mgr_next_cnf_id (d_smgr);
+  btor_sat_add (d_smgr, a);
+  btor_sat_add (d_smgr, -b);
+  btor_sat_add (d_smgr, 0);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, -b), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, c), 0);
+  btor_sat_assume (d_smgr, b);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, b));
+  ASSERT_FALSE (btor_sat_failed (d_smgr, -b));
+  btor_sat_reset (d_smgr);
+}
+
+static std::jmp_buf abort_env;
+
+static void
+abort_longjmp (const char *msg)
+{
+  (void) msg;
+  std::longjmp (abort_env, 1);
+}
+
+TEST_F (TestSatMgr, external_terminated)
+{
+  /* answers the first query and terminates */
+  const char *cmd =
+      "while read l; do case $l in a*) printf 's SATISFIABLE\\nv 0\\n'; "
+      "exit 0;; esac; done";
+  struct sigaction sa;
+  int32_t a, i;
+  volatile bool aborted = false;
+
+  d_btor->ext_sat_cmd = btor_mem_strdup (d_btor->mm, cmd);
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_EXTERNAL);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+
+  /* more than fits into the pipe, writing fails with SIGPIPE after the
+   * solver terminated, which is reported as error instead */
+  for (i = 0; i < 100000; i++)
+  {
+    btor_sat_add (d_smgr, a);
+    btor_sat_add (d_smgr, 0);
+  }
+  boolector_set_abort (abort_longjmp);
+  if (!setjmp (abort_env))
+    btor_sat_check_sat (d_smgr, -1);
+  else
+    aborted = true;
+  boolector_set_abort (0);
+  ASSERT_TRUE (aborted);
+  btor_sat_reset (d_smgr);
+
+  /* the disposition of SIGPIPE is not changed */
+  ASSERT_EQ (sigaction (SIGPIPE, 0, &sa), 0);
+  ASSERT_EQ (sa.sa_handler, SIG_DFL);
+}
+#endif
+
+TEST_F (TestSatMgr, lookahead_cubes)
+{
+  BtorIntStack clauses, assumptions, cubes;
+  int32_t cnf[] = {1, 2, 0, -1, 3, 0, -2, 3, 0, -3, 4, 5, 0, -4, -5, 0};
+  size_t i, num_cubes, len;
+
+  BTOR_INIT_STACK (d_btor->mm, clauses);
+  BTOR_INIT_STACK (d_btor->mm, assumptions);
+  BTOR_INIT_STACK (d_btor->mm, cubes);
+  for (i = 0; i < sizeof cnf / sizeof *cnf; i++)
+    BTOR_PUSH_STACK (clauses, cnf[i]);
+
+  btor_lookahead_cubes (d_btor->mm, 5, &clauses, &assumptions, 2, &cubes);
+  num_cubes = len = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (cubes); i++)
+  {
+    if (BTOR_PEEK_STACK (cubes, i))
+    {
+      ASSERT_LT (++len, 3u);
+      continue;
+    }
+    num_cubes += 1;
+    len = 0;
+  }
+  ASSERT_GT (num_cubes, 1u);
+  ASSERT_LE (num_cubes, 4u);
+
+  /* inconsistent under assumptions: not split */
+  BTOR_RESET_STACK (cubes);
+  BTOR_PUSH_STACK (assumptions, -3);
+  BTOR_PUSH_STACK (assumptions, 1);
+  btor_lookahead_cubes (d_btor->mm, 5, &clauses, &assumptions, 2, &cubes);
+  ASSERT_EQ (BTOR_COUNT_STACK (cubes), 1u);
+  ASSERT_EQ (BTOR_PEEK_STACK (cubes, 0), 0);
+
+  BTOR_RELEASE_STACK (cubes);
+  BTOR_RELEASE_STACK (assumptions);
+  BTOR_RELEASE_STACK (clauses);
+}
+
+TEST_F (TestSatMgr, share)
+{
+  BtorSATShare *share;
+  BtorSATShareClient c0, c1;
+  int32_t cls[] = {1, -2, 3, 0}, big[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0};
+  int32_t *lits, lbd, i;
+
+  share = btor_sat_share_new (d_btor->mm, 4, 2);
+  btor_sat_share_init_client (share, &c0, 0);
+  btor_sat_share_init_client (share, &c1, 1);
+
+  ASSERT_TRUE (btor_sat_share_export (&c0, cls, 2));
+  ASSERT_FALSE (btor_sat_share_export (&c0, cls, 3));
+  ASSERT_FALSE (btor_sat_share_export (&c0, big, 1));
+  /* own clauses are not imported */
+  ASSERT_EQ (btor_sat_share_import (&c0, &lbd), nullptr);
+  lits = btor_sat_share_import (&c1, &lbd);
+  ASSERT_NE (lits, nullptr);
+  ASSERT_EQ (lbd, 2);
+  for (i = 0; cls[i]; i++) ASSERT_EQ (lits[i], cls[i]);
+  ASSERT_EQ (lits[i], 0);
+  ASSERT_EQ (btor_sat_share_import (&c1, &lbd), nullptr);
+
+  /* overwritten clauses are skipped */
+  for (i = 1; i <= 6; i++)
+  {
+    cls[0] = i;
+    ASSERT_TRUE (btor_sat_share_export (&c0, cls, 1));
+  }
+  for (i = 3; i <= 6; i++)
+  {
+    lits = btor_sat_share_import (&c1, &lbd);
+    ASSERT_NE (lits, nullptr);
+    ASSERT_EQ (lits[0], i);
+  }
+  ASSERT_EQ (btor_sat_share_import (&c1, &lbd), nullptr);
+  ASSERT_EQ (c0.num_exported, 7u);
+  ASSERT_EQ (c1.num_imported, 5u);
+
+  btor_sat_share_delete (share);
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+
+/* Each thread exports clauses [id, n, n + 1, ..., n + id] and checks that the
+ * imported clauses are not torn. */
+static void *
+share_thread (void *state)
+{
+  BtorSATShareClient *client = (BtorSATShareClient *) state;
+  int32_t lits[BTOR_SAT_SHARE_MAX_SIZE + 1], *imported, lbd, id, n, i;
+
+  id = (int32_t) client->id + 1;
+  for (n = 1; n <= 20000; n++)
+  {
+    lits[0] = id;
+    for (i = 1; i <= id; i++) lits[i] = n + i - 1;
+    lits[i] = 0;
+    (void) btor_sat_share_export (client, lits, 0);
+    while ((imported = btor_sat_share_import (client, &lbd)))
+    {
+      for (i = 1; i <= imported[0]; i++)
+        if (imported[i] != imported[1] + i - 1) return client;
+      if (imported[i]) return client;
+    }
+  }
+  return 0;
+}
+
+TEST_F (TestSatMgr, share_threads)
+{
+  BtorSATShare *share;
+  BtorSATShareClient clients[4];
+  pthread_t threads[4];
+  void *res;
+  uint32_t i;
+
+  share = btor_sat_share_new (d_btor->mm, 64, 0);
+  for (i = 0; i < 4; i++)
+  {
+    btor_sat_share_init_client (share, clients + i, i);
+    ASSERT_EQ (pthread_create (threads + i, 0, share_thread, clients + i), 0);
+  }
+  for (i = 0; i < 4; i++)
+  {
+    pthread_join (threads[i], &res);
+    ASSERT_EQ (res, nullptr);
+  }
+  btor_sat_share_delete (share);
+}
+
+TEST_F (TestSatMgr, portfolio)
+{
+  int32_t a, b, c;
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 4);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  ASSERT_EQ (((BtorSATPortfolio *) d_smgr->solver)->size, 4u);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  c = btor_sat_mgr_next_cnf_id (d_smgr);
+  ASSERT_EQ (a, 2);
+  ASSERT_EQ (c, 4);
+
+  /* (a | b) & (-a | c) & (-b | c) */
+  btor_sat_add (d_smgr, a);
+  btor_sat_add (d_smgr, b);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_add (d_smgr, -a);
+  btor_sat_add (d_smgr, c);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_add (d_smgr, -b);
+  btor_sat_add (d_smgr, c);
+  btor_sat_add (d_smgr, 0);
+
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, c), 1);
+
+  btor_sat_assume (d_smgr, -c);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, -c));
+
+  btor_sat_assume (d_smgr, -a);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+  btor_sat_reset (d_smgr);
+}
+
+TEST_F (TestSatMgr, portfolio_check_sat)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *mul, *c, *eq;
+
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 3);
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s   = boolector_bitvec_sort (d_btor, 12);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  mul = boolector_mul (d_btor, x, y);
+  c   = boolector_unsigned_int (d_btor, 3007, s);
+  eq  = boolector_eq (d_btor, mul, c);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (strcmp (btor_get_sat_mgr (d_btor)->name, "Portfolio"), 0);
+  boolector_release (d_btor, eq);
+
+  eq = boolector_eq (d_btor, x, c);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_release (d_btor, eq);
+
+  eq = boolector_eq (d_btor, x, y);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_TRUE (boolector_failed (d_btor, eq));
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestSatMgr, cubes)
+{
+  BtorSATCubes *cubes;
+  int32_t x, p, q, r;
+  size_t i;
+
+  /* 'x' implies the most assignments and is split on. Under 'p' the cube 'x'
+   * and under 'q' the cube '-x' is refuted by the clauses over 'y', 'z' and
+   * 'u', 'w', respectively, which is not detected by propagation. */
+  int32_t cnf[] = {
+      /* x = 2 */
+      -2, 10, 0, -2, 11, 0, 2, 12, 0, 2, 13, 0,
+      /* p = 3, y = 6, z = 7 */
+      -2, -3, 6, 7, 0, -2, -3, 6, -7, 0, -2, -3, -6, 7, 0, -2, -3, -6, -7, 0,
+      /* q = 4, u = 8, w = 9 */
+      2, -4, 8, 9, 0, 2, -4, 8, -9, 0, 2, -4, -8, 9, 0, 2, -4, -8, -9, 0};
+
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_enable_cubes (d_smgr, 1, 2);
+  btor_sat_init (d_smgr);
+  ASSERT_EQ (strcmp (d_smgr->name, "Cube-and-Conquer"), 0);
+  cubes = (BtorSATCubes *) d_smgr->solver;
+  for (i = 0; i < 12; i++) btor_sat_mgr_next_cnf_id (d_smgr);
+  for (i = 0; i < sizeof cnf / sizeof *cnf; i++) btor_sat_add (d_smgr, cnf[i]);
+  x = 2;
+  p = 3;
+  q = 4;
+  r = 5;
+
+  /* refuting 'x' requires 'p' and refuting '-x' requires 'q' */
+  btor_sat_assume (d_smgr, p);
+  btor_sat_assume (d_smgr, q);
+  btor_sat_assume (d_smgr, r);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_EQ (BTOR_COUNT_STACK (cubes->starts), 2u);
+  ASSERT_EQ (BTOR_COUNT_STACK (cubes->cubes), 4u);
+  ASSERT_EQ (BTOR_PEEK_STACK (cubes->cubes, 0), x);
+  ASSERT_EQ (BTOR_PEEK_STACK (cubes->cubes, 2), -x);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, p));
+  ASSERT_TRUE (btor_sat_failed (d_smgr, q));
+  ASSERT_FALSE (btor_sat_failed (d_smgr, r));
+
+  /* only cube '-x' is satisfiable, the model is the one of its worker */
+  btor_sat_assume (d_smgr, p);
+  btor_sat_assume (d_smgr, r);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (BTOR_COUNT_STACK (cubes->starts), 2u);
+  ASSERT_GE (cubes->winner, 0);
+  ASSERT_EQ (btor_sat_deref (d_smgr, x), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, 12), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, 13), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, r), 1);
+  ASSERT_EQ (cubes->num_cubes, 4u);
+  btor_sat_reset (d_smgr);
+}
+
+#endif
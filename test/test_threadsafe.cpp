@@ -0,0 +1,196 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+#include <csetjmp>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "boolector.h"
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+
+class TestThreadSafe : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t NUM_THREADS = 4;
+  static constexpr uint32_t NUM_TERMS   = 500;
+
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_THREAD_SAFE, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  }
+
+  /* Build the same terms over 'x' and 'y' as all other threads. */
+  void build (BoolectorSort s,
+              BoolectorNode *x,
+              BoolectorNode *y,
+              std::vector<BoolectorNode *> &terms)
+  {
+    BoolectorNode *c, *add, *mul, *res;
+
+    for (uint32_t i = 0; i < NUM_TERMS; i++)
+    {
+      c   = boolector_unsigned_int (d_btor, i, s);
+      add = boolector_add (d_btor, x, c);
+      mul = boolector_mul (d_btor, add, y);
+      res = boolector_ult (d_btor, mul, c);
+      terms.push_back (res);
+      boolector_release (d_btor, c);
+      boolector_release (d_btor, add);
+      boolector_release (d_btor, mul);
+    }
+  }
+};
+
+TEST_F (TestThreadSafe, build_terms)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y;
+  std::vector<std::thread> threads;
+  std::vector<BoolectorNode *> terms[NUM_THREADS];
+
+  s = boolector_bitvec_sort (d_btor, 16);
+  x = boolector_var (d_btor, s, "x");
+  y = boolector_var (d_btor, s, "y");
+
+  for (uint32_t i = 0; i < NUM_THREADS; i++)
+    threads.emplace_back (
+        [this, s, x, y, &terms, i] () { build (s, x, y, terms[i]); });
+  for (std::thread &t : threads) t.join ();
+
+  /* hash consing yields the same nodes in all threads */
+  for (uint32_t i = 1; i < NUM_THREADS; i++)
+  {
+    ASSERT_EQ (terms[i].size (), (size_t) NUM_TERMS);
+    for (uint32_t j = 0; j < NUM_TERMS; j++)
+      ASSERT_EQ (terms[i][j], terms[0][j]);
+  }
+
+  threads.clear ();
+  for (uint32_t i = 0; i < NUM_THREADS; i++)
+    threads.emplace_back ([this, &terms, i] () {
+      BoolectorNode *n;
+      for (uint32_t j = i % 2; j < NUM_TERMS; j += 2)
+      {
+        n = boolector_not (d_btor, terms[i][j]);
+        boolector_assert (d_btor, n);
+        boolector_release (d_btor, n);
+      }
+      for (BoolectorNode *t : terms[i]) boolector_release (d_btor, t);
+    });
+  for (std::thread &t : threads) t.join ();
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestThreadSafe, getters)
+{
+  BoolectorSort s, s1, fs;
+  BoolectorNode *x, *y, *c, *f, *args[2];
+  std::vector<std::thread> threads;
+  std::vector<BoolectorNode *> terms[NUM_THREADS];
+
+  s  = boolector_bitvec_sort (d_btor, 16);
+  s1 = boolector_bitvec_sort (d_btor, 16);
+  x  = boolector_var (d_btor, s, "x");
+  y  = boolector_var (d_btor, s, "y");
+  c  = boolector_unsigned_int (d_btor, 42, s);
+  BoolectorSort domain[2] = {s, s};
+  fs                      = boolector_fun_sort (d_btor, domain, 2, s);
+  f                       = boolector_uf (d_btor, fs, "f");
+  args[0]                 = x;
+  args[1]                 = y;
+
+  /* half of the threads construct terms while the others query the terms
+   * and sorts created above */
+  for (uint32_t i = 0; i < NUM_THREADS; i++)
+  {
+    if (i % 2 == 0)
+      threads.emplace_back (
+          [this, s, x, y, &terms, i] () { build (s, x, y, terms[i]); });
+    else
+      threads.emplace_back ([this, s, s1, x, y, c, f, &args] () {
+        const char *bits;
+        for (uint32_t j = 0; j < NUM_TERMS; j++)
+        {
+          ASSERT_EQ (boolector_get_width (d_btor, x), 16u);
+          ASSERT_EQ (boolector_bitvec_sort_get_width (d_btor, s), 16u);
+          ASSERT_TRUE (boolector_is_equal_sort (d_btor, x, y));
+          ASSERT_TRUE (boolector_is_var (d_btor, x));
+          ASSERT_TRUE (boolector_is_const (d_btor, c));
+          ASSERT_FALSE (boolector_is_const (d_btor, y));
+          ASSERT_TRUE (boolector_is_fun (d_btor, f));
+          ASSERT_EQ (boolector_fun_sort_check (d_btor, args, 2, f), -1);
+          ASSERT_EQ (boolector_get_node_id (d_btor, x),
+                     boolector_get_node_id (d_btor, x));
+          ASSERT_GT (boolector_get_refs (d_btor), 0u);
+          ASSERT_EQ (s, s1);
+          bits = boolector_get_bits (d_btor, c);
+          ASSERT_STREQ (bits, "0000000000101010");
+          boolector_free_bits (d_btor, bits);
+        }
+      });
+  }
+  for (std::thread &t : threads) t.join ();
+
+  for (uint32_t i = 0; i < NUM_THREADS; i += 2)
+    for (BoolectorNode *t : terms[i]) boolector_release (d_btor, t);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, f);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, s1);
+  boolector_release_sort (d_btor, fs);
+}
+
+static std::jmp_buf abort_env;
+
+static void
+abort_longjmp (const char *msg)
+{
+  (void) msg;
+  std::longjmp (abort_env, 1);
+}
+
+TEST_F (TestThreadSafe, abort_releases_lock)
+{
+  BoolectorSort s;
+  BoolectorNode *x;
+
+  s = boolector_bitvec_sort (d_btor, 8);
+  x = boolector_var (d_btor, s, "x");
+
+  /* the abort callback returns to the user without unwinding the API call,
+   * the lock of the instance must have been released before */
+  boolector_set_abort (abort_longjmp);
+  if (!setjmp (abort_env)) boolector_get_width (d_btor, 0);
+  boolector_set_abort (0);
+
+  std::thread t ([this, x] () {
+    BoolectorNode *n = boolector_not (d_btor, x);
+    ASSERT_EQ (boolector_get_width (d_btor, n), 8u);
+    boolector_release (d_btor, n);
+  });
+  t.join ();
+
+  boolector_release (d_btor, x);
+  boolector_release_sort (d_btor, s);
+}
+
+#endif